@@ -8,6 +8,8 @@ namespace OpenAutoIt
 class REPLInterpreter
 {
 public:
+    REPLInterpreter();
+
     int Run();
 
 private:
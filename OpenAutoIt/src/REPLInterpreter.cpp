@@ -7,10 +7,18 @@
 #include "OpenAutoIt/SourceManager.hpp"
 #include "OpenAutoIt/Utililty.hpp"
 #include <string>
+#include <string_view>
 
 namespace OpenAutoIt
 {
 
+REPLInterpreter::REPLInterpreter()
+{
+    m_Interpreter.vm().SetupOutputHandler(
+            [](std::string_view message) { out(message); },
+            [](std::string_view message) { err(message); });
+}
+
 int REPLInterpreter::Run()
 {
     out("Welcome to the OpenAutoIt REPL!\n");
@@ -14,16 +14,6 @@
 
 using namespace OpenAutoIt;
 
-void standard_output_handler(const std::string& message)
-{
-    std::cout << message;
-}
-
-void error_output_handler(const std::string& message)
-{
-    std::cerr << message;
-}
-
 int main(int argc, char* argv[])
 {
     if (argc < 2)
@@ -67,10 +57,14 @@ int main(int argc, char* argv[])
     }
 
     OpenAutoIt::Interpreter interpreter;
-    interpreter.vm().SetupOutputHandler(standard_output_handler, error_output_handler);
+    interpreter.vm().SetupOutputFileDescriptors(1, 2);
+
+    // Diagnostics were written through std::cout
+    std::cout.flush();
 
     interpreter.SetDocument(document);
     interpreter.Run();
+    interpreter.vm().FlushOutput();
 
     const phi::u32 exit_code = interpreter.vm().GetExitCode();
 
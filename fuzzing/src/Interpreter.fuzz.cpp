@@ -36,12 +36,7 @@ extern "C" int LLVMFuzzerTestOneInput(const phi::uint8_t* data, phi::size_t size
     interpreter.SetDocument(document);
 
     // Limit number of executions because of the halting problem
-    phi::u64 statements_ran = 0u;
-    while (interpreter.vm().CanRun() && statements_ran < MaxNumberOfStatements)
-    {
-        interpreter.Step();
-        ++statements_ran;
-    }
+    (void)interpreter.RunFor(MaxNumberOfStatements);
 
     return 0;
 }
@@ -9,6 +9,7 @@
 #include "OpenAutoIt/AST/ASTExpression.hpp"
 
 // Expressions
+#include "OpenAutoIt/AST/ASTArrayLiteral.hpp"
 #include "OpenAutoIt/AST/ASTArraySubscriptExpression.hpp"
 #include "OpenAutoIt/AST/ASTBinaryExpression.hpp"
 #include "OpenAutoIt/AST/ASTBooleanLiteral.hpp"
@@ -27,6 +28,9 @@
 // Statements
 #include "OpenAutoIt/AST/ASTExitStatement.hpp"
 #include "OpenAutoIt/AST/ASTExpressionStatement.hpp"
+#include "OpenAutoIt/AST/ASTForInStatement.hpp"
+#include "OpenAutoIt/AST/ASTForStatement.hpp"
 #include "OpenAutoIt/AST/ASTIfStatement.hpp"
+#include "OpenAutoIt/AST/ASTReDimStatement.hpp"
 #include "OpenAutoIt/AST/ASTVariableAssignment.hpp"
 #include "OpenAutoIt/AST/ASTWhileStatement.hpp"
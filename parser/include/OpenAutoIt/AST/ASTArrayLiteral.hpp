@@ -0,0 +1,43 @@
+#pragma once
+
+#include "OpenAutoIt/AST/ASTExpression.hpp"
+#include "OpenAutoIt/AST/ASTNode.hpp"
+#include "OpenAutoIt/Utililty.hpp"
+#include <phi/core/scope_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// Like '[1, 2, 3]' or '[[1, 2], [3, 4]]' for multi dimensional arrays
+class ASTArrayLiteral final : public ASTExpression
+{
+public:
+    ASTArrayLiteral()
+    {
+        m_NodeType = ASTNodeType::ArrayLiteral;
+    }
+
+    [[nodiscard]] std::string DumpAST(phi::usize indent = 0u) const override
+    {
+        std::string ret;
+
+        ret += indent_times(indent);
+        ret += "ArrayLiteral\n";
+        ret += indent_times(indent) + "[\n";
+
+        for (const auto& element : m_Elements)
+        {
+            ret += element->DumpAST(indent + 1u) + ",\n";
+        }
+
+        ret += indent_times(indent) + ']';
+
+        return ret;
+    }
+
+    // TODO: Make these private
+public:
+    std::vector<phi::not_null_scope_ptr<ASTExpression>> m_Elements;
+};
+} // namespace OpenAutoIt
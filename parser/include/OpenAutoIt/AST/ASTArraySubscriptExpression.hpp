@@ -6,31 +6,43 @@
 #include "OpenAutoIt/Utililty.hpp"
 #include <phi/core/scope_ptr.hpp>
 #include <string>
+#include <vector>
 
 namespace OpenAutoIt
 {
+// Accessing an element of an array like '$array[1][2]'
 class ASTArraySubscriptExpression final : public ASTExpression
 {
 public:
-    ASTArraySubscriptExpression(phi::not_null_scope_ptr<ASTExpression>&& expression)
-        : m_IndexExpression{phi::move(expression)}
+    ASTArraySubscriptExpression(phi::not_null_scope_ptr<ASTExpression>&& array_expression)
+        : m_ArrayExpression{phi::move(array_expression)}
     {
         m_NodeType = ASTNodeType::ArraySubscriptExpression;
     }
 
     [[nodiscard]] std::string DumpAST(phi::usize indent = 0u) const override
     {
-        (void)indent;
-
         std::string ret;
 
-        // TODO: Implement me
+        ret += indent_times(indent);
+        ret += "ArraySubscriptExpression\n";
+        ret += indent_times(indent) + "[\n";
+        ret += m_ArrayExpression->DumpAST(indent + 1u);
+        ret += '\n';
+
+        for (const auto& index_expression : m_IndexExpressions)
+        {
+            ret += index_expression->DumpAST(indent + 1u) + ",\n";
+        }
+
+        ret += indent_times(indent) + ']';
 
         return ret;
     }
 
     // TODO: Make these private
 public:
-    phi::not_null_scope_ptr<ASTExpression> m_IndexExpression;
+    phi::not_null_scope_ptr<ASTExpression>              m_ArrayExpression;
+    std::vector<phi::not_null_scope_ptr<ASTExpression>> m_IndexExpressions;
 };
 } // namespace OpenAutoIt
@@ -7,6 +7,7 @@
 #include <phi/algorithm/string_equals.hpp>
 #include <phi/core/assert.hpp>
 #include <phi/core/scope_ptr.hpp>
+#include <phi/core/sized_types.hpp>
 #include <vector>
 
 namespace OpenAutoIt
@@ -25,16 +26,16 @@ public:
         m_Functions.emplace_back(phi::move(child));
     }
 
-    [[nodiscard]] phi::observer_ptr<ASTFunctionDefinition> LookupFunctionDefinitionByName(
-            phi::string_view function_name)
+    [[nodiscard]] phi::observer_ptr<const ASTFunctionDefinition> LookupFunctionDefinitionByName(
+            phi::string_view function_name) const
     {
-        for (phi::not_null_observer_ptr<ASTFunctionDefinition> func_definition : m_Functions)
+        for (const phi::not_null_scope_ptr<ASTFunctionDefinition>& func_definition : m_Functions)
         {
             const phi::string_view function_definition_name = func_definition->m_FunctionName;
 
             if (string_equals_ignore_case(function_definition_name, function_name))
             {
-                return phi::move(func_definition);
+                return func_definition.get();
             }
         }
 
@@ -74,5 +75,9 @@ public:
 public:
     std::vector<phi::not_null_scope_ptr<ASTStatement>>          m_Statements;
     std::vector<phi::not_null_scope_ptr<ASTFunctionDefinition>> m_Functions;
+    phi::size_t m_OperatorExpressionCount{0u}; // See ASTExpression::m_OperatorIndex
+
+    // The enclosing region of every function and loop, see ASTNode::NoRegionIndex
+    std::vector<phi::size_t> m_RegionParents;
 };
 } // namespace OpenAutoIt
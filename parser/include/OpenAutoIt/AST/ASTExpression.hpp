@@ -2,6 +2,8 @@
 
 #include "OpenAutoIt/AST/ASTNode.hpp"
 #include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <limits>
 
 namespace OpenAutoIt
 {
@@ -21,5 +23,15 @@ public:
                 return false;
         }
     }
+
+    static constexpr const phi::size_t NoOperatorIndex{std::numeric_limits<phi::size_t>::max()};
+
+    // Binary and unary expressions are numbered densely per document in the order they are parsed
+    // so per expression data can be kept in a plain vector, see
+    // ASTDocument::m_OperatorExpressionCount
+    phi::size_t m_OperatorIndex{NoOperatorIndex};
+
+    // The innermost function or loop containing the operator
+    phi::size_t m_RegionIndex{NoRegionIndex};
 };
 } // namespace OpenAutoIt
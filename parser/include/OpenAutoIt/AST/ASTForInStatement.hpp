@@ -0,0 +1,54 @@
+#pragma once
+
+#include "OpenAutoIt/AST/ASTExpression.hpp"
+#include "OpenAutoIt/AST/ASTStatement.hpp"
+#include "OpenAutoIt/Statements.hpp"
+#include "OpenAutoIt/Utililty.hpp"
+#include <phi/container/string_view.hpp>
+#include <phi/core/scope_ptr.hpp>
+#include <string>
+
+namespace OpenAutoIt
+{
+// https://www.autoitscript.com/autoit3/docs/keywords/ForInNext.htm
+class ASTForInStatement final : public ASTStatement
+{
+public:
+    ASTForInStatement(phi::string_view                         variable_name,
+                      phi::not_null_scope_ptr<ASTExpression>&& collection)
+        : m_VariableName{variable_name}
+        , m_CollectionExpression{phi::move(collection)}
+    {
+        m_NodeType = ASTNodeType::ForInStatement;
+    }
+
+    [[nodiscard]] std::string DumpAST(phi::usize indent = 0u) const override
+    {
+        std::string ret;
+
+        ret += indent_times(indent);
+        ret += "ForInStatement [$";
+        ret += std::string_view(m_VariableName.data(), m_VariableName.length().unsafe());
+        ret += " In ";
+        ret += m_CollectionExpression->DumpAST(0u);
+        ret += "]\n";
+        ret += indent_times(indent);
+        ret += "[\n";
+        for (const auto& statement : m_Statements)
+        {
+            ret += statement->DumpAST(indent + 1u);
+        }
+        ret += indent_times(indent);
+        ret += "]\n";
+
+        return ret;
+    }
+
+    // TODO: Make these private
+public:
+    phi::string_view                       m_VariableName; // Variable name without the $
+    phi::not_null_scope_ptr<ASTExpression> m_CollectionExpression;
+    Statements                             m_Statements;
+    phi::size_t                            m_RegionIndex{NoRegionIndex}; // Only the body
+};
+} // namespace OpenAutoIt
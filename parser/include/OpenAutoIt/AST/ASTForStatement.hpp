@@ -0,0 +1,66 @@
+#pragma once
+
+#include "OpenAutoIt/AST/ASTExpression.hpp"
+#include "OpenAutoIt/AST/ASTStatement.hpp"
+#include "OpenAutoIt/Statements.hpp"
+#include "OpenAutoIt/Utililty.hpp"
+#include <phi/container/string_view.hpp>
+#include <phi/core/scope_ptr.hpp>
+#include <string>
+
+namespace OpenAutoIt
+{
+// https://www.autoitscript.com/autoit3/docs/keywords/For.htm
+class ASTForStatement final : public ASTStatement
+{
+public:
+    ASTForStatement(phi::string_view variable_name, phi::not_null_scope_ptr<ASTExpression>&& start,
+                    phi::not_null_scope_ptr<ASTExpression>&& end,
+                    phi::scope_ptr<ASTExpression>&&          step)
+        : m_VariableName{variable_name}
+        , m_StartExpression{phi::move(start)}
+        , m_EndExpression{phi::move(end)}
+        , m_StepExpression{phi::move(step)}
+    {
+        m_NodeType = ASTNodeType::ForStatement;
+    }
+
+    [[nodiscard]] std::string DumpAST(phi::usize indent = 0u) const override
+    {
+        std::string ret;
+
+        ret += indent_times(indent);
+        ret += "ForStatement [$";
+        ret += std::string_view(m_VariableName.data(), m_VariableName.length().unsafe());
+        ret += " = ";
+        ret += m_StartExpression->DumpAST(0u);
+        ret += " To ";
+        ret += m_EndExpression->DumpAST(0u);
+        if (m_StepExpression)
+        {
+            ret += " Step ";
+            ret += m_StepExpression->DumpAST(0u);
+        }
+        ret += "]\n";
+        ret += indent_times(indent);
+        ret += "[\n";
+        for (const auto& statement : m_Statements)
+        {
+            ret += statement->DumpAST(indent + 1u);
+        }
+        ret += indent_times(indent);
+        ret += "]\n";
+
+        return ret;
+    }
+
+    // TODO: Make these private
+public:
+    phi::string_view                       m_VariableName; // Variable name without the $
+    phi::not_null_scope_ptr<ASTExpression> m_StartExpression;
+    phi::not_null_scope_ptr<ASTExpression> m_EndExpression;
+    phi::scope_ptr<ASTExpression>          m_StepExpression; // Optional, defaults to 1
+    Statements                             m_Statements;
+    phi::size_t                            m_RegionIndex{NoRegionIndex}; // Only the body
+};
+} // namespace OpenAutoIt
@@ -82,6 +82,7 @@ public:
     phi::string_view                                   m_FunctionName;
     std::vector<FunctionParameter>                     m_Parameters;
     std::vector<phi::not_null_scope_ptr<ASTStatement>> m_FunctionBody;
+    phi::size_t                                        m_RegionIndex{NoRegionIndex};
 };
 
 } // namespace OpenAutoIt
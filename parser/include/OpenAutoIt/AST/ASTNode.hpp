@@ -6,24 +6,29 @@
 #include <phi/core/assert.hpp>
 #include <phi/core/observer_ptr.hpp>
 #include <phi/core/types.hpp>
+#include <limits>
 #include <string>
 
 namespace OpenAutoIt
 {
 
 #define OPENAUTOIT_ENUM_AST_NODE_TYPE()                                                            \
+    OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(ArrayLiteral)                                               \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(ArraySubscriptExpression)                                   \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(BinaryExpression)                                           \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(BooleanLiteral)                                             \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(ExitStatement)                                              \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(ExpressionStatement)                                        \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(FloatLiteral)                                               \
+    OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(ForInStatement)                                             \
+    OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(ForStatement)                                               \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(FunctionCallExpression)                                     \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(FunctionReferenceExpression)                                \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(IfStatement)                                                \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(IntegerLiteral)                                             \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(KeywordLiteral)                                             \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(MacroExpression)                                            \
+    OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(ReDimStatement)                                             \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(StringLiteral)                                              \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(TernaryIfExpression)                                        \
     OPENAUTOIT_ENUM_AST_NODE_TYPE_IMPL(UnaryExpression)                                            \
@@ -74,6 +79,11 @@ public:
 
     virtual ~ASTNode() = default;
 
+    // Functions and loops are numbered densely per document in the order they are parsed, see
+    // ASTDocument::m_RegionParents. Their call and back edge counts decide when the operators
+    // inside of them are compiled.
+    static constexpr const phi::size_t NoRegionIndex{std::numeric_limits<phi::size_t>::max()};
+
     [[nodiscard]] const char* Name() const
     {
         PHI_ASSERT(m_NodeType != ASTNodeType::NONE);
@@ -101,6 +111,18 @@ public:
         return ret;
     }
 
+    template <typename TypeT>
+    phi::not_null_observer_ptr<const TypeT> as() const
+    {
+        static_assert(phi::is_base_of_v<ASTNode, TypeT>,
+                      "Can only cast to derived classes of ASTNode");
+
+        const TypeT* ret = dynamic_cast<const TypeT*>(this);
+        PHI_ASSERT(ret);
+
+        return ret;
+    }
+
 protected:
     ASTNodeType m_NodeType{ASTNodeType::NONE};
 };
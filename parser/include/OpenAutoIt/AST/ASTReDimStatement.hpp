@@ -0,0 +1,48 @@
+#pragma once
+
+#include "OpenAutoIt/AST/ASTExpression.hpp"
+#include "OpenAutoIt/AST/ASTNode.hpp"
+#include "OpenAutoIt/AST/ASTStatement.hpp"
+#include "OpenAutoIt/Utililty.hpp"
+#include <phi/container/string_view.hpp>
+#include <phi/core/scope_ptr.hpp>
+#include <string>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// https://www.autoitscript.com/autoit3/docs/keywords/ReDim.htm
+class ASTReDimStatement final : public ASTStatement
+{
+public:
+    ASTReDimStatement()
+    {
+        m_NodeType = ASTNodeType::ReDimStatement;
+    }
+
+    [[nodiscard]] std::string DumpAST(phi::usize indent = 0u) const override
+    {
+        std::string ret;
+
+        ret += indent_times(indent);
+        ret += "ReDimStatement: $";
+        ret += std::string_view(m_VariableName.data(), m_VariableName.length().unsafe());
+        ret += '\n';
+        ret += indent_times(indent) + "[\n";
+
+        for (const auto& dimension : m_Dimensions)
+        {
+            ret += dimension->DumpAST(indent + 1u) + ",\n";
+        }
+
+        ret += indent_times(indent) + "]\n";
+
+        return ret;
+    }
+
+    // TODO: Make these private
+public:
+    phi::string_view                                    m_VariableName;
+    std::vector<phi::not_null_scope_ptr<ASTExpression>> m_Dimensions;
+};
+} // namespace OpenAutoIt
@@ -3,11 +3,13 @@
 #include "OpenAutoIt/AST/ASTExpression.hpp"
 #include "OpenAutoIt/AST/ASTNode.hpp"
 #include "OpenAutoIt/AST/ASTStatement.hpp"
+#include "OpenAutoIt/TokenKind.hpp"
 #include "OpenAutoIt/Utililty.hpp"
 #include "OpenAutoIt/VariableScope.hpp"
 #include <phi/container/string_view.hpp>
 #include <phi/core/boolean.hpp>
 #include <phi/core/scope_ptr.hpp>
+#include <vector>
 
 namespace OpenAutoIt
 {
@@ -31,7 +33,14 @@ public:
         ret += enum_name(m_Scope);
         ret += "] $";
         ret += std::string_view(m_VariableName.data(), m_VariableName.length().unsafe());
-        ret += " =";
+        for (const auto& subscript : m_Subscripts)
+        {
+            ret += "[\n";
+            ret += subscript->DumpAST(indent + 1u);
+            ret += "\n]";
+        }
+        ret += ' ';
+        ret += enum_name(m_Operator);
 
         if (m_InitialValueExpression)
         {
@@ -49,10 +58,15 @@ public:
 
     /// TODO: These should not be public
 public:
-    phi::boolean                  m_IsStatic{false};
-    phi::boolean                  m_IsConst{false};
-    VariableScope                 m_Scope{VariableScope::Auto};
-    phi::string_view              m_VariableName{};
-    phi::scope_ptr<ASTExpression> m_InitialValueExpression;
+    phi::boolean     m_IsStatic{false};
+    phi::boolean     m_IsConst{false};
+    VariableScope    m_Scope{VariableScope::Auto};
+    phi::string_view m_VariableName{};
+    TokenKind        m_Operator{TokenKind::OP_Equals}; // = or a compound assignment
+    phi::boolean     m_IsArray{false};
+    // Either the dimensions of an array declaration like 'Local $a[3]' or the indices of the
+    // element which gets assigned like '$a[1] = 2'
+    std::vector<phi::not_null_scope_ptr<ASTExpression>> m_Subscripts;
+    phi::scope_ptr<ASTExpression>                       m_InitialValueExpression;
 };
 } // namespace OpenAutoIt
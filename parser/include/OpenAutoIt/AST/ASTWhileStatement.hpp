@@ -41,5 +41,8 @@ public:
 public:
     phi::not_null_scope_ptr<ASTExpression>             m_ConditionExpression;
     std::vector<phi::not_null_scope_ptr<ASTStatement>> m_Statements;
+
+    // Covers the condition as well since it's evaluated for every iteration
+    phi::size_t m_RegionIndex{NoRegionIndex};
 };
 } // namespace OpenAutoIt
@@ -12,6 +12,7 @@ class ASTFunctionDefinition;
 class ASTExpression;
 
 // Expressions
+class ASTArrayLiteral;
 class ASTArraySubscriptExpression;
 class ASTBinaryExpression;
 class ASTBooleanLiteral;
@@ -30,7 +31,10 @@ class ASTStatement;
 // Statements
 class ASTExitStatement;
 class ASTExpressionStatement;
+class ASTForInStatement;
+class ASTForStatement;
 class ASTIfStatement;
+class ASTReDimStatement;
 class ASTVariableAssignment;
 class ASTWhileStatement;
 
@@ -10,6 +10,7 @@
 #include "OpenAutoIt/SourceFile.hpp"
 #include "OpenAutoIt/SourceLocation.hpp"
 #include "OpenAutoIt/SourceManager.hpp"
+#include "OpenAutoIt/Statements.hpp"
 #include "OpenAutoIt/Token.hpp"
 #include "OpenAutoIt/TokenKind.hpp"
 #include "OpenAutoIt/TokenStream.hpp"
@@ -114,6 +115,23 @@ private:
         }
     }
 
+    [[nodiscard]] PHI_ATTRIBUTE_CONST constexpr static phi::boolean IsCompoundAssignmentOperator(
+            const TokenKind token_kind)
+    {
+        switch (token_kind)
+        {
+            case TokenKind::OP_PlusEquals:
+            case TokenKind::OP_MinusEquals:
+            case TokenKind::OP_MultiplyEquals:
+            case TokenKind::OP_DivideEquals:
+            case TokenKind::OP_ConcatenateEquals:
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
     void PushParsingContext(phi::not_null_observer_ptr<const SourceFile> source_file,
                             TokenStream&&                                token_stream);
     void PushParsingContext(phi::not_null_observer_ptr<const SourceFile> source_file,
@@ -157,6 +175,12 @@ private:
         m_Document->AppendFunction(phi::move(function));
     }
 
+    void AssignOperatorIndex(ASTExpression& expression);
+
+    // Opens the region of a function or loop nested in the current one and returns its index
+    [[nodiscard]] phi::size_t BeginRegion();
+    void                      EndRegion(phi::size_t region);
+
     void AppendSourceFileToDocument(phi::not_null_observer_ptr<const SourceFile> source_file,
                                     SourceLocation                               included_from);
 
@@ -174,9 +198,13 @@ private:
     phi::scope_ptr<ASTStatement> ParseStatement();
 
     phi::scope_ptr<ASTWhileStatement>                  ParseWhileStatement();
+    phi::scope_ptr<ASTStatement>                       ParseForStatement();
+    phi::scope_ptr<ASTForInStatement>                  ParseForInStatement(phi::string_view name);
+    phi::boolean                                       ParseForLoopBody(Statements& statements);
     phi::scope_ptr<ASTVariableAssignment>              ParseVariableAssignment();
     phi::scope_ptr<ASTExpressionStatement>             ParseExpressionStatement();
     phi::scope_ptr<ASTIfStatement>                     ParseIfStatement();
+    phi::scope_ptr<ASTReDimStatement>                  ParseReDimStatement();
     std::vector<phi::not_null_scope_ptr<ASTStatement>> ParseIfCaseStatements();
 
     // Expressions
@@ -189,7 +217,9 @@ private:
     phi::scope_ptr<ASTExpression>                       ParseFunctionExpression();
     std::vector<phi::not_null_scope_ptr<ASTExpression>> ParseFunctionCallArguments();
     phi::scope_ptr<ASTVariableExpression>               ParseVariableExpression();
-    phi::scope_ptr<ASTArraySubscriptExpression>         ParseArraySubscriptExpression();
+    phi::scope_ptr<ASTArraySubscriptExpression>         ParseArraySubscriptExpression(
+                    phi::not_null_scope_ptr<ASTExpression>&& array_expression);
+    phi::scope_ptr<ASTExpression>                       ParseSubscript();
     phi::scope_ptr<ASTExpression>                       ParseParenExpression();
     phi::scope_ptr<ASTExitStatement>                    ParseExitStatement();
     phi::scope_ptr<ASTUnaryExpression>     ParseUnaryExpression(const TokenKind operator_kind);
@@ -203,11 +233,13 @@ private:
     phi::scope_ptr<ASTBooleanLiteral> ParseBooleanLiteral();
     phi::scope_ptr<ASTKeywordLiteral> ParseKeywordLiteral();
     phi::scope_ptr<ASTFloatLiteral>   ParseFloatLiteral();
+    phi::scope_ptr<ASTArrayLiteral>   ParseArrayLiteral();
 
     phi::not_null_observer_ptr<SourceManager>    m_SourceManager;
     phi::not_null_observer_ptr<DiagnosticEngine> m_DiagnosticEngine;
     phi::not_null_observer_ptr<Lexer>            m_Lexer;
     phi::observer_ptr<ASTDocument>               m_Document;
+    phi::size_t                                  m_CurrentRegion{ASTNode::NoRegionIndex};
 
     std::stack<ParsingContext>            m_ParsingContextStack;
     std::unordered_set<const SourceFile*> m_IncludeOnceFiles;
@@ -543,35 +543,35 @@ static constexpr std::array<std::pair<phi::string_view, OpenAutoIt::TokenKind>,
                 {"tcprecv", OpenAutoIt::TokenKind::BI_TCPRecv},
                 {"tcpsend", OpenAutoIt::TokenKind::BI_TCPSend},
                 {"tcpshutdown", OpenAutoIt::TokenKind::BI_TCPShutdown},
-                {"tcpstartup", OpenAutoIt::TokenKind::BI_UDPShutdown},
-                {"timerdiff", OpenAutoIt::TokenKind::BI_TCPStartup},
-                {"timerinit", OpenAutoIt::TokenKind::BI_UDPStartup},
-                {"tooltip", OpenAutoIt::TokenKind::BI_TimerDiff},
-                {"traycreateitem", OpenAutoIt::TokenKind::BI_TimerInit},
-                {"traycreatemenu", OpenAutoIt::TokenKind::BI_ToolTip},
-                {"traygetmsg", OpenAutoIt::TokenKind::BI_TrayCreateItem},
-                {"trayitemdelete", OpenAutoIt::TokenKind::BI_TrayCreateMenu},
-                {"trayitemgethandle", OpenAutoIt::TokenKind::BI_TrayGetMsg},
-                {"trayitemgetstate", OpenAutoIt::TokenKind::BI_TrayItemDelete},
-                {"trayitemgettext", OpenAutoIt::TokenKind::BI_TrayItemGetHandle},
-                {"trayitemsetonevent", OpenAutoIt::TokenKind::BI_TrayItemGetState},
-                {"trayitemsetstate", OpenAutoIt::TokenKind::BI_TrayItemGetText},
-                {"trayitemsettext", OpenAutoIt::TokenKind::BI_TrayItemSetOnEvent},
-                {"traysetclick", OpenAutoIt::TokenKind::BI_TrayItemSetState},
-                {"trayseticon", OpenAutoIt::TokenKind::BI_TrayItemSetText},
-                {"traysetonevent", OpenAutoIt::TokenKind::BI_TraySetClick},
-                {"traysetpauseicon", OpenAutoIt::TokenKind::BI_TraySetIcon},
-                {"traysetstate", OpenAutoIt::TokenKind::BI_TraySetOnEvent},
-                {"traysettooltip", OpenAutoIt::TokenKind::BI_TraySetPauseIcon},
-                {"traytip", OpenAutoIt::TokenKind::BI_TraySetState},
-                {"ubound", OpenAutoIt::TokenKind::BI_TraySetToolTip},
-                {"udpbind", OpenAutoIt::TokenKind::BI_TrayTip},
-                {"udpclosesocket", OpenAutoIt::TokenKind::BI_UBound},
-                {"udpopen", OpenAutoIt::TokenKind::BI_UDPBind},
-                {"udprecv", OpenAutoIt::TokenKind::BI_UDPCloseSocket},
-                {"udpsend", OpenAutoIt::TokenKind::BI_UDPOpen},
-                {"udpshutdown", OpenAutoIt::TokenKind::BI_UDPRecv},
-                {"udpstartup", OpenAutoIt::TokenKind::BI_UDPSend},
+                {"tcpstartup", OpenAutoIt::TokenKind::BI_TCPStartup},
+                {"timerdiff", OpenAutoIt::TokenKind::BI_TimerDiff},
+                {"timerinit", OpenAutoIt::TokenKind::BI_TimerInit},
+                {"tooltip", OpenAutoIt::TokenKind::BI_ToolTip},
+                {"traycreateitem", OpenAutoIt::TokenKind::BI_TrayCreateItem},
+                {"traycreatemenu", OpenAutoIt::TokenKind::BI_TrayCreateMenu},
+                {"traygetmsg", OpenAutoIt::TokenKind::BI_TrayGetMsg},
+                {"trayitemdelete", OpenAutoIt::TokenKind::BI_TrayItemDelete},
+                {"trayitemgethandle", OpenAutoIt::TokenKind::BI_TrayItemGetHandle},
+                {"trayitemgetstate", OpenAutoIt::TokenKind::BI_TrayItemGetState},
+                {"trayitemgettext", OpenAutoIt::TokenKind::BI_TrayItemGetText},
+                {"trayitemsetonevent", OpenAutoIt::TokenKind::BI_TrayItemSetOnEvent},
+                {"trayitemsetstate", OpenAutoIt::TokenKind::BI_TrayItemSetState},
+                {"trayitemsettext", OpenAutoIt::TokenKind::BI_TrayItemSetText},
+                {"traysetclick", OpenAutoIt::TokenKind::BI_TraySetClick},
+                {"trayseticon", OpenAutoIt::TokenKind::BI_TraySetIcon},
+                {"traysetonevent", OpenAutoIt::TokenKind::BI_TraySetOnEvent},
+                {"traysetpauseicon", OpenAutoIt::TokenKind::BI_TraySetPauseIcon},
+                {"traysetstate", OpenAutoIt::TokenKind::BI_TraySetState},
+                {"traysettooltip", OpenAutoIt::TokenKind::BI_TraySetToolTip},
+                {"traytip", OpenAutoIt::TokenKind::BI_TrayTip},
+                {"ubound", OpenAutoIt::TokenKind::BI_UBound},
+                {"udpbind", OpenAutoIt::TokenKind::BI_UDPBind},
+                {"udpclosesocket", OpenAutoIt::TokenKind::BI_UDPCloseSocket},
+                {"udpopen", OpenAutoIt::TokenKind::BI_UDPOpen},
+                {"udprecv", OpenAutoIt::TokenKind::BI_UDPRecv},
+                {"udpsend", OpenAutoIt::TokenKind::BI_UDPSend},
+                {"udpshutdown", OpenAutoIt::TokenKind::BI_UDPShutdown},
+                {"udpstartup", OpenAutoIt::TokenKind::BI_UDPStartup},
                 {"vargettype", OpenAutoIt::TokenKind::BI_VarGetType},
                 {"winactivate", OpenAutoIt::TokenKind::BI_WinActivate},
                 {"winactive", OpenAutoIt::TokenKind::BI_WinActive},
@@ -598,8 +598,8 @@ static constexpr std::array<std::pair<phi::string_view, OpenAutoIt::TokenKind>,
                 {"winsettitle", OpenAutoIt::TokenKind::BI_WinSetTitle},
                 {"winsettrans", OpenAutoIt::TokenKind::BI_WinSetTrans},
                 {"winwait", OpenAutoIt::TokenKind::BI_WinWait},
-                {"winwaitactive", OpenAutoIt::TokenKind::BI_WinWaitClose},
-                {"winwaitclose", OpenAutoIt::TokenKind::BI_WinWaitActive},
+                {"winwaitactive", OpenAutoIt::TokenKind::BI_WinWaitActive},
+                {"winwaitclose", OpenAutoIt::TokenKind::BI_WinWaitClose},
                 {"winwaitnotactive", OpenAutoIt::TokenKind::BI_WinWaitNotActive},
         }};
 
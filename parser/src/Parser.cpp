@@ -178,6 +178,10 @@ void Parser::ParseDocument(phi::not_null_observer_ptr<ASTDocument> document)
 
     while (ShouldContinueParsing())
     {
+        // Every top level item starts outside of any region, even if the previous one failed to
+        // parse and left its region open
+        m_CurrentRegion = ASTNode::NoRegionIndex;
+
         if (!CurrentTokenStream().has_more())
         {
             PopParsingContext();
@@ -427,6 +431,33 @@ phi::optional<const Token&> Parser::MustParse(TokenKind kind)
     return token;
 }
 
+void Parser::AssignOperatorIndex(ASTExpression& expression)
+{
+    PHI_ASSERT(m_Document);
+
+    expression.m_OperatorIndex = m_Document->m_OperatorExpressionCount++;
+    expression.m_RegionIndex   = m_CurrentRegion;
+}
+
+phi::size_t Parser::BeginRegion()
+{
+    PHI_ASSERT(m_Document);
+
+    const phi::size_t region = m_Document->m_RegionParents.size();
+    m_Document->m_RegionParents.emplace_back(m_CurrentRegion);
+    m_CurrentRegion = region;
+
+    return region;
+}
+
+void Parser::EndRegion(phi::size_t region)
+{
+    PHI_ASSERT(m_Document);
+    PHI_ASSERT(region == m_CurrentRegion);
+
+    m_CurrentRegion = m_Document->m_RegionParents[region];
+}
+
 void Parser::AppendSourceFileToDocument(phi::not_null_observer_ptr<const SourceFile> source_file,
                                         SourceLocation                               included_from)
 {
@@ -457,6 +488,7 @@ phi::scope_ptr<ASTFunctionDefinition> Parser::ParseFunctionDefinition()
 
     auto function_definition            = phi::make_scope<ASTFunctionDefinition>();
     function_definition->m_FunctionName = function_name_token->GetText();
+    function_definition->m_RegionIndex  = BeginRegion();
 
     // Next we MUST parse an opening parenthesis (LParen)
     if (!MustParse(TokenKind::LParen))
@@ -524,6 +556,8 @@ phi::scope_ptr<ASTFunctionDefinition> Parser::ParseFunctionDefinition()
         return {};
     }
 
+    EndRegion(function_definition->m_RegionIndex);
+
     return phi::move(function_definition);
 }
 
@@ -753,6 +787,28 @@ phi::scope_ptr<ASTStatement> Parser::ParseStatement()
             break;
         }
 
+        // For statement
+        case TokenKind::KW_For: {
+            ret_statement = ParseForStatement();
+            if (!ret_statement)
+            {
+                err("ERR: Failed to parse for statement!\n");
+                return {};
+            }
+            break;
+        }
+
+        // ReDim statement
+        case TokenKind::KW_ReDim: {
+            ret_statement = ParseReDimStatement();
+            if (!ret_statement)
+            {
+                err("ERR: Failed to parse ReDim statement!\n");
+                return {};
+            }
+            break;
+        }
+
         // Exit statement
         case TokenKind::KW_Exit: {
             ret_statement = ParseExitStatement();
@@ -790,6 +846,8 @@ phi::scope_ptr<ASTWhileStatement> Parser::ParseWhileStatement()
     }
     ConsumeCurrent();
 
+    const phi::size_t region = BeginRegion();
+
     // Next we MUST parse an Expression
     auto while_condition_expression = ParseExpression();
     if (!while_condition_expression)
@@ -800,12 +858,18 @@ phi::scope_ptr<ASTWhileStatement> Parser::ParseWhileStatement()
 
     auto while_statement =
             phi::make_scope<ASTWhileStatement>(while_condition_expression.release_not_null());
+    while_statement->m_RegionIndex = region;
 
     // Parse statements until KW_WEnd
     while (HasMoreTokens() && CurrentToken().GetTokenKind() != TokenKind::KW_WEnd)
     {
         ConsumeNewLineAndComments();
 
+        if (!HasMoreTokens() || CurrentToken().GetTokenKind() == TokenKind::KW_WEnd)
+        {
+            break;
+        }
+
         // Parse statements
         auto statement = ParseStatement();
         if (!statement)
@@ -832,9 +896,149 @@ phi::scope_ptr<ASTWhileStatement> Parser::ParseWhileStatement()
     }
     ConsumeCurrent();
 
+    EndRegion(region);
+
     return phi::move(while_statement);
 }
 
+phi::scope_ptr<ASTStatement> Parser::ParseForStatement()
+{
+    if (!MustParse(TokenKind::KW_For))
+    {
+        // TODO: Proper error
+        return {};
+    }
+
+    // Next we MUST parse the loop variable
+    auto variable_token = MustParse(TokenKind::VariableIdentifier);
+    if (!variable_token)
+    {
+        err("ERR: Expected variable after For!\n");
+        return {};
+    }
+
+    // VariableIdentifiers begin with a '$' which we strip
+    PHI_ASSERT(variable_token->GetText().length() > 1u);
+    const phi::string_view variable_name = variable_token->GetText().substring_view(1u);
+
+    // 'For $element In $collection' starts a For...In loop instead
+    if (MustParse(TokenKind::KW_In))
+    {
+        return ParseForInStatement(variable_name);
+    }
+
+    // Next we MUST parse a '='
+    if (!MustParse(TokenKind::OP_Equals))
+    {
+        err("ERR: Expected '=' or 'In' after For variable!\n");
+        return {};
+    }
+
+    // Next we MUST parse the start expression
+    auto start_expression = ParseExpression();
+    if (!start_expression)
+    {
+        // TODO: Proper error
+        return {};
+    }
+
+    // Next we MUST parse To
+    if (!MustParse(TokenKind::KW_To))
+    {
+        err("ERR: Missing To!\n");
+        return {};
+    }
+
+    // Next we MUST parse the end expression
+    auto end_expression = ParseExpression();
+    if (!end_expression)
+    {
+        // TODO: Proper error
+        return {};
+    }
+
+    // Parse optional Step expression
+    phi::scope_ptr<ASTExpression> step_expression;
+    if (MustParse(TokenKind::KW_Step))
+    {
+        step_expression = ParseExpression();
+        if (!step_expression)
+        {
+            // TODO: Proper error
+            return {};
+        }
+    }
+
+    auto for_statement = phi::make_scope<ASTForStatement>(
+            variable_name, start_expression.release_not_null(), end_expression.release_not_null(),
+            phi::move(step_expression));
+
+    for_statement->m_RegionIndex = BeginRegion();
+    if (!ParseForLoopBody(for_statement->m_Statements))
+    {
+        return {};
+    }
+    EndRegion(for_statement->m_RegionIndex);
+
+    return phi::move(for_statement);
+}
+
+phi::scope_ptr<ASTForInStatement> Parser::ParseForInStatement(phi::string_view variable_name)
+{
+    // Next we MUST parse the collection expression
+    auto collection_expression = ParseExpression();
+    if (!collection_expression)
+    {
+        // TODO: Proper error
+        return {};
+    }
+
+    auto for_in_statement = phi::make_scope<ASTForInStatement>(
+            variable_name, collection_expression.release_not_null());
+
+    for_in_statement->m_RegionIndex = BeginRegion();
+    if (!ParseForLoopBody(for_in_statement->m_Statements))
+    {
+        return {};
+    }
+    EndRegion(for_in_statement->m_RegionIndex);
+
+    return phi::move(for_in_statement);
+}
+
+phi::boolean Parser::ParseForLoopBody(Statements& statements)
+{
+    // Parse statements until KW_Next
+    while (HasMoreTokens() && CurrentToken().GetTokenKind() != TokenKind::KW_Next)
+    {
+        ConsumeNewLineAndComments();
+
+        if (!HasMoreTokens() || CurrentToken().GetTokenKind() == TokenKind::KW_Next)
+        {
+            break;
+        }
+
+        // Parse statements
+        auto statement = ParseStatement();
+        if (!statement)
+        {
+            // TODO: Proper error
+            return false;
+        }
+
+        statements.emplace_back(statement.release_not_null());
+    }
+
+    // Next token MUST be KW_Next
+    if (!MustParse(TokenKind::KW_Next))
+    {
+        err("ERR: Missing Next!\n");
+        return false;
+    }
+
+    return true;
+}
+
 phi::scope_ptr<ASTVariableAssignment> Parser::ParseVariableAssignment()
 {
     auto variable_declaration = phi::make_scope<ASTVariableAssignment>();
@@ -920,17 +1124,84 @@ phi::scope_ptr<ASTVariableAssignment> Parser::ParseVariableAssignment()
         return {};
     }
 
+    const phi::boolean is_declaration = variable_declaration->m_IsConst ||
+                                        variable_declaration->m_IsStatic ||
+                                        variable_declaration->m_Scope != VariableScope::Auto;
+
+    // Either the dimensions of an array declaration like 'Local $a[3]' or the indices of the
+    // element being assigned like '$a[1] = 2'
+    phi::size_t empty_dimensions{0u};
+    while (HasMoreTokens() && CurrentToken().GetTokenKind() == TokenKind::LSquare)
+    {
+        variable_declaration->m_IsArray = true;
+
+        // 'Local $a[] = [1, 2, 3]' takes its size from the initializer
+        ConsumeCurrent();
+        if (HasMoreTokens() && CurrentToken().GetTokenKind() == TokenKind::RSquare)
+        {
+            ConsumeCurrent();
+            ++empty_dimensions;
+            continue;
+        }
+
+        phi::scope_ptr<ASTExpression> subscript = ParseExpression();
+        if (!subscript)
+        {
+            err("ERR: Failed to parse array subscript!\n");
+            return {};
+        }
+
+        if (!MustParse(TokenKind::RSquare))
+        {
+            err("ERR: Expected closing ']' for array subscript!\n");
+            return {};
+        }
+
+        variable_declaration->m_Subscripts.emplace_back(subscript.release_not_null());
+    }
+
+    if (variable_declaration->m_IsArray && !is_declaration &&
+        variable_declaration->m_Subscripts.empty())
+    {
+        err("ERR: Missing array subscript!\n");
+        return {};
+    }
+
+    // 'Local $m[]' without an initializer declares a map
+    const auto is_map_declaration = [&]() {
+        return is_declaration && empty_dimensions == 1u &&
+               variable_declaration->m_Subscripts.empty() &&
+               !variable_declaration->m_InitialValueExpression;
+    };
+
     // Next me must parse a OP_Equals/'=', a new line, comment or finish parsing
     if (!HasMoreTokens())
     {
+        if (empty_dimensions > 0u && !is_map_declaration())
+        {
+            err("ERR: Array declaration without a size requires an initializer!\n");
+            return {};
+        }
+
         return variable_declaration;
     }
 
     // Check for equals
     const Token& next_token = CurrentToken();
 
-    if (next_token.GetTokenKind() == TokenKind::OP_Equals)
+    if (next_token.GetTokenKind() == TokenKind::OP_Equals ||
+        IsCompoundAssignmentOperator(next_token.GetTokenKind()))
     {
+        // Compound assignments like '$a += 1' can only modify existing variables
+        if (next_token.GetTokenKind() != TokenKind::OP_Equals &&
+            (variable_declaration->m_IsConst || variable_declaration->m_IsStatic ||
+             variable_declaration->m_Scope != VariableScope::Auto))
+        {
+            err("ERR: Compound assignment is not allowed in a variable declaration!\n");
+            return {};
+        }
+
+        variable_declaration->m_Operator = next_token.GetTokenKind();
         ConsumeCurrent();
 
         // Now me MUST parse an expression
@@ -945,6 +1216,22 @@ phi::scope_ptr<ASTVariableAssignment> Parser::ParseVariableAssignment()
         variable_declaration->m_InitialValueExpression = phi::move(expression);
     }
 
+    if (empty_dimensions > 0u && !is_map_declaration() &&
+        (!variable_declaration->m_Subscripts.empty() ||
+         !variable_declaration->m_InitialValueExpression ||
+         variable_declaration->m_InitialValueExpression->NodeType() != ASTNodeType::ArrayLiteral))
+    {
+        err("ERR: Array declaration without a size requires an array literal initializer!\n");
+        return {};
+    }
+
+    if (variable_declaration->m_IsArray && !is_declaration &&
+        !variable_declaration->m_InitialValueExpression)
+    {
+        err("ERR: Expected assignment to array element!\n");
+        return {};
+    }
+
     return variable_declaration;
 }
 
@@ -1090,6 +1377,44 @@ std::vector<phi::not_null_scope_ptr<ASTStatement>> Parser::ParseIfCaseStatements
     return statements;
 }
 
+phi::scope_ptr<ASTReDimStatement> Parser::ParseReDimStatement()
+{
+    if (!MustParse(TokenKind::KW_ReDim))
+    {
+        return {};
+    }
+
+    if (!HasMoreTokens() || CurrentToken().GetTokenKind() != TokenKind::VariableIdentifier)
+    {
+        err("ERR: Expected variable after ReDim!\n");
+        return {};
+    }
+
+    auto redim_statement            = phi::make_scope<ASTReDimStatement>();
+    redim_statement->m_VariableName = CurrentToken().GetText().substring_view(1u);
+    ConsumeCurrent();
+
+    // Parse the new dimensions like '[10][2]'
+    while (HasMoreTokens() && CurrentToken().GetTokenKind() == TokenKind::LSquare)
+    {
+        phi::scope_ptr<ASTExpression> dimension = ParseSubscript();
+        if (!dimension)
+        {
+            return {};
+        }
+
+        redim_statement->m_Dimensions.emplace_back(dimension.release_not_null());
+    }
+
+    if (redim_statement->m_Dimensions.empty())
+    {
+        err("ERR: ReDim requires at least one dimension!\n");
+        return {};
+    }
+
+    return redim_statement;
+}
+
 phi::scope_ptr<ASTIntegerLiteral> Parser::ParseIntegerLiteral()
 {
     const Token& token = CurrentToken();
@@ -1281,6 +1606,20 @@ phi::scope_ptr<ASTExpression> Parser::ParseExpressionLhs()
             return {};
         }
 
+        // Array subscript like '$array[1][2]'
+        if (HasMoreTokens() && CurrentToken().GetTokenKind() == TokenKind::LSquare)
+        {
+            auto subscript_expression =
+                    ParseArraySubscriptExpression(variable_expression.release_not_null());
+            if (!subscript_expression)
+            {
+                err("ERR: Failed to parse array subscript expression\n");
+                return {};
+            }
+
+            return phi::move(subscript_expression);
+        }
+
         return phi::move(variable_expression);
     }
     // Keyword literal
@@ -1309,17 +1648,17 @@ phi::scope_ptr<ASTExpression> Parser::ParseExpressionLhs()
 
         return phi::move(float_literal);
     }
-    // ArraySubscript expression
+    // Array literal
     if (token.GetTokenKind() == TokenKind::LSquare)
     {
-        auto subscript_expression = ParseArraySubscriptExpression();
-        if (!subscript_expression)
+        auto array_literal = ParseArrayLiteral();
+        if (!array_literal)
         {
-            err("ERR: Failed to parse array subscript expression\n");
+            err("ERR: Failed to parse array literal\n");
             return {};
         }
 
-        return phi::move(subscript_expression);
+        return phi::move(array_literal);
     }
     if (token.IsMacro())
     {
@@ -1359,13 +1698,15 @@ phi::scope_ptr<ASTExpression> Parser::ParseExpressionRhs(phi::not_null_scope_ptr
             return phi::move(lhs);
         }
         int token_precedence = OperatorPrecedence.lookup(operator_token.GetTokenKind());
-        ConsumeCurrent();
 
+        // Leave the operator for the caller which binds less tightly
         if (token_precedence < precedence)
         {
             return phi::move(lhs);
         }
 
+        ConsumeCurrent();
+
         if (operator_token.GetTokenKind() == TokenKind::OP_TernaryIf)
         {
             phi::scope_ptr<ASTTernaryIfExpression> ternary_if_expression =
@@ -1390,9 +1731,12 @@ phi::scope_ptr<ASTExpression> Parser::ParseExpressionRhs(phi::not_null_scope_ptr
         // Nothing left to parse so directly return from here
         if (!HasMoreTokens())
         {
-            return phi::make_not_null_scope<ASTBinaryExpression>(phi::move(lhs),
-                                                                 operator_token.GetTokenKind(),
-                                                                 rhs_expression.release_not_null());
+            auto binary_expression = phi::make_not_null_scope<ASTBinaryExpression>(
+                    phi::move(lhs), operator_token.GetTokenKind(),
+                    rhs_expression.release_not_null());
+            AssignOperatorIndex(*binary_expression);
+
+            return phi::move(binary_expression);
         }
 
         // If BinOp binds less tightly with RHS than the operator after RHS, let
@@ -1414,6 +1758,7 @@ phi::scope_ptr<ASTExpression> Parser::ParseExpressionRhs(phi::not_null_scope_ptr
         // Merge LHS/RHS.
         lhs = phi::make_not_null_scope<ASTBinaryExpression>(
                 phi::move(lhs), operator_token.GetTokenKind(), rhs_expression.release_not_null());
+        AssignOperatorIndex(*lhs);
     }
 }
 
@@ -1513,16 +1858,29 @@ phi::scope_ptr<ASTVariableExpression> Parser::ParseVariableExpression()
     return phi::move(variable_expression);
 }
 
-PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wsuggest-attribute=const")
-PHI_GCC_SUPPRESS_WARNING("-Wsuggest-attribute=pure")
-
-phi::scope_ptr<ASTArraySubscriptExpression> Parser::ParseArraySubscriptExpression()
+phi::scope_ptr<ASTArraySubscriptExpression> Parser::ParseArraySubscriptExpression(
+        phi::not_null_scope_ptr<ASTExpression>&& array_expression)
 {
-    if (!HasMoreTokens())
+    auto subscript_expression =
+            phi::make_scope<ASTArraySubscriptExpression>(phi::move(array_expression));
+
+    // Parse all subscripts like '[1][2]'
+    while (HasMoreTokens() && CurrentToken().GetTokenKind() == TokenKind::LSquare)
     {
-        return {};
+        phi::scope_ptr<ASTExpression> index_expression = ParseSubscript();
+        if (!index_expression)
+        {
+            return {};
+        }
+
+        subscript_expression->m_IndexExpressions.emplace_back(index_expression.release_not_null());
     }
 
+    return subscript_expression;
+}
+
+phi::scope_ptr<ASTExpression> Parser::ParseSubscript()
+{
     if (!MustParse(TokenKind::LSquare))
     {
         return {};
@@ -1536,14 +1894,13 @@ phi::scope_ptr<ASTArraySubscriptExpression> Parser::ParseArraySubscriptExpressio
 
     if (!MustParse(TokenKind::RSquare))
     {
+        err("ERR: Expected closing ']' for array subscript!\n");
         return {};
     }
 
-    return phi::make_scope<ASTArraySubscriptExpression>(phi::move(expression.release_not_null()));
+    return expression;
 }
 
-PHI_GCC_SUPPRESS_WARNING_POP()
-
 phi::scope_ptr<ASTExpression> Parser::ParseParenExpression()
 {
     // NOTE: Me MUST have consumed the LParen before this
@@ -1591,16 +1948,19 @@ phi::scope_ptr<ASTUnaryExpression> Parser::ParseUnaryExpression(const TokenKind
         return {};
     }
 
-    // Parse expression
-    phi::scope_ptr<ASTExpression> expression = ParseExpression();
+    // Unary operators bind tighter than any binary operator so only parse the operand itself
+    phi::scope_ptr<ASTExpression> expression = ParseExpressionLhs();
     if (!expression)
     {
         // TODO: Proper error
         return {};
     }
 
-    return phi::make_scope<ASTUnaryExpression>(operator_kind,
-                                               phi::move(expression.release_not_null()));
+    auto unary_expression = phi::make_scope<ASTUnaryExpression>(
+            operator_kind, phi::move(expression.release_not_null()));
+    AssignOperatorIndex(*unary_expression);
+
+    return unary_expression;
 }
 
 phi::scope_ptr<ASTTernaryIfExpression> Parser::ParseTernaryIfExpression(
@@ -1710,4 +2070,40 @@ phi::scope_ptr<ASTFloatLiteral> Parser::ParseFloatLiteral()
     // TODO: Proper error
     return {};
 }
+
+phi::scope_ptr<ASTArrayLiteral> Parser::ParseArrayLiteral()
+{
+    if (!MustParse(TokenKind::LSquare))
+    {
+        return {};
+    }
+
+    auto array_literal = phi::make_scope<ASTArrayLiteral>();
+
+    // Elements are separated by commas and may themselves be array literals for more dimensions
+    while (HasMoreTokens() && CurrentToken().GetTokenKind() != TokenKind::RSquare)
+    {
+        phi::scope_ptr<ASTExpression> element = ParseExpression();
+        if (!element)
+        {
+            return {};
+        }
+
+        array_literal->m_Elements.emplace_back(element.release_not_null());
+
+        if (!HasMoreTokens() || CurrentToken().GetTokenKind() != TokenKind::Comma)
+        {
+            break;
+        }
+        ConsumeCurrent();
+    }
+
+    if (!MustParse(TokenKind::RSquare))
+    {
+        err("ERR: Expected closing ']' for array literal!\n");
+        return {};
+    }
+
+    return array_literal;
+}
 } // namespace OpenAutoIt
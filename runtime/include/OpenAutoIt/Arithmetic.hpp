@@ -0,0 +1,217 @@
+#pragma once
+
+#include "OpenAutoIt/CheckedOperations.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <cmath>
+#include <limits>
+
+PHI_CLANG_SUPPRESS_WARNING_PUSH()
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace OpenAutoIt
+{
+enum class ArithmeticOperation
+{
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Power,
+};
+
+// Unboxed numeric value used by the arithmetic kernels below
+struct Number
+{
+    [[nodiscard]] static Number MakeInt(const phi::int64_t value)
+    {
+        Number number;
+        number.int64 = value;
+        return number;
+    }
+
+    [[nodiscard]] static Number MakeDouble(const double value)
+    {
+        Number number;
+        number.is_double      = true;
+        number.floating_point = value;
+        return number;
+    }
+
+    [[nodiscard]] double AsDouble() const
+    {
+        return is_double ? floating_point : static_cast<double>(int64);
+    }
+
+    phi::boolean is_double{false};
+    phi::int64_t int64{0};
+    double       floating_point{0.0};
+};
+
+template <ArithmeticOperation Operation>
+[[nodiscard]] Number ArithmeticDouble(const double lhs, const double rhs)
+{
+    switch (Operation)
+    {
+        case ArithmeticOperation::Add:
+            return Number::MakeDouble(lhs + rhs);
+        case ArithmeticOperation::Subtract:
+            return Number::MakeDouble(lhs - rhs);
+        case ArithmeticOperation::Multiply:
+            return Number::MakeDouble(lhs * rhs);
+        case ArithmeticOperation::Divide:
+            return Number::MakeDouble(lhs / rhs);
+        case ArithmeticOperation::Power:
+            return Number::MakeDouble(std::pow(lhs, rhs));
+    }
+
+    PHI_ASSERT_NOT_REACHED();
+}
+
+[[nodiscard]] inline Number DivideInt64(const phi::int64_t lhs, const phi::int64_t rhs)
+{
+    // Return infinity when dividing by 0
+    if (rhs == 0)
+    {
+        if (lhs == 0)
+        {
+            return Number::MakeDouble(std::numeric_limits<double>::quiet_NaN());
+        }
+        if (lhs < 0)
+        {
+            return Number::MakeDouble(-std::numeric_limits<double>::infinity());
+        }
+
+        return Number::MakeDouble(std::numeric_limits<double>::infinity());
+    }
+
+    // NOTE: AutoIt always returns a double here but exact results are kept as integers since
+    //       they behave the same everywhere else
+    // NOTE: Checking the overflow case first since the modulo would also trap for it
+    if (!(lhs == std::numeric_limits<phi::int64_t>::min() && rhs == -1) && lhs % rhs == 0)
+    {
+        return Number::MakeInt(lhs / rhs);
+    }
+
+    return Number::MakeDouble(static_cast<double>(lhs) / static_cast<double>(rhs));
+}
+
+[[nodiscard]] inline Number PowerInt64(const phi::int64_t base, const phi::int64_t exponent)
+{
+    // Negative exponents produce fractions
+    if (exponent < 0)
+    {
+        return Number::MakeDouble(std::pow(static_cast<double>(base), static_cast<double>(exponent)));
+    }
+
+    // Exponentiation by squaring, promoting to double on overflow
+    phi::int64_t result             = 1;
+    phi::int64_t current_base       = base;
+    phi::int64_t remaining_exponent = exponent;
+    while (remaining_exponent > 0)
+    {
+        if ((remaining_exponent & 1) != 0 && CheckedMultiply(result, current_base, result))
+        {
+            return Number::MakeDouble(
+                    std::pow(static_cast<double>(base), static_cast<double>(exponent)));
+        }
+
+        remaining_exponent >>= 1;
+        if (remaining_exponent > 0 && CheckedMultiply(current_base, current_base, current_base))
+        {
+            return Number::MakeDouble(
+                    std::pow(static_cast<double>(base), static_cast<double>(exponent)));
+        }
+    }
+
+    return Number::MakeInt(result);
+}
+
+template <ArithmeticOperation Operation>
+[[nodiscard]] Number ArithmeticInt64(const phi::int64_t lhs, const phi::int64_t rhs)
+{
+    phi::int64_t result{0};
+
+    switch (Operation)
+    {
+        case ArithmeticOperation::Add:
+            if (CheckedAdd(lhs, rhs, result))
+            {
+                break;
+            }
+            return Number::MakeInt(result);
+
+        case ArithmeticOperation::Subtract:
+            if (CheckedMinus(lhs, rhs, result))
+            {
+                break;
+            }
+            return Number::MakeInt(result);
+
+        case ArithmeticOperation::Multiply:
+            if (CheckedMultiply(lhs, rhs, result))
+            {
+                break;
+            }
+            return Number::MakeInt(result);
+
+        case ArithmeticOperation::Divide:
+            return DivideInt64(lhs, rhs);
+
+        case ArithmeticOperation::Power:
+            return PowerInt64(lhs, rhs);
+    }
+
+    // The result overflowed so we promote to double
+    return ArithmeticDouble<Operation>(static_cast<double>(lhs), static_cast<double>(rhs));
+}
+
+template <ArithmeticOperation Operation>
+[[nodiscard]] Number ArithmeticNumber(const Number lhs, const Number rhs)
+{
+    if (!lhs.is_double && !rhs.is_double)
+    {
+        return ArithmeticInt64<Operation>(lhs.int64, rhs.int64);
+    }
+
+    return ArithmeticDouble<Operation>(lhs.AsDouble(), rhs.AsDouble());
+}
+
+enum class Ordering : phi::uint8_t
+{
+    Less,
+    Equal,
+    Greater,
+    Unordered, // At least one side is NaN
+};
+
+template <typename T>
+[[nodiscard]] Ordering OrderValues(const T lhs, const T rhs)
+{
+    if (lhs < rhs)
+    {
+        return Ordering::Less;
+    }
+    if (rhs < lhs)
+    {
+        return Ordering::Greater;
+    }
+
+    return lhs <= rhs ? Ordering::Equal : Ordering::Unordered;
+}
+
+// Two integers are compared exactly, everything else is compared as doubles
+[[nodiscard]] inline Ordering CompareNumbers(const Number lhs, const Number rhs)
+{
+    if (!lhs.is_double && !rhs.is_double)
+    {
+        return OrderValues(lhs.int64, rhs.int64);
+    }
+
+    return OrderValues(lhs.AsDouble(), rhs.AsDouble());
+}
+} // namespace OpenAutoIt
+
+PHI_CLANG_SUPPRESS_WARNING_POP()
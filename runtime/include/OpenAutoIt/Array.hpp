@@ -0,0 +1,90 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <vector>
+
+namespace OpenAutoIt
+{
+class Variant;
+
+// AutoIt limits for arrays
+// https://www.autoitscript.com/autoit3/docs/appendix/LimitsDefaults.htm
+constexpr const phi::size_t MaxArrayDimensions{64u};
+constexpr const phi::size_t MaxArrayElements{16'777'216u};
+
+// Subscripts or dimension sizes of an array without allocating
+struct ArraySubscripts
+{
+    std::array<phi::size_t, MaxArrayDimensions> values{};
+    phi::size_t                                  count{0u};
+};
+
+// How the elements of an array are stored
+enum class ArrayStorage : phi::uint8_t
+{
+    Boxed,  // Every element is a Variant
+    Int64,  // Every element is an Int64 stored without the Variant
+    Double, // Every element is a Double stored without the Variant
+};
+
+// A multi dimensional array storing all elements in a single contiguous block in row-major order.
+// Arrays where every element has the same numeric type are transparently stored unboxed. The first
+// write of a different type converts them back to Variants for good.
+class Array
+{
+public:
+    // Creates a one dimensional array which takes over the elements without copying them. Fails if
+    // there are more than MaxArrayElements.
+    [[nodiscard]] static phi::optional<Array> FromElements(std::vector<Variant>&& elements);
+
+    [[nodiscard]] phi::size_t GetDimensionCount() const;
+
+    // Size of the given dimension. This is what UBound returns
+    [[nodiscard]] phi::size_t GetDimension(phi::size_t dimension) const;
+
+    [[nodiscard]] phi::size_t GetElementCount() const;
+
+    [[nodiscard]] ArrayStorage GetStorage() const;
+
+    // All of these fail if the number of subscripts doesn't match or any subscript is out of range
+    [[nodiscard]] phi::optional<Variant> GetElement(const ArraySubscripts& subscripts) const;
+
+    // Element at the given row-major index which must be less than GetElementCount()
+    [[nodiscard]] Variant GetElementAt(phi::size_t index) const;
+
+    // Moves the element out of the array leaving an empty string behind. Used for modifying an
+    // element in place without copying its payload
+    [[nodiscard]] phi::optional<Variant> TakeElement(const ArraySubscripts& subscripts);
+
+    [[nodiscard]] phi::boolean SetElement(const ArraySubscripts& subscripts, Variant value);
+
+    // Resizes the array while keeping all elements which are still in range. Returns false if the
+    // dimensions exceed the limits in which case the array is left unchanged.
+    // NOTE: Changing the number of dimensions removes all elements
+    [[nodiscard]] phi::boolean ReDim(const ArraySubscripts& dimensions);
+
+private:
+    [[nodiscard]] phi::boolean ComputeIndex(const ArraySubscripts& subscripts,
+                                            phi::size_t&           index) const;
+
+    // Boxed elements are counted by type so we know when all of them have the same type
+    void CountElement(const Variant& element);
+    void UncountElement(const Variant& element);
+
+    void TrySpecialize();
+    void Box();
+
+    std::vector<phi::size_t>  m_Dimensions;
+    std::vector<Variant>      m_Elements;
+    std::vector<phi::int64_t> m_Int64Elements;
+    std::vector<double>       m_DoubleElements;
+    phi::size_t               m_Int64Count{0u};
+    phi::size_t               m_DoubleCount{0u};
+    ArrayStorage              m_Storage{ArrayStorage::Boxed};
+    phi::boolean              m_CanSpecialize{true};
+};
+} // namespace OpenAutoIt
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// A view of a range of bytes inside a reference counted buffer. Copies and slices share the buffer
+// so taking a part of a large binary never copies its bytes. The bytes only get copied when a
+// binary is modified while its buffer is shared.
+class Binary
+{
+public:
+    Binary() = default;
+
+    // Copies the given bytes into a new buffer
+    explicit Binary(std::string_view bytes);
+
+    // Takes ownership of the bytes without copying them
+    explicit Binary(std::string&& bytes);
+
+    Binary(const Binary& other);
+    Binary(Binary&& other);
+
+    ~Binary();
+
+    Binary& operator=(const Binary& other);
+    Binary& operator=(Binary&& other);
+
+    // Parses a string like "0x48656C6C6F". Fails if the string doesn't start with "0x", contains
+    // anything other than hex digits or has an odd number of them
+    [[nodiscard]] static phi::optional<Binary> FromHexString(std::string_view string);
+
+    [[nodiscard]] phi::size_t  GetSize() const;
+    [[nodiscard]] phi::boolean IsEmpty() const;
+
+    [[nodiscard]] std::string_view GetBytes() const;
+
+    // Returns a view of size bytes starting at offset which shares the buffer. The range is clamped
+    // to the size of this binary.
+    [[nodiscard]] Binary Slice(phi::size_t offset, phi::size_t size) const;
+
+    void Append(std::string_view bytes);
+
+    // Appends the bytes as uppercase hex digits prefixed by "0x", which is how AutoIt converts a
+    // binary to a string. An empty binary results in an empty string.
+    void AppendHexString(std::string& string) const;
+
+private:
+    struct Buffer
+    {
+        std::string bytes;
+        phi::size_t reference_count{1u};
+    };
+
+    void Release();
+
+    Buffer*     m_Buffer{nullptr}; // nullptr for empty binaries so they never allocate
+    phi::size_t m_Offset{0u};
+    phi::size_t m_Size{0u};
+};
+} // namespace OpenAutoIt
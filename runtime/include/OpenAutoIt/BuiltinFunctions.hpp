@@ -1,7 +1,11 @@
 #pragma once
 
+#include <vector>
+
 namespace OpenAutoIt
 {
+class FormatString;
+class Regex;
 class VirtualMachine;
 class Variant;
 
@@ -9,10 +13,122 @@ class Variant;
 
 Variant BuiltIn_Abs(const VirtualMachine& vm, const Variant& input);
 
+Variant BuiltIn_AscW(const VirtualMachine& vm, const Variant& character);
+
+Variant BuiltIn_Binary(const VirtualMachine& vm, const Variant& input);
+
+Variant BuiltIn_BinaryLen(const VirtualMachine& vm, const Variant& binary);
+
+Variant BuiltIn_BinaryMid(const VirtualMachine& vm, const Variant& binary, const Variant& start,
+                          const Variant& count);
+
+Variant BuiltIn_BinaryToString(const VirtualMachine& vm, const Variant& binary,
+                               const Variant& flag);
+
+Variant BuiltIn_ChrW(const VirtualMachine& vm, const Variant& code);
+
 Variant BuiltIn_ConsoleWrite(VirtualMachine& vm, const Variant& input);
 
 Variant BuiltIn_ConsoleWriteError(VirtualMachine& vm, const Variant& input);
 
+// flag 1 returns an array of the size, the number of files and the number of directories
+Variant BuiltIn_DirGetSize(VirtualMachine& vm, const Variant& path, const Variant& flag);
+
+// Closes handles of FileOpen as well as FileFindFirstFile
+Variant BuiltIn_FileClose(VirtualMachine& vm, const Variant& file);
+
+Variant BuiltIn_FileFindFirstFile(VirtualMachine& vm, const Variant& filename);
+
+Variant BuiltIn_FileFindNextFile(VirtualMachine& vm, const Variant& search, const Variant& flag);
+
+Variant BuiltIn_FileGetPos(VirtualMachine& vm, const Variant& file);
+
+Variant BuiltIn_FileOpen(VirtualMachine& vm, const Variant& filename, const Variant& mode);
+
+// file is either a handle returned by FileOpen or a file name
+Variant BuiltIn_FileRead(VirtualMachine& vm, const Variant& file, const Variant& count);
+
+// file is either a handle returned by FileOpen or a file name
+Variant BuiltIn_FileReadLine(VirtualMachine& vm, const Variant& file, const Variant& line);
+
+// file is either a handle returned by FileOpen or a file name
+Variant BuiltIn_FileReadToArray(VirtualMachine& vm, const Variant& file);
+
+Variant BuiltIn_FileSetPos(VirtualMachine& vm, const Variant& file, const Variant& offset,
+                           const Variant& origin);
+
+Variant BuiltIn_IsBinary(const VirtualMachine& vm, const Variant& input);
+
+Variant BuiltIn_IsMap(const VirtualMachine& vm, const Variant& input);
+
+Variant BuiltIn_MapAppend(VirtualMachine& vm, Variant& map, const Variant& value);
+
+Variant BuiltIn_MapExists(const VirtualMachine& vm, const Variant& map, const Variant& key);
+
+Variant BuiltIn_MapKeys(const VirtualMachine& vm, const Variant& map);
+
+Variant BuiltIn_MapRemove(VirtualMachine& vm, Variant& map, const Variant& key);
+
+Variant BuiltIn_StringAddCR(const VirtualMachine& vm, const Variant& string);
+
+// The arguments start with the format control string which is already compiled into format
+Variant BuiltIn_StringFormat(VirtualMachine& vm, const FormatString& format,
+                             const std::vector<Variant>& arguments);
+
+Variant BuiltIn_StringInStr(const VirtualMachine& vm, const Variant& string,
+                            const Variant& substring, const Variant& case_sense,
+                            const Variant& occurrence, const Variant& start, const Variant& count);
+
+Variant BuiltIn_StringIsAlNum(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringIsAlpha(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringIsASCII(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringIsDigit(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringIsLower(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringIsSpace(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringIsUpper(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringIsXDigit(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringLeft(const VirtualMachine& vm, const Variant& string, const Variant& count);
+
+Variant BuiltIn_StringLen(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringLower(const VirtualMachine& vm, const Variant& string);
+
+// The pattern is compiled by the caller and is nullptr if it is invalid
+Variant BuiltIn_StringMid(const VirtualMachine& vm, const Variant& string, const Variant& start,
+                          const Variant& count);
+
+Variant BuiltIn_StringRegExp(const VirtualMachine& vm, const Variant& string, const Regex* regex,
+                             const Variant& flag, const Variant& offset);
+
+Variant BuiltIn_StringRegExpReplace(const VirtualMachine& vm, const Variant& string,
+                                    const Regex* regex, const Variant& replace,
+                                    const Variant& count);
+
+Variant BuiltIn_StringReplace(const VirtualMachine& vm, const Variant& string,
+                              const Variant& search, const Variant& replace,
+                              const Variant& occurrence, const Variant& case_sense);
+
+Variant BuiltIn_StringRight(const VirtualMachine& vm, const Variant& string, const Variant& count);
+
+Variant BuiltIn_StringSplit(const VirtualMachine& vm, const Variant& string,
+                            const Variant& delimiters, const Variant& flag);
+
+Variant BuiltIn_StringStripCR(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_StringStripWS(const VirtualMachine& vm, const Variant& string, const Variant& flag);
+
+Variant BuiltIn_StringUpper(const VirtualMachine& vm, const Variant& string);
+
+Variant BuiltIn_UBound(const VirtualMachine& vm, const Variant& array, const Variant& dimension);
+
 Variant BuiltIn_VarGetType(const VirtualMachine& vm, const Variant& input);
 
 // OpenAutoIt Extensions
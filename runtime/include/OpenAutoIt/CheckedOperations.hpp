@@ -0,0 +1,81 @@
+#pragma once
+
+#include <phi/compiler_support/compiler.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <limits>
+
+namespace OpenAutoIt
+{
+
+// These functions return true if the operation overflowed, in which case the value of result is
+// unspecified
+
+// Add
+[[nodiscard]] inline phi::boolean CheckedAdd(const phi::int64_t lhs, const phi::int64_t rhs,
+                                             phi::int64_t& result)
+{
+#if PHI_COMPILER_IS(CLANG_COMPAT) || PHI_COMPILER_IS(GCC_COMPAT)
+    return __builtin_add_overflow(lhs, rhs, &result);
+#else
+    if ((rhs > 0 && lhs > std::numeric_limits<phi::int64_t>::max() - rhs) ||
+        (rhs < 0 && lhs < std::numeric_limits<phi::int64_t>::min() - rhs))
+    {
+        return true;
+    }
+
+    result = lhs + rhs;
+    return false;
+#endif
+}
+
+// Minus
+[[nodiscard]] inline phi::boolean CheckedMinus(const phi::int64_t lhs, const phi::int64_t rhs,
+                                               phi::int64_t& result)
+{
+#if PHI_COMPILER_IS(CLANG_COMPAT) || PHI_COMPILER_IS(GCC_COMPAT)
+    return __builtin_sub_overflow(lhs, rhs, &result);
+#else
+    if ((rhs < 0 && lhs > std::numeric_limits<phi::int64_t>::max() + rhs) ||
+        (rhs > 0 && lhs < std::numeric_limits<phi::int64_t>::min() + rhs))
+    {
+        return true;
+    }
+
+    result = lhs - rhs;
+    return false;
+#endif
+}
+
+// Multiply
+[[nodiscard]] inline phi::boolean CheckedMultiply(const phi::int64_t lhs, const phi::int64_t rhs,
+                                                  phi::int64_t& result)
+{
+#if PHI_COMPILER_IS(CLANG_COMPAT) || PHI_COMPILER_IS(GCC_COMPAT)
+    return __builtin_mul_overflow(lhs, rhs, &result);
+#else
+    if (lhs != 0 && rhs != 0)
+    {
+        if ((lhs == -1 && rhs == std::numeric_limits<phi::int64_t>::min()) ||
+            (rhs == -1 && lhs == std::numeric_limits<phi::int64_t>::min()))
+        {
+            return true;
+        }
+
+        const phi::int64_t product = static_cast<phi::int64_t>(static_cast<phi::uint64_t>(lhs) *
+                                                               static_cast<phi::uint64_t>(rhs));
+        if (product / rhs != lhs)
+        {
+            return true;
+        }
+
+        result = product;
+        return false;
+    }
+
+    result = 0;
+    return false;
+#endif
+}
+
+} // namespace OpenAutoIt
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "OpenAutoIt/AST/ASTExpression.hpp"
+#include "OpenAutoIt/Variant.hpp"
+#include "OpenAutoIt/VirtualMachine.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// A numeric expression compiled into a flat program working on unboxed Int64 and Double values
+// NOTE: Only literals, variables, the arithmetic and comparison operators as well as And and Or are
+//       supported. Every variable load is guarded to be numeric, if a guard fails the expression
+//       must be evaluated by the tree walking interpreter instead.
+class CompiledExpression
+{
+public:
+    // Returns an empty optional if the expression can't be compiled
+    [[nodiscard]] static phi::optional<CompiledExpression> Compile(
+            phi::not_null_observer_ptr<const ASTExpression> expression);
+
+    // Returns false if a type guard failed in which case result is left untouched
+    // NOTE: Variables are only looked up by name again after the variable layout of the virtual
+    //       machine changed, see VirtualMachine::GetVariableLayoutVersion
+    [[nodiscard]] phi::boolean Execute(const VirtualMachine& vm, Variant& result);
+
+    static constexpr const phi::size_t MaxStackDepth{16u};
+
+private:
+    enum class OpCode : phi::uint8_t
+    {
+        PushInt64,
+        PushDouble,
+        LoadVariable,
+        Negate,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Power,
+        Equal,
+        NotEqual,
+        LessThan,
+        LessThanEqual,
+        GreaterThan,
+        GreaterThanEqual,
+        // Short circuit for And/Or. If the value on top of the stack decides the result it's
+        // replaced by that result and execution continues at the target, otherwise it's popped.
+        JumpIfFalse,
+        JumpIfTrue,
+        ToBoolean,
+    };
+
+    // Comparisons, And and Or produce booleans which are kept as the Int64 values 0 and 1
+    enum class ValueKind : phi::uint8_t
+    {
+        Number,
+        Boolean,
+    };
+
+    struct Instruction
+    {
+        explicit Instruction(OpCode code)
+            : op_code{code}
+        {}
+
+        OpCode       op_code;
+        phi::int64_t int64{0};
+        double       floating_point{0.0};
+        phi::size_t  operand{0u}; // Variable slot or jump target
+    };
+
+    [[nodiscard]] phi::boolean CompileNode(phi::not_null_observer_ptr<const ASTExpression> expression,
+                                           phi::size_t depth, ValueKind& kind);
+
+    [[nodiscard]] phi::size_t GetVariableSlot(std::string_view variable_name);
+
+    void ResolveVariables(const VirtualMachine& vm);
+
+    std::vector<Instruction> m_Instructions;
+    ValueKind                m_ResultKind{ValueKind::Number};
+
+    // Every variable is resolved once and then used until the variable layout changes
+    std::vector<std::string_view>                 m_VariableNames;
+    std::vector<phi::observer_ptr<const Variant>> m_Variables;
+    phi::uint64_t                                 m_ResolvedVersion{0u}; // Zero is never used
+};
+} // namespace OpenAutoIt
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "OpenAutoIt/Wildcard.hpp"
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#if !PHI_PLATFORM_IS(LINUX)
+#    include <filesystem>
+#endif
+
+namespace OpenAutoIt
+{
+class ThreadPool;
+
+enum class EntryType
+{
+    File,
+    Directory,
+    SymbolicLink,
+    Other,
+    Unknown, // The file system didn't report the type
+};
+
+struct DirectoryEntry
+{
+    std::string_view name;
+    EntryType        type;
+};
+
+struct EntryStatus
+{
+    EntryType     type;
+    phi::uint64_t size;
+};
+
+// Reads the entries of a directory except . and ..
+// NOTE: On Linux the entries are read in batches with getdents64 into a buffer owned by the reader
+//       and their type comes from d_type, so only entries which need their size are passed to
+//       fstatat relative to the open directory. Other platforms use std::filesystem.
+class DirectoryReader
+{
+public:
+    static constexpr const phi::size_t BufferSize{32u * 1024u};
+
+    [[nodiscard]] static phi::optional<DirectoryReader> Open(const std::string& path);
+
+    DirectoryReader(const DirectoryReader&) = delete;
+    DirectoryReader(DirectoryReader&& other) noexcept;
+
+    ~DirectoryReader();
+
+    DirectoryReader& operator=(const DirectoryReader&) = delete;
+    DirectoryReader& operator=(DirectoryReader&& other) noexcept;
+
+    // The name of the entry stays valid until the next call
+    [[nodiscard]] phi::optional<DirectoryEntry> Next();
+
+    // Status of the entry last returned by Next without following symbolic links
+    [[nodiscard]] phi::optional<EntryStatus> GetStatus(const DirectoryEntry& entry) const;
+
+private:
+#if PHI_PLATFORM_IS(LINUX)
+    explicit DirectoryReader(int file_descriptor);
+
+    void Close();
+
+    int                     m_FileDescriptor{-1};
+    std::unique_ptr<char[]> m_Buffer;
+    phi::size_t             m_BufferSize{0u};
+    phi::size_t             m_BufferOffset{0u};
+    phi::boolean            m_End{false};
+#else
+    explicit DirectoryReader(std::filesystem::directory_iterator iterator);
+
+    std::filesystem::directory_iterator m_Iterator;
+    std::filesystem::directory_entry    m_Entry;
+    std::string                         m_Name;
+#endif
+};
+
+// The search of FileFindFirstFile. Only the last component of the pattern may contain wildcards.
+class FileSearch
+{
+public:
+    struct Result
+    {
+        std::string_view name;
+        phi::boolean     is_directory;
+    };
+
+    // Fails if the directory can't be read or nothing matches the pattern
+    [[nodiscard]] static phi::optional<FileSearch> Open(std::string_view pattern);
+
+    // The name stays valid until the next call
+    [[nodiscard]] phi::optional<Result> Next();
+
+private:
+    FileSearch(DirectoryReader reader, Wildcard wildcard);
+
+    [[nodiscard]] phi::optional<Result> FindNext();
+
+    DirectoryReader m_Reader;
+    Wildcard        m_Wildcard;
+
+    // Open already finds the first match to know whether there is one
+    phi::boolean m_HasFirst{false};
+    std::string  m_FirstName;
+    phi::boolean m_FirstIsDirectory{false};
+};
+
+// https://www.autoitscript.com/autoit3/docs/functions/DirGetSize.htm
+struct DirectorySize
+{
+    phi::uint64_t size{0u};
+    phi::uint64_t files{0u};
+    phi::uint64_t directories{0u};
+};
+
+// Sums up the sizes of all files in the directory without following symbolic links. With a pool
+// every subdirectory becomes a task so idle workers steal whole subtrees from each other while the
+// calling thread helps until all of them are done. Fails if the directory can't be read.
+[[nodiscard]] phi::optional<DirectorySize> GetDirectorySize(const std::string&            path,
+                                                           phi::boolean                  recursive,
+                                                           phi::observer_ptr<ThreadPool> pool);
+} // namespace OpenAutoIt
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "OpenAutoIt/AST/ASTDocument.hpp"
+#include "OpenAutoIt/Interpreter.hpp"
+#include "OpenAutoIt/ThreadPool.hpp"
+#include "OpenAutoIt/VirtualMachine.hpp"
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/scope_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// Runs many instances of one parsed document at the same time on a thread pool
+// NOTE: The document is shared read-only between all instances. Every instance has its own
+//       Interpreter and VirtualMachine and therefore its own variables and output handlers.
+class Engine
+{
+public:
+    explicit Engine(phi::not_null_observer_ptr<const ASTDocument> document,
+                    phi::usize number_of_threads = std::thread::hardware_concurrency());
+
+    // Start a new instance of the document
+    // The returned interpreter must not be accessed before Wait returned
+    phi::not_null_observer_ptr<const Interpreter> Spawn(OutputHandler standard,
+                                                        OutputHandler error);
+
+    // Blocks until all instances finished running
+    void Wait();
+
+    // Number of statements an instance runs before other instances get a turn
+    static constexpr const phi::uint64_t StepsPerSlice{4'096u};
+
+private:
+    void RunSlice(phi::not_null_observer_ptr<Interpreter> interpreter);
+
+    phi::not_null_observer_ptr<const ASTDocument>     m_Document;
+    std::mutex                                        m_InstancesMutex;
+    std::vector<phi::not_null_scope_ptr<Interpreter>> m_Instances;
+
+    // NOTE: Declared last so all workers are joined before the instances are destroyed
+    ThreadPool m_ThreadPool;
+};
+} // namespace OpenAutoIt
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// https://www.autoitscript.com/autoit3/docs/functions/FileSetPos.htm
+enum class FileOrigin
+{
+    Begin,
+    Current,
+    End,
+};
+
+// A file opened for reading. Regular files are memory mapped so reading only returns views into the
+// mapping and the kernel pages the file in and out as needed. Everything else like pipes is read
+// through a buffer which only grows to the size of the longest line read.
+// Text files skip a leading UTF-8 byte order mark and count characters instead of bytes.
+// NOTE: Views returned by the read functions stay valid until the next read.
+class File
+{
+public:
+    static constexpr const phi::size_t ReadBufferSize{64u * 1024u};
+
+    // The line index records the start of every LineCheckpointInterval-th line
+    static constexpr const phi::size_t LineCheckpointInterval{64u};
+
+    [[nodiscard]] static phi::optional<File> Open(const std::string& path, phi::boolean binary);
+
+    File(const File&) = delete;
+    File(File&& other) noexcept;
+
+    ~File();
+
+    File& operator=(const File&) = delete;
+    File& operator=(File&& other) noexcept;
+
+    [[nodiscard]] phi::boolean IsBinary() const;
+
+    // Returns up to count characters, or bytes for binary files, starting at the position. Without
+    // a count the rest of the file is returned. Returns nothing at the end of the file.
+    [[nodiscard]] phi::optional<std::string_view> Read(phi::optional<phi::size_t> count);
+
+    // Returns the line starting at the position without its line break
+    [[nodiscard]] phi::optional<std::string_view> ReadLine();
+
+    // Returns the line with the given 1 based number and moves the position behind it. Mapped files
+    // look the line up in the line index which is extended as far as needed. Other files are read
+    // again from the start which only works if they can seek.
+    [[nodiscard]] phi::optional<std::string_view> ReadLine(phi::size_t line);
+
+    [[nodiscard]] phi::optional<std::string_view> ReadLastLine();
+
+    phi::boolean SetPosition(phi::int64_t offset, FileOrigin origin);
+
+    [[nodiscard]] phi::uint64_t GetPosition() const;
+
+private:
+    File(int file_descriptor, phi::boolean binary);
+
+    void Close();
+
+    // The bytes from the position on which are in memory
+    [[nodiscard]] std::string_view GetAvailable() const;
+
+    // False at the end of the file and for mapped files which are in memory entirely
+    [[nodiscard]] phi::boolean CanFillBuffer() const;
+
+    // Reads more bytes into the buffer and returns whether any were read. Views of the available
+    // bytes have to be fetched again afterwards even if nothing was read.
+    phi::boolean FillBuffer();
+
+    void Consume(phi::size_t size);
+
+    // Advances the line index until it knows the start of the line or reached the end of the file
+    void ExtendLineIndex(phi::size_t line);
+
+    [[nodiscard]] phi::optional<phi::size_t> FindLineStart(phi::size_t line);
+
+    int           m_FileDescriptor{-1};
+    phi::boolean  m_Binary{false};
+    phi::boolean  m_Seekable{false};
+    phi::uint64_t m_ContentStart{0u}; // Behind the byte order mark
+    phi::uint64_t m_Position{0u};
+
+    // Mapped files
+    const char*  m_Data{nullptr};
+    phi::size_t  m_Size{0u};
+    phi::boolean m_Mapped{false};
+
+    // Other files
+    std::string  m_Buffer;
+    phi::size_t  m_BufferOffset{0u}; // Start of the position in the buffer
+    phi::boolean m_EndOfFile{false};
+
+    // Line index of mapped files
+    std::vector<phi::size_t> m_LineCheckpoints;
+    phi::size_t              m_IndexedLine{0u};  // Highest line with a known start
+    phi::size_t              m_IndexedStart{0u}; // Start of that line
+};
+} // namespace OpenAutoIt
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "OpenAutoIt/Variant.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+
+namespace OpenAutoIt
+{
+// State of an active For...To...Step or For...In loop
+// NOTE: The counter is kept unboxed here and only ever written back into the variable slot,
+//       so each iteration avoids going through the generic expression evaluation.
+struct ForLoopState
+{
+    phi::boolean active{false};
+    phi::boolean is_integer{true};
+
+    // Slot of the loop variable, stable since it lives inside a node based map
+    Variant* variable{nullptr};
+
+    phi::int64_t int_counter{0};
+    phi::int64_t int_end{0};
+    phi::int64_t int_step{1};
+
+    double double_counter{0.0};
+    double double_end{0.0};
+    double double_step{1.0};
+
+    // For...In iterates over a copy of the collection which only shares its payload, so changing
+    // the collection inside of the loop doesn't affect the iteration
+    Variant     collection;
+    phi::size_t position{0u};
+};
+} // namespace OpenAutoIt
@@ -1,15 +1,25 @@
 #pragma once
 
+#include "OpenAutoIt/AST/ASTArrayLiteral.hpp"
+#include "OpenAutoIt/AST/ASTBinaryExpression.hpp"
 #include "OpenAutoIt/AST/ASTBooleanLiteral.hpp"
 #include "OpenAutoIt/AST/ASTExpression.hpp"
 #include "OpenAutoIt/AST/ASTExpressionStatement.hpp"
+#include "OpenAutoIt/AST/ASTForInStatement.hpp"
+#include "OpenAutoIt/AST/ASTForStatement.hpp"
+#include "OpenAutoIt/AST/ASTFunctionCallExpression.hpp"
 #include "OpenAutoIt/AST/ASTIfStatement.hpp"
 #include "OpenAutoIt/AST/ASTIntegerLiteral.hpp"
 #include "OpenAutoIt/AST/ASTMacroExpression.hpp"
 #include "OpenAutoIt/AST/ASTNode.hpp"
+#include "OpenAutoIt/AST/ASTReDimStatement.hpp"
 #include "OpenAutoIt/AST/ASTStringLiteral.hpp"
 #include "OpenAutoIt/AST/ASTVariableAssignment.hpp"
 #include "OpenAutoIt/AST/ASTVariableExpression.hpp"
+#include "OpenAutoIt/Array.hpp"
+#include "OpenAutoIt/CompiledExpression.hpp"
+#include "OpenAutoIt/Regex.hpp"
+#include "OpenAutoIt/StringFormat.hpp"
 #include "OpenAutoIt/TokenKind.hpp"
 #include "OpenAutoIt/Variant.hpp"
 #include "OpenAutoIt/VirtualMachine.hpp"
@@ -18,12 +28,15 @@
 #include <phi/core/assert.hpp>
 #include <phi/core/move.hpp>
 #include <phi/core/observer_ptr.hpp>
+#include <phi/core/optional.hpp>
 #include <phi/core/scope_ptr.hpp>
+#include <phi/core/sized_types.hpp>
 #include <phi/core/types.hpp>
+#include <chrono>
 #include <iostream>
 #include <string>
-
-// TODO: Lots of const correctness issues here
+#include <unordered_map>
+#include <vector>
 
 namespace OpenAutoIt
 {
@@ -33,13 +46,32 @@ class Interpreter
 public:
     Interpreter() = default;
 
-    void SetDocument(phi::not_null_observer_ptr<ASTDocument> new_document);
+    // NOTE: The document is never modified by the interpreter so a single document can be shared by
+    //       any number of interpreters
+    void SetDocument(phi::not_null_observer_ptr<const ASTDocument> new_document);
 
     void Run();
 
+    enum class RunResult
+    {
+        Yielded,  // The budget was used up. Calling RunFor or RunUntil again resumes the script
+        Finished, // The script ran to completion or exited
+        Errored,  // The script was aborted because of a runtime error
+    };
+
+    // Run at most max_steps statements
+    RunResult RunFor(phi::u64 max_steps);
+
+    // Run until the deadline has passed
+    // NOTE: The clock is only checked every DeadlineCheckInterval steps so the deadline can be
+    //       overshot by that many steps
+    RunResult RunUntil(std::chrono::steady_clock::time_point deadline);
+
+    static constexpr const phi::uint64_t DeadlineCheckInterval{256u};
+
     void Step();
 
-    [[nodiscard]] phi::not_null_observer_ptr<ASTStatement> GetCurrentStatement() const;
+    [[nodiscard]] phi::not_null_observer_ptr<const ASTStatement> GetCurrentStatement() const;
 
     [[nodiscard]] VirtualMachine& vm();
 
@@ -51,16 +83,88 @@ public:
         No  = false,
     };
 
-    StatementFinished InterpretStatement(phi::not_null_observer_ptr<ASTStatement> statement);
+    StatementFinished InterpretStatement(phi::not_null_observer_ptr<const ASTStatement> statement);
+
+    // Handles '+=', '-=', '*=', '/=' and '&=' which modify the variable in place
+    StatementFinished InterpretCompoundAssignment(
+            phi::string_view variable_name, TokenKind op,
+            phi::not_null_observer_ptr<const ASTExpression> expression);
+
+    // Appends the operands of a concatenation chain like '$s & x & y' to the variable one after
+    // another. Only used for assignments where this gives the same result as concatenating.
+    StatementFinished InterpretAppendChain(
+            phi::string_view                                      variable_name,
+            phi::not_null_observer_ptr<const ASTBinaryExpression> chain);
+
+    // Handles array declarations like 'Local $a[3]' and element assignments like '$a[1] = 2'
+    StatementFinished InterpretArrayAssignment(
+            phi::not_null_observer_ptr<const ASTVariableAssignment> assignment);
 
-    Variant InterpretExpression(phi::not_null_observer_ptr<ASTExpression> expression);
+    StatementFinished InterpretMapAssignment(
+            phi::not_null_observer_ptr<const ASTVariableAssignment> assignment,
+            const Variant&                                          value);
+
+    StatementFinished InterpretReDimStatement(
+            phi::not_null_observer_ptr<const ASTReDimStatement> statement);
+
+    StatementFinished InterpretForStatement(
+            phi::not_null_observer_ptr<const ASTForStatement> statement);
+
+    StatementFinished InterpretForInStatement(
+            phi::not_null_observer_ptr<const ASTForInStatement> statement);
+
+    Variant InterpretExpression(phi::not_null_observer_ptr<const ASTExpression> expression);
+
+    Variant InterpretArrayLiteral(phi::not_null_observer_ptr<const ASTArrayLiteral> array_literal);
+
+    // Evaluates the single subscript used for maps. Returns an empty optional after reporting a
+    // runtime error
+    phi::optional<Variant> InterpretMapKey(
+            const std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions);
+
+    // Evaluates array subscripts or dimensions. Returns false after reporting a runtime error
+    phi::boolean InterpretSubscripts(
+            const std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions,
+            ArraySubscripts&                                           subscripts);
+
+    // Used for expressions which are evaluated repeatedly like loop conditions and assignments.
+    // Once the function or loop containing such an expression got hot it is compiled and from then
+    // on executed as a CompiledExpression, falling back to InterpretExpression whenever a type
+    // guard fails. A loop which gets hot while running switches over with its next iteration.
+    Variant InterpretTieredExpression(phi::not_null_observer_ptr<const ASTExpression> expression);
+
+    static constexpr const phi::uint32_t HotCallThreshold{16u};
+    static constexpr const phi::uint32_t HotBackEdgeThreshold{64u};
+    static constexpr const phi::uint32_t MaxDeoptimizations{16u};
+
+    enum class ExpressionTier : phi::uint8_t
+    {
+        Interpreted,
+        Compiled,
+        NotCompilable,
+    };
+
+    [[nodiscard]] ExpressionTier GetExpressionTier(const ASTExpression& expression) const;
 
     std::vector<Variant> InterpretExpressions(
-            std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions);
+            const std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions);
 
     Variant InterpretBuiltInFunctionCall(const TokenKind             function,
                                          const std::vector<Variant>& arguments);
 
+    // MapAppend and MapRemove take the map by reference so they can't use the evaluated arguments
+    Variant InterpretMapModifyingFunctionCall(
+            phi::not_null_observer_ptr<const ASTFunctionCallExpression> function_call);
+
+    // StringRegExp and StringRegExpReplace look up their compiled pattern before calling the
+    // builtin so literal patterns only need to be looked up once per call site
+    Variant InterpretRegexFunctionCall(
+            phi::not_null_observer_ptr<const ASTFunctionCallExpression> function_call);
+
+    // Same for the format control string of StringFormat
+    Variant InterpretStringFormatFunctionCall(
+            phi::not_null_observer_ptr<const ASTFunctionCallExpression> function_call);
+
     Variant InterpretFunctionCall(const phi::string_view      function,
                                   const std::vector<Variant>& arguments);
 
@@ -70,14 +174,45 @@ public:
 
     Variant EvaluateBinaryExpression(const Variant& lhs, const Variant& rhs, const TokenKind op);
 
-    Variant EvaluateBinaryPlusExpression(const Variant& lhs, const Variant& rhs);
-    Variant EvaluateBinaryMinusExpression(const Variant& lhs, const Variant& rhs);
-    Variant EvaluateBinaryMultiplyExpression(const Variant& lhs, const Variant& rhs);
-    Variant EvaluateBinaryDivideExpression(const Variant& lhs, const Variant& rhs);
-
 private:
-    phi::observer_ptr<ASTDocument> m_Document;
-    VirtualMachine                 m_VirtualMachine;
-    Statements                     m_VirtualBlock;
+    [[nodiscard]] RunResult GetRunResult() const;
+
+    void InterpretArrayLiteralElements(const ASTArrayLiteral& array_literal, Array& array,
+                                       ArraySubscripts& subscripts, phi::size_t depth);
+
+    // Counts the calls of a function or the back edges of a loop, see ASTNode::NoRegionIndex
+    void CountCall(phi::size_t region);
+    void CountBackEdge(phi::size_t region);
+
+    // A region is hot if it or any region containing it is hot
+    [[nodiscard]] phi::boolean IsRegionHot(phi::size_t region) const;
+
+    struct RegionProfile
+    {
+        phi::uint32_t call_count{0u};
+        phi::uint32_t back_edge_count{0u};
+        phi::boolean  hot{false};
+    };
+
+    struct ExpressionProfile
+    {
+        ExpressionTier                    tier{ExpressionTier::Interpreted};
+        phi::uint32_t                     deoptimization_count{0u};
+        phi::optional<CompiledExpression> compiled;
+    };
+
+    phi::observer_ptr<const ASTDocument> m_Document;
+    VirtualMachine                       m_VirtualMachine;
+    Statements                           m_VirtualBlock;
+
+    // Indexed by ASTExpression::m_OperatorIndex and the region index of functions and loops
+    // NOTE: Kept here instead of in the AST so the document stays read-only
+    std::vector<ExpressionProfile> m_ExpressionProfiles;
+    std::vector<RegionProfile>     m_RegionProfiles;
+
+    // Compiled literal patterns by call site. They are pinned in the caches of the virtual machine
+    // so they stay valid as long as it does.
+    std::unordered_map<const ASTFunctionCallExpression*, const Regex*>        m_RegexCallSites;
+    std::unordered_map<const ASTFunctionCallExpression*, const FormatString*> m_FormatCallSites;
 };
 } // namespace OpenAutoIt
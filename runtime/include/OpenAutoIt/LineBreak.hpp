@@ -0,0 +1,39 @@
+#pragma once
+
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+class ThreadPool;
+class Variant;
+
+// AutoIt ends lines with either CRLF, LF or CR when reading files
+
+// Strings smaller than this are split into lines by the calling thread
+constexpr const phi::size_t ParallelSplitThreshold{1024u * 1024u};
+
+// Returns the offset of the first CR or LF or the size of the string
+[[nodiscard]] phi::size_t FindLineBreak(std::string_view string);
+
+// Returns the size of the line break at the offset which has to point at a CR or LF. A CR at the
+// end of the string counts as a single byte even if the next byte might be a LF.
+[[nodiscard]] constexpr phi::size_t GetLineBreakSize(const std::string_view string,
+                                                     const phi::size_t      offset)
+{
+    return string[offset] == '\r' && offset + 1u < string.size() && string[offset + 1u] == '\n' ?
+                   2u :
+                   1u;
+}
+
+// Number of lines FileReadToArray splits the string into. A line break at the very end doesn't
+// start another line.
+[[nodiscard]] phi::size_t CountLines(std::string_view string);
+
+// Splits the string into its lines the same way CountLines counts them. With a pool the string is
+// cut into one chunk per thread and the chunks are counted and then split in parallel.
+[[nodiscard]] std::vector<Variant> SplitLines(std::string_view              string,
+                                              phi::observer_ptr<ThreadPool> pool);
+} // namespace OpenAutoIt
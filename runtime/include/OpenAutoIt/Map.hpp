@@ -0,0 +1,66 @@
+#pragma once
+
+#include "OpenAutoIt/Variant.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// https://www.autoitscript.com/autoit3/docs/intro/lang_variables.htm#ArrayMaps
+// Keys are either strings which are case sensitive or Int64. The string "1" and the integer 1 are
+// different keys.
+class Map
+{
+public:
+    struct Entry
+    {
+        Variant       key;
+        Variant       value;
+        phi::uint64_t hash{0u}; // Cached so growing the table never hashes a string again
+        phi::boolean  removed{false};
+    };
+
+    [[nodiscard]] static phi::boolean IsValidKey(const Variant& key);
+
+    // Number of elements in the map
+    [[nodiscard]] phi::size_t GetSize() const;
+
+    [[nodiscard]] phi::observer_ptr<const Variant> Find(const Variant& key) const;
+
+    [[nodiscard]] phi::boolean Contains(const Variant& key) const;
+
+    // Returns the value for the key inserting an empty string if it doesn't exist yet
+    [[nodiscard]] Variant& FindOrInsert(const Variant& key);
+
+    // Returns false if the key didn't exist
+    phi::boolean Remove(const Variant& key);
+
+    // Adds the value with an Int64 key one larger than the largest Int64 key used so far and
+    // returns that key
+    phi::int64_t Append(Variant value);
+
+    // All entries in insertion order. Removed entries stay part of this with removed set to true
+    // until enough of them accumulate for the entries to be compacted.
+    [[nodiscard]] const std::vector<Entry>& GetEntries() const;
+
+private:
+    [[nodiscard]] static phi::uint64_t HashKey(const Variant& key);
+
+    // Returns the slot holding the key or the first free slot where it would be inserted
+    [[nodiscard]] phi::size_t FindSlot(const Variant& key, phi::uint64_t hash) const;
+
+    // Removes the entries marked as removed and resizes the table for the current size
+    void Rebuild();
+
+    // The table only stores indices into m_Entries which keeps the insertion order and makes the
+    // table itself small. Lookups use linear probing.
+    std::vector<Entry>         m_Entries;
+    std::vector<phi::uint32_t> m_Slots;
+    phi::size_t                m_Size{0u};
+    phi::size_t                m_UsedSlots{0u}; // Including the ones of removed entries
+    phi::int64_t               m_NextIntKey{0};
+};
+} // namespace OpenAutoIt
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <array>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// Large enough for every Int64 and Double formatted by the functions below
+static constexpr const phi::size_t NumberBufferSize{32u};
+
+using NumberBuffer = std::array<char, NumberBufferSize>;
+
+// These functions format numbers the same way AutoIt displays them without allocating. The
+// returned view points into the given buffer or to a static string.
+
+[[nodiscard]] std::string_view FormatInt64(phi::int64_t value, NumberBuffer& buffer);
+
+// Doubles are displayed with at most 15 significant digits and without trailing zeros. The
+// exponent notation is used when the exponent is less than -4 or at least 15, like '%.15g' with a
+// three digit exponent. So 0.5 is displayed as "0.5", 2.0 as "2" and 2^64 as
+// "1.84467440737096e+019".
+[[nodiscard]] std::string_view FormatDouble(double value, NumberBuffer& buffer);
+} // namespace OpenAutoIt
@@ -0,0 +1,14 @@
+#pragma once
+
+#include "OpenAutoIt/Arithmetic.hpp"
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// Converts a string to a number the same way AutoIt does
+// NOTE: Only the longest prefix forming a number is used, so "3.14Hey" results in 3.14 and a string
+//       not starting with a number results in 0. Leading whitespace, a sign, hexadecimal numbers
+//       starting with "0x", fractions and exponents are supported. Integers are returned as Int64
+//       unless they don't fit, everything else is returned as a double.
+[[nodiscard]] Number ParseNumber(std::string_view string);
+} // namespace OpenAutoIt
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// NOTE: Handlers are per VirtualMachine and may carry their own state, so multiple virtual machines
+//       can run at the same time while writing to different sinks
+using OutputHandler = std::function<void(std::string_view)>;
+
+// Decides when buffered output is written to its file descriptor. Besides these conditions the
+// output is written when it's flushed explicitly and when the stream is destroyed.
+struct FlushPolicy
+{
+    static constexpr const phi::size_t DefaultThreshold{64u * 1024u};
+
+    phi::size_t  threshold{DefaultThreshold}; // Written once more bytes would be buffered
+    phi::boolean line_buffered{false};        // Written after every message with a newline
+
+    // Line buffered for terminals so output shows up right away, fully buffered otherwise
+    [[nodiscard]] static FlushPolicy ForFileDescriptor(int file_descriptor);
+
+    // Every message is written right away
+    [[nodiscard]] static FlushPolicy Unbuffered();
+};
+
+// One output stream of a virtual machine like stdout or stderr. Messages either go straight to an
+// OutputHandler, which sees every message separately, or are collected and written to a file
+// descriptor in batches. Without either the output is discarded.
+// NOTE: Writing to a file descriptor uses writev so a message which doesn't fit into the buffer
+//       anymore is written together with the buffered output without copying it first.
+class OutputStream
+{
+public:
+    OutputStream() = default;
+
+    OutputStream(const OutputStream&) = delete;
+    OutputStream(OutputStream&&)      = delete;
+
+    ~OutputStream();
+
+    OutputStream& operator=(const OutputStream&) = delete;
+    OutputStream& operator=(OutputStream&&)      = delete;
+
+    void SetHandler(OutputHandler handler);
+
+    void SetFileDescriptor(int file_descriptor, FlushPolicy policy);
+
+    void Write(std::string_view message);
+
+    void Flush();
+
+private:
+    void WriteToFileDescriptor(std::string_view buffered, std::string_view message) const;
+
+    OutputHandler m_Handler;
+    int           m_FileDescriptor{-1};
+    FlushPolicy   m_Policy;
+    std::string   m_Buffer;
+};
+} // namespace OpenAutoIt
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace OpenAutoIt
+{
+// Compiled patterns by their source so scripts calling functions like StringRegExp or
+// StringFormat in a loop only compile each pattern once. Patterns which failed to compile are
+// remembered as well. CompiledT needs a static Compile(std::string_view) returning a
+// phi::optional<CompiledT>.
+template <typename CompiledT>
+class PatternCache
+{
+public:
+    static constexpr const phi::size_t DefaultCapacity{64u};
+
+    explicit PatternCache(const phi::size_t capacity = DefaultCapacity)
+        : m_Capacity{capacity}
+    {}
+
+    // Returns nullptr for an invalid pattern. The least recently used pattern is evicted once the
+    // capacity is exceeded so the result is only valid until the next call.
+    [[nodiscard]] const CompiledT* Get(const std::string_view pattern)
+    {
+        if (const auto pinned = m_PinnedLookup.find(pattern); pinned != m_PinnedLookup.end())
+        {
+            return GetCompiled(*pinned->second);
+        }
+
+        if (const auto existing = m_Lookup.find(pattern); existing != m_Lookup.end())
+        {
+            m_Entries.splice(m_Entries.begin(), m_Entries, existing->second);
+            return GetCompiled(m_Entries.front());
+        }
+
+        if (m_Entries.size() >= m_Capacity && !m_Entries.empty())
+        {
+            m_Lookup.erase(m_Entries.back().pattern);
+            m_Entries.pop_back();
+        }
+
+        m_Entries.push_front({std::string{pattern}, CompiledT::Compile(pattern)});
+        m_Lookup.emplace(m_Entries.front().pattern, m_Entries.begin());
+        return GetCompiled(m_Entries.front());
+    }
+
+    // Same as Get but the pattern is never evicted. Used for the literal patterns of call sites
+    // which can then keep the result around.
+    [[nodiscard]] const CompiledT* GetPinned(const std::string_view pattern)
+    {
+        if (const auto pinned = m_PinnedLookup.find(pattern); pinned != m_PinnedLookup.end())
+        {
+            return GetCompiled(*pinned->second);
+        }
+
+        // Move an already compiled pattern over instead of compiling it again
+        if (const auto existing = m_Lookup.find(pattern); existing != m_Lookup.end())
+        {
+            const typename Entries::iterator entry = existing->second;
+            m_Lookup.erase(existing);
+            m_PinnedEntries.splice(m_PinnedEntries.begin(), m_Entries, entry);
+        }
+        else
+        {
+            m_PinnedEntries.push_front({std::string{pattern}, CompiledT::Compile(pattern)});
+        }
+
+        m_PinnedLookup.emplace(m_PinnedEntries.front().pattern, m_PinnedEntries.begin());
+        return GetCompiled(m_PinnedEntries.front());
+    }
+
+private:
+    struct Entry
+    {
+        std::string              pattern;
+        phi::optional<CompiledT> compiled;
+    };
+
+    using Entries = std::list<Entry>;
+
+    [[nodiscard]] static const CompiledT* GetCompiled(const Entry& entry)
+    {
+        return entry.compiled ? &*entry.compiled : nullptr;
+    }
+
+    Entries                                                          m_Entries; // Most recent first
+    std::unordered_map<std::string_view, typename Entries::iterator> m_Lookup;
+    Entries                                                          m_PinnedEntries;
+    std::unordered_map<std::string_view, typename Entries::iterator> m_PinnedLookup;
+    phi::size_t                                                      m_Capacity;
+};
+} // namespace OpenAutoIt
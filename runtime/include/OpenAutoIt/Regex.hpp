@@ -0,0 +1,65 @@
+#pragma once
+
+#include "OpenAutoIt/PatternCache.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <limits>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// A compiled PCRE flavoured regular expression as used by StringRegExp and StringRegExpReplace.
+// Supported are character classes, anchors, word boundaries, greedy, lazy and possessive
+// quantifiers, capturing, non capturing and named groups, backreferences, atomic groups,
+// lookahead, fixed width lookbehind and the inline options i, m, s and x.
+// NOTE: Patterns without backreferences, lookarounds or atomic groups are first run through a
+//       lazily built DFA which caches its states and transitions across calls. It decides whether
+//       there is a match at all in linear time so the backtracker only runs to find the bounds
+//       and groups of actual matches. The backtracker itself remembers which states already
+//       failed at which position for these patterns so it stays linear as well. A group inside
+//       of a loop which can match nothing, like (a*)*, keeps the last iteration which matched
+//       something instead of PCRE's final empty iteration.
+class Regex
+{
+public:
+    static constexpr const phi::size_t NoMatch{std::numeric_limits<phi::size_t>::max()};
+
+    // Byte offsets of the whole match followed by those of each group. Groups which didn't
+    // participate in the match are set to NoMatch.
+    using Captures = std::vector<phi::size_t>;
+
+    Regex(Regex&& other) noexcept;
+    Regex& operator=(Regex&& other) noexcept;
+    ~Regex();
+
+    Regex(const Regex&)            = delete;
+    Regex& operator=(const Regex&) = delete;
+
+    // Returns an empty optional if the pattern is invalid
+    [[nodiscard]] static phi::optional<Regex> Compile(std::string_view pattern);
+
+    // Number of capturing groups not counting the whole match
+    [[nodiscard]] phi::size_t GetGroupCount() const;
+
+    [[nodiscard]] phi::boolean IsMatch(std::string_view subject, phi::size_t offset = 0u) const;
+
+    // Finds the leftmost match starting at or after the byte offset. On success captures holds
+    // 2 * (GetGroupCount() + 1) offsets.
+    [[nodiscard]] phi::boolean Search(std::string_view subject, phi::size_t offset,
+                                      Captures& captures) const;
+
+private:
+    struct Program;
+
+    explicit Regex(std::unique_ptr<Program> program);
+
+    std::unique_ptr<Program> m_Program;
+};
+
+// Compiled regular expressions by their pattern, see PatternCache
+using RegexCache = PatternCache<Regex>;
+} // namespace OpenAutoIt
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#    define OPENAUTOIT_HAS_SSE2
+#    include <emmintrin.h>
+#endif
+
+// Helpers shared by the byte processing kernels of the string functions. Every kernel has a scalar
+// version so the SSE2 code paths are purely an optimization.
+namespace OpenAutoIt
+{
+[[nodiscard]] constexpr char FoldASCII(const char character)
+{
+    return character >= 'A' && character <= 'Z' ? static_cast<char>(character | 0x20) : character;
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsSpace.htm
+[[nodiscard]] constexpr phi::boolean IsWhitespace(const char character)
+{
+    return (character >= '\t' && character <= '\r') || character == ' ';
+}
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+[[nodiscard]] inline __m128i LoadUnaligned(const char* bytes)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));
+}
+
+inline void StoreUnaligned(char* destination, const __m128i bytes)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), bytes);
+}
+
+// Returns a mask of the bytes in [first, last] using a single signed comparison. Adding the bias
+// moves first to -128 so every byte in the range ends up below -128 + the size of the range.
+[[nodiscard]] inline __m128i MaskByteRange(const __m128i bytes, const char first, const char last)
+{
+    const __m128i bias  = _mm_set1_epi8(static_cast<char>(-128 - first));
+    const __m128i limit = _mm_set1_epi8(static_cast<char>(-128 + (last - first) + 1));
+
+    return _mm_cmplt_epi8(_mm_add_epi8(bytes, bias), limit);
+}
+
+// Lower cases the ASCII letters of 16 bytes at once
+[[nodiscard]] inline __m128i FoldASCII(const __m128i bytes)
+{
+    const __m128i is_upper = MaskByteRange(bytes, 'A', 'Z');
+    return _mm_or_si128(bytes, _mm_and_si128(is_upper, _mm_set1_epi8(0x20)));
+}
+
+// Converts a byte mask into one bit per byte
+[[nodiscard]] inline unsigned int ToBits(const __m128i mask)
+{
+    return static_cast<unsigned int>(_mm_movemask_epi8(mask));
+}
+
+// One bit per byte which is set if the byte is equal to the given character
+[[nodiscard]] inline unsigned int MatchByte(const __m128i bytes, const char character)
+{
+    return ToBits(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(character)));
+}
+
+// One bit per byte which is set for the bytes matching IsWhitespace
+[[nodiscard]] inline unsigned int MatchWhitespace(const __m128i bytes)
+{
+    return ToBits(MaskByteRange(bytes, '\t', '\r')) | MatchByte(bytes, ' ');
+}
+
+// One bit per byte which is set for bytes outside of ASCII
+[[nodiscard]] inline unsigned int MatchNonASCII(const __m128i bytes)
+{
+    return ToBits(bytes);
+}
+#endif
+} // namespace OpenAutoIt
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <OpenAutoIt/AST/ASTStatement.hpp>
+#include <OpenAutoIt/ForLoopState.hpp>
 #include <OpenAutoIt/Statements.hpp>
 #include <OpenAutoIt/Variant.hpp>
 #include <phi/core/observer_ptr.hpp>
@@ -20,7 +21,7 @@ enum class ScopeKind : phi::uint8_t
 class Scope
 {
 public:
-    Scope(ScopeKind scope_kind, std::string_view scope_name, Statements& scope_statements)
+    Scope(ScopeKind scope_kind, std::string_view scope_name, const Statements& scope_statements)
         : kind{scope_kind}
         , name{scope_name}
         , statements{scope_statements}
@@ -29,7 +30,8 @@ public:
     ScopeKind                                     kind;
     std::string_view                              name;
     std::unordered_map<std::string_view, Variant> variables;
-    Statements&                                   statements;
+    const Statements&                             statements;
     phi::usize                                    index{0u};
+    ForLoopState                                  for_loop; // For loop at the current index
 };
 } // namespace OpenAutoIt
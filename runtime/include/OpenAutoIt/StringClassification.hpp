@@ -0,0 +1,27 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// The character classes tested by the StringIs* functions
+enum class CharacterClass : phi::uint8_t
+{
+    Alpha,
+    AlphaNumeric,
+    ASCII,
+    Digit,
+    HexDigit,
+    Lower,
+    Space,
+    Upper,
+};
+
+// Returns whether the string is not empty and every character belongs to the character class
+// NOTE: ASCII is checked 16 bytes at a time. Only Alpha, AlphaNumeric, Lower and Upper have to
+//       decode non ASCII characters. Lower and Upper use the case mappings to decide the case.
+[[nodiscard]] phi::boolean StringIsCharacterClass(std::string_view string,
+                                                  CharacterClass   character_class);
+} // namespace OpenAutoIt
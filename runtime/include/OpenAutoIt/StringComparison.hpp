@@ -0,0 +1,16 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// Case insensitive equality as used by the '=' and '<>' operators
+// NOTE: Strings are compared 16 bytes at a time while folding ASCII letters. Only a difference in
+//       non ASCII characters falls back to decoding and case folding each code point.
+[[nodiscard]] phi::boolean StringEqualsIgnoreCase(std::string_view lhs, std::string_view rhs);
+
+// Case insensitive ordering as used by the '<', '<=', '>' and '>=' operators. Returns a negative
+// value if lhs is ordered before rhs, zero if both are equal and a positive value otherwise.
+[[nodiscard]] int StringCompareIgnoreCase(std::string_view lhs, std::string_view rhs);
+} // namespace OpenAutoIt
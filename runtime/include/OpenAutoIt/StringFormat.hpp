@@ -0,0 +1,80 @@
+#pragma once
+
+#include "OpenAutoIt/PatternCache.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+class Variant;
+
+// The format control string of StringFormat split into literal text and printf style conversion
+// specifications like "%-8.3f". Supported are the flags '-', '+', ' ', '0' and '#', a width, a
+// precision and the types d, i, o, u, x, X, e, E, f, g, G and s. Length modifiers like "l" or
+// "I64" are accepted but ignored, "%%" is a literal percent sign and invalid specifications are
+// kept as literal text.
+// NOTE: Each specification is translated once into the matching fmt presentation so formatting
+//       only walks the compiled list and writes every argument straight into the output buffer.
+class FormatString
+{
+public:
+    // Never fails. The result is only optional so format strings can be kept in a PatternCache.
+    [[nodiscard]] static phi::optional<FormatString> Compile(std::string_view format);
+
+    // Number of arguments consumed by the conversion specifications
+    [[nodiscard]] phi::size_t GetArgumentCount() const;
+
+    // Replaces the contents of the buffer with the formatted arguments. Missing arguments are
+    // formatted like an empty string.
+    void Format(const Variant* arguments, phi::size_t argument_count, std::string& buffer) const;
+
+private:
+    enum class Conversion : phi::uint8_t
+    {
+        SignedDecimal,       // d and i
+        UnsignedDecimal,     // u
+        Octal,               // o
+        HexLowerCase,        // x
+        HexUpperCase,        // X
+        ExponentLowerCase,   // e
+        ExponentUpperCase,   // E
+        Fixed,               // f
+        GeneralLowerCase,    // g
+        GeneralUpperCase,    // G
+        String,              // s
+    };
+
+    struct Specification
+    {
+        phi::size_t   literal_offset; // Literal text in front of the conversion
+        phi::size_t   literal_size;
+        Conversion    conversion;
+        phi::boolean  left_align{false};
+        phi::boolean  plus_sign{false};
+        phi::boolean  space_sign{false};
+        phi::boolean  zero_pad{false};
+        phi::boolean  alternate_form{false};
+        phi::uint32_t width{0u};
+        phi::int32_t  precision{-1}; // Negative if none was given
+    };
+
+    static void AppendInteger(const Specification& specification, const Variant& argument,
+                              std::string& buffer);
+    static void AppendFloatingPoint(const Specification& specification, const Variant& argument,
+                                    std::string& buffer);
+    static void AppendString(const Specification& specification, const Variant& argument,
+                             std::string& buffer);
+
+    std::string                m_Literals; // All literal text with "%%" already resolved
+    std::vector<Specification> m_Specifications;
+    phi::size_t                m_TrailingLiteralOffset{0u};
+};
+
+// Compiled format strings by their source, see PatternCache
+using FormatStringCache = PatternCache<FormatString>;
+} // namespace OpenAutoIt
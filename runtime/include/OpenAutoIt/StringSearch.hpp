@@ -0,0 +1,64 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// The casesense parameter of StringInStr and StringReplace
+enum class CaseSense : phi::uint8_t
+{
+    IgnoreCase,      // Ignores the case of every character
+    MatchCase,       //
+    IgnoreCaseASCII, // Only ignores the case of ASCII letters which is faster
+};
+
+// Finds the occurrences of a needle inside of a haystack. Everything which only depends on the
+// needle is prepared once so searching the same haystack repeatedly is cheap.
+// NOTE: Short needles are found by comparing their first and last byte against 16 positions at
+//       once and only verifying the candidates. Longer needles use the two-way algorithm which
+//       stays linear even for needles like "aaaaaaab".
+class StringSearcher
+{
+public:
+    struct Match
+    {
+        phi::size_t offset;
+        phi::size_t size; // Ignoring the case of non ASCII characters can change the size
+    };
+
+    StringSearcher(std::string_view haystack, std::string_view needle, CaseSense case_sense);
+
+    // Returns the first match starting at or after from
+    [[nodiscard]] phi::optional<Match> FindNext(phi::size_t from) const;
+
+    // Returns the last match which ends at or before end
+    [[nodiscard]] phi::optional<Match> FindPrevious(phi::size_t end) const;
+
+private:
+    enum class Strategy : phi::uint8_t
+    {
+        Empty,
+        Bytes,
+        FoldedBytes,
+        FoldedCodePoints,
+    };
+
+    [[nodiscard]] phi::size_t MatchCodePointsAt(phi::size_t offset, phi::size_t end) const;
+
+    std::string_view m_Haystack;
+    std::string      m_Needle;           // ASCII letters are lower case for FoldedBytes
+    std::u32string   m_FoldedCodePoints; // Only used for FoldedCodePoints
+    Strategy         m_Strategy;
+
+    // Critical factorization of the needle used by the two-way algorithm
+    phi::boolean m_UseTwoWay{false};
+    phi::boolean m_Periodic{false};
+    phi::size_t  m_CriticalPosition{0u};
+    phi::size_t  m_Period{0u};
+};
+} // namespace OpenAutoIt
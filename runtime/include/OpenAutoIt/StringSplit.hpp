@@ -0,0 +1,60 @@
+#pragma once
+
+#include "OpenAutoIt/StringSearch.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <bitset>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// Splits a string into the fields returned by StringSplit. Either every character of the
+// delimiters separates two fields or only the entire delimiter string does. Without any
+// delimiters every character is a field of its own.
+// NOTE: Counting the fields first allows the caller to allocate the result once. Delimiter
+//       characters are found by comparing their first bytes against 16 bytes of the string at once.
+class StringSplitter
+{
+public:
+    StringSplitter(std::string_view string, std::string_view delimiters,
+                   phi::boolean entire_delimiter);
+
+    [[nodiscard]] phi::size_t CountFields() const;
+
+    // Returns the next field or an empty optional once every field was returned
+    [[nodiscard]] phi::optional<std::string_view> NextField();
+
+private:
+    enum class Strategy : phi::uint8_t
+    {
+        Characters,          // Every character is a field
+        DelimiterCharacters, // Each character of the delimiters separates fields
+        EntireDelimiter,     // Only the whole delimiter string separates fields
+    };
+
+    struct Delimiter
+    {
+        phi::size_t offset;
+        phi::size_t size;
+    };
+
+    // Returns the first delimiter starting at or after from
+    [[nodiscard]] phi::optional<Delimiter> FindDelimiter(phi::size_t from) const;
+
+    // Returns the size of the delimiter character at the offset or zero if there is none
+    [[nodiscard]] phi::size_t MatchDelimiterCharacter(phi::size_t offset) const;
+
+    std::string_view              m_String;
+    std::string_view              m_Delimiters;
+    Strategy                      m_Strategy;
+    phi::boolean                  m_ASCIIDelimiters{true};
+    std::string                   m_FirstBytes; // Distinct first bytes of the delimiter characters
+    std::bitset<256>              m_IsFirstByte;
+    phi::optional<StringSearcher> m_Searcher; // Only used for EntireDelimiter
+    phi::size_t                   m_Position{0u};
+    phi::boolean                  m_Finished{false};
+};
+} // namespace OpenAutoIt
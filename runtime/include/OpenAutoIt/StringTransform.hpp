@@ -0,0 +1,30 @@
+#pragma once
+
+#include <phi/core/types.hpp>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// Flags of StringStripWS
+constexpr const phi::int64_t StripLeadingWhitespace{1};
+constexpr const phi::int64_t StripTrailingWhitespace{2};
+constexpr const phi::int64_t StripDoubleWhitespace{4};
+constexpr const phi::int64_t StripAllWhitespace{8};
+
+// Case conversion using the simple case mappings from "OpenAutoIt/Unicode.hpp"
+// NOTE: The result is allocated with the size of the input and only grows for the few mappings
+//       which need a longer UTF-8 sequence like U+023A to U+2C65. Runs of ASCII are converted 16
+//       bytes at a time.
+[[nodiscard]] std::string StringToUpperCase(std::string_view string);
+[[nodiscard]] std::string StringToLowerCase(std::string_view string);
+
+// Strips the whitespace characters selected by the StringStripWS flags. Runs of whitespace
+// between words are reduced to their first character.
+[[nodiscard]] std::string StringStripWhitespace(std::string_view string, phi::int64_t flags);
+
+// Inserts a carriage return before every line feed
+[[nodiscard]] std::string StringAddCarriageReturns(std::string_view string);
+
+[[nodiscard]] std::string StringStripCarriageReturns(std::string_view string);
+} // namespace OpenAutoIt
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/types.hpp>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// The tasks of a single call which splits up its work. Waiting for a group only waits for its own
+// tasks so calls from different instances can share one pool.
+class TaskGroup
+{
+public:
+    TaskGroup() = default;
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup(TaskGroup&&)      = delete;
+
+    ~TaskGroup() = default;
+
+    TaskGroup& operator=(const TaskGroup&) = delete;
+    TaskGroup& operator=(TaskGroup&&)      = delete;
+
+private:
+    friend class ThreadPool;
+
+    // Guarded by the mutex of the pool
+    phi::usize m_QueuedTasks{0u};
+    phi::usize m_UnfinishedTasks{0u};
+};
+
+// Work-stealing thread pool
+// NOTE: Every worker owns a queue. Tasks submitted from a worker go to the back of its own queue
+//       and workers take tasks from the front of their own queue, so tasks which resubmit
+//       themselves take turns with the other tasks. Idle workers steal from the back of the other
+//       queues.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(phi::usize number_of_threads);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&)      = delete;
+
+    ~ThreadPool();
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&)      = delete;
+
+    void Submit(Task task);
+
+    // The task counts towards the group until it finished
+    void Submit(TaskGroup& group, Task task);
+
+    // Blocks until all submitted tasks, including the ones they submitted themselves, are done.
+    // Only meant for the owner of the pool since it also waits for the tasks of everyone else.
+    void Wait();
+
+    // Runs queued tasks of the group until all of them are done. Since the waiting thread helps
+    // instead of only blocking it's safe to wait from inside a task, even with a single worker.
+    // Completing the group synchronizes with the waiting thread so results can be read right away.
+    void Wait(TaskGroup& group);
+
+    // Process wide pool for virtual machines which weren't given one. Only created on first use.
+    [[nodiscard]] static ThreadPool& GetShared();
+
+    [[nodiscard]] phi::usize GetNumberOfThreads() const;
+
+private:
+    struct QueuedTask
+    {
+        Task       task;
+        TaskGroup* group{nullptr};
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex             mutex;
+        std::deque<QueuedTask> tasks;
+    };
+
+    void Enqueue(QueuedTask task);
+
+    void WorkerLoop(phi::usize worker_index);
+
+    [[nodiscard]] phi::boolean TryPopTask(phi::usize worker_index, QueuedTask& task);
+
+    // Takes the newest queued task of the group from any queue
+    [[nodiscard]] phi::boolean TryPopGroupTask(phi::usize first_queue, const TaskGroup& group,
+                                               QueuedTask& task);
+
+    // Called with the queue of the task still locked so the queued counts are never ahead of the
+    // queues. Otherwise a waiting thread would keep seeing a count for a task it can't find.
+    // NOTE: Queue mutexes are always locked before the pool mutex
+    void Dequeued(const QueuedTask& task);
+
+    void RunTask(QueuedTask& task);
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_Queues;
+    std::vector<std::thread>                  m_Threads;
+
+    std::mutex              m_Mutex;
+    std::condition_variable m_WorkAvailable;
+    std::condition_variable m_AllDone;
+    std::condition_variable m_GroupProgress; // A group task was queued or a group finished
+    phi::usize              m_QueuedTasks{0u};
+    phi::usize              m_UnfinishedTasks{0u};
+    phi::usize              m_NextQueue{0u};
+    phi::boolean            m_Stopping{false};
+};
+} // namespace OpenAutoIt
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// Maps the UTF-16 code unit positions AutoIt indexes strings by to the byte offsets of a UTF-8
+// string. Positions in strings which only contain ASCII map one to one. For other strings the byte
+// offset of every CheckpointInterval-th code unit after the leading ASCII is recorded so a lookup
+// only has to walk a few characters.
+// NOTE: Strings keep their index next to their value so it is only built once, see
+//       Variant::GetUTF16Index. The index doesn't reference the string so every lookup takes the
+//       string it was built from.
+class UTF16Index
+{
+public:
+    static constexpr const phi::size_t CheckpointInterval{64u};
+
+    // Index of the empty string
+    UTF16Index() = default;
+
+    explicit UTF16Index(std::string_view string);
+
+    [[nodiscard]] phi::boolean IsASCII() const;
+
+    // Length in UTF-16 code units so characters outside of the basic multilingual plane count twice
+    [[nodiscard]] phi::size_t GetLength() const;
+
+    // Returns the byte offset of the character at the code unit index or the size of the string if
+    // the index is past its end. An index pointing at the second half of a surrogate pair maps to
+    // the next character.
+    [[nodiscard]] phi::size_t ToOffset(std::string_view string, phi::size_t index) const;
+
+    // Returns the number of code units in front of the byte offset
+    [[nodiscard]] phi::size_t ToIndex(std::string_view string, phi::size_t offset) const;
+
+private:
+    struct Checkpoint
+    {
+        phi::size_t offset; // Start of the character containing the code unit
+        phi::size_t index;  // Code unit index of that character
+    };
+
+    phi::size_t             m_Length{0u};
+    phi::size_t             m_ASCIIPrefix{0u}; // Bytes in front of the first non ASCII byte
+    std::vector<Checkpoint> m_Checkpoints;     // Empty for ASCII strings
+};
+} // namespace OpenAutoIt
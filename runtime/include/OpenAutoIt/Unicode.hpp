@@ -0,0 +1,58 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+// Used in place of invalid UTF-8 or UTF-16 sequences
+constexpr const char32_t ReplacementCharacter{0xFFFD};
+
+// Decodes the UTF-8 sequence starting at index and advances index past it. An invalid sequence
+// decodes to U+FFFD and only advances index by a single byte.
+[[nodiscard]] char32_t DecodeUTF8(std::string_view string, phi::size_t& index);
+
+// Writes the UTF-8 sequence of the code point to output which must have room for 4 bytes. Returns
+// the number of bytes written.
+phi::size_t EncodeUTF8(char32_t code_point, char* output);
+
+void AppendUTF8(std::string& string, char32_t code_point);
+
+[[nodiscard]] constexpr phi::boolean IsUTF8ContinuationByte(const char byte)
+{
+    return (static_cast<unsigned char>(byte) & 0xC0u) == 0x80u;
+}
+
+[[nodiscard]] phi::boolean IsASCII(std::string_view string);
+
+// Returns the offset of the first byte outside of ASCII or the size of the string
+[[nodiscard]] phi::size_t FindFirstNonASCII(std::string_view string);
+
+// Whether every sequence of the string is valid UTF-8 according to DecodeUTF8
+[[nodiscard]] phi::boolean IsValidUTF8(std::string_view string);
+
+// Replaces every invalid sequence with U+FFFD the same way DecodeUTF8 does
+[[nodiscard]] std::string SanitizeUTF8(std::string_view string);
+
+// AutoIt indexes strings by UTF-16 code units. Returns the number of code units the string would
+// take as UTF-16 so characters outside of the basic multilingual plane count twice.
+[[nodiscard]] phi::size_t CountUTF16CodeUnits(std::string_view string);
+
+// Returns the byte offset of the character at the given UTF-16 code unit index or the size of the
+// string if the index is past its end
+[[nodiscard]] phi::size_t FindUTF8Offset(std::string_view string, phi::size_t code_units);
+
+// Simple one to one case mappings of UnicodeData.txt. Code points without a mapping are returned as
+// is.
+[[nodiscard]] char32_t ToLowerCase(char32_t code_point);
+[[nodiscard]] char32_t ToUpperCase(char32_t code_point);
+
+// Whether the code point belongs to one of the general categories Lu, Ll, Lt, Lm or Lo
+[[nodiscard]] phi::boolean IsLetter(char32_t code_point);
+
+// Maps all case variants of a code point to the same code point, so 'K', 'k' and the Kelvin sign
+// all fold to 'k'
+[[nodiscard]] char32_t FoldCase(char32_t code_point);
+} // namespace OpenAutoIt
@@ -1,21 +1,24 @@
 #pragma once
 
+#include "OpenAutoIt/Array.hpp"
+#include "OpenAutoIt/Binary.hpp"
 #include "OpenAutoIt/TokenKind.hpp"
-#include <phi/compiler_support/char8_t.hpp>
 #include <phi/compiler_support/warning.hpp>
 #include <phi/container/string_view.hpp>
 #include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
 #include <phi/core/types.hpp>
 #include <string>
-#include <vector>
 
 namespace OpenAutoIt
 {
 
-class Variant;
+class Map;
+class UTF16Index;
 
-using array_t  = std::vector<Variant>;
-using binary_t = std::basic_string<char8_t>;
+using array_t  = Array;
+using binary_t = Binary;
+using map_t    = Map;
 using ptr_t    = phi::uintptr_t;
 using string_t = std::string;
 
@@ -24,7 +27,7 @@ using string_t = std::string;
 class Variant
 {
 public:
-    enum class Type
+    enum class Type : phi::uint8_t
     {
         Array,
         Binary,
@@ -33,6 +36,7 @@ public:
         Function,
         Int64,
         Keyword,
+        Map,
         Pointer,
         String,
         // TODO: DllStruct?
@@ -62,6 +66,7 @@ public:
     [[nodiscard]] phi::boolean IsFunction() const;
     [[nodiscard]] phi::boolean IsInt64() const;
     [[nodiscard]] phi::boolean IsKeyword() const;
+    [[nodiscard]] phi::boolean IsMap() const;
     [[nodiscard]] phi::boolean IsPointer() const;
     [[nodiscard]] phi::boolean IsString() const;
 
@@ -93,14 +98,23 @@ public:
     [[nodiscard]] TokenKind&       AsKeyword();
     [[nodiscard]] const TokenKind& AsKeyword() const;
 
+    // NOTE: Include "OpenAutoIt/Map.hpp" to use the returned map
+    [[nodiscard]] map_t&       AsMap();
+    [[nodiscard]] const map_t& AsMap() const;
+
     [[nodiscard]] ptr_t&       AsPointer();
     [[nodiscard]] const ptr_t& AsPointer() const;
 
     [[nodiscard]] string_t&       AsString();
     [[nodiscard]] const string_t& AsString() const;
 
+    // Character positions of the string. The index is built on first use and kept until the
+    // string is accessed mutably.
+    // NOTE: Include "OpenAutoIt/UTF16Index.hpp" to use the returned index
+    [[nodiscard]] const UTF16Index& GetUTF16Index() const;
+
     // Casting
-    // NOTE: You cannot cast to Array, Function or Keyword
+    // NOTE: You cannot cast to Array, Function, Keyword or Map
     [[nodiscard]] Variant CastToBinary() const;
     [[nodiscard]] Variant CastToBoolean() const;
     [[nodiscard]] Variant CastToDouble() const;
@@ -115,8 +129,23 @@ public:
     [[nodiscard]] Variant Subtract(const Variant& other) const;
     [[nodiscard]] Variant Multiply(const Variant& other) const;
     [[nodiscard]] Variant Divide(const Variant& other) const;
+    [[nodiscard]] Variant Power(const Variant& other) const;
     [[nodiscard]] Variant Concatenate(const Variant& other) const;
 
+    // Concatenates in place. The string only gets copied if its shared with another Variant
+    void Append(const Variant& other);
+
+    // Comparisons which all return a Boolean
+    // NOTE: Two strings are compared case insensitive. If only one side is a string its converted
+    //       to a number first. EqualCaseSensitive ('==') always compares both sides as strings.
+    [[nodiscard]] Variant Equal(const Variant& other) const;
+    [[nodiscard]] Variant EqualCaseSensitive(const Variant& other) const;
+    [[nodiscard]] Variant NotEqual(const Variant& other) const;
+    [[nodiscard]] Variant LessThan(const Variant& other) const;
+    [[nodiscard]] Variant LessThanEqual(const Variant& other) const;
+    [[nodiscard]] Variant GreaterThan(const Variant& other) const;
+    [[nodiscard]] Variant GreaterThanEqual(const Variant& other) const;
+
     [[nodiscard]] Variant Abs() const;
 
     [[nodiscard]] Variant UnaryMinus() const;
@@ -127,6 +156,12 @@ public:
     // Undefined
     [[nodiscard]] static Variant MakeUndefined();
 
+    // Array
+    [[nodiscard]] static Variant MakeArray(array_t&& value);
+
+    // Binary
+    [[nodiscard]] static Variant MakeBinary(binary_t&& value);
+
     // Boolean
     [[nodiscard]] static Variant MakeBoolean(phi::boolean value);
 
@@ -139,6 +174,9 @@ public:
     // Keyword
     [[nodiscard]] static Variant MakeKeyword(TokenKind value);
 
+    // Map
+    [[nodiscard]] static Variant MakeMap();
+
     // Pointer
     [[nodiscard]] static Variant MakePointer(ptr_t value);
 
@@ -149,6 +187,10 @@ public:
     [[nodiscard]] static Variant MakeString(string_t&& value);
 
 private:
+    // Reference counted heap storage shared between copies of a Variant
+    template <typename T>
+    struct SharedPayload;
+
     void copy_from(const Variant& other);
 
     void move_from(Variant&& other);
@@ -157,16 +199,23 @@ private:
 
     Type m_Type;
 
+    // NOTE: Arrays, binaries, maps and strings are stored on the heap to keep the Variant itself
+    //       small. A nullptr represents an empty value so default constructed Variants never
+    //       allocate.
+    //       Copies share the payload which only gets copied once it's accessed mutably.
     union
     {
-        array_t      array;
-        binary_t     binary;
-        phi::boolean boolean;
-        phi::f64     floating_point;
-        phi::i64     int64;
-        TokenKind    keyword;
-        ptr_t        pointer;
-        string_t     string; // Can also hold a Function
+        SharedPayload<array_t>*  array;
+        SharedPayload<binary_t>* binary;
+        phi::boolean             boolean;
+        phi::f64                 floating_point;
+        phi::i64                 int64;
+        TokenKind                keyword;
+        SharedPayload<map_t>*    map;
+        ptr_t                    pointer;
+        SharedPayload<string_t>* string; // Can also hold a Function
     };
 };
+
+static_assert(sizeof(Variant) <= 16u, "Variant should fit into 16 bytes");
 } // namespace OpenAutoIt
@@ -1,8 +1,14 @@
 #pragma once
 
 #include "OpenAutoIt/AST/ASTStatement.hpp"
+#include "OpenAutoIt/Directory.hpp"
+#include "OpenAutoIt/File.hpp"
+#include "OpenAutoIt/OutputStream.hpp"
+#include "OpenAutoIt/Regex.hpp"
 #include "OpenAutoIt/Scope.hpp"
 #include "OpenAutoIt/StackTraceEntry.hpp"
+#include "OpenAutoIt/StringFormat.hpp"
+#include "OpenAutoIt/ThreadPool.hpp"
 #include "OpenAutoIt/Utililty.hpp"
 #include "OpenAutoIt/VariableScope.hpp"
 #include "OpenAutoIt/Variant.hpp"
@@ -11,13 +17,16 @@
 #include <phi/core/boolean.hpp>
 #include <phi/core/forward.hpp>
 #include <phi/core/observer_ptr.hpp>
+#include <phi/core/optional.hpp>
 #include <phi/core/types.hpp>
 #include <iostream>
 #include <iterator>
 #include <list>
 #include <ostream>
+#include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
 
@@ -30,8 +39,6 @@ namespace OpenAutoIt
 {
 using StackTrace = std::vector<StackTraceEntry>;
 
-using OutputHandler = void (*)(const std::string&);
-
 // The abstract virtual machine running AutoIt
 class VirtualMachine
 {
@@ -39,15 +46,17 @@ public:
     template <typename... ArgsT>
     void RuntimeError(std::string_view format_string, ArgsT&&... args)
     {
-        err("[OpenAutoIt] ");
-        err("\033[31m");
-        err("RUNTIME ERROR!");
-        err("\033[0m\n");
-        err(" > ");
-        err("\033[31m");
-        err(fmt::format(fmt::runtime(format_string), phi::forward<ArgsT>(args)...));
-        err("\033[0m\n");
-        err("Stack trace:\n");
+        std::string message;
+
+        message += "[OpenAutoIt] ";
+        message += "\033[31m";
+        message += "RUNTIME ERROR!";
+        message += "\033[0m\n";
+        message += " > ";
+        message += "\033[31m";
+        message += fmt::format(fmt::runtime(format_string), phi::forward<ArgsT>(args)...);
+        message += "\033[0m\n";
+        message += "Stack trace:\n";
 
         // Print stack trace
         StackTrace stack_trace = GetStackTrace();
@@ -55,16 +64,18 @@ public:
         {
             const StackTraceEntry& entry = stack_trace.at(index.unsafe());
 
-            err(fmt::format("\t#{:d} {:s} {:s}:{:d}:{:d}\n", index.unsafe(), entry.function,
-                            entry.file, entry.line.unsafe(), entry.column.unsafe()));
+            message += fmt::format("\t#{:d} {:s} {:s}:{:d}:{:d}\n", index.unsafe(), entry.function,
+                                   entry.file, entry.line.unsafe(), entry.column.unsafe());
         }
 
+        PrintError(message);
+
         m_Aborting = true;
     }
 
-    void PushFunctionScope(std::string_view function_name, Statements& statements);
-    void PushBlockScope(Statements& statements);
-    void PushGlobalScope(Statements& statements);
+    void PushFunctionScope(std::string_view function_name, const Statements& statements);
+    void PushBlockScope(const Statements& statements);
+    void PushGlobalScope(const Statements& statements);
     void PopScope();
 
     [[nodiscard]] Scope&       GetCurrentScope();
@@ -87,23 +98,78 @@ public:
     [[nodiscard]] phi::optional<const Variant&> LookupVariableRefByName(
             std::string_view variable_name) const;
 
+    // Changes whenever looking up a variable by name could find a different variable or a variable
+    // found before could have been destroyed. Entering and leaving block scopes without variables,
+    // like the body of a loop, keeps it the same. Zero is never used.
+    [[nodiscard]] phi::uint64_t GetVariableLayoutVersion() const;
+
     [[nodiscard]] phi::boolean CanRun() const;
 
+    [[nodiscard]] phi::boolean IsAborting() const;
+
     void Exit(phi::u32 exit_code);
 
     [[nodiscard]] phi::u32 GetExitCode() const;
 
+    // Every message is passed to the handlers as is
     void SetupOutputHandler(OutputHandler standard, OutputHandler error);
 
-    void Print(const std::string& message) const;
-    void PrintError(const std::string& message) const;
+    // Standard output is buffered according to the policy of its file descriptor while error output
+    // is written right away
+    void SetupOutputFileDescriptors(int standard, int error);
+
+    void Print(std::string_view message);
+    void PrintError(std::string_view message);
+
+    // Writes all buffered output. Also done on exit and when the virtual machine is destroyed.
+    void FlushOutput();
+
+    // Files and file searches share their handles which start at 1 so FileClose closes both
+    [[nodiscard]] phi::int64_t               AddFile(File file);
+    [[nodiscard]] phi::int64_t               AddFileSearch(FileSearch search);
+    [[nodiscard]] phi::optional<File&>       LookupFile(phi::int64_t handle);
+    [[nodiscard]] phi::optional<FileSearch&> LookupFileSearch(phi::int64_t handle);
+    phi::boolean                             CloseFile(phi::int64_t handle);
+
+    // Pool for builtins which split up large amounts of work. The Engine shares its own pool with
+    // all of its instances, otherwise the process wide pool is used.
+    void                      SetThreadPool(ThreadPool& pool);
+    [[nodiscard]] ThreadPool& GetThreadPool();
+
+    [[nodiscard]] RegexCache& GetRegexCache();
+
+    [[nodiscard]] FormatStringCache& GetFormatStringCache();
+
+    // Scratch buffer for StringFormat which keeps its capacity across calls
+    [[nodiscard]] std::string& GetFormatBuffer();
 
 private:
     std::list<Scope> m_Scopes;
+    phi::uint64_t    m_VariableLayoutVersion{1u};
+
+    OutputStream m_StandardOutput;
+    OutputStream m_ErrorOutput;
+    phi::boolean m_Aborting{false};
+    phi::u32     m_ExitCode{0u};
+
+    struct FileHandle
+    {
+        phi::optional<File>       file;
+        phi::optional<FileSearch> search;
+    };
+
+    // Returns a free slot for a new handle
+    [[nodiscard]] std::vector<FileHandle>::iterator AcquireFileHandle();
+
+    [[nodiscard]] phi::observer_ptr<FileHandle> GetFileHandle(phi::int64_t handle);
+
+    // Handle n is stored at n - 1 and closed handles are reused
+    std::vector<FileHandle> m_FileHandles;
+
+    phi::observer_ptr<ThreadPool> m_ThreadPool;
 
-    OutputHandler m_StandardOutputHandler{nullptr};
-    OutputHandler m_ErrorOutputHandler{nullptr};
-    phi::boolean  m_Aborting{false};
-    phi::u32      m_ExitCode{0u};
+    RegexCache        m_RegexCache;
+    FormatStringCache m_FormatStringCache;
+    std::string       m_FormatBuffer;
 };
 } // namespace OpenAutoIt
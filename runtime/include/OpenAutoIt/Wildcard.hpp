@@ -0,0 +1,33 @@
+#pragma once
+
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+// File name pattern of FileFindFirstFile where * matches any number of characters and ? matches a
+// single character. Like the file systems of Windows matching ignores the case of ASCII letters and
+// *.* also matches names without a dot.
+// NOTE: The pattern is split into the parts between its stars once so matching a name only has to
+//       find these parts in order.
+class Wildcard
+{
+public:
+    explicit Wildcard(std::string_view pattern);
+
+    [[nodiscard]] phi::boolean Matches(std::string_view name) const;
+
+private:
+    // Returns the offset behind the segment if it matches at the offset or npos otherwise
+    [[nodiscard]] static phi::size_t MatchSegment(std::string_view name, phi::size_t offset,
+                                                  std::string_view segment);
+
+    std::vector<std::string> m_Segments; // Lower cased parts between the stars
+    phi::boolean             m_LeadingStar{false};
+    phi::boolean             m_TrailingStar{false};
+    phi::boolean             m_MatchesAll{false};
+};
+} // namespace OpenAutoIt
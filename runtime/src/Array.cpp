@@ -0,0 +1,433 @@
+#include "OpenAutoIt/Array.hpp"
+
+#include "OpenAutoIt/Variant.hpp"
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Returns false if the dimensions exceed the AutoIt limits
+    [[nodiscard]] phi::boolean ComputeElementCount(const ArraySubscripts& dimensions,
+                                                   phi::size_t&           element_count)
+    {
+        if (dimensions.count == 0u || dimensions.count > MaxArrayDimensions)
+        {
+            return false;
+        }
+
+        element_count = 1u;
+        for (phi::size_t index{0u}; index < dimensions.count; ++index)
+        {
+            const phi::size_t dimension = dimensions.values[index];
+
+            // NOTE: Checked before multiplying so this can never overflow
+            if (dimension > MaxArrayElements ||
+                (dimension != 0u && element_count > MaxArrayElements / dimension))
+            {
+                return false;
+            }
+
+            element_count *= dimension;
+        }
+
+        return true;
+    }
+} // namespace
+
+phi::optional<Array> Array::FromElements(std::vector<Variant>&& elements)
+{
+    if (elements.size() > MaxArrayElements)
+    {
+        return {};
+    }
+
+    Array array;
+    array.m_Dimensions.assign(1u, elements.size());
+    array.m_Elements = phi::move(elements);
+
+    for (const Variant& element : array.m_Elements)
+    {
+        array.CountElement(element);
+    }
+    array.TrySpecialize();
+
+    return array;
+}
+
+phi::size_t Array::GetDimensionCount() const
+{
+    return m_Dimensions.size();
+}
+
+phi::size_t Array::GetDimension(const phi::size_t dimension) const
+{
+    PHI_ASSERT(dimension < m_Dimensions.size());
+
+    return m_Dimensions[dimension];
+}
+
+phi::size_t Array::GetElementCount() const
+{
+    switch (m_Storage)
+    {
+        case ArrayStorage::Boxed:
+            return m_Elements.size();
+        case ArrayStorage::Int64:
+            return m_Int64Elements.size();
+        case ArrayStorage::Double:
+            return m_DoubleElements.size();
+    }
+
+    PHI_ASSERT_NOT_REACHED();
+    return 0u;
+}
+
+ArrayStorage Array::GetStorage() const
+{
+    return m_Storage;
+}
+
+phi::optional<Variant> Array::GetElement(const ArraySubscripts& subscripts) const
+{
+    phi::size_t index{0u};
+    if (!ComputeIndex(subscripts, index))
+    {
+        return {};
+    }
+
+    return GetElementAt(index);
+}
+
+phi::optional<Variant> Array::TakeElement(const ArraySubscripts& subscripts)
+{
+    phi::size_t index{0u};
+    if (!ComputeIndex(subscripts, index))
+    {
+        return {};
+    }
+
+    if (m_Storage != ArrayStorage::Boxed)
+    {
+        return GetElementAt(index);
+    }
+
+    Variant& element = m_Elements[index];
+    UncountElement(element);
+
+    return phi::move(element);
+}
+
+phi::boolean Array::SetElement(const ArraySubscripts& subscripts, Variant value)
+{
+    phi::size_t index{0u};
+    if (!ComputeIndex(subscripts, index))
+    {
+        return false;
+    }
+
+    // Once an array held mixed types it is likely to do so again, so it stays boxed to avoid
+    // converting back and forth
+    switch (m_Storage)
+    {
+        case ArrayStorage::Int64:
+            if (value.IsInt64())
+            {
+                m_Int64Elements[index] = value.AsInt64().unsafe();
+                return true;
+            }
+            Box();
+            m_CanSpecialize = false;
+            break;
+
+        case ArrayStorage::Double:
+            if (value.IsDouble())
+            {
+                m_DoubleElements[index] = value.AsDouble().unsafe();
+                return true;
+            }
+            Box();
+            m_CanSpecialize = false;
+            break;
+
+        case ArrayStorage::Boxed:
+            break;
+    }
+
+    Variant& element = m_Elements[index];
+    UncountElement(element);
+    CountElement(value);
+    element = phi::move(value);
+
+    TrySpecialize();
+
+    return true;
+}
+
+phi::boolean Array::ReDim(const ArraySubscripts& dimensions)
+{
+    phi::size_t element_count{0u};
+    if (!ComputeElementCount(dimensions, element_count))
+    {
+        return false;
+    }
+
+    const auto dimension_count = static_cast<std::ptrdiff_t>(dimensions.count);
+
+    // Changing the number of dimensions discards all elements
+    if (dimensions.count != m_Dimensions.size())
+    {
+        m_Dimensions.assign(dimensions.values.begin(), dimensions.values.begin() + dimension_count);
+        m_Elements.clear();
+        m_Elements.resize(element_count);
+        m_Int64Elements.clear();
+        m_DoubleElements.clear();
+
+        m_Int64Count    = 0u;
+        m_DoubleCount   = 0u;
+        m_Storage       = ArrayStorage::Boxed;
+        m_CanSpecialize = true;
+
+        return true;
+    }
+
+    phi::boolean only_first_changed{true};
+    for (phi::size_t index{1u}; index < dimensions.count; ++index)
+    {
+        if (dimensions.values[index] != m_Dimensions[index])
+        {
+            only_first_changed = false;
+            break;
+        }
+    }
+
+    // Since the first dimension is the outermost one the existing elements stay where they are and
+    // we only need to add or remove elements at the end. Growing geometrically makes a loop
+    // calling ReDim with one more element each iteration amortized O(1)
+    if (only_first_changed)
+    {
+        // Unboxed storage can only shrink since new elements are empty strings
+        if (m_Storage == ArrayStorage::Int64 && element_count <= m_Int64Elements.size())
+        {
+            m_Int64Elements.resize(element_count);
+            m_Dimensions[0u] = dimensions.values[0u];
+            return true;
+        }
+        if (m_Storage == ArrayStorage::Double && element_count <= m_DoubleElements.size())
+        {
+            m_DoubleElements.resize(element_count);
+            m_Dimensions[0u] = dimensions.values[0u];
+            return true;
+        }
+
+        Box();
+
+        for (phi::size_t index = element_count; index < m_Elements.size(); ++index)
+        {
+            UncountElement(m_Elements[index]);
+        }
+
+        if (element_count > m_Elements.capacity())
+        {
+            const phi::size_t grown_capacity = m_Elements.capacity() * 2u;
+            m_Elements.reserve(grown_capacity > element_count ? grown_capacity : element_count);
+        }
+
+        m_Elements.resize(element_count);
+        m_Dimensions[0u] = dimensions.values[0u];
+
+        TrySpecialize();
+
+        return true;
+    }
+
+    // Otherwise every element which is still in range is moved to its new position
+    Box();
+
+    std::vector<Variant> new_elements(element_count);
+
+    ArraySubscripts subscripts;
+    subscripts.count = dimensions.count;
+
+    for (phi::size_t old_index{0u}; old_index < m_Elements.size(); ++old_index)
+    {
+        // Decompose the old index into subscripts starting with the innermost dimension
+        phi::size_t  remainder = old_index;
+        phi::boolean in_range{true};
+        for (phi::size_t dimension = dimensions.count; dimension > 0u; --dimension)
+        {
+            const phi::size_t subscript = remainder % m_Dimensions[dimension - 1u];
+            remainder /= m_Dimensions[dimension - 1u];
+
+            subscripts.values[dimension - 1u] = subscript;
+
+            in_range = in_range && subscript < dimensions.values[dimension - 1u];
+        }
+
+        if (!in_range)
+        {
+            UncountElement(m_Elements[old_index]);
+            continue;
+        }
+
+        phi::size_t new_index{0u};
+        for (phi::size_t dimension{0u}; dimension < dimensions.count; ++dimension)
+        {
+            new_index = new_index * dimensions.values[dimension] + subscripts.values[dimension];
+        }
+
+        new_elements[new_index] = phi::move(m_Elements[old_index]);
+    }
+
+    m_Dimensions.assign(dimensions.values.begin(), dimensions.values.begin() + dimension_count);
+    m_Elements = phi::move(new_elements);
+
+    return true;
+}
+
+phi::boolean Array::ComputeIndex(const ArraySubscripts& subscripts, phi::size_t& index) const
+{
+    if (subscripts.count != m_Dimensions.size())
+    {
+        return false;
+    }
+
+    index = 0u;
+    for (phi::size_t dimension{0u}; dimension < subscripts.count; ++dimension)
+    {
+        const phi::size_t subscript = subscripts.values[dimension];
+        if (subscript >= m_Dimensions[dimension])
+        {
+            return false;
+        }
+
+        index = index * m_Dimensions[dimension] + subscript;
+    }
+
+    return true;
+}
+
+Variant Array::GetElementAt(const phi::size_t index) const
+{
+    PHI_ASSERT(index < GetElementCount());
+
+    switch (m_Storage)
+    {
+        case ArrayStorage::Boxed:
+            return m_Elements[index];
+        case ArrayStorage::Int64:
+            return Variant::MakeInt(m_Int64Elements[index]);
+        case ArrayStorage::Double:
+            return Variant::MakeDouble(m_DoubleElements[index]);
+    }
+
+    PHI_ASSERT_NOT_REACHED();
+    return {};
+}
+
+void Array::CountElement(const Variant& element)
+{
+    if (element.IsInt64())
+    {
+        ++m_Int64Count;
+    }
+    else if (element.IsDouble())
+    {
+        ++m_DoubleCount;
+    }
+}
+
+void Array::UncountElement(const Variant& element)
+{
+    if (element.IsInt64())
+    {
+        PHI_ASSERT(m_Int64Count > 0u);
+        --m_Int64Count;
+    }
+    else if (element.IsDouble())
+    {
+        PHI_ASSERT(m_DoubleCount > 0u);
+        --m_DoubleCount;
+    }
+}
+
+void Array::TrySpecialize()
+{
+    if (!m_CanSpecialize || m_Storage != ArrayStorage::Boxed || m_Elements.empty())
+    {
+        return;
+    }
+
+    if (m_Int64Count == m_Elements.size())
+    {
+        m_Int64Elements.resize(m_Elements.size());
+        for (phi::size_t index{0u}; index < m_Elements.size(); ++index)
+        {
+            m_Int64Elements[index] = m_Elements[index].AsInt64().unsafe();
+        }
+
+        m_Storage = ArrayStorage::Int64;
+    }
+    else if (m_DoubleCount == m_Elements.size())
+    {
+        m_DoubleElements.resize(m_Elements.size());
+        for (phi::size_t index{0u}; index < m_Elements.size(); ++index)
+        {
+            m_DoubleElements[index] = m_Elements[index].AsDouble().unsafe();
+        }
+
+        m_Storage = ArrayStorage::Double;
+    }
+    else
+    {
+        return;
+    }
+
+    m_Elements.clear();
+    m_Elements.shrink_to_fit();
+    m_Int64Count  = 0u;
+    m_DoubleCount = 0u;
+}
+
+void Array::Box()
+{
+    switch (m_Storage)
+    {
+        case ArrayStorage::Boxed:
+            return;
+
+        case ArrayStorage::Int64:
+            m_Elements.reserve(m_Int64Elements.size());
+            for (const phi::int64_t value : m_Int64Elements)
+            {
+                m_Elements.emplace_back(Variant::MakeInt(value));
+            }
+
+            m_Int64Count = m_Int64Elements.size();
+            m_Int64Elements.clear();
+            m_Int64Elements.shrink_to_fit();
+            break;
+
+        case ArrayStorage::Double:
+            m_Elements.reserve(m_DoubleElements.size());
+            for (const double value : m_DoubleElements)
+            {
+                m_Elements.emplace_back(Variant::MakeDouble(value));
+            }
+
+            m_DoubleCount = m_DoubleElements.size();
+            m_DoubleElements.clear();
+            m_DoubleElements.shrink_to_fit();
+            break;
+    }
+
+    m_Storage = ArrayStorage::Boxed;
+}
+} // namespace OpenAutoIt
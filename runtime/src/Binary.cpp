@@ -0,0 +1,232 @@
+#include "OpenAutoIt/Binary.hpp"
+
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <phi/text/hex_digit_value.hpp>
+#include <phi/text/is_hex_digit.hpp>
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    constexpr const char hex_digits[]{"0123456789ABCDEF"};
+} // namespace
+
+Binary::Binary(const std::string_view bytes)
+{
+    if (!bytes.empty())
+    {
+        m_Buffer = new Buffer{std::string(bytes)}; // NOLINT(cppcoreguidelines-owning-memory)
+        m_Size   = bytes.size();
+    }
+}
+
+Binary::Binary(std::string&& bytes)
+{
+    if (!bytes.empty())
+    {
+        m_Size   = bytes.size();
+        m_Buffer = new Buffer{phi::move(bytes)}; // NOLINT(cppcoreguidelines-owning-memory)
+    }
+}
+
+Binary::Binary(const Binary& other)
+    : m_Buffer{other.m_Buffer}
+    , m_Offset{other.m_Offset}
+    , m_Size{other.m_Size}
+{
+    if (m_Buffer != nullptr)
+    {
+        ++m_Buffer->reference_count;
+    }
+}
+
+Binary::Binary(Binary&& other)
+    : m_Buffer{other.m_Buffer}
+    , m_Offset{other.m_Offset}
+    , m_Size{other.m_Size}
+{
+    other.m_Buffer = nullptr;
+    other.m_Offset = 0u;
+    other.m_Size   = 0u;
+}
+
+Binary::~Binary()
+{
+    Release();
+}
+
+Binary& Binary::operator=(const Binary& other)
+{
+    if (this != &other)
+    {
+        Binary copy{other};
+        *this = phi::move(copy);
+    }
+
+    return *this;
+}
+
+Binary& Binary::operator=(Binary&& other)
+{
+    if (this != &other)
+    {
+        Release();
+
+        m_Buffer = other.m_Buffer;
+        m_Offset = other.m_Offset;
+        m_Size   = other.m_Size;
+
+        other.m_Buffer = nullptr;
+        other.m_Offset = 0u;
+        other.m_Size   = 0u;
+    }
+
+    return *this;
+}
+
+phi::optional<Binary> Binary::FromHexString(const std::string_view string)
+{
+    if (string.size() < 2u || string[0u] != '0' || (string[1u] != 'x' && string[1u] != 'X') ||
+        string.size() % 2u != 0u)
+    {
+        return {};
+    }
+
+    std::string bytes;
+    bytes.resize((string.size() - 2u) / 2u);
+
+    for (phi::size_t index{2u}, byte{0u}; index < string.size(); index += 2u, ++byte)
+    {
+        const char high = string[index];
+        const char low  = string[index + 1u];
+        if (!phi::is_hex_digit(high) || !phi::is_hex_digit(low))
+        {
+            return {};
+        }
+
+        bytes[byte] = static_cast<char>((phi::hex_digit_value(high).unsafe() << 4u) |
+                                        phi::hex_digit_value(low).unsafe());
+    }
+
+    return Binary{phi::move(bytes)};
+}
+
+phi::size_t Binary::GetSize() const
+{
+    return m_Size;
+}
+
+phi::boolean Binary::IsEmpty() const
+{
+    return m_Size == 0u;
+}
+
+std::string_view Binary::GetBytes() const
+{
+    if (m_Buffer == nullptr)
+    {
+        return {};
+    }
+
+    return std::string_view{m_Buffer->bytes}.substr(m_Offset, m_Size);
+}
+
+Binary Binary::Slice(phi::size_t offset, phi::size_t size) const
+{
+    offset = std::min(offset, m_Size);
+    size   = std::min(size, m_Size - offset);
+    if (size == 0u)
+    {
+        return {};
+    }
+
+    Binary slice{*this};
+    slice.m_Offset += offset;
+    slice.m_Size = size;
+
+    return slice;
+}
+
+void Binary::Append(const std::string_view bytes)
+{
+    if (bytes.empty())
+    {
+        return;
+    }
+
+    if (m_Buffer == nullptr)
+    {
+        *this = Binary{bytes};
+        return;
+    }
+
+    std::string& buffer = m_Buffer->bytes;
+
+    // Appending a part of our own buffer in place could invalidate the bytes while copying them
+    const std::less_equal<const char*> less_equal;
+    const phi::boolean                 aliases = less_equal(buffer.data(), bytes.data()) &&
+                                 less_equal(bytes.data(), buffer.data() + buffer.size());
+
+    if (m_Buffer->reference_count == 1u && !aliases)
+    {
+        // Nobody else can see the buffer, so the bytes outside of our view can simply be dropped
+        buffer.resize(m_Offset + m_Size);
+        buffer.erase(0u, m_Offset);
+        buffer.append(bytes);
+
+        m_Offset = 0u;
+        m_Size   = buffer.size();
+        return;
+    }
+
+    std::string copy;
+    copy.reserve(m_Size + bytes.size());
+    copy.append(GetBytes());
+    copy.append(bytes);
+
+    *this = Binary{phi::move(copy)};
+}
+
+void Binary::AppendHexString(std::string& string) const
+{
+    if (m_Size == 0u)
+    {
+        return;
+    }
+
+    const std::string_view bytes = GetBytes();
+
+    phi::size_t position = string.size();
+    string.resize(position + 2u + bytes.size() * 2u);
+    string[position++] = '0';
+    string[position++] = 'x';
+
+    for (const char character : bytes)
+    {
+        const auto byte    = static_cast<unsigned char>(character);
+        string[position++] = hex_digits[byte >> 4u];
+        string[position++] = hex_digits[byte & 0x0Fu];
+    }
+}
+
+void Binary::Release()
+{
+    if (m_Buffer != nullptr && --m_Buffer->reference_count == 0u)
+    {
+        delete m_Buffer; // NOLINT(cppcoreguidelines-owning-memory)
+    }
+
+    m_Buffer = nullptr;
+    m_Offset = 0u;
+    m_Size   = 0u;
+}
+} // namespace OpenAutoIt
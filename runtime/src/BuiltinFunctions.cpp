@@ -1,12 +1,380 @@
 #include "OpenAutoIt/BuiltinFunctions.hpp"
 
+#include "OpenAutoIt/Array.hpp"
+#include "OpenAutoIt/Binary.hpp"
+#include "OpenAutoIt/Directory.hpp"
+#include "OpenAutoIt/File.hpp"
+#include "OpenAutoIt/LineBreak.hpp"
+#include "OpenAutoIt/Map.hpp"
+#include "OpenAutoIt/NumberFormatting.hpp"
+#include "OpenAutoIt/Regex.hpp"
+#include "OpenAutoIt/StringClassification.hpp"
+#include "OpenAutoIt/StringFormat.hpp"
+#include "OpenAutoIt/StringSearch.hpp"
+#include "OpenAutoIt/StringSplit.hpp"
+#include "OpenAutoIt/StringTransform.hpp"
+#include "OpenAutoIt/ThreadPool.hpp"
+#include "OpenAutoIt/UTF16Index.hpp"
+#include "OpenAutoIt/Unicode.hpp"
 #include "OpenAutoIt/Variant.hpp"
 #include "OpenAutoIt/VirtualMachine.hpp"
+#include <phi/compiler_support/unused.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/optional.hpp>
 #include <phi/math/abs.hpp>
+#include <algorithm>
+#include <limits>
 #include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace OpenAutoIt
 {
+namespace
+{
+    // Flags of BinaryToString
+    constexpr const phi::int64_t BinaryToStringANSI{1};
+    constexpr const phi::int64_t BinaryToStringUTF16LE{2};
+    constexpr const phi::int64_t BinaryToStringUTF16BE{3};
+    constexpr const phi::int64_t BinaryToStringUTF8{4};
+
+    // Flags of DirGetSize
+    constexpr const phi::int64_t DirGetSizeExtended{1};
+    constexpr const phi::int64_t DirGetSizeNoRecurse{2};
+
+    // Flags of FileOpen
+    constexpr const phi::int64_t FileOpenAppend{1};
+    constexpr const phi::int64_t FileOpenOverwrite{2};
+    constexpr const phi::int64_t FileOpenBinary{16};
+
+    // Converts UTF-16 to UTF-8 in a single pass. Unpaired surrogates and a trailing odd byte are
+    // replaced with U+FFFD
+    [[nodiscard]] std::string ConvertUTF16ToUTF8(const std::string_view bytes,
+                                                 const phi::boolean     big_endian)
+    {
+        const auto read_unit = [&](const phi::size_t index) -> char32_t {
+            const auto first  = static_cast<unsigned char>(bytes[index]);
+            const auto second = static_cast<unsigned char>(bytes[index + 1u]);
+
+            return big_endian ? static_cast<char32_t>((first << 8u) | second) :
+                                static_cast<char32_t>((second << 8u) | first);
+        };
+
+        std::string string;
+        string.reserve(bytes.size() / 2u);
+
+        phi::size_t index{0u};
+        for (; index + 1u < bytes.size(); index += 2u)
+        {
+            const char32_t unit = read_unit(index);
+
+            if (unit >= 0xD800u && unit <= 0xDBFFu && index + 3u < bytes.size())
+            {
+                const char32_t low = read_unit(index + 2u);
+                if (low >= 0xDC00u && low <= 0xDFFFu)
+                {
+                    AppendUTF8(string, 0x10000u + ((unit - 0xD800u) << 10u) + (low - 0xDC00u));
+                    index += 2u;
+                    continue;
+                }
+            }
+
+            const phi::boolean is_surrogate = unit >= 0xD800u && unit <= 0xDFFFu;
+            AppendUTF8(string, is_surrogate ? ReplacementCharacter : unit);
+        }
+
+        if (index < bytes.size())
+        {
+            AppendUTF8(string, ReplacementCharacter);
+        }
+
+        return string;
+    }
+
+    // Returns the value as a string without copying strings or allocating for numbers. Other types
+    // are converted into storage which has to outlive the returned view.
+    [[nodiscard]] std::string_view ToStringView(const Variant& value, NumberBuffer& buffer,
+                                                Variant& storage)
+    {
+        switch (value.GetType())
+        {
+            case Variant::Type::String:
+                return value.AsString();
+
+            case Variant::Type::Int64:
+                return FormatInt64(value.AsInt64().unsafe(), buffer);
+
+            case Variant::Type::Double:
+                return FormatDouble(value.AsDouble().unsafe(), buffer);
+
+            default:
+                storage = value.CastToString();
+                PHI_ASSERT(storage.IsString());
+
+                return storage.AsString();
+        }
+    }
+
+    // FileRead and FileReadLine accept either a handle from FileOpen or a file name which is opened
+    // just for the call and stored in temporary
+    [[nodiscard]] phi::optional<File&> GetFile(VirtualMachine& vm, const Variant& file,
+                                               phi::optional<File>& temporary)
+    {
+        if (file.IsString())
+        {
+            temporary = File::Open(file.AsString(), false);
+            if (!temporary)
+            {
+                return {};
+            }
+
+            return *temporary;
+        }
+
+        return vm.LookupFile(file.CastToInt64().AsInt64().unsafe());
+    }
+
+    [[nodiscard]] Variant MakeReadResult(const File&                            file,
+                                         const phi::optional<std::string_view>& data)
+    {
+        if (!data)
+        {
+            // TODO: Set @error to -1 at the end of the file
+            return Variant::MakeString("");
+        }
+
+        if (file.IsBinary())
+        {
+            return Variant::MakeBinary(Binary{*data});
+        }
+
+        return Variant::MakeString(*data);
+    }
+
+    [[nodiscard]] CaseSense ToCaseSense(const Variant& case_sense)
+    {
+        if (case_sense.IsDefault())
+        {
+            return CaseSense::IgnoreCase;
+        }
+
+        switch (case_sense.CastToInt64().AsInt64().unsafe())
+        {
+            case 1:
+                return CaseSense::MatchCase;
+            case 2:
+                return CaseSense::IgnoreCaseASCII;
+            default:
+                return CaseSense::IgnoreCase;
+        }
+    }
+
+    // Converts between the character positions used by AutoIt and byte offsets into the UTF-8
+    // string using the index cached by the string. Pure ASCII strings skip the conversion.
+    class CharacterPositions
+    {
+    public:
+        // The string has to be a Variant holding a string so its cached index can be used
+        explicit CharacterPositions(const Variant& string)
+            : m_String{string.AsString()}
+            , m_Index{string.GetUTF16Index()}
+        {}
+
+        [[nodiscard]] phi::size_t GetLength() const
+        {
+            return m_Index.GetLength();
+        }
+
+        [[nodiscard]] phi::size_t ToOffset(const phi::size_t index) const
+        {
+            return m_Index.ToOffset(m_String, index);
+        }
+
+        [[nodiscard]] phi::size_t ToIndex(const phi::size_t offset) const
+        {
+            return m_Index.ToIndex(m_String, offset);
+        }
+
+    private:
+        std::string_view  m_String;
+        const UTF16Index& m_Index;
+    };
+
+    // Returns up to count characters starting at the character index first
+    [[nodiscard]] Variant MakeSubstring(const Variant& string, const phi::size_t first,
+                                        const phi::size_t count)
+    {
+        const CharacterPositions positions{string};
+        const std::string_view   value = string.AsString();
+
+        const phi::size_t length = positions.GetLength();
+        if (first >= length || count == 0u)
+        {
+            return Variant::MakeString("");
+        }
+
+        const phi::size_t begin = positions.ToOffset(first);
+        const phi::size_t end =
+                count >= length - first ? value.size() : positions.ToOffset(first + count);
+
+        return Variant::MakeString(std::string{value.substr(begin, end - begin)});
+    }
+
+    [[nodiscard]] Variant StringIs(const Variant& string, const CharacterClass character_class)
+    {
+        const Variant value = string.CastToString();
+
+        return Variant::MakeInt(StringIsCharacterClass(value.AsString(), character_class) ? 1 : 0);
+    }
+
+    // Flags of StringSplit
+    constexpr const phi::int64_t StringSplitEntireDelimiter{1};
+    constexpr const phi::int64_t StringSplitNoCount{2};
+
+    // Flags of StringRegExp
+    constexpr const phi::int64_t RegExpMatch{0};
+    constexpr const phi::int64_t RegExpArrayMatch{1};
+    constexpr const phi::int64_t RegExpArrayFullMatch{2};
+    constexpr const phi::int64_t RegExpArrayGlobalMatch{3};
+    constexpr const phi::int64_t RegExpArrayGlobalFullMatch{4};
+
+    [[nodiscard]] Variant MakeOneDimensionalArray(std::vector<Variant>&& elements)
+    {
+        phi::optional<Array> array = Array::FromElements(phi::move(elements));
+        PHI_ASSERT(array);
+
+        return Variant::MakeArray(phi::move(*array));
+    }
+
+    // Appends the text of a group or an empty string if the group didn't participate in the match
+    void AppendGroup(std::vector<Variant>& elements, const std::string_view subject,
+                     const Regex::Captures& captures, const phi::size_t group)
+    {
+        const phi::size_t start = captures[group * 2u];
+        const phi::size_t end   = captures[group * 2u + 1u];
+
+        elements.push_back(Variant::MakeString(
+                start == Regex::NoMatch ? std::string_view{} : subject.substr(start, end - start)));
+    }
+
+    // Where to continue searching after a match. An empty match has to advance by a character so
+    // the same empty match isn't found again.
+    [[nodiscard]] phi::size_t NextSearchOffset(const std::string_view subject,
+                                               const Regex::Captures& captures)
+    {
+        phi::size_t offset = captures[1u];
+        if (offset != captures[0u] || offset >= subject.size())
+        {
+            return offset + static_cast<phi::size_t>(offset == captures[0u]);
+        }
+
+        ++offset;
+        while (offset < subject.size() && IsUTF8ContinuationByte(subject[offset]))
+        {
+            ++offset;
+        }
+
+        return offset;
+    }
+
+    // Part of the replacement of StringRegExpReplace which is either literal text or a group
+    struct ReplacementPart
+    {
+        std::string_view text;
+        phi::size_t      group{Regex::NoMatch};
+    };
+
+    // Splits the replacement into its parts once so it doesn't have to be parsed again for every
+    // match. \0 - \9, $0 - $9 and ${n} insert groups and \\ inserts a backslash.
+    [[nodiscard]] std::vector<ReplacementPart> ParseReplacement(const std::string_view replacement,
+                                                                const phi::size_t group_count)
+    {
+        std::vector<ReplacementPart> parts;
+        phi::size_t                  literal_start{0u};
+
+        const auto add_literal = [&](const phi::size_t end) {
+            if (end > literal_start)
+            {
+                parts.push_back({replacement.substr(literal_start, end - literal_start)});
+            }
+        };
+
+        for (phi::size_t index{0u}; index + 1u < replacement.size(); ++index)
+        {
+            const char character = replacement[index];
+            if (character != '\\' && character != '$')
+            {
+                continue;
+            }
+
+            const char  next = replacement[index + 1u];
+            phi::size_t group{Regex::NoMatch};
+            phi::size_t end{index + 2u};
+
+            if (next >= '0' && next <= '9')
+            {
+                group = static_cast<phi::size_t>(next - '0');
+            }
+            else if (character == '$' && next == '{')
+            {
+                const phi::size_t closing = replacement.find('}', index + 2u);
+                if (closing == std::string_view::npos || closing == index + 2u ||
+                    closing > index + 4u)
+                {
+                    continue;
+                }
+
+                group = 0u;
+                for (phi::size_t digit{index + 2u}; digit < closing; ++digit)
+                {
+                    if (replacement[digit] < '0' || replacement[digit] > '9')
+                    {
+                        group = Regex::NoMatch;
+                        break;
+                    }
+                    group = group * 10u + static_cast<phi::size_t>(replacement[digit] - '0');
+                }
+                if (group == Regex::NoMatch)
+                {
+                    continue;
+                }
+                end = closing + 1u;
+            }
+            else if (character == '\\' && next == '\\')
+            {
+                // Keep the first backslash as the literal
+                add_literal(index + 1u);
+                literal_start = index + 2u;
+                ++index;
+                continue;
+            }
+            else
+            {
+                continue;
+            }
+
+            add_literal(index);
+
+            // Groups which don't exist are replaced with nothing
+            if (group <= group_count)
+            {
+                parts.push_back({{}, group});
+            }
+
+            literal_start = end;
+            index         = end - 1u;
+        }
+
+        add_literal(replacement.size());
+        return parts;
+    }
+} // namespace
 
 // https://www.autoitscript.com/autoit3/docs/functions/Abs.htm
 Variant BuiltIn_Abs(const VirtualMachine& /*vm*/, const Variant& input)
@@ -14,13 +382,130 @@ Variant BuiltIn_Abs(const VirtualMachine& /*vm*/, const Variant& input)
     return input.Abs();
 }
 
+// https://www.autoitscript.com/autoit3/docs/functions/AscW.htm
+Variant BuiltIn_AscW(const VirtualMachine& /*vm*/, const Variant& character)
+{
+    const Variant          value  = character.CastToString();
+    const std::string_view string = value.AsString();
+    if (string.empty())
+    {
+        return Variant::MakeInt(0);
+    }
+
+    phi::size_t    index{0u};
+    const char32_t code_point = DecodeUTF8(string, index);
+
+    // Characters outside of the basic multilingual plane start with their high surrogate
+    if (code_point >= 0x10000u)
+    {
+        return Variant::MakeInt(0xD800 + static_cast<phi::int64_t>((code_point - 0x10000u) >> 10u));
+    }
+
+    return Variant::MakeInt(static_cast<phi::int64_t>(code_point));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/Binary.htm
+Variant BuiltIn_Binary(const VirtualMachine& /*vm*/, const Variant& input)
+{
+    return input.CastToBinary();
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/BinaryLen.htm
+Variant BuiltIn_BinaryLen(const VirtualMachine& /*vm*/, const Variant& binary)
+{
+    if (binary.IsBinary())
+    {
+        return Variant::MakeInt(static_cast<phi::int64_t>(binary.AsBinary().GetSize()));
+    }
+
+    const Variant value = binary.CastToBinary();
+
+    return Variant::MakeInt(static_cast<phi::int64_t>(value.AsBinary().GetSize()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/BinaryMid.htm
+Variant BuiltIn_BinaryMid(const VirtualMachine& /*vm*/, const Variant& binary,
+                          const Variant& start, const Variant& count)
+{
+    const Variant value = binary.CastToBinary();
+    const Binary& bytes = value.AsBinary();
+
+    // TODO: Set @error for a start less than 1
+    const phi::int64_t start_value = start.CastToInt64().AsInt64().unsafe();
+    if (start_value < 1)
+    {
+        return Variant::MakeBinary(Binary{});
+    }
+
+    // Default or a negative count returns everything from start to the end
+    const phi::int64_t count_value =
+            count.IsDefault() ? -1 : count.CastToInt64().AsInt64().unsafe();
+    const phi::size_t size =
+            count_value < 0 ? bytes.GetSize() : static_cast<phi::size_t>(count_value);
+
+    // NOTE: The slice shares the bytes of the original binary
+    return Variant::MakeBinary(bytes.Slice(static_cast<phi::size_t>(start_value - 1), size));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/BinaryToString.htm
+Variant BuiltIn_BinaryToString(const VirtualMachine& /*vm*/, const Variant& binary,
+                               const Variant& flag)
+{
+    const Variant          value = binary.CastToBinary();
+    const std::string_view bytes = value.AsBinary().GetBytes();
+
+    const phi::int64_t flag_value = flag.IsDefault() ? BinaryToStringANSI :
+                                                       flag.CastToInt64().AsInt64().unsafe();
+
+    switch (flag_value)
+    {
+        // NOTE: Strings are stored as UTF-8 so ANSI uses the bytes as is
+        case BinaryToStringANSI:
+            return Variant::MakeString(std::string{bytes});
+
+        // Invalid sequences are replaced so every string holds valid UTF-8
+        case BinaryToStringUTF8:
+            return Variant::MakeString(IsValidUTF8(bytes) ? std::string{bytes} :
+                                                            SanitizeUTF8(bytes));
+
+        case BinaryToStringUTF16LE:
+            return Variant::MakeString(ConvertUTF16ToUTF8(bytes, false));
+
+        case BinaryToStringUTF16BE:
+            return Variant::MakeString(ConvertUTF16ToUTF8(bytes, true));
+
+        // TODO: Set @error for invalid flags
+        default:
+            return Variant::MakeString("");
+    }
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/ChrW.htm
+Variant BuiltIn_ChrW(const VirtualMachine& /*vm*/, const Variant& code)
+{
+    const phi::int64_t code_value = code.CastToInt64().AsInt64().unsafe();
+
+    // TODO: Set @error to 1 for an invalid code
+    if (code_value < 0 || code_value > 0xFFFF)
+    {
+        return Variant::MakeString("");
+    }
+
+    // NOTE: Strings are stored as UTF-8 which can't hold unpaired surrogates
+    const auto         code_unit = static_cast<char32_t>(code_value);
+    const phi::boolean surrogate = code_unit >= 0xD800u && code_unit <= 0xDFFFu;
+    std::string        character;
+    AppendUTF8(character, surrogate ? ReplacementCharacter : code_unit);
+
+    return Variant::MakeString(phi::move(character));
+}
+
 // https://www.autoitscript.com/autoit3/docs/functions/ConsoleWrite.htm
 Variant BuiltIn_ConsoleWrite(VirtualMachine& vm, const Variant& input)
 {
-    const Variant value = input.CastToString();
-    PHI_ASSERT(value.IsString());
-
-    const std::string& output = value.AsString();
+    NumberBuffer           buffer;
+    Variant                converted;
+    const std::string_view output = ToStringView(input, buffer, converted);
 
     // Output to VM
     vm.Print(output);
@@ -31,10 +516,9 @@ Variant BuiltIn_ConsoleWrite(VirtualMachine& vm, const Variant& input)
 // https://www.autoitscript.com/autoit3/docs/functions/ConsoleWriteError.htm
 Variant BuiltIn_ConsoleWriteError(VirtualMachine& vm, const Variant& input)
 {
-    const Variant value = input.CastToString();
-    PHI_ASSERT(value.IsString());
-
-    const std::string& output = value.AsString();
+    NumberBuffer           buffer;
+    Variant                converted;
+    const std::string_view output = ToStringView(input, buffer, converted);
 
     // Output to VM
     vm.PrintError(output);
@@ -42,6 +526,905 @@ Variant BuiltIn_ConsoleWriteError(VirtualMachine& vm, const Variant& input)
     return Variant::MakeInt(static_cast<phi::int64_t>(output.size()));
 }
 
+// https://www.autoitscript.com/autoit3/docs/functions/DirGetSize.htm
+Variant BuiltIn_DirGetSize(VirtualMachine& vm, const Variant& path, const Variant& flag)
+{
+    const phi::int64_t flags     = flag.IsDefault() ? 0 : flag.CastToInt64().AsInt64().unsafe();
+    const phi::boolean recursive = (flags & DirGetSizeNoRecurse) == 0;
+    const Variant      directory = path.CastToString();
+
+    // Subdirectories are traversed in parallel
+    const phi::optional<DirectorySize> size = GetDirectorySize(
+            directory.AsString(), recursive, recursive ? &vm.GetThreadPool() : nullptr);
+    if (!size)
+    {
+        // TODO: Set @error to 1
+        return Variant::MakeInt(-1);
+    }
+
+    if ((flags & DirGetSizeExtended) == 0)
+    {
+        return Variant::MakeInt(static_cast<phi::int64_t>(size->size));
+    }
+
+    std::vector<Variant> elements;
+    elements.reserve(3u);
+    elements.push_back(Variant::MakeInt(static_cast<phi::int64_t>(size->size)));
+    elements.push_back(Variant::MakeInt(static_cast<phi::int64_t>(size->files)));
+    elements.push_back(Variant::MakeInt(static_cast<phi::int64_t>(size->directories)));
+
+    return MakeOneDimensionalArray(phi::move(elements));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileClose.htm
+Variant BuiltIn_FileClose(VirtualMachine& vm, const Variant& file)
+{
+    return Variant::MakeInt(vm.CloseFile(file.CastToInt64().AsInt64().unsafe()) ? 1 : 0);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileFindFirstFile.htm
+Variant BuiltIn_FileFindFirstFile(VirtualMachine& vm, const Variant& filename)
+{
+    const Variant pattern = filename.CastToString();
+
+    phi::optional<FileSearch> search = FileSearch::Open(pattern.AsString());
+    if (!search)
+    {
+        return Variant::MakeInt(-1);
+    }
+
+    return Variant::MakeInt(vm.AddFileSearch(phi::move(*search)));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileFindNextFile.htm
+Variant BuiltIn_FileFindNextFile(VirtualMachine& vm, const Variant& search,
+                                 const Variant& /*flag*/)
+{
+    const phi::optional<FileSearch&> handle =
+            vm.LookupFileSearch(search.CastToInt64().AsInt64().unsafe());
+    if (!handle)
+    {
+        // TODO: Set @error to 1
+        return Variant::MakeString("");
+    }
+
+    const phi::optional<FileSearch::Result> result = handle->Next();
+    if (!result)
+    {
+        // TODO: Set @error to 1
+        return Variant::MakeString("");
+    }
+
+    // TODO: Set @extended to 1 for directories and return the attributes with flag 1
+    return Variant::MakeString(std::string{result->name});
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileGetPos.htm
+Variant BuiltIn_FileGetPos(VirtualMachine& vm, const Variant& file)
+{
+    const phi::optional<File&> handle = vm.LookupFile(file.CastToInt64().AsInt64().unsafe());
+    if (!handle)
+    {
+        // TODO: Set @error
+        return Variant::MakeInt(0);
+    }
+
+    return Variant::MakeInt(static_cast<phi::int64_t>(handle->GetPosition()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileOpen.htm
+Variant BuiltIn_FileOpen(VirtualMachine& vm, const Variant& filename, const Variant& mode)
+{
+    const phi::int64_t flags = mode.IsDefault() ? 0 : mode.CastToInt64().AsInt64().unsafe();
+
+    // TODO: Support opening files for writing
+    if ((flags & (FileOpenAppend | FileOpenOverwrite)) != 0)
+    {
+        return Variant::MakeInt(-1);
+    }
+
+    const Variant path = filename.CastToString();
+
+    phi::optional<File> file = File::Open(path.AsString(), (flags & FileOpenBinary) != 0);
+    if (!file)
+    {
+        return Variant::MakeInt(-1);
+    }
+
+    return Variant::MakeInt(vm.AddFile(phi::move(*file)));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileRead.htm
+Variant BuiltIn_FileRead(VirtualMachine& vm, const Variant& file, const Variant& count)
+{
+    phi::optional<File>        temporary;
+    const phi::optional<File&> handle = GetFile(vm, file, temporary);
+    if (!handle)
+    {
+        // TODO: Set @error to 1
+        return Variant::MakeString("");
+    }
+
+    phi::optional<phi::size_t> characters;
+    if (!count.IsDefault())
+    {
+        if (const phi::int64_t value = count.CastToInt64().AsInt64().unsafe(); value >= 0)
+        {
+            characters = static_cast<phi::size_t>(value);
+        }
+    }
+
+    return MakeReadResult(*handle, handle->Read(characters));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileReadLine.htm
+Variant BuiltIn_FileReadLine(VirtualMachine& vm, const Variant& file, const Variant& line)
+{
+    phi::optional<File>        temporary;
+    const phi::optional<File&> handle = GetFile(vm, file, temporary);
+    if (!handle)
+    {
+        // TODO: Set @error to 1
+        return Variant::MakeString("");
+    }
+
+    const phi::int64_t number = line.IsDefault() ? 0 : line.CastToInt64().AsInt64().unsafe();
+    if (number == -1)
+    {
+        return MakeReadResult(*handle, handle->ReadLastLine());
+    }
+
+    if (number > 0)
+    {
+        return MakeReadResult(*handle, handle->ReadLine(static_cast<phi::size_t>(number)));
+    }
+
+    return MakeReadResult(*handle, handle->ReadLine());
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileReadToArray.htm
+Variant BuiltIn_FileReadToArray(VirtualMachine& vm, const Variant& file)
+{
+    phi::optional<File>        temporary;
+    const phi::optional<File&> handle = GetFile(vm, file, temporary);
+    if (!handle)
+    {
+        // TODO: Set @error to 1
+        return Variant::MakeString("");
+    }
+
+    // Mapped files are split right from the mapping
+    const phi::optional<std::string_view> content = handle->Read({});
+    if (!content)
+    {
+        // TODO: Set @error to 2
+        return Variant::MakeString("");
+    }
+
+    const phi::observer_ptr<ThreadPool> pool =
+            content->size() >= ParallelSplitThreshold ? &vm.GetThreadPool() : nullptr;
+
+    // TODO: Set @extended to the number of lines
+    phi::optional<Array> lines = Array::FromElements(SplitLines(*content, pool));
+    if (!lines)
+    {
+        // TODO: Error
+        return {};
+    }
+
+    return Variant::MakeArray(phi::move(*lines));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/FileSetPos.htm
+Variant BuiltIn_FileSetPos(VirtualMachine& vm, const Variant& file, const Variant& offset,
+                           const Variant& origin)
+{
+    const phi::optional<File&> handle = vm.LookupFile(file.CastToInt64().AsInt64().unsafe());
+    if (!handle)
+    {
+        return Variant::MakeBoolean(false);
+    }
+
+    FileOrigin file_origin{};
+    switch (origin.CastToInt64().AsInt64().unsafe())
+    {
+        case 0:
+            file_origin = FileOrigin::Begin;
+            break;
+        case 1:
+            file_origin = FileOrigin::Current;
+            break;
+        case 2:
+            file_origin = FileOrigin::End;
+            break;
+        default:
+            return Variant::MakeBoolean(false);
+    }
+
+    return Variant::MakeBoolean(
+            handle->SetPosition(offset.CastToInt64().AsInt64().unsafe(), file_origin));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/IsBinary.htm
+Variant BuiltIn_IsBinary(const VirtualMachine& /*vm*/, const Variant& input)
+{
+    return Variant::MakeInt(input.IsBinary() ? 1 : 0);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/IsMap.htm
+Variant BuiltIn_IsMap(const VirtualMachine& /*vm*/, const Variant& input)
+{
+    return Variant::MakeInt(input.IsMap() ? 1 : 0);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/MapAppend.htm
+Variant BuiltIn_MapAppend(VirtualMachine& /*vm*/, Variant& map, const Variant& value)
+{
+    // TODO: Set @error
+    if (!map.IsMap())
+    {
+        return Variant::MakeInt(0);
+    }
+
+    return Variant::MakeInt(map.AsMap().Append(value));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/MapExists.htm
+Variant BuiltIn_MapExists(const VirtualMachine& /*vm*/, const Variant& map, const Variant& key)
+{
+    // TODO: Set @error
+    if (!map.IsMap())
+    {
+        return Variant::MakeBoolean(false);
+    }
+
+    return Variant::MakeBoolean(map.AsMap().Contains(key));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/MapKeys.htm
+Variant BuiltIn_MapKeys(const VirtualMachine& /*vm*/, const Variant& map)
+{
+    // TODO: Set @error
+    if (!map.IsMap())
+    {
+        return {};
+    }
+
+    const Map& value = map.AsMap();
+
+    ArraySubscripts subscripts;
+    subscripts.count     = 1u;
+    subscripts.values[0] = value.GetSize();
+
+    Array keys;
+    const phi::boolean resized = keys.ReDim(subscripts);
+    PHI_ASSERT(resized);
+    PHI_UNUSED_VARIABLE(resized);
+
+    subscripts.values[0] = 0u;
+    for (const Map::Entry& entry : value.GetEntries())
+    {
+        if (entry.removed)
+        {
+            continue;
+        }
+
+        const phi::boolean stored = keys.SetElement(subscripts, entry.key);
+        PHI_ASSERT(stored);
+        PHI_UNUSED_VARIABLE(stored);
+
+        ++subscripts.values[0];
+    }
+
+    return Variant::MakeArray(phi::move(keys));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/MapRemove.htm
+Variant BuiltIn_MapRemove(VirtualMachine& /*vm*/, Variant& map, const Variant& key)
+{
+    // TODO: Set @error
+    if (!map.IsMap())
+    {
+        return Variant::MakeInt(0);
+    }
+
+    return Variant::MakeInt(map.AsMap().Remove(key) ? 1 : 0);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringAddCR.htm
+Variant BuiltIn_StringAddCR(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    const Variant value = string.CastToString();
+
+    return Variant::MakeString(StringAddCarriageReturns(value.AsString()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringFormat.htm
+Variant BuiltIn_StringFormat(VirtualMachine& vm, const FormatString& format,
+                             const std::vector<Variant>& arguments)
+{
+    // Format into the buffer of the virtual machine so only the result needs to be allocated
+    std::string& buffer = vm.GetFormatBuffer();
+    format.Format(arguments.data() + 1u, arguments.size() - 1u, buffer);
+
+    return Variant::MakeString(buffer);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringInStr.htm
+Variant BuiltIn_StringInStr(const VirtualMachine& /*vm*/, const Variant& string,
+                            const Variant& substring, const Variant& case_sense,
+                            const Variant& occurrence, const Variant& start, const Variant& count)
+{
+    const Variant          string_value    = string.CastToString();
+    const Variant          substring_value = substring.CastToString();
+    const std::string_view haystack        = string_value.AsString();
+
+    const phi::int64_t occurrence_value =
+            occurrence.IsDefault() ? 1 : occurrence.CastToInt64().AsInt64().unsafe();
+    // TODO: Set @error to 1 for an occurrence of zero
+    if (occurrence_value == 0)
+    {
+        return Variant::MakeInt(0);
+    }
+
+    const CharacterPositions positions{string_value};
+    const auto               length = static_cast<phi::int64_t>(positions.GetLength());
+
+    // Negative occurrences search from the right so start defaults to the end of the string
+    const phi::boolean backwards   = occurrence_value < 0;
+    const phi::int64_t start_value = start.IsDefault() ? (backwards ? length : 1) :
+                                                         start.CastToInt64().AsInt64().unsafe();
+    // TODO: Set @error to 1 for an invalid start
+    if (start_value < 1 || start_value > std::max(length, phi::int64_t{1}))
+    {
+        return Variant::MakeInt(0);
+    }
+
+    const phi::int64_t count_value =
+            count.IsDefault() ? length : count.CastToInt64().AsInt64().unsafe();
+    // TODO: Set @error to 2 for an invalid count
+    if (count_value < 0)
+    {
+        return Variant::MakeInt(0);
+    }
+
+    // Only the characters selected by start and count are searched
+    const phi::int64_t first = backwards ? std::max(start_value - count_value, phi::int64_t{0}) :
+                                           start_value - 1;
+    const phi::int64_t last =
+            backwards ? start_value : std::min(start_value - 1 + count_value, length);
+
+    const phi::size_t begin = positions.ToOffset(static_cast<phi::size_t>(first));
+    const phi::size_t end   = positions.ToOffset(static_cast<phi::size_t>(last));
+
+    const StringSearcher searcher{haystack.substr(begin, end - begin),
+                                  substring_value.AsString(), ToCaseSense(case_sense)};
+
+    // NOTE: Occurrences may overlap
+    phi::optional<StringSearcher::Match> match;
+    if (backwards)
+    {
+        phi::size_t match_end = end - begin;
+        for (phi::int64_t index{0}; index > occurrence_value; --index)
+        {
+            match = searcher.FindPrevious(match_end);
+            if (!match)
+            {
+                return Variant::MakeInt(0);
+            }
+            match_end = match->offset + match->size - 1u;
+        }
+    }
+    else
+    {
+        phi::size_t from{0u};
+        for (phi::int64_t index{0}; index < occurrence_value; ++index)
+        {
+            match = searcher.FindNext(from);
+            if (!match)
+            {
+                return Variant::MakeInt(0);
+            }
+            from = match->offset + 1u;
+        }
+    }
+
+    const phi::size_t index = positions.ToIndex(begin + match->offset);
+
+    return Variant::MakeInt(static_cast<phi::int64_t>(index) + 1);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsAlNum.htm
+Variant BuiltIn_StringIsAlNum(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::AlphaNumeric);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsAlpha.htm
+Variant BuiltIn_StringIsAlpha(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::Alpha);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsASCII.htm
+Variant BuiltIn_StringIsASCII(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::ASCII);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsDigit.htm
+Variant BuiltIn_StringIsDigit(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::Digit);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsLower.htm
+Variant BuiltIn_StringIsLower(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::Lower);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsSpace.htm
+Variant BuiltIn_StringIsSpace(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::Space);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsUpper.htm
+Variant BuiltIn_StringIsUpper(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::Upper);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringIsXDigit.htm
+Variant BuiltIn_StringIsXDigit(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    return StringIs(string, CharacterClass::HexDigit);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringLeft.htm
+Variant BuiltIn_StringLeft(const VirtualMachine& /*vm*/, const Variant& string,
+                           const Variant& count)
+{
+    const Variant      value       = string.CastToString();
+    const phi::int64_t count_value = count.CastToInt64().AsInt64().unsafe();
+    if (count_value <= 0)
+    {
+        return Variant::MakeString("");
+    }
+
+    return MakeSubstring(value, 0u, static_cast<phi::size_t>(count_value));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringLen.htm
+Variant BuiltIn_StringLen(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    const Variant value = string.CastToString();
+
+    return Variant::MakeInt(static_cast<phi::int64_t>(value.GetUTF16Index().GetLength()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringLower.htm
+Variant BuiltIn_StringLower(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    const Variant value = string.CastToString();
+
+    return Variant::MakeString(StringToLowerCase(value.AsString()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringMid.htm
+Variant BuiltIn_StringMid(const VirtualMachine& /*vm*/, const Variant& string, const Variant& start,
+                          const Variant& count)
+{
+    const Variant      value       = string.CastToString();
+    const phi::int64_t start_value = start.CastToInt64().AsInt64().unsafe();
+    const phi::int64_t count_value =
+            count.IsDefault() ? -1 : count.CastToInt64().AsInt64().unsafe();
+    if (start_value < 1)
+    {
+        return Variant::MakeString("");
+    }
+
+    // A negative count returns the rest of the string
+    const phi::size_t count_characters = count_value < 0 ?
+                                                 std::numeric_limits<phi::size_t>::max() :
+                                                 static_cast<phi::size_t>(count_value);
+
+    return MakeSubstring(value, static_cast<phi::size_t>(start_value) - 1u, count_characters);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringRegExp.htm
+Variant BuiltIn_StringRegExp(const VirtualMachine& /*vm*/, const Variant& string,
+                             const Regex* regex, const Variant& flag, const Variant& offset)
+{
+    const phi::int64_t flag_value =
+            flag.IsDefault() ? RegExpMatch : flag.CastToInt64().AsInt64().unsafe();
+
+    // TODO: Set @error to 2 and @extended to the offset of the error in the pattern
+    if (regex == nullptr)
+    {
+        return flag_value == RegExpMatch ? Variant::MakeInt(0) : Variant::MakeString("");
+    }
+
+    const Variant          string_value = string.CastToString();
+    const std::string_view subject      = string_value.AsString();
+
+    const phi::int64_t offset_value =
+            offset.IsDefault() ? 1 : offset.CastToInt64().AsInt64().unsafe();
+    const phi::size_t start = CharacterPositions{string_value}.ToOffset(
+            static_cast<phi::size_t>(std::max(offset_value, phi::int64_t{1})) - 1u);
+
+    if (flag_value == RegExpMatch)
+    {
+        return Variant::MakeInt(regex->IsMatch(subject, start) ? 1 : 0);
+    }
+
+    const phi::size_t group_count = regex->GetGroupCount();
+
+    Regex::Captures      captures;
+    std::vector<Variant> elements;
+
+    switch (flag_value)
+    {
+        case RegExpArrayMatch:
+        case RegExpArrayFullMatch: {
+            // TODO: Set @error to 1
+            if (!regex->Search(subject, start, captures))
+            {
+                return Variant::MakeString("");
+            }
+
+            // Without any groups the first flag returns the whole match instead
+            const phi::size_t first_group =
+                    flag_value == RegExpArrayMatch && group_count > 0u ? 1u : 0u;
+            for (phi::size_t group{first_group}; group <= group_count; ++group)
+            {
+                AppendGroup(elements, subject, captures, group);
+            }
+            break;
+        }
+
+        case RegExpArrayGlobalMatch:
+        case RegExpArrayGlobalFullMatch: {
+            // Every match continues where the previous one ended so the subject is scanned once
+            for (phi::size_t position{start};
+                 position <= subject.size() && regex->Search(subject, position, captures);
+                 position = NextSearchOffset(subject, captures))
+            {
+                if (flag_value == RegExpArrayGlobalMatch)
+                {
+                    for (phi::size_t group{group_count > 0u ? 1u : 0u}; group <= group_count;
+                         ++group)
+                    {
+                        AppendGroup(elements, subject, captures, group);
+                    }
+                    continue;
+                }
+
+                std::vector<Variant> match;
+                for (phi::size_t group{0u}; group <= group_count; ++group)
+                {
+                    AppendGroup(match, subject, captures, group);
+                }
+                elements.push_back(MakeOneDimensionalArray(phi::move(match)));
+            }
+
+            // TODO: Set @error to 1
+            if (elements.empty())
+            {
+                return Variant::MakeString("");
+            }
+            break;
+        }
+
+        default:
+            // TODO: Set @error to 3
+            return Variant::MakeString("");
+    }
+
+    return MakeOneDimensionalArray(phi::move(elements));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringRegExpReplace.htm
+Variant BuiltIn_StringRegExpReplace(const VirtualMachine& /*vm*/, const Variant& string,
+                                    const Regex* regex, const Variant& replace,
+                                    const Variant& count)
+{
+    const Variant string_value = string.CastToString();
+
+    // TODO: Set @error to 2 and @extended to the offset of the error in the pattern
+    if (regex == nullptr)
+    {
+        return string_value;
+    }
+
+    const Variant          replace_value = replace.CastToString();
+    const std::string_view subject       = string_value.AsString();
+
+    const std::vector<ReplacementPart> parts =
+            ParseReplacement(replace_value.AsString(), regex->GetGroupCount());
+
+    // Zero or less replaces every match
+    // TODO: Set @extended to the number of replacements
+    const phi::int64_t count_value = count.IsDefault() ? 0 : count.CastToInt64().AsInt64().unsafe();
+    const phi::size_t  limit       = count_value <= 0 ? subject.size() + 1u :
+                                                        static_cast<phi::size_t>(count_value);
+
+    std::string     result;
+    phi::size_t     copied{0u};
+    phi::size_t     replaced{0u};
+    Regex::Captures captures;
+
+    for (phi::size_t position{0u}; replaced < limit && position <= subject.size() &&
+                                   regex->Search(subject, position, captures);
+         position = NextSearchOffset(subject, captures), ++replaced)
+    {
+        result.append(subject.substr(copied, captures[0u] - copied));
+        for (const ReplacementPart& part : parts)
+        {
+            if (part.group == Regex::NoMatch)
+            {
+                result.append(part.text);
+            }
+            else if (captures[part.group * 2u] != Regex::NoMatch)
+            {
+                result.append(subject.substr(captures[part.group * 2u],
+                                             captures[part.group * 2u + 1u] -
+                                                     captures[part.group * 2u]));
+            }
+        }
+
+        copied = captures[1u];
+    }
+
+    if (replaced == 0u)
+    {
+        return string_value;
+    }
+
+    result.append(subject.substr(copied));
+    return Variant::MakeString(phi::move(result));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringReplace.htm
+Variant BuiltIn_StringReplace(const VirtualMachine& /*vm*/, const Variant& string,
+                              const Variant& search, const Variant& replace,
+                              const Variant& occurrence, const Variant& case_sense)
+{
+    const Variant          string_value  = string.CastToString();
+    const Variant          replace_value = replace.CastToString();
+    const std::string_view haystack      = string_value.AsString();
+    const std::string_view replacement   = replace_value.AsString();
+
+    // A number replaces the characters starting at that position with the replacement
+    // TODO: Set @extended to the number of replaced characters
+    if (search.IsNumeric())
+    {
+        const CharacterPositions positions{string_value};
+        const phi::int64_t       start_value = search.CastToInt64().AsInt64().unsafe();
+        if (start_value < 1 || static_cast<phi::size_t>(start_value) > positions.GetLength())
+        {
+            return string_value;
+        }
+
+        const phi::size_t start_index = static_cast<phi::size_t>(start_value) - 1u;
+        const phi::size_t begin       = positions.ToOffset(start_index);
+        const phi::size_t end = positions.ToOffset(start_index + CountUTF16CodeUnits(replacement));
+
+        std::string result;
+        result.reserve(haystack.size() - (end - begin) + replacement.size());
+        result.append(haystack.substr(0u, begin));
+        result.append(replacement);
+        result.append(haystack.substr(end));
+
+        return Variant::MakeString(phi::move(result));
+    }
+
+    const Variant search_value = search.CastToString();
+
+    // Zero replaces every occurrence and negative occurrences replace from the right
+    const phi::int64_t occurrence_value =
+            occurrence.IsDefault() ? 0 : occurrence.CastToInt64().AsInt64().unsafe();
+    const phi::boolean backwards = occurrence_value < 0;
+    const phi::size_t  limit =
+            occurrence_value == 0 ? haystack.size() + 1u :
+            backwards             ? static_cast<phi::size_t>(-(occurrence_value + 1)) + 1u :
+                                    static_cast<phi::size_t>(occurrence_value);
+
+    const StringSearcher searcher{haystack, search_value.AsString(), ToCaseSense(case_sense)};
+
+    // Count the matches first so the result can be allocated once
+    // TODO: Set @extended to the number of replacements
+    phi::size_t replacements{0u};
+    phi::size_t matched_size{0u};
+    for (phi::size_t position = backwards ? haystack.size() : 0u; replacements < limit;
+         ++replacements)
+    {
+        const phi::optional<StringSearcher::Match> match =
+                backwards ? searcher.FindPrevious(position) : searcher.FindNext(position);
+        if (!match)
+        {
+            break;
+        }
+
+        matched_size += match->size;
+        position = backwards ? match->offset : match->offset + match->size;
+    }
+
+    if (replacements == 0u)
+    {
+        return string_value;
+    }
+
+    std::string result;
+    result.resize(haystack.size() - matched_size + replacements * replacement.size());
+
+    if (backwards)
+    {
+        // Fill the result from its end while walking the matches from the right
+        phi::size_t position = haystack.size();
+        phi::size_t output   = result.size();
+        for (phi::size_t index{0u}; index < replacements; ++index)
+        {
+            const StringSearcher::Match match = searcher.FindPrevious(position).value();
+            const phi::size_t           tail  = position - (match.offset + match.size);
+
+            output -= tail;
+            haystack.copy(result.data() + output, tail, match.offset + match.size);
+            output -= replacement.size();
+            replacement.copy(result.data() + output, replacement.size());
+
+            position = match.offset;
+        }
+        haystack.copy(result.data(), position);
+    }
+    else
+    {
+        phi::size_t position{0u};
+        phi::size_t output{0u};
+        for (phi::size_t index{0u}; index < replacements; ++index)
+        {
+            const StringSearcher::Match match = searcher.FindNext(position).value();
+
+            output += haystack.copy(result.data() + output, match.offset - position, position);
+            output += replacement.copy(result.data() + output, replacement.size());
+
+            position = match.offset + match.size;
+        }
+        haystack.copy(result.data() + output, haystack.size() - position, position);
+    }
+
+    return Variant::MakeString(phi::move(result));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringRight.htm
+Variant BuiltIn_StringRight(const VirtualMachine& /*vm*/, const Variant& string,
+                            const Variant& count)
+{
+    const Variant      value       = string.CastToString();
+    const phi::int64_t count_value = count.CastToInt64().AsInt64().unsafe();
+    if (count_value <= 0)
+    {
+        return Variant::MakeString("");
+    }
+
+    const phi::size_t length           = value.GetUTF16Index().GetLength();
+    const phi::size_t count_characters = std::min(static_cast<phi::size_t>(count_value), length);
+
+    return MakeSubstring(value, length - count_characters, count_characters);
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringSplit.htm
+Variant BuiltIn_StringSplit(const VirtualMachine& /*vm*/, const Variant& string,
+                            const Variant& delimiters, const Variant& flag)
+{
+    const Variant      string_value     = string.CastToString();
+    const Variant      delimiters_value = delimiters.CastToString();
+    const phi::int64_t flag_value = flag.IsDefault() ? 0 : flag.CastToInt64().AsInt64().unsafe();
+
+    const phi::boolean no_count = (flag_value & StringSplitNoCount) != 0;
+
+    StringSplitter splitter{string_value.AsString(), delimiters_value.AsString(),
+                            (flag_value & StringSplitEntireDelimiter) != 0};
+
+    // Count the fields first so the array is allocated once at its final size
+    // TODO: Set @error to 1 if no delimiter was found
+    const phi::size_t field_count = splitter.CountFields();
+    const phi::size_t first_field = no_count ? 0u : 1u;
+
+    ArraySubscripts subscripts;
+    subscripts.count     = 1u;
+    subscripts.values[0] = first_field + field_count;
+
+    Array fields;
+    if (!fields.ReDim(subscripts))
+    {
+        // TODO: Error
+        return {};
+    }
+
+    subscripts.values[0] = 0u;
+    if (!no_count)
+    {
+        const auto         count  = static_cast<phi::int64_t>(field_count);
+        const phi::boolean stored = fields.SetElement(subscripts, Variant::MakeInt(count));
+        PHI_ASSERT(stored);
+        PHI_UNUSED_VARIABLE(stored);
+    }
+
+    for (subscripts.values[0] = first_field; const auto field = splitter.NextField();
+         ++subscripts.values[0])
+    {
+        const phi::boolean stored = fields.SetElement(subscripts, Variant::MakeString(*field));
+        PHI_ASSERT(stored);
+        PHI_UNUSED_VARIABLE(stored);
+    }
+
+    return Variant::MakeArray(phi::move(fields));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringStripCR.htm
+Variant BuiltIn_StringStripCR(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    const Variant value = string.CastToString();
+
+    return Variant::MakeString(StringStripCarriageReturns(value.AsString()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringStripWS.htm
+Variant BuiltIn_StringStripWS(const VirtualMachine& /*vm*/, const Variant& string,
+                              const Variant& flag)
+{
+    const Variant value = string.CastToString();
+
+    return Variant::MakeString(
+            StringStripWhitespace(value.AsString(), flag.CastToInt64().AsInt64().unsafe()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringUpper.htm
+Variant BuiltIn_StringUpper(const VirtualMachine& /*vm*/, const Variant& string)
+{
+    const Variant value = string.CastToString();
+
+    return Variant::MakeString(StringToUpperCase(value.AsString()));
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/UBound.htm
+Variant BuiltIn_UBound(const VirtualMachine& /*vm*/, const Variant& array, const Variant& dimension)
+{
+    // For maps this is the number of elements
+    if (array.IsMap())
+    {
+        return Variant::MakeInt(static_cast<phi::int64_t>(array.AsMap().GetSize()));
+    }
+
+    // TODO: Set @error for non arrays and invalid dimensions
+    if (!array.IsArray())
+    {
+        return Variant::MakeInt(0);
+    }
+
+    const Array& value = array.AsArray();
+
+    const phi::int64_t dimension_index = dimension.CastToInt64().AsInt64().unsafe();
+
+    // Dimension 0 returns the number of dimensions
+    if (dimension_index == 0)
+    {
+        return Variant::MakeInt(static_cast<phi::int64_t>(value.GetDimensionCount()));
+    }
+
+    if (dimension_index < 0 ||
+        static_cast<phi::size_t>(dimension_index) > value.GetDimensionCount())
+    {
+        return Variant::MakeInt(0);
+    }
+
+    const phi::size_t size = value.GetDimension(static_cast<phi::size_t>(dimension_index) - 1u);
+
+    return Variant::MakeInt(static_cast<phi::int64_t>(size));
+}
+
 // https://www.autoitscript.com/autoit3/docs/functions/VarGetType.htm
 Variant BuiltIn_VarGetType(const VirtualMachine& /*vm*/, const Variant& input)
 {
@@ -51,10 +1434,9 @@ Variant BuiltIn_VarGetType(const VirtualMachine& /*vm*/, const Variant& input)
 // OpenAutoIt extension
 Variant BuiltIn_ConsoleWriteLine(VirtualMachine& vm, const Variant& input)
 {
-    const Variant value = input.CastToString();
-    PHI_ASSERT(value.IsString());
-
-    const std::string& output = value.AsString();
+    NumberBuffer           buffer;
+    Variant                converted;
+    const std::string_view output = ToStringView(input, buffer, converted);
 
     // Output to VM
     vm.Print(output);
@@ -65,10 +1447,9 @@ Variant BuiltIn_ConsoleWriteLine(VirtualMachine& vm, const Variant& input)
 // OpenAutoIt extension
 Variant BuiltIn_ConsoleWriteErrorLine(VirtualMachine& vm, const Variant& input)
 {
-    const Variant value = input.CastToString();
-    PHI_ASSERT(value.IsString());
-
-    const std::string& output = value.AsString();
+    NumberBuffer           buffer;
+    Variant                converted;
+    const std::string_view output = ToStringView(input, buffer, converted);
 
     // Output to VM
     vm.PrintError(output);
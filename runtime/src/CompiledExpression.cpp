@@ -0,0 +1,446 @@
+#include "OpenAutoIt/CompiledExpression.hpp"
+
+#include "OpenAutoIt/AST/ASTBinaryExpression.hpp"
+#include "OpenAutoIt/AST/ASTExpression.hpp"
+#include "OpenAutoIt/AST/ASTFloatLiteral.hpp"
+#include "OpenAutoIt/AST/ASTIntegerLiteral.hpp"
+#include "OpenAutoIt/AST/ASTNode.hpp"
+#include "OpenAutoIt/AST/ASTUnaryExpression.hpp"
+#include "OpenAutoIt/AST/ASTVariableExpression.hpp"
+#include "OpenAutoIt/Arithmetic.hpp"
+#include "OpenAutoIt/TokenKind.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/move.hpp>
+#include <limits>
+#include <string_view>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace OpenAutoIt
+{
+namespace
+{
+    [[nodiscard]] Number MakeBooleanNumber(const phi::boolean value)
+    {
+        return Number::MakeInt(value ? 1 : 0);
+    }
+
+    // Same as Variant::CastToBoolean
+    [[nodiscard]] phi::boolean IsTrue(const Number value)
+    {
+        return value.is_double ? value.floating_point != 0.0 : value.int64 != 0;
+    }
+
+    // Pops the right hand side and returns its ordering relative to the left hand side
+    [[nodiscard]] Ordering PopAndCompare(Number* stack, phi::size_t& stack_size)
+    {
+        PHI_ASSERT(stack_size >= 2u);
+        --stack_size;
+
+        return CompareNumbers(stack[stack_size - 1u], stack[stack_size]);
+    }
+} // namespace
+
+phi::optional<CompiledExpression> CompiledExpression::Compile(
+        phi::not_null_observer_ptr<const ASTExpression> expression)
+{
+    CompiledExpression compiled;
+
+    if (!compiled.CompileNode(expression, 1u, compiled.m_ResultKind))
+    {
+        return {};
+    }
+
+    compiled.m_Variables.resize(compiled.m_VariableNames.size());
+
+    return phi::move(compiled);
+}
+
+phi::boolean CompiledExpression::CompileNode(
+        phi::not_null_observer_ptr<const ASTExpression> expression, phi::size_t depth,
+        ValueKind& kind)
+{
+    // Execution uses a fixed size stack
+    if (depth > MaxStackDepth)
+    {
+        return false;
+    }
+
+    kind = ValueKind::Number;
+
+    switch (expression->NodeType())
+    {
+        case ASTNodeType::IntegerLiteral: {
+            Instruction instruction{OpCode::PushInt64};
+            instruction.int64 = expression->as<ASTIntegerLiteral>()->m_Value.unsafe();
+
+            m_Instructions.emplace_back(instruction);
+            return true;
+        }
+
+        case ASTNodeType::FloatLiteral: {
+            Instruction instruction{OpCode::PushDouble};
+            instruction.floating_point = expression->as<ASTFloatLiteral>()->m_Value.unsafe();
+
+            m_Instructions.emplace_back(instruction);
+            return true;
+        }
+
+        case ASTNodeType::VariableExpression: {
+            const phi::string_view variable_name =
+                    expression->as<ASTVariableExpression>()->m_VariableName;
+
+            Instruction instruction{OpCode::LoadVariable};
+            instruction.operand = GetVariableSlot(std::string_view(variable_name));
+
+            m_Instructions.emplace_back(instruction);
+            return true;
+        }
+
+        case ASTNodeType::UnaryExpression: {
+            const auto unary_expression = expression->as<ASTUnaryExpression>();
+
+            ValueKind operand_kind{};
+            if (!CompileNode(unary_expression->m_Expression.not_null_observer(), depth,
+                             operand_kind))
+            {
+                return false;
+            }
+
+            switch (unary_expression->m_Operator)
+            {
+                // NOTE: Unary plus returns its operand as is so booleans stay booleans
+                case TokenKind::OP_Plus:
+                    kind = operand_kind;
+                    return true;
+
+                case TokenKind::OP_Minus:
+                    if (operand_kind != ValueKind::Number)
+                    {
+                        return false;
+                    }
+
+                    m_Instructions.emplace_back(Instruction{OpCode::Negate});
+                    return true;
+
+                default:
+                    return false;
+            }
+        }
+
+        case ASTNodeType::BinaryExpression: {
+            const auto binary_expression = expression->as<ASTBinaryExpression>();
+
+            ValueKind lhs_kind{};
+            ValueKind rhs_kind{};
+
+            // And/Or only evaluate their right hand side if it decides the result
+            if (binary_expression->m_Operator == TokenKind::KW_And ||
+                binary_expression->m_Operator == TokenKind::KW_Or)
+            {
+                if (!CompileNode(binary_expression->m_LHS.not_null_observer(), depth, lhs_kind))
+                {
+                    return false;
+                }
+
+                const phi::size_t jump_index = m_Instructions.size();
+                m_Instructions.emplace_back(Instruction{
+                        binary_expression->m_Operator == TokenKind::KW_And ? OpCode::JumpIfFalse :
+                                                                             OpCode::JumpIfTrue});
+
+                // The left hand side was popped when we get here
+                if (!CompileNode(binary_expression->m_RHS.not_null_observer(), depth, rhs_kind))
+                {
+                    return false;
+                }
+
+                m_Instructions.emplace_back(Instruction{OpCode::ToBoolean});
+                m_Instructions[jump_index].operand = m_Instructions.size();
+
+                kind = ValueKind::Boolean;
+                return true;
+            }
+
+            OpCode op_code{};
+            switch (binary_expression->m_Operator)
+            {
+                case TokenKind::OP_Plus:
+                    op_code = OpCode::Add;
+                    break;
+                case TokenKind::OP_Minus:
+                    op_code = OpCode::Subtract;
+                    break;
+                case TokenKind::OP_Multiply:
+                    op_code = OpCode::Multiply;
+                    break;
+                case TokenKind::OP_Divide:
+                    op_code = OpCode::Divide;
+                    break;
+                case TokenKind::OP_Raise:
+                    op_code = OpCode::Power;
+                    break;
+
+                // NOTE: '==' compares the string representations so it isn't supported
+                case TokenKind::OP_Equals:
+                    op_code = OpCode::Equal;
+                    kind    = ValueKind::Boolean;
+                    break;
+                case TokenKind::OP_NotEqual:
+                    op_code = OpCode::NotEqual;
+                    kind    = ValueKind::Boolean;
+                    break;
+                case TokenKind::OP_LessThan:
+                    op_code = OpCode::LessThan;
+                    kind    = ValueKind::Boolean;
+                    break;
+                case TokenKind::OP_LessThanEqual:
+                    op_code = OpCode::LessThanEqual;
+                    kind    = ValueKind::Boolean;
+                    break;
+                case TokenKind::OP_GreaterThan:
+                    op_code = OpCode::GreaterThan;
+                    kind    = ValueKind::Boolean;
+                    break;
+                case TokenKind::OP_GreaterThanEqual:
+                    op_code = OpCode::GreaterThanEqual;
+                    kind    = ValueKind::Boolean;
+                    break;
+
+                default:
+                    return false;
+            }
+
+            // The left hand side stays on the stack while the right hand side is evaluated.
+            // Booleans behave differently from numbers in arithmetic and comparisons so they
+            // aren't supported as operands.
+            const ValueKind result_kind = kind;
+            if (!CompileNode(binary_expression->m_LHS.not_null_observer(), depth, lhs_kind) ||
+                !CompileNode(binary_expression->m_RHS.not_null_observer(), depth + 1u, rhs_kind) ||
+                lhs_kind != ValueKind::Number || rhs_kind != ValueKind::Number)
+            {
+                return false;
+            }
+
+            m_Instructions.emplace_back(Instruction{op_code});
+            kind = result_kind;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+phi::size_t CompiledExpression::GetVariableSlot(const std::string_view variable_name)
+{
+    for (phi::size_t slot{0u}; slot < m_VariableNames.size(); ++slot)
+    {
+        if (m_VariableNames[slot] == variable_name)
+        {
+            return slot;
+        }
+    }
+
+    m_VariableNames.emplace_back(variable_name);
+    return m_VariableNames.size() - 1u;
+}
+
+void CompiledExpression::ResolveVariables(const VirtualMachine& vm)
+{
+    for (phi::size_t slot{0u}; slot < m_VariableNames.size(); ++slot)
+    {
+        const auto variable = vm.LookupVariableRefByName(m_VariableNames[slot]);
+
+        m_Variables[slot] = variable ? &variable.value() : nullptr;
+    }
+
+    m_ResolvedVersion = vm.GetVariableLayoutVersion();
+}
+
+phi::boolean CompiledExpression::Execute(const VirtualMachine& vm, Variant& result)
+{
+    // Guard for the resolved variables
+    if (m_ResolvedVersion != vm.GetVariableLayoutVersion())
+    {
+        ResolveVariables(vm);
+    }
+
+    Number      stack[MaxStackDepth];
+    phi::size_t stack_size{0u};
+
+    phi::size_t index{0u};
+    while (index < m_Instructions.size())
+    {
+        const Instruction& instruction = m_Instructions[index++];
+
+        switch (instruction.op_code)
+        {
+            case OpCode::PushInt64:
+                stack[stack_size++] = Number::MakeInt(instruction.int64);
+                break;
+
+            case OpCode::PushDouble:
+                stack[stack_size++] = Number::MakeDouble(instruction.floating_point);
+                break;
+
+            case OpCode::LoadVariable: {
+                const phi::observer_ptr<const Variant> variable = m_Variables[instruction.operand];
+
+                // Type guard
+                if (!variable)
+                {
+                    return false;
+                }
+
+                if (variable->IsInt64())
+                {
+                    stack[stack_size++] = Number::MakeInt(variable->AsInt64().unsafe());
+                }
+                else if (variable->IsDouble())
+                {
+                    stack[stack_size++] = Number::MakeDouble(variable->AsDouble().unsafe());
+                }
+                else
+                {
+                    return false;
+                }
+                break;
+            }
+
+            case OpCode::Negate: {
+                PHI_ASSERT(stack_size >= 1u);
+                Number& value = stack[stack_size - 1u];
+
+                if (value.is_double)
+                {
+                    value.floating_point = -value.floating_point;
+                }
+                // Leave the wrapping behavior of the minimum value to the interpreter
+                else if (value.int64 == std::numeric_limits<phi::int64_t>::min())
+                {
+                    return false;
+                }
+                else
+                {
+                    value.int64 = -value.int64;
+                }
+                break;
+            }
+
+            case OpCode::Add:
+                PHI_ASSERT(stack_size >= 2u);
+                --stack_size;
+                stack[stack_size - 1u] = ArithmeticNumber<ArithmeticOperation::Add>(
+                        stack[stack_size - 1u], stack[stack_size]);
+                break;
+
+            case OpCode::Subtract:
+                PHI_ASSERT(stack_size >= 2u);
+                --stack_size;
+                stack[stack_size - 1u] = ArithmeticNumber<ArithmeticOperation::Subtract>(
+                        stack[stack_size - 1u], stack[stack_size]);
+                break;
+
+            case OpCode::Multiply:
+                PHI_ASSERT(stack_size >= 2u);
+                --stack_size;
+                stack[stack_size - 1u] = ArithmeticNumber<ArithmeticOperation::Multiply>(
+                        stack[stack_size - 1u], stack[stack_size]);
+                break;
+
+            case OpCode::Divide:
+                PHI_ASSERT(stack_size >= 2u);
+                --stack_size;
+                stack[stack_size - 1u] = ArithmeticNumber<ArithmeticOperation::Divide>(
+                        stack[stack_size - 1u], stack[stack_size]);
+                break;
+
+            case OpCode::Power:
+                PHI_ASSERT(stack_size >= 2u);
+                --stack_size;
+                stack[stack_size - 1u] = ArithmeticNumber<ArithmeticOperation::Power>(
+                        stack[stack_size - 1u], stack[stack_size]);
+                break;
+
+            case OpCode::Equal: {
+                const Ordering ordering = PopAndCompare(stack, stack_size);
+                stack[stack_size - 1u]  = MakeBooleanNumber(ordering == Ordering::Equal);
+                break;
+            }
+
+            case OpCode::NotEqual: {
+                const Ordering ordering = PopAndCompare(stack, stack_size);
+                stack[stack_size - 1u]  = MakeBooleanNumber(ordering != Ordering::Equal);
+                break;
+            }
+
+            case OpCode::LessThan: {
+                const Ordering ordering = PopAndCompare(stack, stack_size);
+                stack[stack_size - 1u]  = MakeBooleanNumber(ordering == Ordering::Less);
+                break;
+            }
+
+            case OpCode::LessThanEqual: {
+                const Ordering ordering = PopAndCompare(stack, stack_size);
+                stack[stack_size - 1u]  = MakeBooleanNumber(ordering == Ordering::Less ||
+                                                            ordering == Ordering::Equal);
+                break;
+            }
+
+            case OpCode::GreaterThan: {
+                const Ordering ordering = PopAndCompare(stack, stack_size);
+                stack[stack_size - 1u]  = MakeBooleanNumber(ordering == Ordering::Greater);
+                break;
+            }
+
+            case OpCode::GreaterThanEqual: {
+                const Ordering ordering = PopAndCompare(stack, stack_size);
+                stack[stack_size - 1u]  = MakeBooleanNumber(ordering == Ordering::Greater ||
+                                                            ordering == Ordering::Equal);
+                break;
+            }
+
+            case OpCode::JumpIfFalse:
+            case OpCode::JumpIfTrue: {
+                PHI_ASSERT(stack_size >= 1u);
+                const phi::boolean value = IsTrue(stack[stack_size - 1u]);
+
+                if (value == (instruction.op_code == OpCode::JumpIfTrue))
+                {
+                    stack[stack_size - 1u] = MakeBooleanNumber(value);
+                    index                  = instruction.operand;
+                }
+                else
+                {
+                    --stack_size;
+                }
+                break;
+            }
+
+            case OpCode::ToBoolean:
+                PHI_ASSERT(stack_size >= 1u);
+                stack[stack_size - 1u] = MakeBooleanNumber(IsTrue(stack[stack_size - 1u]));
+                break;
+        }
+    }
+
+    PHI_ASSERT(stack_size == 1u);
+    const Number& value = stack[0u];
+
+    if (m_ResultKind == ValueKind::Boolean)
+    {
+        result = Variant::MakeBoolean(value.int64 != 0);
+    }
+    else if (value.is_double)
+    {
+        result = Variant::MakeDouble(value.floating_point);
+    }
+    else
+    {
+        result = Variant::MakeInt(value.int64);
+    }
+
+    return true;
+}
+} // namespace OpenAutoIt
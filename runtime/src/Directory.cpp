@@ -0,0 +1,481 @@
+#include "OpenAutoIt/Directory.hpp"
+
+#include "OpenAutoIt/ThreadPool.hpp"
+#include "OpenAutoIt/Wildcard.hpp"
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+#if PHI_PLATFORM_IS(LINUX)
+#    include <dirent.h>
+#    include <fcntl.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#else
+#    include <filesystem>
+#endif
+
+namespace OpenAutoIt
+{
+namespace
+{
+#if PHI_PLATFORM_IS(WINDOWS)
+    constexpr const std::string_view PathSeparators{"/\\"};
+#else
+    constexpr const std::string_view PathSeparators{"/"};
+#endif
+
+    [[nodiscard]] std::string JoinPath(const std::string& directory, const std::string_view name)
+    {
+        std::string path;
+        path.reserve(directory.size() + 1u + name.size());
+        path += directory;
+        if (!directory.empty() && PathSeparators.find(directory.back()) == PathSeparators.npos)
+        {
+            path += '/';
+        }
+        path += name;
+
+        return path;
+    }
+
+#if PHI_PLATFORM_IS(LINUX)
+    // Layout of the records written by getdents64
+    struct LinuxDirectoryEntry
+    {
+        std::uint64_t  inode;
+        std::int64_t   offset;
+        unsigned short record_length;
+        unsigned char  type;
+        char           name[1];
+    };
+
+    [[nodiscard]] EntryType ToEntryType(const unsigned char type)
+    {
+        switch (type)
+        {
+            case DT_REG:
+                return EntryType::File;
+            case DT_DIR:
+                return EntryType::Directory;
+            case DT_LNK:
+                return EntryType::SymbolicLink;
+            case DT_UNKNOWN:
+                return EntryType::Unknown;
+            default:
+                return EntryType::Other;
+        }
+    }
+
+    [[nodiscard]] EntryType ToEntryType(const mode_t mode)
+    {
+        if (S_ISREG(mode))
+        {
+            return EntryType::File;
+        }
+        if (S_ISDIR(mode))
+        {
+            return EntryType::Directory;
+        }
+        if (S_ISLNK(mode))
+        {
+            return EntryType::SymbolicLink;
+        }
+
+        return EntryType::Other;
+    }
+#else
+    [[nodiscard]] EntryType ToEntryType(const std::filesystem::file_type type)
+    {
+        switch (type)
+        {
+            case std::filesystem::file_type::regular:
+                return EntryType::File;
+            case std::filesystem::file_type::directory:
+                return EntryType::Directory;
+            case std::filesystem::file_type::symlink:
+                return EntryType::SymbolicLink;
+            case std::filesystem::file_type::none:
+            case std::filesystem::file_type::not_found:
+            case std::filesystem::file_type::unknown:
+                return EntryType::Unknown;
+            default:
+                return EntryType::Other;
+        }
+    }
+#endif
+
+    // Resolves the type with a stat call if the file system didn't report it
+    [[nodiscard]] phi::optional<EntryType> ResolveType(const DirectoryReader& reader,
+                                                       const DirectoryEntry&  entry)
+    {
+        if (entry.type != EntryType::Unknown)
+        {
+            return entry.type;
+        }
+
+        const phi::optional<EntryStatus> status = reader.GetStatus(entry);
+        if (!status)
+        {
+            return {};
+        }
+
+        return status->type;
+    }
+
+    // State shared by all tasks of one GetDirectorySize call
+    struct DirectoryTraversal
+    {
+        std::atomic<phi::uint64_t> size{0u};
+        std::atomic<phi::uint64_t> files{0u};
+        std::atomic<phi::uint64_t> directories{0u};
+
+        phi::boolean                  recursive{true};
+        phi::observer_ptr<ThreadPool> pool;
+        TaskGroup                     group; // The pool may be shared so only these are awaited
+    };
+
+    void AddDirectory(DirectoryReader& reader, const std::string& path,
+                      DirectoryTraversal& traversal);
+
+    void AddSubdirectory(const std::string& path, DirectoryTraversal& traversal)
+    {
+        // TODO: Set @error when a subdirectory can't be read
+        phi::optional<DirectoryReader> reader = DirectoryReader::Open(path);
+        if (reader)
+        {
+            AddDirectory(*reader, path, traversal);
+        }
+    }
+
+    void AddDirectory(DirectoryReader& reader, const std::string& path,
+                      DirectoryTraversal& traversal)
+    {
+        // Counted locally so the shared totals are only touched once per directory
+        phi::uint64_t size{0u};
+        phi::uint64_t files{0u};
+        phi::uint64_t directories{0u};
+
+        while (const phi::optional<DirectoryEntry> entry = reader.Next())
+        {
+            const phi::optional<EntryType> type = ResolveType(reader, *entry);
+            if (!type)
+            {
+                continue;
+            }
+
+            if (*type == EntryType::Directory)
+            {
+                ++directories;
+                if (!traversal.recursive)
+                {
+                    continue;
+                }
+
+                std::string subdirectory = JoinPath(path, entry->name);
+                if (traversal.pool)
+                {
+                    traversal.pool->Submit(
+                            traversal.group,
+                            [subdirectory = std::move(subdirectory), &traversal]() {
+                                AddSubdirectory(subdirectory, traversal);
+                            });
+                }
+                else
+                {
+                    AddSubdirectory(subdirectory, traversal);
+                }
+
+                continue;
+            }
+
+            // Only the size requires a stat call
+            ++files;
+            if (const phi::optional<EntryStatus> status = reader.GetStatus(*entry); status)
+            {
+                size += status->size;
+            }
+        }
+
+        traversal.size += size;
+        traversal.files += files;
+        traversal.directories += directories;
+    }
+} // namespace
+
+#if PHI_PLATFORM_IS(LINUX)
+phi::optional<DirectoryReader> DirectoryReader::Open(const std::string& path)
+{
+    const int file_descriptor =
+            ::openat(AT_FDCWD, path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (file_descriptor < 0)
+    {
+        return {};
+    }
+
+    return DirectoryReader{file_descriptor};
+}
+
+DirectoryReader::DirectoryReader(const int file_descriptor)
+    : m_FileDescriptor{file_descriptor}
+    , m_Buffer{std::make_unique<char[]>(BufferSize)}
+{}
+
+DirectoryReader::DirectoryReader(DirectoryReader&& other) noexcept
+    : m_FileDescriptor{std::exchange(other.m_FileDescriptor, -1)}
+    , m_Buffer{std::move(other.m_Buffer)}
+    , m_BufferSize{std::exchange(other.m_BufferSize, 0u)}
+    , m_BufferOffset{std::exchange(other.m_BufferOffset, 0u)}
+    , m_End{other.m_End}
+{}
+
+DirectoryReader::~DirectoryReader()
+{
+    Close();
+}
+
+DirectoryReader& DirectoryReader::operator=(DirectoryReader&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+
+        m_FileDescriptor = std::exchange(other.m_FileDescriptor, -1);
+        m_Buffer         = std::move(other.m_Buffer);
+        m_BufferSize     = std::exchange(other.m_BufferSize, 0u);
+        m_BufferOffset   = std::exchange(other.m_BufferOffset, 0u);
+        m_End            = other.m_End;
+    }
+
+    return *this;
+}
+
+phi::optional<DirectoryEntry> DirectoryReader::Next()
+{
+    while (true)
+    {
+        if (m_BufferOffset >= m_BufferSize)
+        {
+            if (m_End)
+            {
+                return {};
+            }
+
+            const long read = ::syscall(SYS_getdents64, m_FileDescriptor, m_Buffer.get(),
+                                        BufferSize);
+            if (read <= 0)
+            {
+                m_End = true;
+                return {};
+            }
+
+            m_BufferSize   = static_cast<phi::size_t>(read);
+            m_BufferOffset = 0u;
+        }
+
+        // The kernel aligns every record for the entry structure
+        const auto* record =
+                reinterpret_cast<const LinuxDirectoryEntry*>(m_Buffer.get() + m_BufferOffset);
+        m_BufferOffset += record->record_length;
+
+        // The name is null terminated inside of the record which GetStatus relies on
+        const std::string_view name{static_cast<const char*>(record->name)};
+        if (name == "." || name == "..")
+        {
+            continue;
+        }
+
+        return DirectoryEntry{name, ToEntryType(record->type)};
+    }
+}
+
+phi::optional<EntryStatus> DirectoryReader::GetStatus(const DirectoryEntry& entry) const
+{
+    struct stat status;
+    if (::fstatat(m_FileDescriptor, entry.name.data(), &status, AT_SYMLINK_NOFOLLOW) != 0)
+    {
+        return {};
+    }
+
+    return EntryStatus{ToEntryType(status.st_mode), static_cast<phi::uint64_t>(status.st_size)};
+}
+
+void DirectoryReader::Close()
+{
+    if (m_FileDescriptor >= 0)
+    {
+        ::close(m_FileDescriptor);
+        m_FileDescriptor = -1;
+    }
+}
+#else
+phi::optional<DirectoryReader> DirectoryReader::Open(const std::string& path)
+{
+    std::error_code                     error;
+    std::filesystem::directory_iterator iterator{std::filesystem::path{path}, error};
+    if (error)
+    {
+        return {};
+    }
+
+    return DirectoryReader{std::move(iterator)};
+}
+
+DirectoryReader::DirectoryReader(std::filesystem::directory_iterator iterator)
+    : m_Iterator{std::move(iterator)}
+{}
+
+DirectoryReader::DirectoryReader(DirectoryReader&& other) noexcept = default;
+
+DirectoryReader::~DirectoryReader() = default;
+
+DirectoryReader& DirectoryReader::operator=(DirectoryReader&& other) noexcept = default;
+
+phi::optional<DirectoryEntry> DirectoryReader::Next()
+{
+    if (m_Iterator == std::filesystem::directory_iterator{})
+    {
+        return {};
+    }
+
+    // Most platforms cache the type while iterating
+    std::error_code                    error;
+    m_Entry                                   = *m_Iterator;
+    m_Name                                    = m_Entry.path().filename().string();
+    const std::filesystem::file_status status = m_Entry.symlink_status(error);
+
+    m_Iterator.increment(error);
+    if (error)
+    {
+        m_Iterator = std::filesystem::directory_iterator{};
+    }
+
+    return DirectoryEntry{m_Name, ToEntryType(status.type())};
+}
+
+phi::optional<EntryStatus> DirectoryReader::GetStatus(const DirectoryEntry& /*entry*/) const
+{
+    std::error_code                    error;
+    const std::filesystem::file_status status = m_Entry.symlink_status(error);
+    if (error)
+    {
+        return {};
+    }
+
+    const EntryType type = ToEntryType(status.type());
+    if (type != EntryType::File)
+    {
+        return EntryStatus{type, 0u};
+    }
+
+    const std::uintmax_t size = m_Entry.file_size(error);
+
+    return EntryStatus{type, error ? 0u : static_cast<phi::uint64_t>(size)};
+}
+#endif
+
+phi::optional<FileSearch> FileSearch::Open(const std::string_view pattern)
+{
+    // Everything in front of the last separator names the directory to search
+    const phi::size_t separator = pattern.find_last_of(PathSeparators);
+    std::string       directory;
+    std::string_view  name_pattern = pattern;
+    if (separator == pattern.npos)
+    {
+        directory = ".";
+    }
+    else
+    {
+        directory    = std::string{pattern.substr(0u, separator == 0u ? 1u : separator)};
+        name_pattern = pattern.substr(separator + 1u);
+    }
+
+    phi::optional<DirectoryReader> reader = DirectoryReader::Open(directory);
+    if (!reader)
+    {
+        return {};
+    }
+
+    FileSearch search{std::move(*reader), Wildcard{name_pattern}};
+
+    const phi::optional<Result> first = search.FindNext();
+    if (!first)
+    {
+        return {};
+    }
+
+    search.m_HasFirst         = true;
+    search.m_FirstName        = std::string{first->name};
+    search.m_FirstIsDirectory = first->is_directory;
+
+    return search;
+}
+
+FileSearch::FileSearch(DirectoryReader reader, Wildcard wildcard)
+    : m_Reader{std::move(reader)}
+    , m_Wildcard{std::move(wildcard)}
+{}
+
+phi::optional<FileSearch::Result> FileSearch::Next()
+{
+    if (m_HasFirst)
+    {
+        m_HasFirst = false;
+        return Result{m_FirstName, m_FirstIsDirectory};
+    }
+
+    return FindNext();
+}
+
+phi::optional<FileSearch::Result> FileSearch::FindNext()
+{
+    while (const phi::optional<DirectoryEntry> entry = m_Reader.Next())
+    {
+        if (!m_Wildcard.Matches(entry->name))
+        {
+            continue;
+        }
+
+        // Only entries of unknown type cost a stat call
+        const phi::optional<EntryType> type = ResolveType(m_Reader, *entry);
+
+        return Result{entry->name, type && *type == EntryType::Directory};
+    }
+
+    return {};
+}
+
+phi::optional<DirectorySize> GetDirectorySize(const std::string&                  path,
+                                              const phi::boolean                  recursive,
+                                              const phi::observer_ptr<ThreadPool> pool)
+{
+    phi::optional<DirectoryReader> reader = DirectoryReader::Open(path);
+    if (!reader)
+    {
+        return {};
+    }
+
+    DirectoryTraversal traversal;
+    traversal.recursive = recursive;
+    traversal.pool      = pool;
+
+    AddDirectory(*reader, path, traversal);
+    if (pool)
+    {
+        pool->Wait(traversal.group);
+    }
+
+    return DirectorySize{traversal.size.load(), traversal.files.load(),
+                         traversal.directories.load()};
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,55 @@
+#include "OpenAutoIt/Engine.hpp"
+
+#include "OpenAutoIt/Interpreter.hpp"
+#include "OpenAutoIt/VirtualMachine.hpp"
+#include <phi/core/move.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/scope_ptr.hpp>
+#include <mutex>
+
+namespace OpenAutoIt
+{
+Engine::Engine(phi::not_null_observer_ptr<const ASTDocument> document,
+               phi::usize                                    number_of_threads)
+    : m_Document{document}
+    , m_ThreadPool{number_of_threads}
+{}
+
+phi::not_null_observer_ptr<const Interpreter> Engine::Spawn(OutputHandler standard,
+                                                            OutputHandler error)
+{
+    phi::not_null_scope_ptr<Interpreter> instance = phi::make_not_null_scope<Interpreter>();
+    instance->vm().SetupOutputHandler(phi::move(standard), phi::move(error));
+    instance->vm().SetThreadPool(m_ThreadPool);
+    instance->SetDocument(m_Document);
+
+    const phi::not_null_observer_ptr<Interpreter> interpreter = instance.not_null_observer();
+
+    {
+        std::lock_guard<std::mutex> lock{m_InstancesMutex};
+        m_Instances.emplace_back(phi::move(instance));
+    }
+
+    m_ThreadPool.Submit([this, interpreter]() { RunSlice(interpreter); });
+
+    return interpreter;
+}
+
+void Engine::Wait()
+{
+    m_ThreadPool.Wait();
+}
+
+void Engine::RunSlice(phi::not_null_observer_ptr<Interpreter> interpreter)
+{
+    if (interpreter->RunFor(StepsPerSlice) == Interpreter::RunResult::Yielded)
+    {
+        // Requeue the instance so the other instances get to run as well
+        m_ThreadPool.Submit([this, interpreter]() { RunSlice(interpreter); });
+        return;
+    }
+
+    // The output handlers have to see everything once Wait returned
+    interpreter->vm().FlushOutput();
+}
+} // namespace OpenAutoIt
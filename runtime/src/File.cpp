@@ -0,0 +1,594 @@
+#include "OpenAutoIt/File.hpp"
+
+#include "OpenAutoIt/LineBreak.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if PHI_PLATFORM_IS(WINDOWS)
+#    include <fcntl.h>
+#    include <io.h>
+#    include <sys/stat.h>
+#    include <sys/types.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace OpenAutoIt
+{
+namespace
+{
+    constexpr const std::string_view ByteOrderMark{"\xEF\xBB\xBF"};
+
+    // The platform specific parts of reading files. Only POSIX platforms map files.
+#if PHI_PLATFORM_IS(WINDOWS)
+    using FileStatus = struct _stat64;
+
+    [[nodiscard]] int OpenForReading(const std::string& path)
+    {
+        return _open(path.c_str(), _O_RDONLY | _O_BINARY);
+    }
+
+    [[nodiscard]] phi::boolean GetStatus(const int file_descriptor, FileStatus& status)
+    {
+        return _fstat64(file_descriptor, &status) == 0;
+    }
+
+    [[nodiscard]] phi::boolean IsRegularFile(const FileStatus& status)
+    {
+        return (status.st_mode & _S_IFMT) == _S_IFREG;
+    }
+
+    [[nodiscard]] phi::boolean IsDirectory(const FileStatus& status)
+    {
+        return (status.st_mode & _S_IFMT) == _S_IFDIR;
+    }
+
+    [[nodiscard]] long long ReadSome(const int file_descriptor, char* buffer,
+                                     const phi::size_t size)
+    {
+        return _read(file_descriptor, buffer,
+                     static_cast<unsigned int>(std::min<phi::size_t>(size, 0x7FFFFFFFu)));
+    }
+
+    [[nodiscard]] phi::boolean Seek(const int file_descriptor, const phi::uint64_t offset)
+    {
+        return _lseeki64(file_descriptor, static_cast<long long>(offset), SEEK_SET) >= 0;
+    }
+
+    void CloseFileDescriptor(const int file_descriptor)
+    {
+        _close(file_descriptor);
+    }
+#else
+    using FileStatus = struct stat;
+
+    [[nodiscard]] int OpenForReading(const std::string& path)
+    {
+        return ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
+
+    [[nodiscard]] phi::boolean GetStatus(const int file_descriptor, FileStatus& status)
+    {
+        return ::fstat(file_descriptor, &status) == 0;
+    }
+
+    [[nodiscard]] phi::boolean IsRegularFile(const FileStatus& status)
+    {
+        return S_ISREG(status.st_mode);
+    }
+
+    [[nodiscard]] phi::boolean IsDirectory(const FileStatus& status)
+    {
+        return S_ISDIR(status.st_mode);
+    }
+
+    [[nodiscard]] long long ReadSome(const int file_descriptor, char* buffer,
+                                     const phi::size_t size)
+    {
+        return ::read(file_descriptor, buffer, size);
+    }
+
+    [[nodiscard]] phi::boolean Seek(const int file_descriptor, const phi::uint64_t offset)
+    {
+        return ::lseek(file_descriptor, static_cast<off_t>(offset), SEEK_SET) >= 0;
+    }
+
+    void CloseFileDescriptor(const int file_descriptor)
+    {
+        ::close(file_descriptor);
+    }
+#endif
+} // namespace
+
+phi::optional<File> File::Open(const std::string& path, const phi::boolean binary)
+{
+    const int file_descriptor = OpenForReading(path);
+    if (file_descriptor < 0)
+    {
+        return {};
+    }
+
+    File file{file_descriptor, binary};
+
+    FileStatus status{};
+    if (!GetStatus(file_descriptor, status) || IsDirectory(status))
+    {
+        return {};
+    }
+
+    file.m_Seekable = IsRegularFile(status);
+
+#if !PHI_PLATFORM_IS(WINDOWS)
+    if (file.m_Seekable &&
+        static_cast<phi::uint64_t>(status.st_size) <= std::numeric_limits<phi::size_t>::max())
+    {
+        file.m_Size = static_cast<phi::size_t>(status.st_size);
+
+        // Empty files can't be mapped but there's nothing to map anyway
+        if (file.m_Size == 0u)
+        {
+            file.m_Mapped = true;
+        }
+        else if (void* data = ::mmap(nullptr, file.m_Size, PROT_READ, MAP_PRIVATE, file_descriptor,
+                                     0);
+                 data != MAP_FAILED)
+        {
+#    if defined(MADV_SEQUENTIAL)
+            ::madvise(data, file.m_Size, MADV_SEQUENTIAL);
+#    endif
+
+            file.m_Data   = static_cast<const char*>(data);
+            file.m_Mapped = true;
+        }
+        else
+        {
+            file.m_Size = 0u;
+        }
+    }
+#endif
+
+    if (!binary)
+    {
+        while (file.GetAvailable().size() < ByteOrderMark.size() && file.FillBuffer())
+        {}
+
+        if (file.GetAvailable().starts_with(ByteOrderMark))
+        {
+            file.Consume(ByteOrderMark.size());
+            file.m_ContentStart = ByteOrderMark.size();
+        }
+    }
+
+    if (file.m_Mapped)
+    {
+        file.m_IndexedLine  = 1u;
+        file.m_IndexedStart = static_cast<phi::size_t>(file.m_ContentStart);
+        file.m_LineCheckpoints.push_back(file.m_IndexedStart);
+    }
+
+    return file;
+}
+
+File::File(File&& other) noexcept
+    : m_FileDescriptor{std::exchange(other.m_FileDescriptor, -1)}
+    , m_Binary{other.m_Binary}
+    , m_Seekable{other.m_Seekable}
+    , m_ContentStart{other.m_ContentStart}
+    , m_Position{other.m_Position}
+    , m_Data{std::exchange(other.m_Data, nullptr)}
+    , m_Size{std::exchange(other.m_Size, 0u)}
+    , m_Mapped{std::exchange(other.m_Mapped, false)}
+    , m_Buffer{std::move(other.m_Buffer)}
+    , m_BufferOffset{other.m_BufferOffset}
+    , m_EndOfFile{other.m_EndOfFile}
+    , m_LineCheckpoints{std::move(other.m_LineCheckpoints)}
+    , m_IndexedLine{other.m_IndexedLine}
+    , m_IndexedStart{other.m_IndexedStart}
+{}
+
+File::~File()
+{
+    Close();
+}
+
+File& File::operator=(File&& other) noexcept
+{
+    if (this != &other)
+    {
+        Close();
+
+        m_FileDescriptor  = std::exchange(other.m_FileDescriptor, -1);
+        m_Binary          = other.m_Binary;
+        m_Seekable        = other.m_Seekable;
+        m_ContentStart    = other.m_ContentStart;
+        m_Position        = other.m_Position;
+        m_Data            = std::exchange(other.m_Data, nullptr);
+        m_Size            = std::exchange(other.m_Size, 0u);
+        m_Mapped          = std::exchange(other.m_Mapped, false);
+        m_Buffer          = std::move(other.m_Buffer);
+        m_BufferOffset    = other.m_BufferOffset;
+        m_EndOfFile       = other.m_EndOfFile;
+        m_LineCheckpoints = std::move(other.m_LineCheckpoints);
+        m_IndexedLine     = other.m_IndexedLine;
+        m_IndexedStart    = other.m_IndexedStart;
+    }
+
+    return *this;
+}
+
+phi::boolean File::IsBinary() const
+{
+    return m_Binary;
+}
+
+phi::optional<std::string_view> File::Read(const phi::optional<phi::size_t> count)
+{
+    std::string_view available = GetAvailable();
+    phi::size_t      size{0u}; // Bytes making up the characters counted so far
+    phi::size_t      characters{0u};
+    while (true)
+    {
+        if (count && m_Binary && available.size() >= *count)
+        {
+            size = *count;
+            break;
+        }
+
+        if (count && !m_Binary)
+        {
+            // Stop at the first byte of the character following the last one to read
+            phi::boolean complete{false};
+            for (; size < available.size(); ++size)
+            {
+                if (IsUTF8ContinuationByte(available[size]))
+                {
+                    continue;
+                }
+
+                if (characters == *count)
+                {
+                    complete = true;
+                    break;
+                }
+
+                ++characters;
+            }
+
+            if (complete)
+            {
+                break;
+            }
+        }
+
+        size = available.size();
+
+        // Filling the buffer moves its content so the view has to be updated in any case
+        const phi::boolean filled = FillBuffer();
+        available                 = GetAvailable();
+        if (!filled)
+        {
+            break;
+        }
+    }
+
+    if (available.empty())
+    {
+        return {};
+    }
+
+    Consume(size);
+
+    return available.substr(0u, size);
+}
+
+phi::optional<std::string_view> File::ReadLine()
+{
+    std::string_view available = GetAvailable();
+    phi::size_t      searched{0u};
+    while (true)
+    {
+        const phi::size_t end = searched + FindLineBreak(available.substr(searched));
+        if (end < available.size())
+        {
+            // A CR at the end of the buffer might be followed by a LF which wasn't read yet
+            if (available[end] == '\r' && end + 1u == available.size() && CanFillBuffer())
+            {
+                FillBuffer();
+                available = GetAvailable();
+                searched  = end;
+                continue;
+            }
+
+            Consume(end + GetLineBreakSize(available, end));
+            return available.substr(0u, end);
+        }
+
+        const phi::boolean filled = FillBuffer();
+        available                 = GetAvailable();
+        searched                  = end;
+        if (!filled)
+        {
+            break;
+        }
+    }
+
+    // The last line doesn't need to end with a line break
+    if (available.empty())
+    {
+        return {};
+    }
+
+    Consume(available.size());
+
+    return available;
+}
+
+phi::optional<std::string_view> File::ReadLine(const phi::size_t line)
+{
+    if (line == 0u)
+    {
+        return {};
+    }
+
+    if (m_Mapped)
+    {
+        const phi::optional<phi::size_t> start = FindLineStart(line);
+        if (!start)
+        {
+            return {};
+        }
+
+        m_Position = *start;
+        return ReadLine();
+    }
+
+    // NOTE: AutoIt itself reads the file again from the start for every line number
+    if (!SetPosition(0, FileOrigin::Begin))
+    {
+        return {};
+    }
+
+    for (phi::size_t current{1u}; current < line; ++current)
+    {
+        if (!ReadLine())
+        {
+            return {};
+        }
+    }
+
+    return ReadLine();
+}
+
+phi::optional<std::string_view> File::ReadLastLine()
+{
+    if (m_Mapped)
+    {
+        ExtendLineIndex(std::numeric_limits<phi::size_t>::max());
+
+        // The index stops at the first line which doesn't exist anymore
+        return ReadLine(m_IndexedLine - 1u);
+    }
+
+    if (!SetPosition(0, FileOrigin::Begin))
+    {
+        return {};
+    }
+
+    phi::optional<phi::uint64_t> last_start;
+    for (phi::uint64_t start = m_Position; ReadLine(); start = m_Position)
+    {
+        last_start = start;
+    }
+
+    if (!last_start || !SetPosition(static_cast<phi::int64_t>(*last_start), FileOrigin::Begin))
+    {
+        return {};
+    }
+
+    return ReadLine();
+}
+
+phi::boolean File::SetPosition(const phi::int64_t offset, const FileOrigin origin)
+{
+    if (!m_Seekable)
+    {
+        return false;
+    }
+
+    phi::int64_t base{0};
+    switch (origin)
+    {
+        case FileOrigin::Begin:
+            break;
+
+        case FileOrigin::Current:
+            base = static_cast<phi::int64_t>(m_Position);
+            break;
+
+        case FileOrigin::End: {
+            FileStatus status{};
+            if (!GetStatus(m_FileDescriptor, status))
+            {
+                return false;
+            }
+
+            base = static_cast<phi::int64_t>(status.st_size);
+            break;
+        }
+    }
+
+    const phi::int64_t target = base + offset;
+    if (target < 0)
+    {
+        return false;
+    }
+
+    // Text files never read their byte order mark
+    const phi::uint64_t position =
+            std::max(static_cast<phi::uint64_t>(target), m_Binary ? 0u : m_ContentStart);
+
+    if (!m_Mapped)
+    {
+        if (!Seek(m_FileDescriptor, position))
+        {
+            return false;
+        }
+
+        m_Buffer.clear();
+        m_BufferOffset = 0u;
+        m_EndOfFile    = false;
+    }
+
+    m_Position = position;
+
+    return true;
+}
+
+phi::uint64_t File::GetPosition() const
+{
+    return m_Position;
+}
+
+File::File(const int file_descriptor, const phi::boolean binary)
+    : m_FileDescriptor{file_descriptor}
+    , m_Binary{binary}
+{}
+
+void File::Close()
+{
+#if !PHI_PLATFORM_IS(WINDOWS)
+    if (m_Data != nullptr)
+    {
+        ::munmap(const_cast<char*>(m_Data), m_Size);
+        m_Data = nullptr;
+    }
+#endif
+
+    if (m_FileDescriptor >= 0)
+    {
+        CloseFileDescriptor(m_FileDescriptor);
+        m_FileDescriptor = -1;
+    }
+}
+
+std::string_view File::GetAvailable() const
+{
+    if (m_Mapped)
+    {
+        if (m_Position >= m_Size)
+        {
+            return {};
+        }
+
+        return {m_Data + m_Position, m_Size - static_cast<phi::size_t>(m_Position)};
+    }
+
+    return std::string_view{m_Buffer}.substr(m_BufferOffset);
+}
+
+phi::boolean File::CanFillBuffer() const
+{
+    return !m_Mapped && !m_EndOfFile;
+}
+
+phi::boolean File::FillBuffer()
+{
+    if (!CanFillBuffer())
+    {
+        return false;
+    }
+
+    // Drop the bytes which were consumed already. Reading at least as much as is left keeps moving
+    // the rest of a long line linear.
+    m_Buffer.erase(0u, m_BufferOffset);
+    m_BufferOffset = 0u;
+
+    const phi::size_t size      = m_Buffer.size();
+    const phi::size_t read_size = std::max(ReadBufferSize, size);
+    m_Buffer.resize(size + read_size);
+
+    long long read{0};
+    do
+    {
+        read = ReadSome(m_FileDescriptor, m_Buffer.data() + size, read_size);
+    } while (read < 0 && errno == EINTR);
+
+    if (read <= 0)
+    {
+        // TODO: Set @error for read errors
+        m_Buffer.resize(size);
+        m_EndOfFile = true;
+        return false;
+    }
+
+    m_Buffer.resize(size + static_cast<phi::size_t>(read));
+
+    return true;
+}
+
+void File::Consume(const phi::size_t size)
+{
+    m_Position += size;
+
+    if (!m_Mapped)
+    {
+        m_BufferOffset += size;
+    }
+}
+
+void File::ExtendLineIndex(const phi::size_t line)
+{
+    const std::string_view data{m_Data, m_Size};
+    while (m_IndexedLine < line && m_IndexedStart < m_Size)
+    {
+        const phi::size_t end = m_IndexedStart + FindLineBreak(data.substr(m_IndexedStart));
+
+        m_IndexedStart = end < m_Size ? end + GetLineBreakSize(data, end) : m_Size;
+        ++m_IndexedLine;
+
+        if ((m_IndexedLine - 1u) % LineCheckpointInterval == 0u)
+        {
+            m_LineCheckpoints.push_back(m_IndexedStart);
+        }
+    }
+}
+
+phi::optional<phi::size_t> File::FindLineStart(const phi::size_t line)
+{
+    ExtendLineIndex(line);
+    if (line > m_IndexedLine)
+    {
+        return {};
+    }
+
+    // Walk the few lines from the closest checkpoint
+    const std::string_view data{m_Data, m_Size};
+    const phi::size_t      checkpoint = (line - 1u) / LineCheckpointInterval;
+
+    phi::size_t start = m_LineCheckpoints[checkpoint];
+    for (phi::size_t current{checkpoint * LineCheckpointInterval + 1u}; current < line; ++current)
+    {
+        const phi::size_t end = start + FindLineBreak(data.substr(start));
+        start                 = end < m_Size ? end + GetLineBreakSize(data, end) : m_Size;
+    }
+
+    if (start >= m_Size)
+    {
+        return {};
+    }
+
+    return start;
+}
+} // namespace OpenAutoIt
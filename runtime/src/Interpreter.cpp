@@ -1,32 +1,45 @@
 #include "OpenAutoIt/Interpreter.hpp"
 
+#include "OpenAutoIt/AST/ASTArrayLiteral.hpp"
+#include "OpenAutoIt/AST/ASTArraySubscriptExpression.hpp"
 #include "OpenAutoIt/AST/ASTBinaryExpression.hpp"
 #include "OpenAutoIt/AST/ASTExitStatement.hpp"
 #include "OpenAutoIt/AST/ASTExpression.hpp"
 #include "OpenAutoIt/AST/ASTFloatLiteral.hpp"
+#include "OpenAutoIt/AST/ASTForInStatement.hpp"
+#include "OpenAutoIt/AST/ASTForStatement.hpp"
 #include "OpenAutoIt/AST/ASTFunctionCallExpression.hpp"
 #include "OpenAutoIt/AST/ASTFunctionDefinition.hpp"
 #include "OpenAutoIt/AST/ASTFunctionReferenceExpression.hpp"
 #include "OpenAutoIt/AST/ASTKeywordLiteral.hpp"
 #include "OpenAutoIt/AST/ASTMacroExpression.hpp"
 #include "OpenAutoIt/AST/ASTNode.hpp"
+#include "OpenAutoIt/AST/ASTReDimStatement.hpp"
 #include "OpenAutoIt/AST/ASTTernaryIfExpression.hpp"
 #include "OpenAutoIt/AST/ASTUnaryExpression.hpp"
 #include "OpenAutoIt/AST/ASTWhileStatement.hpp"
+#include "OpenAutoIt/Array.hpp"
 #include "OpenAutoIt/BuiltinFunctions.hpp"
+#include "OpenAutoIt/ForLoopState.hpp"
+#include "OpenAutoIt/Map.hpp"
+#include "OpenAutoIt/StringFormat.hpp"
 #include "OpenAutoIt/Token.hpp"
 #include "OpenAutoIt/TokenKind.hpp"
-#include "OpenAutoIt/UnsafeOperations.hpp"
+#include "OpenAutoIt/VariableScope.hpp"
 #include "OpenAutoIt/Variant.hpp"
 #include "OpenAutoIt/VirtualMachine.hpp"
 #include <phi/compiler_support/extended_attributes.hpp>
+#include <phi/compiler_support/unused.hpp>
 #include <phi/compiler_support/warning.hpp>
 #include <phi/container/string_view.hpp>
 #include <phi/core/assert.hpp>
 #include <phi/core/observer_ptr.hpp>
+#include <phi/core/optional.hpp>
 #include <phi/core/sized_types.hpp>
 #include <phi/core/types.hpp>
 #include <phi/core/unsafe_cast.hpp>
+#include <chrono>
+#include <vector>
 
 PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
 
@@ -38,9 +51,243 @@ PHI_MSVC_SUPPRESS_WARNING(4702) // unreachable code
 
 namespace OpenAutoIt
 {
-void Interpreter::SetDocument(phi::not_null_observer_ptr<ASTDocument> new_document)
+namespace
+{
+    [[nodiscard]] double NumericToDouble(const Variant& value)
+    {
+        PHI_ASSERT(value.IsNumeric());
+
+        if (value.IsInt64())
+        {
+            return static_cast<double>(value.AsInt64().unsafe());
+        }
+
+        return value.AsDouble().unsafe();
+    }
+
+    // Write the loop counter back into the variable slot reusing the storage when possible
+    void WriteBackForCounter(Variant& slot, const phi::int64_t value)
+    {
+        if (slot.IsInt64())
+        {
+            slot.AsInt64() = value;
+            return;
+        }
+
+        slot = Variant::MakeInt(value);
+    }
+
+    void WriteBackForCounter(Variant& slot, const double value)
+    {
+        if (slot.IsDouble())
+        {
+            slot.AsDouble() = value;
+            return;
+        }
+
+        slot = Variant::MakeDouble(value);
+    }
+
+    [[nodiscard]] phi::boolean IsForCounterInRange(const ForLoopState& loop)
+    {
+        if (loop.is_integer)
+        {
+            return loop.int_step >= 0 ? loop.int_counter <= loop.int_end :
+                                        loop.int_counter >= loop.int_end;
+        }
+
+        return loop.double_step >= 0.0 ? loop.double_counter <= loop.double_end :
+                                         loop.double_counter >= loop.double_end;
+    }
+
+    // Advance the counter by one step. Returns false if the counter would overflow
+    [[nodiscard]] phi::boolean AdvanceForCounter(ForLoopState& loop)
+    {
+        if (loop.is_integer)
+        {
+            const phi::int64_t current = loop.int_counter;
+
+            // Wrapping add through unsigned arithmetic so overflow can be detected afterwards
+            loop.int_counter = static_cast<phi::int64_t>(static_cast<phi::uint64_t>(current) +
+                                                         static_cast<phi::uint64_t>(loop.int_step));
+
+            return loop.int_step >= 0 ? loop.int_counter >= current : loop.int_counter <= current;
+        }
+
+        loop.double_counter += loop.double_step;
+        return true;
+    }
+
+    void ApplyCompoundAssignment(Variant& variable, const TokenKind op, const Variant& value)
+    {
+        switch (op)
+        {
+            case TokenKind::OP_PlusEquals:
+                variable = variable.Add(value);
+                break;
+            case TokenKind::OP_MinusEquals:
+                variable = variable.Subtract(value);
+                break;
+            case TokenKind::OP_MultiplyEquals:
+                variable = variable.Multiply(value);
+                break;
+            case TokenKind::OP_DivideEquals:
+                variable = variable.Divide(value);
+                break;
+            case TokenKind::OP_ConcatenateEquals:
+                variable.Append(value);
+                break;
+
+            default:
+                PHI_ASSERT_NOT_REACHED();
+        }
+    }
+
+    // Returns true if the predicate returns true for the expression or any of its subexpressions
+    template <typename PredicateT>
+    [[nodiscard]] phi::boolean AnySubexpression(const ASTExpression& expression,
+                                                const PredicateT&    predicate)
+    {
+        if (predicate(expression))
+        {
+            return true;
+        }
+
+        const auto any_of = [&predicate](const auto& expressions) {
+            for (const auto& element : expressions)
+            {
+                if (AnySubexpression(*element, predicate))
+                {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        switch (expression.NodeType())
+        {
+            case ASTNodeType::ArrayLiteral:
+                return any_of(expression.as<ASTArrayLiteral>()->m_Elements);
+
+            case ASTNodeType::ArraySubscriptExpression: {
+                const auto subscript_expression = expression.as<ASTArraySubscriptExpression>();
+
+                return AnySubexpression(*subscript_expression->m_ArrayExpression, predicate) ||
+                       any_of(subscript_expression->m_IndexExpressions);
+            }
+
+            case ASTNodeType::BinaryExpression: {
+                const auto binary_expression = expression.as<ASTBinaryExpression>();
+
+                return AnySubexpression(*binary_expression->m_LHS, predicate) ||
+                       AnySubexpression(*binary_expression->m_RHS, predicate);
+            }
+
+            case ASTNodeType::FunctionCallExpression:
+                return any_of(expression.as<ASTFunctionCallExpression>()->m_Arguments);
+
+            case ASTNodeType::TernaryIfExpression: {
+                const auto ternary_expression = expression.as<ASTTernaryIfExpression>();
+
+                return AnySubexpression(*ternary_expression->m_ConditionExpression, predicate) ||
+                       AnySubexpression(*ternary_expression->m_TrueExpression, predicate) ||
+                       AnySubexpression(*ternary_expression->m_FalseExpression, predicate);
+            }
+
+            case ASTNodeType::UnaryExpression:
+                return AnySubexpression(*expression.as<ASTUnaryExpression>()->m_Expression,
+                                        predicate);
+
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] phi::boolean IsVariable(const ASTExpression&   expression,
+                                          const phi::string_view variable_name)
+    {
+        return expression.NodeType() == ASTNodeType::VariableExpression &&
+               expression.as<ASTVariableExpression>()->m_VariableName == variable_name;
+    }
+
+    // Whether the expression is a chain like '(($s & x) & y)' starting with the given variable
+    // which gives the same result as appending x and then y to the variable in place. Function
+    // calls could observe or modify the variable in between and so could reading it after the
+    // first operand was appended.
+    [[nodiscard]] phi::boolean IsAppendChain(const ASTExpression&   expression,
+                                             const phi::string_view variable_name)
+    {
+        phi::not_null_observer_ptr<const ASTExpression> current = &expression;
+        while (current->NodeType() == ASTNodeType::BinaryExpression)
+        {
+            const auto binary_expression = current->as<ASTBinaryExpression>();
+            if (binary_expression->m_Operator != TokenKind::OP_Concatenate)
+            {
+                return false;
+            }
+
+            const phi::boolean is_first_operand =
+                    IsVariable(*binary_expression->m_LHS, variable_name);
+
+            const auto is_unsafe = [&](const ASTExpression& subexpression) {
+                return subexpression.NodeType() == ASTNodeType::FunctionCallExpression ||
+                       (!is_first_operand && IsVariable(subexpression, variable_name));
+            };
+            if (AnySubexpression(*binary_expression->m_RHS, is_unsafe))
+            {
+                return false;
+            }
+
+            if (is_first_operand)
+            {
+                return true;
+            }
+
+            current = binary_expression->m_LHS.not_null_observer();
+        }
+
+        return false;
+    }
+
+    // Nested array literals form additional dimensions where each dimension is as large as its
+    // largest literal. So '[[1, 2], [3]]' results in a 2x2 array
+    void MeasureArrayLiteral(const ASTArrayLiteral& array_literal, ArraySubscripts& dimensions,
+                             const phi::size_t depth)
+    {
+        if (depth >= MaxArrayDimensions)
+        {
+            return;
+        }
+
+        if (depth >= dimensions.count)
+        {
+            dimensions.count         = depth + 1u;
+            dimensions.values[depth] = 0u;
+        }
+
+        if (array_literal.m_Elements.size() > dimensions.values[depth])
+        {
+            dimensions.values[depth] = array_literal.m_Elements.size();
+        }
+
+        for (const auto& element : array_literal.m_Elements)
+        {
+            if (element->NodeType() == ASTNodeType::ArrayLiteral)
+            {
+                MeasureArrayLiteral(*element->as<ASTArrayLiteral>(), dimensions, depth + 1u);
+            }
+        }
+    }
+} // namespace
+
+void Interpreter::SetDocument(phi::not_null_observer_ptr<const ASTDocument> new_document)
 {
     m_Document = new_document;
+    m_ExpressionProfiles.clear();
+    m_ExpressionProfiles.resize(m_Document->m_OperatorExpressionCount);
+    m_RegionProfiles.clear();
+    m_RegionProfiles.resize(m_Document->m_RegionParents.size());
+
     vm().PushGlobalScope(m_Document->m_Statements);
 }
 
@@ -52,6 +299,31 @@ void Interpreter::Run()
     }
 }
 
+Interpreter::RunResult Interpreter::RunFor(phi::u64 max_steps)
+{
+    const phi::uint64_t steps = max_steps.unsafe();
+    for (phi::uint64_t step{0u}; step < steps && vm().CanRun(); ++step)
+    {
+        Step();
+    }
+
+    return GetRunResult();
+}
+
+Interpreter::RunResult Interpreter::RunUntil(std::chrono::steady_clock::time_point deadline)
+{
+    // Reading the clock is expensive compared to most statements so we only check it after a batch
+    while (RunFor(DeadlineCheckInterval) == RunResult::Yielded)
+    {
+        if (std::chrono::steady_clock::now() >= deadline)
+        {
+            return RunResult::Yielded;
+        }
+    }
+
+    return GetRunResult();
+}
+
 void Interpreter::Step()
 {
     Scope& current_scope = vm().GetCurrentScope();
@@ -75,13 +347,28 @@ void Interpreter::Step()
     }
 }
 
-phi::not_null_observer_ptr<ASTStatement> Interpreter::GetCurrentStatement() const
+phi::not_null_observer_ptr<const ASTStatement> Interpreter::GetCurrentStatement() const
 {
     const Scope& current_scope = vm().GetCurrentScope();
     PHI_ASSERT(!current_scope.statements.empty());
     PHI_ASSERT(current_scope.index < current_scope.statements.size());
 
-    return current_scope.statements.at(current_scope.index.unsafe());
+    return current_scope.statements.at(current_scope.index.unsafe()).not_null_observer();
+}
+
+Interpreter::RunResult Interpreter::GetRunResult() const
+{
+    if (vm().CanRun())
+    {
+        return RunResult::Yielded;
+    }
+
+    if (vm().IsAborting())
+    {
+        return RunResult::Errored;
+    }
+
+    return RunResult::Finished;
 }
 
 PHI_ATTRIBUTE_CONST VirtualMachine& Interpreter::vm()
@@ -95,7 +382,7 @@ PHI_ATTRIBUTE_CONST const VirtualMachine& Interpreter::vm() const
 }
 
 Interpreter::StatementFinished Interpreter::InterpretStatement(
-        phi::not_null_observer_ptr<ASTStatement> statement)
+        phi::not_null_observer_ptr<const ASTStatement> statement)
 {
     // NOTE: Generally we return Yes for finished statements and the ending of loops
     //       While returning No for unfinished loops like While and For
@@ -105,7 +392,7 @@ Interpreter::StatementFinished Interpreter::InterpretStatement(
         case ASTNodeType::ExpressionStatement: {
             auto expression_statement = statement->as<ASTExpressionStatement>();
 
-            InterpretExpression(expression_statement->m_Expression);
+            InterpretExpression(expression_statement->m_Expression.not_null_observer());
             return StatementFinished::Yes;
         }
 
@@ -113,7 +400,8 @@ Interpreter::StatementFinished Interpreter::InterpretStatement(
             auto if_statement = statement->as<ASTIfStatement>();
 
             const Variant if_condition_value =
-                    InterpretExpression(if_statement->m_IfCase.condition).CastToBoolean();
+                    InterpretTieredExpression(if_statement->m_IfCase.condition.not_null_observer())
+                            .CastToBoolean();
             PHI_ASSERT(if_condition_value.IsBoolean());
 
             if (if_condition_value.AsBoolean())
@@ -126,7 +414,8 @@ Interpreter::StatementFinished Interpreter::InterpretStatement(
             for (auto&& else_if_case : if_statement->m_ElseIfCases)
             {
                 const Variant condition_value =
-                        InterpretExpression(else_if_case.condition).CastToBoolean();
+                        InterpretTieredExpression(else_if_case.condition.not_null_observer())
+                                .CastToBoolean();
                 PHI_ASSERT(condition_value.IsBoolean());
 
                 if (condition_value.AsBoolean())
@@ -144,15 +433,38 @@ Interpreter::StatementFinished Interpreter::InterpretStatement(
         case ASTNodeType::VariableAssignment: {
             auto variable_assignment = statement->as<ASTVariableAssignment>();
 
+            if (variable_assignment->m_IsArray)
+            {
+                return InterpretArrayAssignment(variable_assignment);
+            }
+
             const phi::string_view variable_name = variable_assignment->m_VariableName;
             PHI_ASSERT(!variable_name.is_empty());
 
-            // TODO: Const?
-            phi::observer_ptr<ASTExpression> initial_expression =
-                    variable_assignment->m_InitialValueExpression;
+            const phi::observer_ptr<const ASTExpression> initial_expression =
+                    variable_assignment->m_InitialValueExpression.observer();
+
+            if (variable_assignment->m_Operator != TokenKind::OP_Equals)
+            {
+                PHI_ASSERT(initial_expression);
+
+                return InterpretCompoundAssignment(variable_name, variable_assignment->m_Operator,
+                                                   initial_expression.not_null());
+            }
+
+            // Rewrite '$s = $s & x & y' to '$s &= x' and '$s &= y' so string builders append in
+            // place
+            if (initial_expression && IsAppendChain(*initial_expression, variable_name) &&
+                vm().LookupVariableRefByName(variable_name))
+            {
+                return InterpretAppendChain(variable_name,
+                                            initial_expression->as<ASTBinaryExpression>());
+            }
+
             if (initial_expression)
             {
-                const Variant expression_value = InterpretExpression(initial_expression.not_null());
+                const Variant expression_value =
+                        InterpretTieredExpression(initial_expression.not_null());
 
                 vm().PushOrAssignVariable(variable_name, expression_value);
                 return StatementFinished::Yes;
@@ -166,9 +478,14 @@ Interpreter::StatementFinished Interpreter::InterpretStatement(
         case ASTNodeType::WhileStatement: {
             auto while_statement = statement->as<ASTWhileStatement>();
 
+            // NOTE: The condition is evaluated again after every iteration so this is the back edge
+            CountBackEdge(while_statement->m_RegionIndex);
+
             // Evaluate condition
             const Variant condition =
-                    InterpretExpression(while_statement->m_ConditionExpression).CastToBoolean();
+                    InterpretTieredExpression(
+                            while_statement->m_ConditionExpression.not_null_observer())
+                            .CastToBoolean();
             PHI_ASSERT(condition.IsBoolean());
 
             if (!condition.AsBoolean())
@@ -181,6 +498,15 @@ Interpreter::StatementFinished Interpreter::InterpretStatement(
             return StatementFinished::No;
         }
 
+        case ASTNodeType::ForStatement:
+            return InterpretForStatement(statement->as<ASTForStatement>());
+
+        case ASTNodeType::ForInStatement:
+            return InterpretForInStatement(statement->as<ASTForInStatement>());
+
+        case ASTNodeType::ReDimStatement:
+            return InterpretReDimStatement(statement->as<ASTReDimStatement>());
+
         case ASTNodeType::ExitStatement: {
             auto exit_statement = statement->as<ASTExitStatement>();
 
@@ -207,197 +533,1397 @@ Interpreter::StatementFinished Interpreter::InterpretStatement(
     }
 }
 
-Variant Interpreter::InterpretExpression(phi::not_null_observer_ptr<ASTExpression> expression)
+Interpreter::StatementFinished Interpreter::InterpretAppendChain(
+        phi::string_view variable_name, phi::not_null_observer_ptr<const ASTBinaryExpression> chain)
 {
-    switch (expression->NodeType())
+    // Operands are appended from left to right so the nested chains come first
+    if (chain->m_LHS->NodeType() == ASTNodeType::BinaryExpression)
     {
-        case ASTNodeType::ArraySubscriptExpression:
-            // TODO: ArraySubscriptExpression
-            return {};
+        InterpretAppendChain(variable_name, chain->m_LHS->as<ASTBinaryExpression>());
+        if (!vm().CanRun())
+        {
+            return StatementFinished::Yes;
+        }
+    }
 
-        case ASTNodeType::BinaryExpression: {
-            auto binary_expression = expression->as<ASTBinaryExpression>();
+    return InterpretCompoundAssignment(variable_name, TokenKind::OP_ConcatenateEquals,
+                                       chain->m_RHS.not_null_observer());
+}
+
+Interpreter::StatementFinished Interpreter::InterpretCompoundAssignment(
+        phi::string_view variable_name, const TokenKind op,
+        phi::not_null_observer_ptr<const ASTExpression> expression)
+{
+    // NOTE: The right hand side is evaluated first since it may also read the variable
+    const Variant value = InterpretTieredExpression(expression);
+
+    auto variable_opt = vm().LookupVariableRefByName(variable_name);
+    if (!variable_opt)
+    {
+        vm().RuntimeError("No variable named '{}'", std::string_view(variable_name));
+        return StatementFinished::Yes;
+    }
+
+    ApplyCompoundAssignment(variable_opt.value(), op, value);
 
-            const Variant lhs_value = InterpretExpression(binary_expression->m_LHS);
-            const Variant rhs_value = InterpretExpression(binary_expression->m_RHS);
+    return StatementFinished::Yes;
+}
+
+Interpreter::StatementFinished Interpreter::InterpretArrayAssignment(
+        phi::not_null_observer_ptr<const ASTVariableAssignment> assignment)
+{
+    const phi::string_view variable_name = assignment->m_VariableName;
+
+    const phi::observer_ptr<const ASTExpression> initial_expression =
+            assignment->m_InitialValueExpression.observer();
 
-            return EvaluateBinaryExpression(lhs_value, rhs_value, binary_expression->m_Operator);
+    const phi::boolean is_declaration = assignment->m_IsConst || assignment->m_IsStatic ||
+                                        assignment->m_Scope != VariableScope::Auto;
+
+    if (is_declaration)
+    {
+        // 'Local $map[]' without an initializer declares a map
+        if (assignment->m_Subscripts.empty() && !initial_expression)
+        {
+            vm().PushOrAssignVariable(variable_name, Variant::MakeMap());
+            return StatementFinished::Yes;
         }
 
-        case ASTNodeType::BooleanLiteral: {
-            auto boolean_literal = expression->as<ASTBooleanLiteral>();
+        Variant value = initial_expression ? InterpretExpression(initial_expression.not_null()) :
+                                             Variant::MakeArray({});
 
-            return Variant::MakeBoolean(boolean_literal->m_Value);
+        // 'Local $a[] = [1, 2]' takes its dimensions from the initializer
+        if (!assignment->m_Subscripts.empty())
+        {
+            ArraySubscripts dimensions;
+            if (!InterpretSubscripts(assignment->m_Subscripts, dimensions))
+            {
+                return StatementFinished::Yes;
+            }
+
+            if (!value.IsArray())
+            {
+                vm().RuntimeError("Array variable must be initialized with an array literal.");
+                return StatementFinished::Yes;
+            }
+
+            // The initializer may be smaller than the declared size but must have the same number
+            // of dimensions
+            const Array& initializer = static_cast<const Variant&>(value).AsArray();
+            if (initializer.GetDimensionCount() != 0u &&
+                initializer.GetDimensionCount() != dimensions.count)
+            {
+                vm().RuntimeError("Array variable has incorrect number of subscripts or subscript "
+                                  "dimension range exceeded.");
+                return StatementFinished::Yes;
+            }
+            for (phi::size_t index{0u}; index < initializer.GetDimensionCount(); ++index)
+            {
+                if (initializer.GetDimension(index) > dimensions.values[index])
+                {
+                    vm().RuntimeError("Array variable has incorrect number of subscripts or "
+                                      "subscript dimension range exceeded.");
+                    return StatementFinished::Yes;
+                }
+            }
+
+            if (!value.AsArray().ReDim(dimensions))
+            {
+                vm().RuntimeError("Array maximum size exceeded.");
+                return StatementFinished::Yes;
+            }
+        }
+
+        vm().PushOrAssignVariable(variable_name, phi::move(value));
+        return StatementFinished::Yes;
+    }
+
+    PHI_ASSERT(initial_expression);
+
+    // NOTE: The value and subscripts are evaluated before taking a mutable reference to the array
+    //       so an expression reading the array doesn't force a copy of it
+    const Variant value = InterpretTieredExpression(initial_expression.not_null());
+
+    const auto existing_variable =
+            static_cast<const VirtualMachine&>(vm()).LookupVariableRefByName(variable_name);
+    if (!existing_variable)
+    {
+        vm().RuntimeError("No variable named '{}'", std::string_view(variable_name));
+        return StatementFinished::Yes;
+    }
+
+    if (existing_variable->IsMap())
+    {
+        return InterpretMapAssignment(assignment, value);
+    }
+
+    if (!existing_variable->IsArray())
+    {
+        vm().RuntimeError("Subscript used on non-accessible variable.");
+        return StatementFinished::Yes;
+    }
+
+    ArraySubscripts subscripts;
+    if (!InterpretSubscripts(assignment->m_Subscripts, subscripts))
+    {
+        return StatementFinished::Yes;
+    }
+
+    // NOTE: Looked up again since evaluating the subscripts might have changed the variable
+    auto variable_opt = vm().LookupVariableRefByName(variable_name);
+    if (!variable_opt || !variable_opt->IsArray())
+    {
+        vm().RuntimeError("Subscript used on non-accessible variable.");
+        return StatementFinished::Yes;
+    }
+    Variant& variable = variable_opt.value();
+
+    Array& array = variable.AsArray();
+
+    if (assignment->m_Operator == TokenKind::OP_Equals)
+    {
+        if (!array.SetElement(subscripts, value))
+        {
+            vm().RuntimeError("Array variable has incorrect number of subscripts or subscript "
+                              "dimension range exceeded.");
+        }
+
+        return StatementFinished::Yes;
+    }
+
+    // NOTE: Taking the element out of the array means '&=' can append to it in place
+    phi::optional<Variant> element = array.TakeElement(subscripts);
+    if (!element)
+    {
+        vm().RuntimeError("Array variable has incorrect number of subscripts or subscript "
+                          "dimension range exceeded.");
+        return StatementFinished::Yes;
+    }
+
+    ApplyCompoundAssignment(element.value(), assignment->m_Operator, value);
+
+    const phi::boolean stored = array.SetElement(subscripts, phi::move(element.value()));
+    PHI_ASSERT(stored);
+    PHI_UNUSED_VARIABLE(stored);
+
+    return StatementFinished::Yes;
+}
+
+Interpreter::StatementFinished Interpreter::InterpretMapAssignment(
+        phi::not_null_observer_ptr<const ASTVariableAssignment> assignment, const Variant& value)
+{
+    const phi::optional<Variant> key = InterpretMapKey(assignment->m_Subscripts);
+    if (!key)
+    {
+        return StatementFinished::Yes;
+    }
+
+    auto variable_opt = vm().LookupVariableRefByName(assignment->m_VariableName);
+    if (!variable_opt || !variable_opt->IsMap())
+    {
+        vm().RuntimeError("Subscript used on non-accessible variable.");
+        return StatementFinished::Yes;
+    }
+
+    Variant& element = variable_opt->AsMap().FindOrInsert(key.value());
+
+    if (assignment->m_Operator == TokenKind::OP_Equals)
+    {
+        element = value;
+    }
+    else
+    {
+        ApplyCompoundAssignment(element, assignment->m_Operator, value);
+    }
+
+    return StatementFinished::Yes;
+}
+
+Interpreter::StatementFinished Interpreter::InterpretReDimStatement(
+        phi::not_null_observer_ptr<const ASTReDimStatement> statement)
+{
+    // NOTE: Evaluated first since the dimensions may be computed from the array itself
+    ArraySubscripts dimensions;
+    if (!InterpretSubscripts(statement->m_Dimensions, dimensions))
+    {
+        return StatementFinished::Yes;
+    }
+
+    auto variable_opt = vm().LookupVariableRefByName(statement->m_VariableName);
+    if (!variable_opt)
+    {
+        vm().RuntimeError("No variable named '{}'", std::string_view(statement->m_VariableName));
+        return StatementFinished::Yes;
+    }
+    Variant& variable = variable_opt.value();
+
+    if (!variable.IsArray())
+    {
+        vm().RuntimeError("\"ReDim\" used without an array variable.");
+        return StatementFinished::Yes;
+    }
+
+    if (!variable.AsArray().ReDim(dimensions))
+    {
+        vm().RuntimeError("Array maximum size exceeded.");
+    }
+
+    return StatementFinished::Yes;
+}
+
+Interpreter::StatementFinished Interpreter::InterpretForStatement(
+        phi::not_null_observer_ptr<const ASTForStatement> statement)
+{
+    // NOTE: The loop state lives in the scope containing the For statement. When the body scope
+    //       finishes we end up here again which is the back edge of the loop.
+    ForLoopState& loop = vm().GetCurrentScope().for_loop;
+
+    if (!loop.active)
+    {
+        // Start, end and step are only evaluated once when entering the loop
+        const Variant start =
+                InterpretTieredExpression(statement->m_StartExpression.not_null_observer())
+                        .CastToNumeric();
+        const Variant end =
+                InterpretTieredExpression(statement->m_EndExpression.not_null_observer())
+                        .CastToNumeric();
+
+        const phi::observer_ptr<const ASTExpression> step_expression =
+                statement->m_StepExpression.observer();
+        const Variant step =
+                step_expression ?
+                        InterpretTieredExpression(step_expression.not_null()).CastToNumeric() :
+                        Variant::MakeInt(1);
+
+        if (!vm().CanRun())
+        {
+            return StatementFinished::Yes;
+        }
+
+        // The loop variable is implicitly declared if it doesn't exist yet
+        const phi::string_view variable_name = statement->m_VariableName;
+        if (!vm().LookupVariableRefByName(variable_name))
+        {
+            vm().PushVariable(variable_name, {});
+        }
+
+        auto variable = vm().LookupVariableRefByName(variable_name);
+        PHI_ASSERT(variable.has_value());
+
+        loop.active     = true;
+        loop.variable   = &variable.value();
+        loop.is_integer = start.IsInt64() && end.IsInt64() && step.IsInt64();
+
+        if (loop.is_integer)
+        {
+            loop.int_counter = start.AsInt64().unsafe();
+            loop.int_end     = end.AsInt64().unsafe();
+            loop.int_step    = step.AsInt64().unsafe();
+        }
+        else
+        {
+            loop.double_counter = NumericToDouble(start);
+            loop.double_end     = NumericToDouble(end);
+            loop.double_step    = NumericToDouble(step);
+        }
+    }
+    else
+    {
+        CountBackEdge(statement->m_RegionIndex);
+
+        if (!AdvanceForCounter(loop))
+        {
+            // The counter overflowed so the end can never be reached
+            loop.active = false;
+            return StatementFinished::Yes;
+        }
+    }
+
+    // Write the new counter value back to the variable
+    PHI_ASSERT(loop.variable != nullptr);
+    if (loop.is_integer)
+    {
+        WriteBackForCounter(*loop.variable, loop.int_counter);
+    }
+    else
+    {
+        WriteBackForCounter(*loop.variable, loop.double_counter);
+    }
+
+    if (!IsForCounterInRange(loop))
+    {
+        loop.active = false;
+        return StatementFinished::Yes;
+    }
+
+    // Interpret the loop body
+    vm().PushBlockScope(statement->m_Statements);
+    return StatementFinished::No;
+}
+
+Interpreter::StatementFinished Interpreter::InterpretForInStatement(
+        phi::not_null_observer_ptr<const ASTForInStatement> statement)
+{
+    // NOTE: Like For...To...Step the loop state lives in the scope containing the statement
+    ForLoopState& loop = vm().GetCurrentScope().for_loop;
+
+    if (!loop.active)
+    {
+        Variant collection =
+                InterpretExpression(statement->m_CollectionExpression.not_null_observer());
+        if (!vm().CanRun())
+        {
+            return StatementFinished::Yes;
+        }
+
+        if (!collection.IsArray() && !collection.IsMap())
+        {
+            vm().RuntimeError("\"For...In\" used without an array or map.");
+            return StatementFinished::Yes;
+        }
+
+        // The loop variable is implicitly declared if it doesn't exist yet
+        const phi::string_view variable_name = statement->m_VariableName;
+        if (!vm().LookupVariableRefByName(variable_name))
+        {
+            vm().PushVariable(variable_name, {});
+        }
+
+        auto variable = vm().LookupVariableRefByName(variable_name);
+        PHI_ASSERT(variable.has_value());
+
+        loop.active     = true;
+        loop.variable   = &variable.value();
+        loop.collection = phi::move(collection);
+        loop.position   = 0u;
+    }
+    else
+    {
+        CountBackEdge(statement->m_RegionIndex);
+    }
+
+    PHI_ASSERT(loop.variable != nullptr);
+    phi::boolean has_element{false};
+
+    // NOTE: Only read through the const accessors, the mutable ones would copy the payload which
+    //       is still shared with the variable
+    const Variant& collection = loop.collection;
+
+    if (collection.IsArray())
+    {
+        const Array& array = collection.AsArray();
+        if (loop.position < array.GetElementCount())
+        {
+            *loop.variable = array.GetElementAt(loop.position);
+            has_element    = true;
+        }
+    }
+    else
+    {
+        // Removed entries are skipped, the remaining ones are visited in insertion order
+        const std::vector<Map::Entry>& entries = collection.AsMap().GetEntries();
+        while (loop.position < entries.size() && entries[loop.position].removed)
+        {
+            ++loop.position;
+        }
+
+        if (loop.position < entries.size())
+        {
+            *loop.variable = entries[loop.position].value;
+            has_element    = true;
+        }
+    }
+
+    if (!has_element)
+    {
+        loop.active     = false;
+        loop.collection = {};
+        return StatementFinished::Yes;
+    }
+
+    ++loop.position;
+
+    // Interpret the loop body
+    vm().PushBlockScope(statement->m_Statements);
+    return StatementFinished::No;
+}
+
+Variant Interpreter::InterpretExpression(
+        phi::not_null_observer_ptr<const ASTExpression> expression)
+{
+    switch (expression->NodeType())
+    {
+        case ASTNodeType::ArrayLiteral:
+            return InterpretArrayLiteral(expression->as<ASTArrayLiteral>());
+
+        case ASTNodeType::ArraySubscriptExpression: {
+            auto subscript_expression = expression->as<ASTArraySubscriptExpression>();
+
+            // NOTE: Copying the array only shares its payload
+            const Variant array_value = InterpretExpression(
+                    subscript_expression->m_ArrayExpression.not_null_observer());
+
+            if (array_value.IsMap())
+            {
+                const phi::optional<Variant> key =
+                        InterpretMapKey(subscript_expression->m_IndexExpressions);
+                if (!key)
+                {
+                    return {};
+                }
+
+                // Reading a key which doesn't exist results in an empty string
+                const phi::observer_ptr<const Variant> element =
+                        array_value.AsMap().Find(key.value());
+
+                return element ? *element : Variant{};
+            }
+
+            if (!array_value.IsArray())
+            {
+                vm().RuntimeError("Subscript used on non-accessible variable.");
+                return {};
+            }
+
+            ArraySubscripts subscripts;
+            if (!InterpretSubscripts(subscript_expression->m_IndexExpressions, subscripts))
+            {
+                return {};
+            }
+
+            phi::optional<Variant> element = array_value.AsArray().GetElement(subscripts);
+            if (!element)
+            {
+                vm().RuntimeError("Array variable has incorrect number of subscripts or subscript "
+                                  "dimension range exceeded.");
+                return {};
+            }
+
+            return phi::move(element.value());
+        }
+
+        case ASTNodeType::BinaryExpression: {
+            auto binary_expression = expression->as<ASTBinaryExpression>();
+
+            const Variant lhs_value =
+                    InterpretExpression(binary_expression->m_LHS.not_null_observer());
+
+            // And/Or short-circuit, the right hand side is only evaluated if it decides the result
+            const TokenKind op = binary_expression->m_Operator;
+            if (op == TokenKind::KW_And || op == TokenKind::KW_Or)
+            {
+                const phi::boolean lhs_boolean = lhs_value.CastToBoolean().AsBoolean();
+                if (lhs_boolean == (op == TokenKind::KW_Or))
+                {
+                    return Variant::MakeBoolean(lhs_boolean);
+                }
+
+                return InterpretExpression(binary_expression->m_RHS.not_null_observer())
+                        .CastToBoolean();
+            }
+
+            const Variant rhs_value =
+                    InterpretExpression(binary_expression->m_RHS.not_null_observer());
+
+            return EvaluateBinaryExpression(lhs_value, rhs_value, op);
+        }
+
+        case ASTNodeType::BooleanLiteral: {
+            auto boolean_literal = expression->as<ASTBooleanLiteral>();
+
+            return Variant::MakeBoolean(boolean_literal->m_Value);
+        }
+
+        case ASTNodeType::FunctionCallExpression: {
+            // TODO: What happens when you assign variable to the return of a void function?
+            auto function_call_expression = expression->as<ASTFunctionCallExpression>();
+
+            // MapAppend and MapRemove modify the map passed to them
+            if (function_call_expression->IsBuiltIn() &&
+                (function_call_expression->FunctionRef().BuiltIn() == TokenKind::BI_MapAppend ||
+                 function_call_expression->FunctionRef().BuiltIn() == TokenKind::BI_MapRemove))
+            {
+                return InterpretMapModifyingFunctionCall(function_call_expression);
+            }
+
+            if (function_call_expression->IsBuiltIn() &&
+                (function_call_expression->FunctionRef().BuiltIn() == TokenKind::BI_StringRegExp ||
+                 function_call_expression->FunctionRef().BuiltIn() ==
+                         TokenKind::BI_StringRegExpReplace))
+            {
+                return InterpretRegexFunctionCall(function_call_expression);
+            }
+
+            if (function_call_expression->IsBuiltIn() &&
+                function_call_expression->FunctionRef().BuiltIn() == TokenKind::BI_StringFormat)
+            {
+                return InterpretStringFormatFunctionCall(function_call_expression);
+            }
+
+            // Evaluate all arguments
+            const std::vector<Variant> arguments =
+                    InterpretExpressions(function_call_expression->m_Arguments);
+
+            // Handle builtin functions seperately
+            if (function_call_expression->IsBuiltIn())
+            {
+                return InterpretBuiltInFunctionCall(
+                        function_call_expression->FunctionRef().BuiltIn(), arguments);
+            }
+
+            return InterpretFunctionCall(function_call_expression->FunctionRef().Function(),
+                                         arguments);
+        }
+
+        case ASTNodeType::FunctionReferenceExpression: {
+            auto function_reference_expression = expression->as<ASTFunctionReferenceExpression>();
+            (void)function_reference_expression;
+
+            // TODO: Support function references
+            return {};
+        }
+
+        case ASTNodeType::IntegerLiteral: {
+            auto integer_literal = expression->as<ASTIntegerLiteral>();
+
+            return Variant::MakeInt(integer_literal->m_Value);
+        }
+
+        case ASTNodeType::KeywordLiteral: {
+            auto keyword_literal = expression->as<ASTKeywordLiteral>();
+
+            return Variant::MakeKeyword(keyword_literal->m_Keyword);
+        }
+
+        case ASTNodeType::FloatLiteral: {
+            auto float_literal = expression->as<ASTFloatLiteral>();
+
+            return Variant::MakeDouble(float_literal->m_Value);
+        }
+
+        case ASTNodeType::StringLiteral: {
+            auto string_literal = expression->as<ASTStringLiteral>();
+
+            return Variant::MakeString(string_literal->m_Value);
+        }
+
+        case ASTNodeType::TernaryIfExpression: {
+            auto ternary_expression = expression->as<ASTTernaryIfExpression>();
+
+            const Variant condition_value = InterpretExpression(
+                    ternary_expression->m_ConditionExpression.not_null_observer());
+
+            if (condition_value.CastToBoolean().AsBoolean())
+            {
+                return InterpretExpression(
+                        ternary_expression->m_TrueExpression.not_null_observer());
+            }
+
+            return InterpretExpression(ternary_expression->m_FalseExpression.not_null_observer());
+        }
+
+        case ASTNodeType::MacroExpression: {
+            auto macro_expression = expression->as<ASTMacroExpression>();
+
+            const TokenKind macro = macro_expression->m_Macro;
+
+            return EvaluateMacroExpression(macro);
+        }
+
+        case ASTNodeType::UnaryExpression: {
+            auto unary_expression = expression->as<ASTUnaryExpression>();
+
+            const Variant expression_value =
+                    InterpretExpression(unary_expression->m_Expression.not_null_observer());
+
+            return EvaluateUnaryExpression(expression_value, unary_expression->m_Operator);
+        }
+
+        case ASTNodeType::VariableExpression: {
+            const auto variable_expression = expression->as<ASTVariableExpression>();
+
+            const phi::string_view variable_name = variable_expression->m_VariableName;
+
+            // NOTE: Copying the Variant only shares its payload, so reading large strings or
+            //       arrays doesn't copy them
+            const auto value =
+                    static_cast<const VirtualMachine&>(vm()).LookupVariableRefByName(variable_name);
+            if (!value)
+            {
+                vm().RuntimeError("No variable named '{}'", std::string_view(variable_name));
+                return {};
+            }
+
+            return value.value();
+        }
+
+        default:
+            PHI_ASSERT_NOT_REACHED();
+    }
+
+    PHI_ASSERT_NOT_REACHED();
+    return {};
+}
+
+Variant Interpreter::InterpretTieredExpression(
+        phi::not_null_observer_ptr<const ASTExpression> expression)
+{
+    // Only operators are worth compiling, everything else is already a single step. Operators
+    // which weren't created by the parser of the current document have no profile.
+    if (expression->m_OperatorIndex >= m_ExpressionProfiles.size())
+    {
+        return InterpretExpression(expression);
+    }
+
+    ExpressionProfile& profile = m_ExpressionProfiles[expression->m_OperatorIndex];
+
+    switch (profile.tier)
+    {
+        case ExpressionTier::Interpreted:
+            if (IsRegionHot(expression->m_RegionIndex))
+            {
+                profile.compiled = CompiledExpression::Compile(expression);
+                profile.tier     = profile.compiled ? ExpressionTier::Compiled :
+                                                      ExpressionTier::NotCompilable;
+            }
+            return InterpretExpression(expression);
+
+        case ExpressionTier::Compiled: {
+            Variant result;
+            if (profile.compiled->Execute(vm(), result))
+            {
+                return result;
+            }
+
+            // A type guard failed so we deoptimize to the interpreter. If this keeps happening the
+            // expression isn't type stable and we stop trying
+            if (++profile.deoptimization_count >= MaxDeoptimizations)
+            {
+                profile.tier = ExpressionTier::NotCompilable;
+            }
+            return InterpretExpression(expression);
+        }
+
+        case ExpressionTier::NotCompilable:
+            return InterpretExpression(expression);
+    }
+
+    PHI_ASSERT_NOT_REACHED();
+    return {};
+}
+
+void Interpreter::CountCall(phi::size_t region)
+{
+    if (region >= m_RegionProfiles.size())
+    {
+        return;
+    }
+
+    RegionProfile& profile = m_RegionProfiles[region];
+    if (!profile.hot && ++profile.call_count >= HotCallThreshold)
+    {
+        profile.hot = true;
+    }
+}
+
+void Interpreter::CountBackEdge(phi::size_t region)
+{
+    if (region >= m_RegionProfiles.size())
+    {
+        return;
+    }
+
+    RegionProfile& profile = m_RegionProfiles[region];
+    if (!profile.hot && ++profile.back_edge_count >= HotBackEdgeThreshold)
+    {
+        profile.hot = true;
+    }
+}
+
+phi::boolean Interpreter::IsRegionHot(phi::size_t region) const
+{
+    // Operators outside of any function or loop are only evaluated once
+    while (region < m_RegionProfiles.size())
+    {
+        if (m_RegionProfiles[region].hot)
+        {
+            return true;
+        }
+
+        region = m_Document->m_RegionParents[region];
+    }
+
+    return false;
+}
+
+Interpreter::ExpressionTier Interpreter::GetExpressionTier(const ASTExpression& expression) const
+{
+    if (expression.m_OperatorIndex >= m_ExpressionProfiles.size())
+    {
+        return ExpressionTier::NotCompilable;
+    }
+
+    return m_ExpressionProfiles[expression.m_OperatorIndex].tier;
+}
+
+Variant Interpreter::InterpretArrayLiteral(
+        phi::not_null_observer_ptr<const ASTArrayLiteral> array_literal)
+{
+    ArraySubscripts dimensions;
+    MeasureArrayLiteral(*array_literal, dimensions, 0u);
+
+    Array array;
+    if (!array.ReDim(dimensions))
+    {
+        vm().RuntimeError("Array maximum size exceeded.");
+        return {};
+    }
+
+    ArraySubscripts subscripts;
+    subscripts.count = dimensions.count;
+    InterpretArrayLiteralElements(*array_literal, array, subscripts, 0u);
+
+    return Variant::MakeArray(phi::move(array));
+}
+
+void Interpreter::InterpretArrayLiteralElements(const ASTArrayLiteral& array_literal, Array& array,
+                                                ArraySubscripts&  subscripts,
+                                                const phi::size_t depth)
+{
+    for (phi::size_t index{0u}; index < array_literal.m_Elements.size(); ++index)
+    {
+        const auto& element = array_literal.m_Elements[index];
+
+        subscripts.values[depth] = index;
+
+        if (element->NodeType() == ASTNodeType::ArrayLiteral &&
+            depth + 1u < array.GetDimensionCount())
+        {
+            InterpretArrayLiteralElements(*element->as<ASTArrayLiteral>(), array, subscripts,
+                                          depth + 1u);
+            continue;
+        }
+
+        // A plain value inside a nested literal like the 1 in '[1, [2, 3]]' is stored at the first
+        // element of the remaining dimensions
+        for (phi::size_t dimension = depth + 1u; dimension < subscripts.count; ++dimension)
+        {
+            subscripts.values[dimension] = 0u;
+        }
+
+        const phi::boolean stored =
+                array.SetElement(subscripts, InterpretExpression(element.not_null_observer()));
+        PHI_ASSERT(stored);
+        PHI_UNUSED_VARIABLE(stored);
+    }
+}
+
+phi::boolean Interpreter::InterpretSubscripts(
+        const std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions,
+        ArraySubscripts&                                           subscripts)
+{
+    if (expressions.size() > MaxArrayDimensions)
+    {
+        vm().RuntimeError("Array variable has incorrect number of subscripts or subscript "
+                          "dimension range exceeded.");
+        return false;
+    }
+
+    subscripts.count = expressions.size();
+    for (phi::size_t index{0u}; index < expressions.size(); ++index)
+    {
+        const Variant value =
+                InterpretExpression(expressions[index].not_null_observer()).CastToInt64();
+        PHI_ASSERT(value.IsInt64());
+
+        const phi::int64_t subscript = value.AsInt64().unsafe();
+        if (subscript < 0)
+        {
+            vm().RuntimeError("Array variable has incorrect number of subscripts or subscript "
+                              "dimension range exceeded.");
+            return false;
+        }
+
+        subscripts.values[index] = static_cast<phi::size_t>(subscript);
+    }
+
+    return true;
+}
+
+phi::optional<Variant> Interpreter::InterpretMapKey(
+        const std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions)
+{
+    if (expressions.size() != 1u)
+    {
+        vm().RuntimeError("Map variable has incorrect number of subscripts.");
+        return {};
+    }
+
+    Variant key = InterpretExpression(expressions.front().not_null_observer());
+    if (!Map::IsValidKey(key))
+    {
+        vm().RuntimeError("Map keys must be strings or integers.");
+        return {};
+    }
+
+    return phi::move(key);
+}
+
+std::vector<Variant> Interpreter::InterpretExpressions(
+        const std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions)
+{
+    std::vector<Variant> ret;
+    ret.reserve(expressions.size());
+
+    for (const auto& expression : expressions)
+    {
+        ret.emplace_back(InterpretExpression(expression.not_null_observer()));
+    }
+
+    return ret;
+}
+
+Variant Interpreter::InterpretBuiltInFunctionCall(const TokenKind             function,
+                                                  const std::vector<Variant>& arguments)
+{
+    // TODO: Is pretty incovinient that every function has to check for itself that it hast the right amount of arguments etc.
+
+    switch (function)
+    {
+        // https://www.autoitscript.com/autoit3/docs/functions/Abs.htm
+        case TokenKind::BI_Abs: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_Abs(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/AscW.htm
+        case TokenKind::BI_AscW: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_AscW(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/Binary.htm
+        case TokenKind::BI_Binary: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_Binary(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/BinaryLen.htm
+        case TokenKind::BI_BinaryLen: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_BinaryLen(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/BinaryMid.htm
+        case TokenKind::BI_BinaryMid: {
+            if (arguments.size() == 2u)
+            {
+                return BuiltIn_BinaryMid(m_VirtualMachine, arguments.at(0u), arguments.at(1u),
+                                         Variant::MakeKeyword(TokenKind::KW_Default));
+            }
+            if (arguments.size() != 3u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_BinaryMid(m_VirtualMachine, arguments.at(0u), arguments.at(1u),
+                                     arguments.at(2u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/BinaryToString.htm
+        case TokenKind::BI_BinaryToString: {
+            if (arguments.size() == 1u)
+            {
+                return BuiltIn_BinaryToString(m_VirtualMachine, arguments.at(0u),
+                                              Variant::MakeKeyword(TokenKind::KW_Default));
+            }
+            if (arguments.size() != 2u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_BinaryToString(m_VirtualMachine, arguments.at(0u), arguments.at(1u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/ChrW.htm
+        case TokenKind::BI_ChrW: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_ChrW(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/ConsoleWrite.htm
+        case TokenKind::BI_ConsoleWrite: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_ConsoleWrite(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/ConsoleWriteError.htm
+        case TokenKind::BI_ConsoleWriteError: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_ConsoleWriteError(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/DirGetSize.htm
+        case TokenKind::BI_DirGetSize: {
+            if (arguments.size() < 1u || arguments.size() > 2u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_DirGetSize(m_VirtualMachine, arguments.at(0u),
+                                      arguments.size() > 1u ? arguments.at(1u) : default_value);
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileClose.htm
+        case TokenKind::BI_FileClose: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_FileClose(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileFindFirstFile.htm
+        case TokenKind::BI_FileFindFirstFile: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_FileFindFirstFile(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileFindNextFile.htm
+        case TokenKind::BI_FileFindNextFile: {
+            if (arguments.size() < 1u || arguments.size() > 2u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_FileFindNextFile(
+                    m_VirtualMachine, arguments.at(0u),
+                    arguments.size() > 1u ? arguments.at(1u) : default_value);
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileGetPos.htm
+        case TokenKind::BI_FileGetPos: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_FileGetPos(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileOpen.htm
+        case TokenKind::BI_FileOpen: {
+            if (arguments.size() < 1u || arguments.size() > 2u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_FileOpen(m_VirtualMachine, arguments.at(0u),
+                                    arguments.size() > 1u ? arguments.at(1u) : default_value);
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileRead.htm
+        case TokenKind::BI_FileRead: {
+            if (arguments.size() < 1u || arguments.size() > 2u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_FileRead(m_VirtualMachine, arguments.at(0u),
+                                    arguments.size() > 1u ? arguments.at(1u) : default_value);
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileReadLine.htm
+        case TokenKind::BI_FileReadLine: {
+            if (arguments.size() < 1u || arguments.size() > 2u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_FileReadLine(m_VirtualMachine, arguments.at(0u),
+                                        arguments.size() > 1u ? arguments.at(1u) : default_value);
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileReadToArray.htm
+        case TokenKind::BI_FileReadToArray: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_FileReadToArray(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/FileSetPos.htm
+        case TokenKind::BI_FileSetPos: {
+            if (arguments.size() != 3u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_FileSetPos(m_VirtualMachine, arguments.at(0u), arguments.at(1u),
+                                      arguments.at(2u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/VarGetType.htm
+        case TokenKind::BI_VarGetType: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_VarGetType(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/IsBinary.htm
+        case TokenKind::BI_IsBinary: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_IsBinary(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/IsMap.htm
+        case TokenKind::BI_IsMap: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_IsMap(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/MapExists.htm
+        case TokenKind::BI_MapExists: {
+            if (arguments.size() != 2u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_MapExists(m_VirtualMachine, arguments.at(0u), arguments.at(1u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/MapKeys.htm
+        case TokenKind::BI_MapKeys: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_MapKeys(m_VirtualMachine, arguments.at(0u));
+        }
+
+        // https://www.autoitscript.com/autoit3/docs/functions/StringAddCR.htm
+        case TokenKind::BI_StringAddCR: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
+
+            return BuiltIn_StringAddCR(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::FunctionCallExpression: {
-            // TODO: What happens when you assign variable to the return of a void function?
-            auto function_call_expression = expression->as<ASTFunctionCallExpression>();
+        // https://www.autoitscript.com/autoit3/docs/functions/StringInStr.htm
+        case TokenKind::BI_StringInStr: {
+            if (arguments.size() < 2u || arguments.size() > 6u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            // Evaluate all arguments
-            const std::vector<Variant> arguments =
-                    InterpretExpressions(function_call_expression->m_Arguments);
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_StringInStr(
+                    m_VirtualMachine, arguments.at(0u), arguments.at(1u),
+                    arguments.size() > 2u ? arguments.at(2u) : default_value,
+                    arguments.size() > 3u ? arguments.at(3u) : default_value,
+                    arguments.size() > 4u ? arguments.at(4u) : default_value,
+                    arguments.size() > 5u ? arguments.at(5u) : default_value);
+        }
 
-            // Handle builtin functions seperately
-            if (function_call_expression->IsBuiltIn())
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsAlNum.htm
+        case TokenKind::BI_StringIsAlNum: {
+            if (arguments.size() != 1u)
             {
-                return InterpretBuiltInFunctionCall(
-                        function_call_expression->FunctionRef().BuiltIn(), arguments);
+                // TODO: Error
+                return {};
             }
 
-            return InterpretFunctionCall(function_call_expression->FunctionRef().Function(),
-                                         arguments);
+            return BuiltIn_StringIsAlNum(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::FunctionReferenceExpression: {
-            auto function_reference_expression = expression->as<ASTFunctionReferenceExpression>();
-            (void)function_reference_expression;
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsAlpha.htm
+        case TokenKind::BI_StringIsAlpha: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            // TODO: Support function references
-            return {};
+            return BuiltIn_StringIsAlpha(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::IntegerLiteral: {
-            auto integer_literal = expression->as<ASTIntegerLiteral>();
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsASCII.htm
+        case TokenKind::BI_StringIsASCII: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            return Variant::MakeInt(integer_literal->m_Value);
+            return BuiltIn_StringIsASCII(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::KeywordLiteral: {
-            auto keyword_literal = expression->as<ASTKeywordLiteral>();
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsDigit.htm
+        case TokenKind::BI_StringIsDigit: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            return Variant::MakeKeyword(keyword_literal->m_Keyword);
+            return BuiltIn_StringIsDigit(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::FloatLiteral: {
-            auto float_literal = expression->as<ASTFloatLiteral>();
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsLower.htm
+        case TokenKind::BI_StringIsLower: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            return Variant::MakeDouble(float_literal->m_Value);
+            return BuiltIn_StringIsLower(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::StringLiteral: {
-            auto string_literal = expression->as<ASTStringLiteral>();
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsSpace.htm
+        case TokenKind::BI_StringIsSpace: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            return Variant::MakeString(string_literal->m_Value);
+            return BuiltIn_StringIsSpace(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::TernaryIfExpression: {
-            auto ternary_expression = expression->as<ASTTernaryIfExpression>();
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsUpper.htm
+        case TokenKind::BI_StringIsUpper: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            const Variant condition_value =
-                    InterpretExpression(ternary_expression->m_ConditionExpression);
+            return BuiltIn_StringIsUpper(m_VirtualMachine, arguments.at(0u));
+        }
 
-            if (condition_value.CastToBoolean().AsBoolean())
+        // https://www.autoitscript.com/autoit3/docs/functions/StringIsXDigit.htm
+        case TokenKind::BI_StringIsXDigit: {
+            if (arguments.size() != 1u)
             {
-                return InterpretExpression(ternary_expression->m_TrueExpression);
+                // TODO: Error
+                return {};
             }
 
-            return InterpretExpression(ternary_expression->m_FalseExpression);
+            return BuiltIn_StringIsXDigit(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::MacroExpression: {
-            auto macro_expression = expression->as<ASTMacroExpression>();
-
-            const TokenKind macro = macro_expression->m_Macro;
+        // https://www.autoitscript.com/autoit3/docs/functions/StringLeft.htm
+        case TokenKind::BI_StringLeft: {
+            if (arguments.size() != 2u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            return EvaluateMacroExpression(macro);
+            return BuiltIn_StringLeft(m_VirtualMachine, arguments.at(0u), arguments.at(1u));
         }
 
-        case ASTNodeType::UnaryExpression: {
-            // TODO: add const
-            auto unary_expression = expression->as<ASTUnaryExpression>();
-
-            Variant expression_value = InterpretExpression(unary_expression->m_Expression);
+        // https://www.autoitscript.com/autoit3/docs/functions/StringLen.htm
+        case TokenKind::BI_StringLen: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            return EvaluateUnaryExpression(expression_value, unary_expression->m_Operator);
+            return BuiltIn_StringLen(m_VirtualMachine, arguments.at(0u));
         }
 
-        case ASTNodeType::VariableExpression: {
-            const auto variable_expression = expression->as<ASTVariableExpression>();
+        // https://www.autoitscript.com/autoit3/docs/functions/StringLower.htm
+        case TokenKind::BI_StringLower: {
+            if (arguments.size() != 1u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-            const phi::string_view variable_name = variable_expression->m_VariableName;
+            return BuiltIn_StringLower(m_VirtualMachine, arguments.at(0u));
+        }
 
-            auto value = vm().LookupVariableByName(variable_name);
-            if (!value)
+        // https://www.autoitscript.com/autoit3/docs/functions/StringMid.htm
+        case TokenKind::BI_StringMid: {
+            if (arguments.size() < 2u || arguments.size() > 3u)
             {
-                vm().RuntimeError("No variable named '{}'", std::string_view(variable_name));
+                // TODO: Error
                 return {};
             }
 
-            return value.value();
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_StringMid(m_VirtualMachine, arguments.at(0u), arguments.at(1u),
+                                     arguments.size() > 2u ? arguments.at(2u) : default_value);
         }
 
-        default:
-            PHI_ASSERT_NOT_REACHED();
-    }
+        // https://www.autoitscript.com/autoit3/docs/functions/StringReplace.htm
+        case TokenKind::BI_StringReplace: {
+            if (arguments.size() < 3u || arguments.size() > 5u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-    PHI_ASSERT_NOT_REACHED();
-    return {};
-}
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_StringReplace(
+                    m_VirtualMachine, arguments.at(0u), arguments.at(1u), arguments.at(2u),
+                    arguments.size() > 3u ? arguments.at(3u) : default_value,
+                    arguments.size() > 4u ? arguments.at(4u) : default_value);
+        }
 
-std::vector<Variant> Interpreter::InterpretExpressions(
-        std::vector<phi::not_null_scope_ptr<ASTExpression>>& expressions)
-{
-    std::vector<Variant> ret;
-    ret.reserve(expressions.size());
+        // https://www.autoitscript.com/autoit3/docs/functions/StringRight.htm
+        case TokenKind::BI_StringRight: {
+            if (arguments.size() != 2u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-    for (auto& expression : expressions)
-    {
-        ret.emplace_back(InterpretExpression(expression));
-    }
+            return BuiltIn_StringRight(m_VirtualMachine, arguments.at(0u), arguments.at(1u));
+        }
 
-    return ret;
-}
+        // https://www.autoitscript.com/autoit3/docs/functions/StringSplit.htm
+        case TokenKind::BI_StringSplit: {
+            if (arguments.size() < 2u || arguments.size() > 3u)
+            {
+                // TODO: Error
+                return {};
+            }
 
-Variant Interpreter::InterpretBuiltInFunctionCall(const TokenKind             function,
-                                                  const std::vector<Variant>& arguments)
-{
-    // TODO: Is pretty incovinient that every function has to check for itself that it hast the right amount of arguments etc.
+            const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+            return BuiltIn_StringSplit(m_VirtualMachine, arguments.at(0u), arguments.at(1u),
+                                       arguments.size() > 2u ? arguments.at(2u) : default_value);
+        }
 
-    switch (function)
-    {
-        // https://www.autoitscript.com/autoit3/docs/functions/Abs.htm
-        case TokenKind::BI_Abs: {
+        // https://www.autoitscript.com/autoit3/docs/functions/StringStripCR.htm
+        case TokenKind::BI_StringStripCR: {
             if (arguments.size() != 1u)
             {
                 // TODO: Error
                 return {};
             }
 
-            return BuiltIn_Abs(m_VirtualMachine, arguments.at(0u));
+            return BuiltIn_StringStripCR(m_VirtualMachine, arguments.at(0u));
         }
 
-        // https://www.autoitscript.com/autoit3/docs/functions/ConsoleWrite.htm
-        case TokenKind::BI_ConsoleWrite: {
-            if (arguments.size() != 1u)
+        // https://www.autoitscript.com/autoit3/docs/functions/StringStripWS.htm
+        case TokenKind::BI_StringStripWS: {
+            if (arguments.size() != 2u)
             {
                 // TODO: Error
                 return {};
             }
 
-            return BuiltIn_ConsoleWrite(m_VirtualMachine, arguments.at(0u));
+            return BuiltIn_StringStripWS(m_VirtualMachine, arguments.at(0u), arguments.at(1u));
         }
 
-        // https://www.autoitscript.com/autoit3/docs/functions/ConsoleWriteError.htm
-        case TokenKind::BI_ConsoleWriteError: {
+        // https://www.autoitscript.com/autoit3/docs/functions/StringUpper.htm
+        case TokenKind::BI_StringUpper: {
             if (arguments.size() != 1u)
             {
                 // TODO: Error
                 return {};
             }
 
-            return BuiltIn_ConsoleWriteError(m_VirtualMachine, arguments.at(0u));
+            return BuiltIn_StringUpper(m_VirtualMachine, arguments.at(0u));
         }
 
-        // https://www.autoitscript.com/autoit3/docs/functions/VarGetType.htm
-        case TokenKind::BI_VarGetType: {
-            if (arguments.size() != 1u)
+        // https://www.autoitscript.com/autoit3/docs/functions/UBound.htm
+        case TokenKind::BI_UBound: {
+            if (arguments.size() == 1u)
+            {
+                return BuiltIn_UBound(m_VirtualMachine, arguments.at(0u), Variant::MakeInt(1));
+            }
+            if (arguments.size() != 2u)
             {
                 // TODO: Error
                 return {};
             }
 
-            return BuiltIn_VarGetType(m_VirtualMachine, arguments.at(0u));
+            return BuiltIn_UBound(m_VirtualMachine, arguments.at(0u), arguments.at(1u));
         }
 
         case TokenKind::BI_ConsoleWriteLine: {
@@ -429,10 +1955,142 @@ Variant Interpreter::InterpretBuiltInFunctionCall(const TokenKind             fu
     return {};
 }
 
+Variant Interpreter::InterpretMapModifyingFunctionCall(
+        phi::not_null_observer_ptr<const ASTFunctionCallExpression> function_call)
+{
+    const TokenKind function  = function_call->FunctionRef().BuiltIn();
+    const auto&     arguments = function_call->m_Arguments;
+
+    if (arguments.size() != 2u)
+    {
+        // TODO: Error
+        return {};
+    }
+
+    // The map is passed by reference so it has to be a variable
+    if (arguments.front()->NodeType() != ASTNodeType::VariableExpression)
+    {
+        vm().RuntimeError("{:s} requires a map variable as its first argument",
+                          enum_name(function));
+        return {};
+    }
+    const phi::string_view variable_name =
+            arguments.front()->as<ASTVariableExpression>()->m_VariableName;
+
+    const Variant argument = InterpretExpression(arguments.back().not_null_observer());
+
+    auto variable = vm().LookupVariableRefByName(variable_name);
+    if (!variable)
+    {
+        vm().RuntimeError("No variable named '{}'", std::string_view(variable_name));
+        return {};
+    }
+
+    switch (function)
+    {
+        // https://www.autoitscript.com/autoit3/docs/functions/MapAppend.htm
+        case TokenKind::BI_MapAppend:
+            return BuiltIn_MapAppend(m_VirtualMachine, variable.value(), argument);
+
+        // https://www.autoitscript.com/autoit3/docs/functions/MapRemove.htm
+        case TokenKind::BI_MapRemove:
+            return BuiltIn_MapRemove(m_VirtualMachine, variable.value(), argument);
+
+        default:
+            PHI_ASSERT_NOT_REACHED();
+            return {};
+    }
+}
+
+Variant Interpreter::InterpretRegexFunctionCall(
+        phi::not_null_observer_ptr<const ASTFunctionCallExpression> function_call)
+{
+    const TokenKind function = function_call->FunctionRef().BuiltIn();
+
+    const phi::size_t minimum_arguments = function == TokenKind::BI_StringRegExp ? 2u : 3u;
+    if (function_call->m_Arguments.size() < minimum_arguments ||
+        function_call->m_Arguments.size() > 4u)
+    {
+        // TODO: Error
+        return {};
+    }
+
+    const std::vector<Variant> arguments = InterpretExpressions(function_call->m_Arguments);
+
+    const Regex* regex{nullptr};
+    if (function_call->m_Arguments.at(1u)->NodeType() == ASTNodeType::StringLiteral)
+    {
+        auto [call_site, inserted] = m_RegexCallSites.try_emplace(function_call.get(), nullptr);
+        if (inserted)
+        {
+            call_site->second = vm().GetRegexCache().GetPinned(arguments.at(1u).AsString());
+        }
+        regex = call_site->second;
+    }
+    else
+    {
+        const Variant pattern = arguments.at(1u).CastToString();
+        regex                 = vm().GetRegexCache().Get(pattern.AsString());
+    }
+
+    const Variant default_value = Variant::MakeKeyword(TokenKind::KW_Default);
+    switch (function)
+    {
+        // https://www.autoitscript.com/autoit3/docs/functions/StringRegExp.htm
+        case TokenKind::BI_StringRegExp:
+            return BuiltIn_StringRegExp(m_VirtualMachine, arguments.at(0u), regex,
+                                        arguments.size() > 2u ? arguments.at(2u) : default_value,
+                                        arguments.size() > 3u ? arguments.at(3u) : default_value);
+
+        // https://www.autoitscript.com/autoit3/docs/functions/StringRegExpReplace.htm
+        case TokenKind::BI_StringRegExpReplace:
+            return BuiltIn_StringRegExpReplace(
+                    m_VirtualMachine, arguments.at(0u), regex, arguments.at(2u),
+                    arguments.size() > 3u ? arguments.at(3u) : default_value);
+
+        default:
+            PHI_ASSERT_NOT_REACHED();
+            return {};
+    }
+}
+
+// https://www.autoitscript.com/autoit3/docs/functions/StringFormat.htm
+Variant Interpreter::InterpretStringFormatFunctionCall(
+        phi::not_null_observer_ptr<const ASTFunctionCallExpression> function_call)
+{
+    if (function_call->m_Arguments.size() < 2u || function_call->m_Arguments.size() > 33u)
+    {
+        // TODO: Error
+        return {};
+    }
+
+    const std::vector<Variant> arguments = InterpretExpressions(function_call->m_Arguments);
+
+    const FormatString* format{nullptr};
+    if (function_call->m_Arguments.at(0u)->NodeType() == ASTNodeType::StringLiteral)
+    {
+        auto [call_site, inserted] = m_FormatCallSites.try_emplace(function_call.get(), nullptr);
+        if (inserted)
+        {
+            call_site->second =
+                    vm().GetFormatStringCache().GetPinned(arguments.at(0u).AsString());
+        }
+        format = call_site->second;
+    }
+    else
+    {
+        const Variant format_control = arguments.at(0u).CastToString();
+        format = vm().GetFormatStringCache().Get(format_control.AsString());
+    }
+
+    PHI_ASSERT(format != nullptr);
+    return BuiltIn_StringFormat(m_VirtualMachine, *format, arguments);
+}
+
 Variant Interpreter::InterpretFunctionCall(const phi::string_view      function,
                                            const std::vector<Variant>& arguments)
 {
-    phi::observer_ptr<ASTFunctionDefinition> function_definition =
+    const phi::observer_ptr<const ASTFunctionDefinition> function_definition =
             m_Document->LookupFunctionDefinitionByName(function);
 
     if (!function_definition)
@@ -441,14 +2099,15 @@ Variant Interpreter::InterpretFunctionCall(const phi::string_view      function,
         return {};
     }
 
+    CountCall(function_definition->m_RegionIndex);
+
     // Push new function scope
     vm().PushFunctionScope(function, function_definition->m_FunctionBody);
 
     // Push arguments into the new scope
     for (phi::usize index{0u}; index < function_definition->m_Parameters.size(); ++index)
     {
-        // TODO: This should be const but theres currently a bug in Phi which prevents us more doing so
-        FunctionParameter& parameter = function_definition->m_Parameters.at(index.unsafe());
+        const FunctionParameter& parameter = function_definition->m_Parameters.at(index.unsafe());
 
         // Check if the argument was explicitly provided
         if (index < arguments.size())
@@ -511,6 +2170,8 @@ Variant Interpreter::EvaluateMacroExpression(const TokenKind macro)
             return Variant::MakeString("\r\n");
         case TokenKind::MK_LF:
             return Variant::MakeString("\n");
+        case TokenKind::MK_TAB:
+            return Variant::MakeString("\t");
 
         default:
             vm().RuntimeError("Unimplemented macro '{:s}'", enum_name(macro));
@@ -522,87 +2183,52 @@ Variant Interpreter::EvaluateMacroExpression(const TokenKind macro)
 
 Variant Interpreter::EvaluateBinaryExpression(const Variant& lhs, const Variant& rhs, TokenKind op)
 {
-    // TODO: Lots of operators missing here
+    // NOTE: And/Or short-circuit so they're handled while interpreting the expression
     switch (op)
     {
         case TokenKind::OP_Plus:
-            return EvaluateBinaryPlusExpression(lhs, rhs);
+            return lhs.Add(rhs);
 
         case TokenKind::OP_Minus:
-            return EvaluateBinaryMinusExpression(lhs, rhs);
+            return lhs.Subtract(rhs);
 
         case TokenKind::OP_Multiply:
-            return EvaluateBinaryMultiplyExpression(lhs, rhs);
+            return lhs.Multiply(rhs);
 
         case TokenKind::OP_Divide:
-            return EvaluateBinaryDivideExpression(lhs, rhs);
+            return lhs.Divide(rhs);
+
+        case TokenKind::OP_Raise:
+            return lhs.Power(rhs);
 
         case TokenKind::OP_Concatenate:
             return lhs.Concatenate(rhs);
 
-        default:
-            return {};
-    }
-}
-
-Variant Interpreter::EvaluateBinaryPlusExpression(const Variant& lhs, const Variant& rhs)
-{
-    // TODO: We currently only support adding integer which is not correct
-    if (!lhs.IsInt64() || !rhs.IsInt64())
-    {
-        return {};
-    }
-
-    return Variant::MakeInt(UnsafeAdd(lhs.AsInt64(), rhs.AsInt64()));
-}
+        // NOTE: Inside of expressions '=' is a comparison
+        case TokenKind::OP_Equals:
+            return lhs.Equal(rhs);
 
-Variant Interpreter::EvaluateBinaryMinusExpression(const Variant& lhs, const Variant& rhs)
-{
-    if (!lhs.IsInt64() || !rhs.IsInt64())
-    {
-        return {};
-    }
+        case TokenKind::OP_EqualsEquals:
+            return lhs.EqualCaseSensitive(rhs);
 
-    return Variant::MakeInt(UnsafeMinus(lhs.AsInt64(), rhs.AsInt64()));
-}
+        case TokenKind::OP_NotEqual:
+            return lhs.NotEqual(rhs);
 
-Variant Interpreter::EvaluateBinaryMultiplyExpression(const Variant& lhs, const Variant& rhs)
-{
-    if (!lhs.IsInt64() || !rhs.IsInt64())
-    {
-        return {};
-    }
+        case TokenKind::OP_LessThan:
+            return lhs.LessThan(rhs);
 
-    return Variant::MakeInt(UnsafeMultiply(lhs.AsInt64(), rhs.AsInt64()));
-}
+        case TokenKind::OP_LessThanEqual:
+            return lhs.LessThanEqual(rhs);
 
-Variant Interpreter::EvaluateBinaryDivideExpression(const Variant& lhs, const Variant& rhs)
-{
-    if (!lhs.IsInt64() || !rhs.IsInt64())
-    {
-        return {};
-    }
+        case TokenKind::OP_GreaterThan:
+            return lhs.GreaterThan(rhs);
 
-    // Return infinity when dividing by 0
-    if (rhs.AsInt64() == 0)
-    {
-        if (lhs.AsInt64() == 0)
-        {
-            return Variant::MakeDouble(phi::f64::limits_type::quiet_NaN());
-        }
-        if (lhs.AsInt64() < 0)
-        {
-            return Variant::MakeDouble(-phi::f64::limits_type::infinity());
-        }
-        if (lhs.AsInt64() > 0)
-        {
-            return Variant::MakeDouble(phi::f64::limits_type::infinity());
-        }
+        case TokenKind::OP_GreaterThanEqual:
+            return lhs.GreaterThanEqual(rhs);
 
-        PHI_ASSERT_NOT_REACHED();
+        default:
+            return {};
     }
-
-    return Variant::MakeInt(UnsafeDivide(lhs.AsInt64(), rhs.AsInt64()));
 }
 
 } // namespace OpenAutoIt
@@ -0,0 +1,214 @@
+#include "OpenAutoIt/LineBreak.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/ThreadPool.hpp"
+#include "OpenAutoIt/Variant.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <bit>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    [[nodiscard]] constexpr phi::boolean IsLineBreak(const char character)
+    {
+        return character == '\n' || character == '\r';
+    }
+
+    // Calls function(offset, breaks) for every block of up to 16 bytes in [begin, end) with one bit
+    // set per line break starting in the block. A LF directly behind a CR belongs to the line break
+    // of the CR even if the CR is in front of begin.
+    template <typename FunctionT>
+    void ForEachLineBreakBlock(const std::string_view string, phi::size_t begin,
+                               const phi::size_t end, FunctionT&& function)
+    {
+        unsigned int carry = begin > 0u && string[begin - 1u] == '\r' ? 1u : 0u;
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; begin + 16u <= end; begin += 16u)
+        {
+            const __m128i      bytes = LoadUnaligned(string.data() + begin);
+            const unsigned int cr    = MatchByte(bytes, '\r');
+            const unsigned int lf    = MatchByte(bytes, '\n');
+
+            function(begin, cr | (lf & ~((cr << 1u) | carry)));
+            carry = cr >> 15u;
+        }
+#endif
+
+        for (; begin < end; begin += 16u)
+        {
+            const phi::size_t size = std::min<phi::size_t>(end - begin, 16u);
+
+            unsigned int cr{0u};
+            unsigned int lf{0u};
+            for (phi::size_t index{0u}; index < size; ++index)
+            {
+                cr |= static_cast<unsigned int>(string[begin + index] == '\r') << index;
+                lf |= static_cast<unsigned int>(string[begin + index] == '\n') << index;
+            }
+
+            function(begin, cr | (lf & ~((cr << 1u) | carry)));
+            carry = (cr >> (size - 1u)) & 1u;
+        }
+    }
+
+    [[nodiscard]] phi::size_t CountLineBreaks(const std::string_view string,
+                                              const phi::size_t begin, const phi::size_t end)
+    {
+        phi::size_t count{0u};
+        ForEachLineBreakBlock(string, begin, end,
+                              [&count](const phi::size_t /*offset*/, const unsigned int breaks) {
+                                  count += static_cast<phi::size_t>(std::popcount(breaks));
+                              });
+
+        return count;
+    }
+
+    // Start of the line containing the offset
+    [[nodiscard]] phi::size_t FindLineStart(const std::string_view string, phi::size_t offset)
+    {
+        while (offset > 0u && !IsLineBreak(string[offset - 1u]))
+        {
+            --offset;
+        }
+
+        // The offset might point at the LF of a CRLF
+        if (offset > 0u && offset < string.size() && string[offset - 1u] == '\r' &&
+            string[offset] == '\n')
+        {
+            ++offset;
+        }
+
+        return offset;
+    }
+
+    // Stores every line ending in [begin, end) starting at lines[first_line]. The last chunk also
+    // stores the last line if it doesn't end with a line break.
+    void SplitChunk(const std::string_view string, const phi::size_t begin, const phi::size_t end,
+                    std::vector<Variant>& lines, phi::size_t first_line)
+    {
+        phi::size_t line_start  = FindLineStart(string, begin);
+        const auto  store_lines = [&](const phi::size_t offset, unsigned int breaks) {
+            for (; breaks != 0u; breaks &= breaks - 1u)
+            {
+                const phi::size_t line_break =
+                        offset + static_cast<phi::size_t>(std::countr_zero(breaks));
+
+                lines[first_line++] =
+                        Variant::MakeString(string.substr(line_start, line_break - line_start));
+                line_start = line_break + GetLineBreakSize(string, line_break);
+            }
+        };
+
+        ForEachLineBreakBlock(string, begin, end, store_lines);
+
+        if (end == string.size() && line_start < string.size())
+        {
+            lines[first_line] = Variant::MakeString(string.substr(line_start));
+        }
+    }
+} // namespace
+
+phi::size_t FindLineBreak(const std::string_view string)
+{
+    phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+    for (; index + 16u <= string.size(); index += 16u)
+    {
+        const __m128i bytes = LoadUnaligned(string.data() + index);
+        if (const unsigned int line_breaks = MatchByte(bytes, '\n') | MatchByte(bytes, '\r');
+            line_breaks != 0u)
+        {
+            return index + static_cast<phi::size_t>(std::countr_zero(line_breaks));
+        }
+    }
+#endif
+
+    for (; index < string.size(); ++index)
+    {
+        if (IsLineBreak(string[index]))
+        {
+            return index;
+        }
+    }
+
+    return string.size();
+}
+
+phi::size_t CountLines(const std::string_view string)
+{
+    const phi::boolean has_last_line = !string.empty() && !IsLineBreak(string.back());
+
+    return CountLineBreaks(string, 0u, string.size()) + (has_last_line ? 1u : 0u);
+}
+
+std::vector<Variant> SplitLines(const std::string_view              string,
+                                const phi::observer_ptr<ThreadPool> pool)
+{
+    if (!pool)
+    {
+        std::vector<Variant> lines(CountLines(string));
+        SplitChunk(string, 0u, string.size(), lines, 0u);
+
+        return lines;
+    }
+
+    // Chunks are cut at arbitrary bytes since line breaks are found relative to the whole string
+    const phi::size_t chunk_count = std::min<phi::size_t>(
+            pool->GetNumberOfThreads().unsafe(), std::max<phi::size_t>(string.size() / 16u, 1u));
+    const phi::size_t chunk_size = string.size() / chunk_count;
+
+    std::vector<phi::size_t> chunk_starts(chunk_count + 1u);
+    for (phi::size_t chunk{0u}; chunk < chunk_count; ++chunk)
+    {
+        chunk_starts[chunk] = chunk * chunk_size;
+    }
+    chunk_starts[chunk_count] = string.size();
+
+    // Count the line breaks of every chunk to know where its lines go
+    // NOTE: The pool may be shared with other callers so only the tasks of this call are awaited
+    TaskGroup                group;
+    std::vector<phi::size_t> first_lines(chunk_count + 1u);
+    for (phi::size_t chunk{0u}; chunk < chunk_count; ++chunk)
+    {
+        pool->Submit(group, [&, chunk]() {
+            first_lines[chunk + 1u] =
+                    CountLineBreaks(string, chunk_starts[chunk], chunk_starts[chunk + 1u]);
+        });
+    }
+    pool->Wait(group);
+
+    for (phi::size_t chunk{0u}; chunk < chunk_count; ++chunk)
+    {
+        first_lines[chunk + 1u] += first_lines[chunk];
+    }
+
+    const phi::boolean   has_last_line = !string.empty() && !IsLineBreak(string.back());
+    std::vector<Variant> lines(first_lines[chunk_count] + (has_last_line ? 1u : 0u));
+
+    for (phi::size_t chunk{0u}; chunk < chunk_count; ++chunk)
+    {
+        // No line ends in the chunk. Skipping it also keeps looking for the start of the first line
+        // of every chunk linear in total.
+        if (first_lines[chunk + 1u] == first_lines[chunk] && chunk + 1u < chunk_count)
+        {
+            continue;
+        }
+
+        pool->Submit(group, [&, chunk]() {
+            SplitChunk(string, chunk_starts[chunk], chunk_starts[chunk + 1u], lines,
+                       first_lines[chunk]);
+        });
+    }
+    pool->Wait(group);
+
+    return lines;
+}
+} // namespace OpenAutoIt
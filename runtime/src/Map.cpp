@@ -0,0 +1,263 @@
+#include "OpenAutoIt/Map.hpp"
+
+#include "OpenAutoIt/Variant.hpp"
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/observer_ptr.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    constexpr const phi::uint32_t EmptySlot{0u};
+    constexpr const phi::uint32_t RemovedSlot{1u};
+
+    // Occupied slots store the entry index offset by this
+    constexpr const phi::uint32_t FirstEntrySlot{2u};
+
+    constexpr const phi::size_t MinimumSlotCount{8u};
+
+    // Small maps are never compacted since it wouldn't save anything
+    constexpr const phi::size_t MinimumEntriesForCompaction{8u};
+
+    [[nodiscard]] phi::boolean KeysEqual(const Variant& lhs, const Variant& rhs)
+    {
+        if (lhs.GetType() != rhs.GetType())
+        {
+            return false;
+        }
+
+        if (lhs.IsInt64())
+        {
+            return lhs.AsInt64().unsafe() == rhs.AsInt64().unsafe();
+        }
+
+        return lhs.AsString() == rhs.AsString();
+    }
+
+    // Finalizer of splitmix64 so consecutive integers spread over the whole table
+    [[nodiscard]] constexpr phi::uint64_t MixBits(phi::uint64_t value)
+    {
+        value ^= value >> 30u;
+        value *= 0xbf58476d1ce4e5b9u;
+        value ^= value >> 27u;
+        value *= 0x94d049bb133111ebu;
+        value ^= value >> 31u;
+
+        return value;
+    }
+} // namespace
+
+phi::boolean Map::IsValidKey(const Variant& key)
+{
+    return key.IsInt64() || key.IsString();
+}
+
+phi::size_t Map::GetSize() const
+{
+    return m_Size;
+}
+
+phi::observer_ptr<const Variant> Map::Find(const Variant& key) const
+{
+    if (m_Size == 0u || !IsValidKey(key))
+    {
+        return nullptr;
+    }
+
+    const phi::size_t   slot  = FindSlot(key, HashKey(key));
+    const phi::uint32_t entry = m_Slots[slot];
+    if (entry < FirstEntrySlot)
+    {
+        return nullptr;
+    }
+
+    return phi::observer_ptr<const Variant>{&m_Entries[entry - FirstEntrySlot].value};
+}
+
+phi::boolean Map::Contains(const Variant& key) const
+{
+    return static_cast<bool>(Find(key));
+}
+
+Variant& Map::FindOrInsert(const Variant& key)
+{
+    PHI_ASSERT(IsValidKey(key));
+
+    const phi::uint64_t hash = HashKey(key);
+
+    if (!m_Slots.empty())
+    {
+        const phi::uint32_t entry = m_Slots[FindSlot(key, hash)];
+        if (entry >= FirstEntrySlot)
+        {
+            return m_Entries[entry - FirstEntrySlot].value;
+        }
+    }
+
+    // Keep the table at most half full so probe sequences stay short
+    if ((m_UsedSlots + 1u) * 2u > m_Slots.size())
+    {
+        Rebuild();
+    }
+
+    const phi::size_t slot = FindSlot(key, hash);
+    if (m_Slots[slot] == EmptySlot)
+    {
+        ++m_UsedSlots;
+    }
+    m_Slots[slot] = static_cast<phi::uint32_t>(m_Entries.size()) + FirstEntrySlot;
+
+    m_Entries.push_back(Entry{key, {}, hash, false});
+    ++m_Size;
+
+    if (key.IsInt64() && key.AsInt64().unsafe() >= m_NextIntKey)
+    {
+        const phi::int64_t int_key = key.AsInt64().unsafe();
+        m_NextIntKey = int_key == std::numeric_limits<phi::int64_t>::max() ? int_key : int_key + 1;
+    }
+
+    return m_Entries.back().value;
+}
+
+phi::boolean Map::Remove(const Variant& key)
+{
+    if (m_Size == 0u || !IsValidKey(key))
+    {
+        return false;
+    }
+
+    const phi::size_t   slot  = FindSlot(key, HashKey(key));
+    const phi::uint32_t entry = m_Slots[slot];
+    if (entry < FirstEntrySlot)
+    {
+        return false;
+    }
+
+    // Release the payloads right away but keep the entry so the positions of all other entries
+    // stay the same
+    Entry& removed_entry  = m_Entries[entry - FirstEntrySlot];
+    removed_entry.key     = {};
+    removed_entry.value   = {};
+    removed_entry.removed = true;
+
+    m_Slots[slot] = RemovedSlot;
+    --m_Size;
+
+    // Compact once most entries are removed
+    if (m_Entries.size() >= MinimumEntriesForCompaction && m_Size * 2u < m_Entries.size())
+    {
+        Rebuild();
+    }
+
+    return true;
+}
+
+phi::int64_t Map::Append(Variant value)
+{
+    const phi::int64_t key = m_NextIntKey;
+
+    FindOrInsert(Variant::MakeInt(key)) = phi::move(value);
+
+    return key;
+}
+
+const std::vector<Map::Entry>& Map::GetEntries() const
+{
+    return m_Entries;
+}
+
+phi::uint64_t Map::HashKey(const Variant& key)
+{
+    if (key.IsInt64())
+    {
+        return MixBits(static_cast<phi::uint64_t>(key.AsInt64().unsafe()));
+    }
+
+    const std::string& string = key.AsString();
+    return MixBits(std::hash<std::string_view>{}(std::string_view{string}));
+}
+
+phi::size_t Map::FindSlot(const Variant& key, const phi::uint64_t hash) const
+{
+    PHI_ASSERT(!m_Slots.empty());
+
+    // NOTE: The slot count is always a power of two
+    const phi::size_t mask = m_Slots.size() - 1u;
+
+    phi::size_t  slot = static_cast<phi::size_t>(hash) & mask;
+    phi::size_t  first_removed_slot{0u};
+    phi::boolean seen_removed_slot{false};
+
+    // There is always at least one empty slot so this terminates
+    while (true)
+    {
+        const phi::uint32_t entry = m_Slots[slot];
+
+        if (entry == EmptySlot)
+        {
+            return seen_removed_slot ? first_removed_slot : slot;
+        }
+
+        if (entry == RemovedSlot)
+        {
+            if (!seen_removed_slot)
+            {
+                first_removed_slot = slot;
+                seen_removed_slot  = true;
+            }
+        }
+        else
+        {
+            const Entry& candidate = m_Entries[entry - FirstEntrySlot];
+            if (candidate.hash == hash && KeysEqual(candidate.key, key))
+            {
+                return slot;
+            }
+        }
+
+        slot = (slot + 1u) & mask;
+    }
+}
+
+void Map::Rebuild()
+{
+    // Drop removed entries
+    if (m_Size != m_Entries.size())
+    {
+        m_Entries.erase(std::remove_if(m_Entries.begin(), m_Entries.end(),
+                                       [](const Entry& entry) { return entry.removed; }),
+                        m_Entries.end());
+    }
+    PHI_ASSERT(m_Entries.size() == m_Size);
+
+    phi::size_t slot_count = MinimumSlotCount;
+    while (slot_count < (m_Size + 1u) * 4u)
+    {
+        slot_count *= 2u;
+    }
+
+    m_Slots.assign(slot_count, EmptySlot);
+    m_UsedSlots = m_Size;
+
+    const phi::size_t mask = slot_count - 1u;
+    for (phi::size_t index{0u}; index < m_Entries.size(); ++index)
+    {
+        phi::size_t slot = static_cast<phi::size_t>(m_Entries[index].hash) & mask;
+        while (m_Slots[slot] != EmptySlot)
+        {
+            slot = (slot + 1u) & mask;
+        }
+
+        m_Slots[slot] = static_cast<phi::uint32_t>(index) + FirstEntrySlot;
+    }
+}
+} // namespace OpenAutoIt
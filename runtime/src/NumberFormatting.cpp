@@ -0,0 +1,235 @@
+#include "OpenAutoIt/NumberFormatting.hpp"
+
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <cmath>
+#include <string_view>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // AutoIt never displays more than 15 significant digits
+    constexpr const phi::size_t MaxSignificantDigits{15u};
+
+    // A double split into its significant decimal digits and the exponent of the first digit
+    struct DecimalDigits
+    {
+        phi::boolean negative{false};
+        char         digits[NumberBufferSize]{};
+        phi::size_t  count{0u};
+        phi::int32_t exponent{0};
+    };
+
+    // Parses the output of fmt which is either in fixed like "-123.45" or in exponent notation like
+    // "1.5e+20"
+    [[nodiscard]] DecimalDigits ParseFormattedDouble(const char* begin, const char* end)
+    {
+        DecimalDigits result;
+
+        const char* it = begin;
+        if (it != end && *it == '-')
+        {
+            result.negative = true;
+            ++it;
+        }
+
+        phi::int32_t integer_digits{0};
+        phi::boolean seen_dot{false};
+        phi::boolean seen_non_zero{false};
+        phi::int32_t leading_fraction_zeros{0};
+
+        for (; it != end && *it != 'e'; ++it)
+        {
+            const char character = *it;
+            if (character == '.')
+            {
+                seen_dot = true;
+                continue;
+            }
+
+            if (!seen_dot)
+            {
+                ++integer_digits;
+            }
+
+            if (!seen_non_zero && character == '0')
+            {
+                if (seen_dot)
+                {
+                    ++leading_fraction_zeros;
+                }
+                continue;
+            }
+
+            seen_non_zero = true;
+            PHI_ASSERT(result.count < NumberBufferSize);
+            result.digits[result.count++] = character;
+        }
+
+        phi::int32_t exponent{0};
+        if (it != end)
+        {
+            // Skip the 'e'
+            ++it;
+
+            phi::boolean negative_exponent{false};
+            if (*it == '-' || *it == '+')
+            {
+                negative_exponent = *it == '-';
+                ++it;
+            }
+
+            for (; it != end; ++it)
+            {
+                exponent = exponent * 10 + (*it - '0');
+            }
+
+            if (negative_exponent)
+            {
+                exponent = -exponent;
+            }
+        }
+
+        // Remove trailing zeros
+        while (result.count > 0u && result.digits[result.count - 1u] == '0')
+        {
+            --result.count;
+        }
+
+        // NOTE: For "0.001" the integer part only consists of zeros
+        if (integer_digits == 1 && begin[result.negative ? 1 : 0] == '0')
+        {
+            result.exponent = exponent - leading_fraction_zeros - 1;
+        }
+        else
+        {
+            result.exponent = exponent + integer_digits - 1;
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] DecimalDigits ToDecimalDigits(const double value)
+    {
+        char buffer[NumberBufferSize];
+
+        // The shortest representation which round trips is the same as rounding to 15 significant
+        // digits when it's short enough. This only holds when the double has its full precision
+        // which subnormals don't have.
+        if (std::fpclassify(value) != FP_SUBNORMAL)
+        {
+            char*         end    = fmt::format_to(buffer, "{}", value);
+            DecimalDigits result = ParseFormattedDouble(buffer, end);
+            if (result.count <= MaxSignificantDigits)
+            {
+                return result;
+            }
+        }
+
+        // Otherwise round to the significant digits AutoIt displays
+        char* end = fmt::format_to(buffer, "{:.{}e}", value, MaxSignificantDigits - 1u);
+        return ParseFormattedDouble(buffer, end);
+    }
+} // namespace
+
+std::string_view FormatInt64(const phi::int64_t value, NumberBuffer& buffer)
+{
+    const char* end = fmt::format_to(buffer.data(), "{}", value);
+
+    return {buffer.data(), static_cast<std::size_t>(end - buffer.data())};
+}
+
+std::string_view FormatDouble(const double value, NumberBuffer& buffer)
+{
+    // Same as the Microsoft C runtime AutoIt is using
+    if (std::isnan(value))
+    {
+        return "-1.#IND";
+    }
+    if (std::isinf(value))
+    {
+        return value < 0.0 ? "-1.#INF" : "1.#INF";
+    }
+
+    const DecimalDigits decimal = ToDecimalDigits(value);
+
+    char* out = buffer.data();
+    if (decimal.negative)
+    {
+        *out++ = '-';
+    }
+
+    // Zero has no significant digits
+    if (decimal.count == 0u)
+    {
+        *out++ = '0';
+        return {buffer.data(), static_cast<std::size_t>(out - buffer.data())};
+    }
+
+    const phi::int32_t exponent = decimal.exponent;
+
+    if (exponent < -4 || exponent >= static_cast<phi::int32_t>(MaxSignificantDigits))
+    {
+        // Exponent notation like "1.5e+020"
+        *out++ = decimal.digits[0];
+        if (decimal.count > 1u)
+        {
+            *out++ = '.';
+            for (phi::size_t index{1u}; index < decimal.count; ++index)
+            {
+                *out++ = decimal.digits[index];
+            }
+        }
+
+        out = fmt::format_to(out, "e{}{:03d}", exponent < 0 ? '-' : '+',
+                             exponent < 0 ? -exponent : exponent);
+    }
+    else if (exponent < 0)
+    {
+        // Like "0.00015"
+        *out++ = '0';
+        *out++ = '.';
+        for (phi::int32_t index{-1}; index > exponent; --index)
+        {
+            *out++ = '0';
+        }
+        for (phi::size_t index{0u}; index < decimal.count; ++index)
+        {
+            *out++ = decimal.digits[index];
+        }
+    }
+    else
+    {
+        // Like "1500" or "1.5"
+        const phi::size_t integer_digits = static_cast<phi::size_t>(exponent) + 1u;
+        for (phi::size_t index{0u}; index < integer_digits; ++index)
+        {
+            *out++ = index < decimal.count ? decimal.digits[index] : '0';
+        }
+
+        if (decimal.count > integer_digits)
+        {
+            *out++ = '.';
+            for (phi::size_t index = integer_digits; index < decimal.count; ++index)
+            {
+                *out++ = decimal.digits[index];
+            }
+        }
+    }
+
+    PHI_ASSERT(out <= buffer.data() + buffer.size());
+
+    return {buffer.data(), static_cast<std::size_t>(out - buffer.data())};
+}
+} // namespace OpenAutoIt
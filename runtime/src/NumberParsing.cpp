@@ -0,0 +1,229 @@
+#include "OpenAutoIt/NumberParsing.hpp"
+
+#include "OpenAutoIt/Arithmetic.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <phi/text/hex_digit_value.hpp>
+#include <phi/text/is_hex_digit.hpp>
+#include <charconv>
+#include <limits>
+#include <string_view>
+#include <system_error>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Up to this many decimal digits always fit into an uint64
+    constexpr const phi::size_t MaxMantissaDigits{19u};
+
+    // Every integer up to this value is exactly representable as a double
+    constexpr const phi::uint64_t MaxExactMantissa{phi::uint64_t(1u) << 53u};
+
+    // Powers of ten which are exactly representable as a double
+    constexpr const double exact_powers_of_ten[]{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+    constexpr const phi::int32_t MaxExactPowerOfTen{22};
+
+    // Exponents larger than this overflow or underflow any double anyway
+    constexpr const phi::int32_t MaxExponent{100'000};
+
+    [[nodiscard]] constexpr phi::boolean IsWhitespace(const char character)
+    {
+        switch (character)
+        {
+            case ' ':
+            case '\t':
+            case '\n':
+            case '\v':
+            case '\f':
+            case '\r':
+                return true;
+
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] constexpr phi::boolean IsDigit(const char character)
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    [[nodiscard]] Number ParseHexadecimal(const char* it, const char* end, const phi::boolean negative)
+    {
+        // NOTE: Values which don't fit wrap around like they do in AutoIt
+        phi::uint64_t value{0u};
+        for (; it != end && phi::is_hex_digit(*it); ++it)
+        {
+            value = (value << 4u) | static_cast<phi::uint64_t>(phi::hex_digit_value(*it).unsafe());
+        }
+
+        return Number::MakeInt(static_cast<phi::int64_t>(negative ? 0u - value : value));
+    }
+
+    // Converts the already validated number in [begin, end) using std::from_chars which is
+    // correctly rounded in every case
+    [[nodiscard]] double ParseDoubleSlow(const char* begin, const char* end,
+                                         const phi::boolean negative, const phi::int32_t exponent)
+    {
+        double value{0.0};
+
+        const std::from_chars_result result =
+                std::from_chars(begin, end, value, std::chars_format::general);
+        if (result.ec == std::errc::result_out_of_range)
+        {
+            value = exponent > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+
+            return negative ? -value : value;
+        }
+
+        return value;
+    }
+} // namespace
+
+Number ParseNumber(const std::string_view string)
+{
+    const char* it  = string.data();
+    const char* end = string.data() + string.size();
+
+    while (it != end && IsWhitespace(*it))
+    {
+        ++it;
+    }
+
+    phi::boolean negative{false};
+    if (it != end && (*it == '+' || *it == '-'))
+    {
+        negative = *it == '-';
+        ++it;
+    }
+
+    if (end - it > 2 && it[0] == '0' && (it[1] == 'x' || it[1] == 'X') &&
+        phi::is_hex_digit(it[2]))
+    {
+        return ParseHexadecimal(it + 2, end, negative);
+    }
+
+    // NOTE: std::from_chars accepts a leading '-' but no '+'
+    const char* number_begin = negative ? it - 1 : it;
+
+    // The digits are accumulated into the mantissa until it's full, the value is then
+    // mantissa * 10^exponent
+    phi::uint64_t mantissa{0u};
+    phi::size_t   mantissa_digits{0u};
+    phi::int32_t  exponent{0};
+    phi::boolean  truncated{false};
+    phi::boolean  is_double{false};
+    phi::boolean  has_digits{false};
+
+    for (; it != end && IsDigit(*it); ++it)
+    {
+        has_digits = true;
+        if (mantissa_digits < MaxMantissaDigits)
+        {
+            mantissa = mantissa * 10u + static_cast<phi::uint64_t>(*it - '0');
+            mantissa_digits += mantissa != 0u ? 1u : 0u;
+        }
+        else
+        {
+            truncated = truncated || *it != '0';
+            ++exponent;
+        }
+    }
+
+    if (it != end && *it == '.')
+    {
+        is_double = true;
+
+        for (++it; it != end && IsDigit(*it); ++it)
+        {
+            has_digits = true;
+            if (mantissa_digits < MaxMantissaDigits)
+            {
+                mantissa = mantissa * 10u + static_cast<phi::uint64_t>(*it - '0');
+                mantissa_digits += mantissa != 0u ? 1u : 0u;
+                --exponent;
+            }
+            else
+            {
+                truncated = truncated || *it != '0';
+            }
+        }
+    }
+
+    if (!has_digits)
+    {
+        return Number::MakeInt(0);
+    }
+
+    // The exponent is only used if it has at least one digit
+    if (it != end && (*it == 'e' || *it == 'E'))
+    {
+        const char* exponent_it = it + 1;
+
+        phi::boolean negative_exponent{false};
+        if (exponent_it != end && (*exponent_it == '+' || *exponent_it == '-'))
+        {
+            negative_exponent = *exponent_it == '-';
+            ++exponent_it;
+        }
+
+        if (exponent_it != end && IsDigit(*exponent_it))
+        {
+            is_double = true;
+
+            phi::int32_t exponent_value{0};
+            for (; exponent_it != end && IsDigit(*exponent_it); ++exponent_it)
+            {
+                if (exponent_value < MaxExponent)
+                {
+                    exponent_value = exponent_value * 10 + (*exponent_it - '0');
+                }
+            }
+
+            exponent += negative_exponent ? -exponent_value : exponent_value;
+            it = exponent_it;
+        }
+    }
+
+    if (!is_double && exponent == 0)
+    {
+        constexpr const phi::uint64_t max_int64 =
+                static_cast<phi::uint64_t>(std::numeric_limits<phi::int64_t>::max());
+
+        if (!negative && mantissa <= max_int64)
+        {
+            return Number::MakeInt(static_cast<phi::int64_t>(mantissa));
+        }
+        if (negative && mantissa <= max_int64 + 1u)
+        {
+            return Number::MakeInt(static_cast<phi::int64_t>(0u - mantissa));
+        }
+
+        // Too large for an Int64 so its converted to a double instead
+    }
+
+    // Fast path where both the mantissa and power of ten are exact so the result is correctly rounded
+    if (!truncated && mantissa <= MaxExactMantissa && exponent >= -MaxExactPowerOfTen &&
+        exponent <= MaxExactPowerOfTen)
+    {
+        double value = static_cast<double>(mantissa);
+        if (exponent < 0)
+        {
+            value /= exact_powers_of_ten[-exponent];
+        }
+        else
+        {
+            value *= exact_powers_of_ten[exponent];
+        }
+
+        return Number::MakeDouble(negative ? -value : value);
+    }
+
+    return Number::MakeDouble(ParseDoubleSlow(number_begin, it, negative, exponent));
+}
+} // namespace OpenAutoIt
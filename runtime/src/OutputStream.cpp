@@ -0,0 +1,176 @@
+#include "OpenAutoIt/OutputStream.hpp"
+
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <cerrno>
+#include <string_view>
+
+#if PHI_PLATFORM_IS(WINDOWS)
+#    include <io.h>
+#else
+#    include <sys/uio.h>
+#    include <unistd.h>
+#endif
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Don't reserve the whole buffer up front for huge thresholds
+    constexpr const phi::size_t MaximumInitialBufferSize{64u * 1024u};
+} // namespace
+
+FlushPolicy FlushPolicy::ForFileDescriptor(const int file_descriptor)
+{
+    FlushPolicy policy;
+#if PHI_PLATFORM_IS(WINDOWS)
+    policy.line_buffered = _isatty(file_descriptor) != 0;
+#else
+    policy.line_buffered = ::isatty(file_descriptor) != 0;
+#endif
+
+    return policy;
+}
+
+FlushPolicy FlushPolicy::Unbuffered()
+{
+    FlushPolicy policy;
+    policy.threshold = 0u;
+
+    return policy;
+}
+
+OutputStream::~OutputStream()
+{
+    Flush();
+}
+
+void OutputStream::SetHandler(OutputHandler handler)
+{
+    Flush();
+
+    m_Handler        = phi::move(handler);
+    m_FileDescriptor = -1;
+}
+
+void OutputStream::SetFileDescriptor(const int file_descriptor, const FlushPolicy policy)
+{
+    Flush();
+
+    m_Handler        = nullptr;
+    m_FileDescriptor = file_descriptor;
+    m_Policy         = policy;
+    m_Buffer.reserve(std::min(policy.threshold, MaximumInitialBufferSize));
+}
+
+void OutputStream::Write(const std::string_view message)
+{
+    if (m_Handler)
+    {
+        m_Handler(message);
+        return;
+    }
+
+    if (m_FileDescriptor < 0 || message.empty())
+    {
+        return;
+    }
+
+    if (m_Buffer.size() + message.size() > m_Policy.threshold)
+    {
+        WriteToFileDescriptor(m_Buffer, message);
+        m_Buffer.clear();
+        return;
+    }
+
+    m_Buffer.append(message);
+
+    if (m_Policy.line_buffered && message.find('\n') != std::string_view::npos)
+    {
+        Flush();
+    }
+}
+
+void OutputStream::Flush()
+{
+    if (m_Buffer.empty())
+    {
+        return;
+    }
+
+    WriteToFileDescriptor(m_Buffer, {});
+    m_Buffer.clear();
+}
+
+void OutputStream::WriteToFileDescriptor(const std::string_view buffered,
+                                         const std::string_view message) const
+{
+#if PHI_PLATFORM_IS(WINDOWS)
+    for (std::string_view part : {buffered, message})
+    {
+        while (!part.empty())
+        {
+            const int written = _write(m_FileDescriptor, part.data(),
+                                       static_cast<unsigned int>(std::min<phi::size_t>(
+                                               part.size(), 0x7FFFFFFFu)));
+            if (written <= 0)
+            {
+                // TODO: Error
+                return;
+            }
+
+            part.remove_prefix(static_cast<phi::size_t>(written));
+        }
+    }
+#else
+    // NOTE: iovec isn't const correct but writev never modifies the data
+    iovec vectors[2]{
+            {const_cast<char*>(buffered.data()), buffered.size()},
+            {const_cast<char*>(message.data()), message.size()},
+    };
+
+    iovec* current = vectors;
+    int    count{2};
+    while (count > 0)
+    {
+        // Skip parts which are completely written
+        if (current->iov_len == 0u)
+        {
+            ++current;
+            --count;
+            continue;
+        }
+
+        const ssize_t written = ::writev(m_FileDescriptor, current, count);
+        if (written < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+
+            // TODO: Error
+            return;
+        }
+
+        // Partial writes continue with the first byte which wasn't written
+        auto remaining = static_cast<phi::size_t>(written);
+        while (count > 0 && remaining >= current->iov_len)
+        {
+            remaining -= current->iov_len;
+            ++current;
+            --count;
+        }
+
+        if (count > 0)
+        {
+            current->iov_base = static_cast<char*>(current->iov_base) + remaining;
+            current->iov_len -= remaining;
+        }
+    }
+#endif
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,2068 @@
+#include "OpenAutoIt/Regex.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace OpenAutoIt
+{
+namespace
+{
+    constexpr const phi::uint32_t Unbounded{std::numeric_limits<phi::uint32_t>::max()};
+
+    // Largest count allowed in a {n,m} quantifier
+    constexpr const phi::uint32_t MaximumRepetitionCount{65535u};
+
+    // Counted repetitions are expanded so this limits patterns like "(a{1000}){1000}"
+    constexpr const phi::size_t MaximumProgramSize{100'000u};
+
+    // Failed states are only remembered while the memo for a search stays below this many entries
+    constexpr const phi::size_t MaximumMemoSize{1u << 21u};
+
+    // The DFA starts over from scratch once it has built this many states
+    constexpr const phi::size_t MaximumDFAStates{1'000u};
+
+    constexpr const char32_t MaximumCodePoint{0x10FFFF};
+
+    enum class AssertionKind : phi::uint8_t
+    {
+        BeginText,        // \A and ^
+        EndText,          // \z
+        EndTextOrNewLine, // \Z and $ which also match before a new line ending the subject
+        BeginLine,        // ^ in multiline mode
+        EndLine,          // $ in multiline mode
+        WordBoundary,     // \b
+        NotWordBoundary,  // \B
+    };
+
+    using CodePointRanges = std::vector<std::pair<char32_t, char32_t>>;
+
+    struct CharacterSet
+    {
+        [[nodiscard]] phi::boolean ContainsInRanges(const char32_t code_point) const
+        {
+            return std::any_of(ranges.begin(), ranges.end(), [&](const auto& range) {
+                return code_point >= range.first && code_point <= range.second;
+            });
+        }
+
+        [[nodiscard]] phi::boolean Matches(const char32_t code_point) const
+        {
+            phi::boolean contained = ContainsInRanges(code_point);
+            if (!contained && ignore_case)
+            {
+                contained = ContainsInRanges(ToLowerCase(code_point)) ||
+                            ContainsInRanges(ToUpperCase(code_point));
+            }
+
+            return contained != negated;
+        }
+
+        [[nodiscard]] phi::boolean Contains(const char32_t code_point) const
+        {
+            if (code_point < 128u)
+            {
+                return ascii[code_point];
+            }
+
+            return Matches(code_point);
+        }
+
+        // Precomputes the result for every ASCII character
+        void Finalize()
+        {
+            for (char32_t code_point{0u}; code_point < 128u; ++code_point)
+            {
+                ascii[code_point] = static_cast<bool>(Matches(code_point));
+            }
+        }
+
+        CodePointRanges  ranges;
+        std::bitset<128> ascii;
+        phi::boolean     negated{false};
+        phi::boolean     ignore_case{false};
+    };
+
+    enum class NodeKind : phi::uint8_t
+    {
+        Empty,
+        Character,
+        Any,
+        Set,
+        Concatenation,
+        Alternation,
+        Repetition,
+        Group,
+        Assertion,
+        Backreference,
+        LookAround,
+        Atomic,
+    };
+
+    struct Node
+    {
+        NodeKind          kind{NodeKind::Empty};
+        char32_t          code_point{0u};
+        phi::boolean      ignore_case{false}; // Character and Backreference
+        phi::boolean      dot_all{false};     // Any
+        phi::boolean      greedy{true};       // Repetition
+        phi::boolean      negated{false};     // LookAround
+        phi::boolean      behind{false};      // LookAround
+        AssertionKind     assertion{AssertionKind::BeginText};
+        phi::uint32_t     index{0u}; // Set index, group number or referenced group
+        phi::uint32_t     minimum{0u};
+        phi::uint32_t     maximum{0u};
+        std::vector<Node> children;
+    };
+
+    enum class OpCode : phi::uint8_t
+    {
+        Character,           // Consumes code_point
+        CharacterIgnoreCase, // Consumes a code point which case folds to code_point
+        Any,                 // Consumes any code point
+        AnyExceptNewLine,    // Consumes any code point except for a line feed
+        Set,                 // Consumes a code point of the character set argument
+        Split,               // Continues at argument and backtracks to alternative
+        Jump,                // Continues at argument
+        Save,                // Stores the position in the register argument
+        CheckProgress,       // Continues at alternative if the position equals register argument
+        Assertion,           // Checks the assertion argument without consuming anything
+        Backreference,       // Consumes the text captured by the group argument
+        LookAround,          // Checks the sub program following it and continues at alternative
+        Atomic,              // Runs the sub program following it and continues at alternative
+        Match,               // Ends the program or the sub program of a lookaround or atomic group
+    };
+
+    struct Instruction
+    {
+        OpCode        op;
+        phi::boolean  flag{false};   // Ignores case for Backreference, negates a LookAround
+        phi::boolean  behind{false}; // LookAround
+        phi::uint32_t argument{0u};
+        phi::uint32_t alternative{0u};
+        char32_t      code_point{0u}; // Also the width of a lookbehind in code points
+    };
+
+    [[nodiscard]] inline char32_t NextCodePoint(const std::string_view string, phi::size_t& index)
+    {
+        const auto byte = static_cast<unsigned char>(string[index]);
+        if (byte < 0x80u)
+        {
+            ++index;
+            return byte;
+        }
+
+        return DecodeUTF8(string, index);
+    }
+
+    [[nodiscard]] inline char32_t FoldCodePoint(const char32_t code_point)
+    {
+        if (code_point < 128u)
+        {
+            return static_cast<char32_t>(FoldASCII(static_cast<char>(code_point)));
+        }
+
+        return FoldCase(code_point);
+    }
+
+    [[nodiscard]] phi::boolean Accepts(const Instruction&               instruction,
+                                       const std::vector<CharacterSet>& sets,
+                                       const char32_t                   code_point)
+    {
+        switch (instruction.op)
+        {
+            case OpCode::Character:
+                return code_point == instruction.code_point;
+            case OpCode::CharacterIgnoreCase:
+                return FoldCodePoint(code_point) == instruction.code_point;
+            case OpCode::Any:
+                return true;
+            case OpCode::AnyExceptNewLine:
+                return code_point != '\n';
+            case OpCode::Set:
+                return sets[instruction.argument].Contains(code_point);
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] constexpr phi::boolean IsWordCharacter(const char character)
+    {
+        return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+               (character >= '0' && character <= '9') || character == '_';
+    }
+
+    [[nodiscard]] phi::boolean CheckAssertion(const AssertionKind    kind,
+                                              const std::string_view subject,
+                                              const phi::size_t      position)
+    {
+        switch (kind)
+        {
+            case AssertionKind::BeginText:
+                return position == 0u;
+            case AssertionKind::EndText:
+                return position == subject.size();
+            case AssertionKind::EndTextOrNewLine:
+                return position == subject.size() ||
+                       (position + 1u == subject.size() && subject[position] == '\n');
+            case AssertionKind::BeginLine:
+                return position == 0u || subject[position - 1u] == '\n';
+            case AssertionKind::EndLine:
+                return position == subject.size() || subject[position] == '\n';
+            case AssertionKind::WordBoundary:
+            case AssertionKind::NotWordBoundary: {
+                const phi::boolean before =
+                        position > 0u && IsWordCharacter(subject[position - 1u]);
+                const phi::boolean after =
+                        position < subject.size() && IsWordCharacter(subject[position]);
+
+                return (before != after) == (kind == AssertionKind::WordBoundary);
+            }
+        }
+
+        PHI_ASSERT_NOT_REACHED();
+    }
+
+    // Replaces the ranges with all code points not contained in them
+    [[nodiscard]] CodePointRanges Complement(CodePointRanges ranges)
+    {
+        std::sort(ranges.begin(), ranges.end());
+
+        CodePointRanges complement;
+        char32_t        next{0u};
+        for (const auto& [first, last] : ranges)
+        {
+            if (first > next)
+            {
+                complement.emplace_back(next, first - 1u);
+            }
+            next = std::max(next, static_cast<char32_t>(last + 1u));
+        }
+        if (next <= MaximumCodePoint)
+        {
+            complement.emplace_back(next, MaximumCodePoint);
+        }
+
+        return complement;
+    }
+
+    // Ranges of the \d, \w and \s classes and their negations \D, \W and \S
+    [[nodiscard]] phi::optional<CodePointRanges> ClassEscapeRanges(const char32_t letter)
+    {
+        CodePointRanges ranges;
+        switch (letter)
+        {
+            case 'd':
+            case 'D':
+                ranges = {{'0', '9'}};
+                break;
+            case 'w':
+            case 'W':
+                ranges = {{'0', '9'}, {'A', 'Z'}, {'_', '_'}, {'a', 'z'}};
+                break;
+            case 's':
+            case 'S':
+                ranges = {{'\t', '\r'}, {' ', ' '}};
+                break;
+            default:
+                return {};
+        }
+
+        if (letter == 'D' || letter == 'W' || letter == 'S')
+        {
+            return Complement(phi::move(ranges));
+        }
+
+        return ranges;
+    }
+
+    // Ranges of the POSIX classes like [:alpha:] which can be used inside of sets
+    [[nodiscard]] phi::optional<CodePointRanges> PosixClassRanges(const std::string_view name)
+    {
+        if (name == "alpha")
+        {
+            return CodePointRanges{{'A', 'Z'}, {'a', 'z'}};
+        }
+        if (name == "digit")
+        {
+            return CodePointRanges{{'0', '9'}};
+        }
+        if (name == "alnum")
+        {
+            return CodePointRanges{{'0', '9'}, {'A', 'Z'}, {'a', 'z'}};
+        }
+        if (name == "word")
+        {
+            return ClassEscapeRanges('w');
+        }
+        if (name == "space")
+        {
+            return ClassEscapeRanges('s');
+        }
+        if (name == "blank")
+        {
+            return CodePointRanges{{'\t', '\t'}, {' ', ' '}};
+        }
+        if (name == "upper")
+        {
+            return CodePointRanges{{'A', 'Z'}};
+        }
+        if (name == "lower")
+        {
+            return CodePointRanges{{'a', 'z'}};
+        }
+        if (name == "xdigit")
+        {
+            return CodePointRanges{{'0', '9'}, {'A', 'F'}, {'a', 'f'}};
+        }
+        if (name == "punct")
+        {
+            return CodePointRanges{{'!', '/'}, {':', '@'}, {'[', '`'}, {'{', '~'}};
+        }
+        if (name == "cntrl")
+        {
+            return CodePointRanges{{0x00, 0x1F}, {0x7F, 0x7F}};
+        }
+        if (name == "print")
+        {
+            return CodePointRanges{{' ', '~'}};
+        }
+        if (name == "graph")
+        {
+            return CodePointRanges{{'!', '~'}};
+        }
+        if (name == "ascii")
+        {
+            return CodePointRanges{{0x00, 0x7F}};
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] phi::optional<phi::uint32_t> HexDigitValue(const char character)
+    {
+        if (character >= '0' && character <= '9')
+        {
+            return static_cast<phi::uint32_t>(character - '0');
+        }
+        if (character >= 'a' && character <= 'f')
+        {
+            return static_cast<phi::uint32_t>(character - 'a' + 10);
+        }
+        if (character >= 'A' && character <= 'F')
+        {
+            return static_cast<phi::uint32_t>(character - 'A' + 10);
+        }
+
+        return {};
+    }
+
+    struct Options
+    {
+        phi::boolean ignore_case{false}; // (?i)
+        phi::boolean multi_line{false};  // (?m)
+        phi::boolean dot_all{false};     // (?s)
+        phi::boolean extended{false};    // (?x)
+    };
+
+    // Recursive descent parser turning a pattern into a tree of nodes. Inline options like (?i)
+    // are resolved while parsing so the nodes carry them directly.
+    class Parser
+    {
+    public:
+        Parser(const std::string_view pattern, std::vector<CharacterSet>& sets)
+            : m_Pattern{pattern}
+            , m_Sets{sets}
+        {}
+
+        [[nodiscard]] phi::optional<Node> Parse()
+        {
+            Node root = ParseAlternation();
+            if (m_Failed || !AtEnd() || m_HighestBackreference > m_GroupCount)
+            {
+                return {};
+            }
+
+            return root;
+        }
+
+        [[nodiscard]] phi::uint32_t GetGroupCount() const
+        {
+            return m_GroupCount;
+        }
+
+    private:
+        [[nodiscard]] phi::boolean AtEnd() const
+        {
+            return m_Position >= m_Pattern.size();
+        }
+
+        [[nodiscard]] char Peek(const phi::size_t ahead = 0u) const
+        {
+            return m_Position + ahead < m_Pattern.size() ? m_Pattern[m_Position + ahead] : '\0';
+        }
+
+        char32_t ConsumeCodePoint()
+        {
+            return NextCodePoint(m_Pattern, m_Position);
+        }
+
+        phi::boolean TryConsume(const char character)
+        {
+            if (!AtEnd() && m_Pattern[m_Position] == character)
+            {
+                ++m_Position;
+                return true;
+            }
+
+            return false;
+        }
+
+        Node Fail()
+        {
+            m_Failed = true;
+            return {};
+        }
+
+        void SkipExtendedWhitespace()
+        {
+            if (!m_Options.extended)
+            {
+                return;
+            }
+
+            while (!AtEnd())
+            {
+                if (IsWhitespace(Peek()))
+                {
+                    ++m_Position;
+                }
+                else if (Peek() == '#')
+                {
+                    while (!AtEnd() && Peek() != '\n')
+                    {
+                        ++m_Position;
+                    }
+                }
+                else
+                {
+                    break;
+                }
+            }
+        }
+
+        Node ParseAlternation()
+        {
+            std::vector<Node> alternatives;
+            alternatives.push_back(ParseConcatenation());
+            while (!m_Failed && TryConsume('|'))
+            {
+                alternatives.push_back(ParseConcatenation());
+            }
+
+            if (alternatives.size() == 1u)
+            {
+                return phi::move(alternatives.front());
+            }
+
+            Node node;
+            node.kind     = NodeKind::Alternation;
+            node.children = phi::move(alternatives);
+            return node;
+        }
+
+        Node ParseConcatenation()
+        {
+            std::vector<Node> items;
+            while (!m_Failed)
+            {
+                SkipExtendedWhitespace();
+                if (AtEnd() || Peek() == '|' || Peek() == ')')
+                {
+                    break;
+                }
+
+                Node item = ParseQuantified();
+                if (item.kind != NodeKind::Empty)
+                {
+                    items.push_back(phi::move(item));
+                }
+            }
+
+            if (items.size() == 1u)
+            {
+                return phi::move(items.front());
+            }
+
+            Node node;
+            if (!items.empty())
+            {
+                node.kind     = NodeKind::Concatenation;
+                node.children = phi::move(items);
+            }
+            return node;
+        }
+
+        // Parses {n}, {n,} or {n,m}. Anything else is left alone as a literal brace.
+        phi::boolean TryParseCountedQuantifier(phi::uint32_t& minimum, phi::uint32_t& maximum)
+        {
+            const phi::size_t start = m_Position;
+
+            auto parse_number = [&](phi::uint32_t& number) {
+                const phi::size_t digits_start = m_Position;
+                number                         = 0u;
+                while (Peek() >= '0' && Peek() <= '9')
+                {
+                    number = std::min(number * 10u + static_cast<phi::uint32_t>(Peek() - '0'),
+                                      MaximumRepetitionCount + 1u);
+                    ++m_Position;
+                }
+                return m_Position != digits_start;
+            };
+
+            ++m_Position; // {
+            if (!parse_number(minimum))
+            {
+                m_Position = start;
+                return false;
+            }
+
+            maximum = minimum;
+            if (TryConsume(','))
+            {
+                if (!parse_number(maximum))
+                {
+                    maximum = Unbounded;
+                }
+            }
+
+            if (!TryConsume('}'))
+            {
+                m_Position = start;
+                return false;
+            }
+
+            return true;
+        }
+
+        Node ParseQuantified()
+        {
+            Node atom = ParseAtom();
+            while (!m_Failed)
+            {
+                SkipExtendedWhitespace();
+
+                phi::uint32_t minimum{0u};
+                phi::uint32_t maximum{Unbounded};
+                switch (Peek())
+                {
+                    case '*':
+                        ++m_Position;
+                        break;
+                    case '+':
+                        ++m_Position;
+                        minimum = 1u;
+                        break;
+                    case '?':
+                        ++m_Position;
+                        maximum = 1u;
+                        break;
+                    case '{':
+                        if (!TryParseCountedQuantifier(minimum, maximum))
+                        {
+                            return atom;
+                        }
+                        break;
+                    default:
+                        return atom;
+                }
+
+                const phi::boolean invalid_maximum =
+                        maximum != Unbounded &&
+                        (maximum > MaximumRepetitionCount || maximum < minimum);
+                if (minimum > MaximumRepetitionCount || invalid_maximum)
+                {
+                    return Fail();
+                }
+
+                Node repetition;
+                repetition.kind    = NodeKind::Repetition;
+                repetition.minimum = minimum;
+                repetition.maximum = maximum;
+                repetition.greedy  = !TryConsume('?');
+
+                const phi::boolean possessive = repetition.greedy && TryConsume('+');
+                repetition.children.push_back(phi::move(atom));
+
+                if (possessive)
+                {
+                    atom      = Node{};
+                    atom.kind = NodeKind::Atomic;
+                    atom.children.push_back(phi::move(repetition));
+                }
+                else
+                {
+                    atom = phi::move(repetition);
+                }
+            }
+
+            return atom;
+        }
+
+        Node MakeCharacter(const char32_t code_point) const
+        {
+            Node node;
+            node.kind        = NodeKind::Character;
+            node.code_point  = code_point;
+            node.ignore_case = m_Options.ignore_case;
+            return node;
+        }
+
+        Node MakeAssertion(const AssertionKind kind) const
+        {
+            Node node;
+            node.kind      = NodeKind::Assertion;
+            node.assertion = kind;
+            return node;
+        }
+
+        Node MakeSet(CharacterSet set)
+        {
+            set.ignore_case = m_Options.ignore_case;
+            set.Finalize();
+            m_Sets.push_back(phi::move(set));
+
+            Node node;
+            node.kind  = NodeKind::Set;
+            node.index = static_cast<phi::uint32_t>(m_Sets.size() - 1u);
+            return node;
+        }
+
+        Node ParseAtom()
+        {
+            switch (Peek())
+            {
+                case '(':
+                    return ParseGroup();
+                case '[':
+                    return ParseSet();
+                case '.': {
+                    ++m_Position;
+
+                    Node node;
+                    node.kind    = NodeKind::Any;
+                    node.dot_all = m_Options.dot_all;
+                    return node;
+                }
+                case '^':
+                    ++m_Position;
+                    return MakeAssertion(m_Options.multi_line ? AssertionKind::BeginLine :
+                                                                AssertionKind::BeginText);
+                case '$':
+                    ++m_Position;
+                    return MakeAssertion(m_Options.multi_line ? AssertionKind::EndLine :
+                                                                AssertionKind::EndTextOrNewLine);
+                case '\\':
+                    return ParseEscape();
+                case '*':
+                case '+':
+                case '?':
+                    // Nothing to repeat
+                    return Fail();
+                default:
+                    return MakeCharacter(ConsumeCodePoint());
+            }
+        }
+
+        // Parses the name of a named group up to the terminator
+        phi::optional<std::string_view> ParseGroupName(const char terminator)
+        {
+            const phi::size_t start = m_Position;
+            while (!AtEnd() && Peek() != terminator)
+            {
+                if (!IsWordCharacter(Peek()))
+                {
+                    return {};
+                }
+                ++m_Position;
+            }
+
+            if (m_Position == start || !TryConsume(terminator))
+            {
+                return {};
+            }
+
+            return m_Pattern.substr(start, m_Position - start - 1u);
+        }
+
+        Node ParseGroup()
+        {
+            ++m_Position; // (
+
+            const Options saved_options = m_Options;
+
+            Node group;
+            group.kind = NodeKind::Group;
+
+            if (TryConsume('?'))
+            {
+                const char kind = Peek();
+                ++m_Position;
+
+                switch (kind)
+                {
+                    case '#':
+                        // Comment
+                        while (!AtEnd() && Peek() != ')')
+                        {
+                            ++m_Position;
+                        }
+                        return TryConsume(')') ? Node{} : Fail();
+                    case ':':
+                        group.kind = NodeKind::Empty; // Only groups its content
+                        break;
+                    case '=':
+                    case '!':
+                        group.kind    = NodeKind::LookAround;
+                        group.negated = kind == '!';
+                        break;
+                    case '>':
+                        group.kind = NodeKind::Atomic;
+                        break;
+                    case '<':
+                        if (TryConsume('='))
+                        {
+                            group.kind   = NodeKind::LookAround;
+                            group.behind = true;
+                            break;
+                        }
+                        if (TryConsume('!'))
+                        {
+                            group.kind    = NodeKind::LookAround;
+                            group.behind  = true;
+                            group.negated = true;
+                            break;
+                        }
+                        if (!ParseNamedGroup(group, '>'))
+                        {
+                            return Fail();
+                        }
+                        break;
+                    case 'P':
+                        if (!TryConsume('<') || !ParseNamedGroup(group, '>'))
+                        {
+                            return Fail();
+                        }
+                        break;
+                    case '\'':
+                        if (!ParseNamedGroup(group, '\''))
+                        {
+                            return Fail();
+                        }
+                        break;
+                    default: {
+                        // Inline options like (?i) or (?i-s:...)
+                        --m_Position;
+
+                        phi::boolean enable{true};
+                        while (!AtEnd() && Peek() != ')' && Peek() != ':')
+                        {
+                            switch (Peek())
+                            {
+                                case '-':
+                                    enable = false;
+                                    break;
+                                case 'i':
+                                    m_Options.ignore_case = enable;
+                                    break;
+                                case 'm':
+                                    m_Options.multi_line = enable;
+                                    break;
+                                case 's':
+                                    m_Options.dot_all = enable;
+                                    break;
+                                case 'x':
+                                    m_Options.extended = enable;
+                                    break;
+                                default:
+                                    return Fail();
+                            }
+                            ++m_Position;
+                        }
+
+                        // Without a colon the options apply until the end of the enclosing group
+                        if (TryConsume(')'))
+                        {
+                            return {};
+                        }
+                        if (!TryConsume(':'))
+                        {
+                            return Fail();
+                        }
+
+                        group.kind = NodeKind::Empty;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                group.index = ++m_GroupCount;
+            }
+
+            Node content = ParseAlternation();
+            if (m_Failed || !TryConsume(')'))
+            {
+                return Fail();
+            }
+
+            m_Options = saved_options;
+
+            if (group.kind == NodeKind::Empty)
+            {
+                return content;
+            }
+
+            group.children.push_back(phi::move(content));
+            return group;
+        }
+
+        phi::boolean ParseNamedGroup(Node& group, const char terminator)
+        {
+            const phi::optional<std::string_view> name = ParseGroupName(terminator);
+            if (!name || m_GroupNames.contains(std::string{*name}))
+            {
+                return false;
+            }
+
+            group.index = ++m_GroupCount;
+            m_GroupNames.emplace(std::string{*name}, group.index);
+            return true;
+        }
+
+        // Parses the escape sequence of a single character after the backslash
+        phi::optional<char32_t> ParseEscapedCodePoint(const char32_t letter)
+        {
+            switch (letter)
+            {
+                case 'a':
+                    return 0x07;
+                case 'e':
+                    return 0x1B;
+                case 'f':
+                    return 0x0C;
+                case 'n':
+                    return 0x0A;
+                case 'r':
+                    return 0x0D;
+                case 't':
+                    return 0x09;
+                case 'v':
+                    return 0x0B;
+                case '0': {
+                    // Up to two more octal digits
+                    char32_t code_point{0u};
+                    for (phi::size_t digit{0u}; digit < 2u && Peek() >= '0' && Peek() <= '7';
+                         ++digit)
+                    {
+                        code_point = code_point * 8u + static_cast<char32_t>(Peek() - '0');
+                        ++m_Position;
+                    }
+                    return code_point;
+                }
+                case 'x': {
+                    char32_t code_point{0u};
+                    if (TryConsume('{'))
+                    {
+                        phi::size_t digits{0u};
+                        while (const phi::optional<phi::uint32_t> value = HexDigitValue(Peek()))
+                        {
+                            code_point = code_point * 16u + *value;
+                            ++m_Position;
+                            if (++digits > 6u)
+                            {
+                                return {};
+                            }
+                        }
+                        if (digits == 0u || !TryConsume('}') || code_point > MaximumCodePoint)
+                        {
+                            return {};
+                        }
+                        return code_point;
+                    }
+
+                    for (phi::size_t digit{0u}; digit < 2u; ++digit)
+                    {
+                        const phi::optional<phi::uint32_t> value = HexDigitValue(Peek());
+                        if (!value)
+                        {
+                            break;
+                        }
+                        code_point = code_point * 16u + *value;
+                        ++m_Position;
+                    }
+                    return code_point;
+                }
+                default:
+                    // Escaping a character without special meaning matches it literally
+                    if (letter < 128u && IsWordCharacter(static_cast<char>(letter)))
+                    {
+                        return {};
+                    }
+                    return letter;
+            }
+        }
+
+        Node ParseEscape()
+        {
+            ++m_Position; // Backslash
+            if (AtEnd())
+            {
+                return Fail();
+            }
+
+            const char32_t letter = ConsumeCodePoint();
+            if (phi::optional<CodePointRanges> ranges = ClassEscapeRanges(letter))
+            {
+                CharacterSet set;
+                set.ranges = phi::move(*ranges);
+                return MakeSet(phi::move(set));
+            }
+
+            switch (letter)
+            {
+                case 'b':
+                    return MakeAssertion(AssertionKind::WordBoundary);
+                case 'B':
+                    return MakeAssertion(AssertionKind::NotWordBoundary);
+                case 'A':
+                    return MakeAssertion(AssertionKind::BeginText);
+                case 'z':
+                    return MakeAssertion(AssertionKind::EndText);
+                case 'Z':
+                    return MakeAssertion(AssertionKind::EndTextOrNewLine);
+                case 'Q': {
+                    // Everything up to \E is taken literally
+                    Node node;
+                    node.kind = NodeKind::Concatenation;
+                    while (!AtEnd() && !(Peek() == '\\' && Peek(1u) == 'E'))
+                    {
+                        node.children.push_back(MakeCharacter(ConsumeCodePoint()));
+                    }
+                    m_Position = std::min(m_Position + 2u, m_Pattern.size());
+                    return node;
+                }
+                case 'E':
+                    return {};
+                case 'k': {
+                    const char opening = Peek();
+                    const char closing = opening == '<' ? '>' : opening == '{' ? '}' : opening;
+                    if (opening != '<' && opening != '{' && opening != '\'')
+                    {
+                        return Fail();
+                    }
+                    ++m_Position;
+
+                    const phi::optional<std::string_view> name = ParseGroupName(closing);
+                    if (!name)
+                    {
+                        return Fail();
+                    }
+
+                    const auto group = m_GroupNames.find(std::string{*name});
+                    if (group == m_GroupNames.end())
+                    {
+                        return Fail();
+                    }
+                    return MakeBackreference(group->second);
+                }
+                default:
+                    break;
+            }
+
+            if (letter >= '1' && letter <= '9')
+            {
+                phi::uint32_t group = static_cast<phi::uint32_t>(letter - '0');
+                while (Peek() >= '0' && Peek() <= '9' && group < 10u)
+                {
+                    group = group * 10u + static_cast<phi::uint32_t>(Peek() - '0');
+                    ++m_Position;
+                }
+                return MakeBackreference(group);
+            }
+
+            const phi::optional<char32_t> code_point = ParseEscapedCodePoint(letter);
+            if (!code_point)
+            {
+                return Fail();
+            }
+            return MakeCharacter(*code_point);
+        }
+
+        Node MakeBackreference(const phi::uint32_t group)
+        {
+            m_HighestBackreference = std::max(m_HighestBackreference, group);
+
+            Node node;
+            node.kind        = NodeKind::Backreference;
+            node.index       = group;
+            node.ignore_case = m_Options.ignore_case;
+            return node;
+        }
+
+        // Parses a single code point of a set or the ranges of a class escape like \d
+        phi::boolean ParseSetItem(char32_t& code_point, CodePointRanges& class_ranges)
+        {
+            if (!TryConsume('\\'))
+            {
+                code_point = ConsumeCodePoint();
+                return true;
+            }
+
+            if (AtEnd())
+            {
+                return false;
+            }
+
+            const char32_t letter = ConsumeCodePoint();
+            if (phi::optional<CodePointRanges> ranges = ClassEscapeRanges(letter))
+            {
+                class_ranges = phi::move(*ranges);
+                return true;
+            }
+            if (letter == 'b')
+            {
+                code_point = 0x08;
+                return true;
+            }
+
+            const phi::optional<char32_t> escaped = ParseEscapedCodePoint(letter);
+            if (!escaped)
+            {
+                return false;
+            }
+            code_point = *escaped;
+            return true;
+        }
+
+        Node ParseSet()
+        {
+            ++m_Position; // [
+
+            CharacterSet set;
+            set.negated = TryConsume('^');
+
+            for (phi::boolean first{true};; first = false)
+            {
+                if (AtEnd())
+                {
+                    return Fail();
+                }
+                if (Peek() == ']' && !first)
+                {
+                    ++m_Position;
+                    break;
+                }
+
+                // POSIX classes like [:alpha:] or [:^digit:]
+                if (Peek() == '[' && Peek(1u) == ':')
+                {
+                    const phi::size_t end = m_Pattern.find(":]", m_Position + 2u);
+                    if (end != std::string_view::npos)
+                    {
+                        std::string_view   name = m_Pattern.substr(m_Position + 2u,
+                                                                   end - m_Position - 2u);
+                        const phi::boolean negated = !name.empty() && name.front() == '^';
+                        if (negated)
+                        {
+                            name.remove_prefix(1u);
+                        }
+
+                        phi::optional<CodePointRanges> ranges = PosixClassRanges(name);
+                        if (!ranges)
+                        {
+                            return Fail();
+                        }
+                        if (negated)
+                        {
+                            ranges = Complement(phi::move(*ranges));
+                        }
+
+                        set.ranges.insert(set.ranges.end(), ranges->begin(), ranges->end());
+                        m_Position = end + 2u;
+                        continue;
+                    }
+                }
+
+                char32_t        first_code_point{0u};
+                CodePointRanges class_ranges;
+                if (!ParseSetItem(first_code_point, class_ranges))
+                {
+                    return Fail();
+                }
+                if (!class_ranges.empty())
+                {
+                    set.ranges.insert(set.ranges.end(), class_ranges.begin(), class_ranges.end());
+                    continue;
+                }
+
+                // A dash at the end of the set or after a class is taken literally
+                if (Peek() == '-' && Peek(1u) != ']' && m_Position + 1u < m_Pattern.size())
+                {
+                    ++m_Position;
+
+                    char32_t last_code_point{0u};
+                    if (!ParseSetItem(last_code_point, class_ranges) || !class_ranges.empty() ||
+                        last_code_point < first_code_point)
+                    {
+                        return Fail();
+                    }
+
+                    set.ranges.emplace_back(first_code_point, last_code_point);
+                    continue;
+                }
+
+                set.ranges.emplace_back(first_code_point, first_code_point);
+            }
+
+            return MakeSet(phi::move(set));
+        }
+
+        std::string_view                               m_Pattern;
+        std::vector<CharacterSet>&                     m_Sets;
+        std::unordered_map<std::string, phi::uint32_t> m_GroupNames;
+        phi::size_t                                    m_Position{0u};
+        Options                                        m_Options;
+        phi::uint32_t                                  m_GroupCount{0u};
+        phi::uint32_t                                  m_HighestBackreference{0u};
+        phi::boolean                                   m_Failed{false};
+    };
+
+    [[nodiscard]] phi::boolean CanMatchEmpty(const Node& node)
+    {
+        switch (node.kind)
+        {
+            case NodeKind::Character:
+            case NodeKind::Any:
+            case NodeKind::Set:
+                return false;
+            case NodeKind::Empty:
+            case NodeKind::Assertion:
+            case NodeKind::LookAround:
+            case NodeKind::Backreference:
+                return true;
+            case NodeKind::Concatenation:
+                return std::all_of(node.children.begin(), node.children.end(), CanMatchEmpty);
+            case NodeKind::Alternation:
+                return std::any_of(node.children.begin(), node.children.end(), CanMatchEmpty);
+            case NodeKind::Repetition:
+                return node.minimum == 0u || CanMatchEmpty(node.children.front());
+            case NodeKind::Group:
+            case NodeKind::Atomic:
+                return CanMatchEmpty(node.children.front());
+        }
+
+        PHI_ASSERT_NOT_REACHED();
+    }
+
+    // Number of code points every match of the node consumes if that is always the same
+    [[nodiscard]] phi::optional<phi::uint32_t> FixedWidth(const Node& node)
+    {
+        switch (node.kind)
+        {
+            case NodeKind::Character:
+            case NodeKind::Any:
+            case NodeKind::Set:
+                return 1u;
+            case NodeKind::Empty:
+            case NodeKind::Assertion:
+            case NodeKind::LookAround:
+                return 0u;
+            case NodeKind::Backreference:
+                return {};
+            case NodeKind::Concatenation: {
+                phi::uint32_t width{0u};
+                for (const Node& child : node.children)
+                {
+                    const phi::optional<phi::uint32_t> child_width = FixedWidth(child);
+                    if (!child_width)
+                    {
+                        return {};
+                    }
+                    width += *child_width;
+                }
+                return width;
+            }
+            case NodeKind::Alternation: {
+                const phi::optional<phi::uint32_t> width = FixedWidth(node.children.front());
+                for (const Node& child : node.children)
+                {
+                    const phi::optional<phi::uint32_t> child_width = FixedWidth(child);
+                    if (!width || !child_width || *child_width != *width)
+                    {
+                        return {};
+                    }
+                }
+                return width;
+            }
+            case NodeKind::Repetition: {
+                const phi::optional<phi::uint32_t> width = FixedWidth(node.children.front());
+                if (!width || node.minimum != node.maximum)
+                {
+                    return {};
+                }
+                return *width * node.minimum;
+            }
+            case NodeKind::Group:
+            case NodeKind::Atomic:
+                return FixedWidth(node.children.front());
+        }
+
+        PHI_ASSERT_NOT_REACHED();
+    }
+
+    // Turns the tree of nodes into instructions for the backtracker and the DFA
+    class Compiler
+    {
+    public:
+        Compiler(std::vector<Instruction>& instructions, const phi::size_t register_count)
+            : m_Instructions{instructions}
+            , m_RegisterCount{register_count}
+        {}
+
+        [[nodiscard]] phi::boolean Compile(const Node& root)
+        {
+            Emit({.op = OpCode::Save, .argument = 0u});
+            EmitNode(root);
+            Emit({.op = OpCode::Save, .argument = 1u});
+            Emit({.op = OpCode::Match});
+
+            return !m_Failed;
+        }
+
+        [[nodiscard]] phi::size_t GetRegisterCount() const
+        {
+            return m_RegisterCount;
+        }
+
+    private:
+        [[nodiscard]] phi::uint32_t GetNextIndex() const
+        {
+            return static_cast<phi::uint32_t>(m_Instructions.size());
+        }
+
+        phi::uint32_t Emit(const Instruction& instruction)
+        {
+            if (m_Instructions.size() >= MaximumProgramSize)
+            {
+                m_Failed = true;
+            }
+
+            m_Instructions.push_back(instruction);
+            return static_cast<phi::uint32_t>(m_Instructions.size() - 1u);
+        }
+
+        void PatchSplit(const phi::uint32_t split, const phi::uint32_t body,
+                        const phi::uint32_t exit, const phi::boolean greedy)
+        {
+            m_Instructions[split].argument    = greedy ? body : exit;
+            m_Instructions[split].alternative = greedy ? exit : body;
+        }
+
+        void EmitNode(const Node& node)
+        {
+            if (m_Failed)
+            {
+                return;
+            }
+
+            switch (node.kind)
+            {
+                case NodeKind::Empty:
+                    break;
+                case NodeKind::Character: {
+                    const char32_t folded = FoldCodePoint(node.code_point);
+
+                    // Characters without case variants don't need to be folded while matching
+                    if (node.ignore_case && (folded != node.code_point ||
+                                             ToUpperCase(node.code_point) != node.code_point))
+                    {
+                        Emit({.op = OpCode::CharacterIgnoreCase, .code_point = folded});
+                    }
+                    else
+                    {
+                        Emit({.op = OpCode::Character, .code_point = node.code_point});
+                    }
+                    break;
+                }
+                case NodeKind::Any:
+                    Emit({.op = node.dot_all ? OpCode::Any : OpCode::AnyExceptNewLine});
+                    break;
+                case NodeKind::Set:
+                    Emit({.op = OpCode::Set, .argument = node.index});
+                    break;
+                case NodeKind::Concatenation:
+                    for (const Node& child : node.children)
+                    {
+                        EmitNode(child);
+                    }
+                    break;
+                case NodeKind::Alternation: {
+                    std::vector<phi::uint32_t> jumps;
+                    for (phi::size_t index{0u}; index + 1u < node.children.size(); ++index)
+                    {
+                        const phi::uint32_t split = Emit({.op = OpCode::Split});
+                        EmitNode(node.children[index]);
+                        jumps.push_back(Emit({.op = OpCode::Jump}));
+                        PatchSplit(split, split + 1u, GetNextIndex(), true);
+                    }
+
+                    EmitNode(node.children.back());
+                    for (const phi::uint32_t jump : jumps)
+                    {
+                        m_Instructions[jump].argument = GetNextIndex();
+                    }
+                    break;
+                }
+                case NodeKind::Repetition:
+                    EmitRepetition(node);
+                    break;
+                case NodeKind::Group:
+                    Emit({.op = OpCode::Save, .argument = node.index * 2u});
+                    EmitNode(node.children.front());
+                    Emit({.op = OpCode::Save, .argument = node.index * 2u + 1u});
+                    break;
+                case NodeKind::Assertion:
+                    Emit({.op       = OpCode::Assertion,
+                          .argument = static_cast<phi::uint32_t>(node.assertion)});
+                    break;
+                case NodeKind::Backreference:
+                    Emit({.op       = OpCode::Backreference,
+                          .flag     = node.ignore_case,
+                          .argument = node.index});
+                    break;
+                case NodeKind::LookAround: {
+                    phi::uint32_t width{0u};
+                    if (node.behind)
+                    {
+                        const phi::optional<phi::uint32_t> fixed_width =
+                                FixedWidth(node.children.front());
+                        if (!fixed_width)
+                        {
+                            m_Failed = true;
+                            return;
+                        }
+                        width = *fixed_width;
+                    }
+
+                    const phi::uint32_t look_around = Emit({.op         = OpCode::LookAround,
+                                                            .flag       = node.negated,
+                                                            .behind     = node.behind,
+                                                            .code_point = width});
+                    EmitNode(node.children.front());
+                    Emit({.op = OpCode::Match});
+                    m_Instructions[look_around].alternative = GetNextIndex();
+                    break;
+                }
+                case NodeKind::Atomic: {
+                    const phi::uint32_t atomic = Emit({.op = OpCode::Atomic});
+                    EmitNode(node.children.front());
+                    Emit({.op = OpCode::Match});
+                    m_Instructions[atomic].alternative = GetNextIndex();
+                    break;
+                }
+            }
+        }
+
+        void EmitRepetition(const Node& node)
+        {
+            const Node& child = node.children.front();
+            for (phi::uint32_t count{0u}; count < node.minimum && !m_Failed; ++count)
+            {
+                EmitNode(child);
+            }
+
+            if (node.maximum == Unbounded)
+            {
+                // An iteration which matches nothing would loop forever so like PCRE the loop ends
+                // after such an iteration
+                const phi::boolean  guarded = CanMatchEmpty(child);
+                const phi::uint32_t guard   = static_cast<phi::uint32_t>(m_RegisterCount);
+                if (guarded)
+                {
+                    ++m_RegisterCount;
+                }
+
+                const phi::uint32_t loop = Emit({.op = OpCode::Split});
+                if (guarded)
+                {
+                    Emit({.op = OpCode::Save, .argument = guard});
+                }
+                EmitNode(child);
+
+                phi::uint32_t check_progress{0u};
+                if (guarded)
+                {
+                    check_progress = Emit({.op = OpCode::CheckProgress, .argument = guard});
+                }
+                Emit({.op = OpCode::Jump, .argument = loop});
+
+                const phi::uint32_t exit = GetNextIndex();
+                if (guarded)
+                {
+                    m_Instructions[check_progress].alternative = exit;
+                }
+                PatchSplit(loop, loop + 1u, exit, node.greedy);
+                return;
+            }
+
+            // Optional iterations are nested so x{0,2} becomes (x(x)?)?
+            std::vector<phi::uint32_t> splits;
+            for (phi::uint32_t count{node.minimum}; count < node.maximum && !m_Failed; ++count)
+            {
+                splits.push_back(Emit({.op = OpCode::Split}));
+                EmitNode(child);
+            }
+
+            for (const phi::uint32_t split : splits)
+            {
+                PatchSplit(split, split + 1u, GetNextIndex(), node.greedy);
+            }
+        }
+
+        std::vector<Instruction>& m_Instructions;
+        phi::size_t               m_RegisterCount;
+        phi::boolean              m_Failed{false};
+    };
+
+    // DFA built on demand from the instructions. A state is the set of instructions which could
+    // consume the next code point. Transitions of ASCII code points are stored in the state itself
+    // while all others go through a hash map. Assertions are assumed to always succeed so a
+    // pattern using them only gets a quick answer if there is no match at all.
+    class LazyDFA
+    {
+    public:
+        LazyDFA(const std::vector<Instruction>& instructions, const std::vector<CharacterSet>& sets,
+                const phi::boolean anchored)
+            : m_Instructions{instructions}
+            , m_Sets{sets}
+            , m_Anchored{anchored}
+            , m_Marks(instructions.size(), 0u)
+        {
+            Reset();
+        }
+
+        // Whether a match could start at or after the offset
+        [[nodiscard]] phi::boolean HasMatch(const std::string_view subject, phi::size_t offset)
+        {
+            phi::uint32_t state = m_StartState;
+            while (!m_States[state].accepting)
+            {
+                if (offset >= subject.size() || (m_Anchored && m_States[state].threads.empty()))
+                {
+                    return false;
+                }
+
+                state = Transition(state, NextCodePoint(subject, offset));
+            }
+
+            return true;
+        }
+
+    private:
+        struct State
+        {
+            std::vector<phi::uint32_t>     threads; // Sorted
+            std::array<phi::int32_t, 128u> ascii_transitions;
+            phi::boolean                   accepting{false};
+        };
+
+        struct ThreadsHash
+        {
+            phi::size_t operator()(const std::vector<phi::uint32_t>& threads) const
+            {
+                phi::uint64_t hash{14695981039346656037u};
+                for (const phi::uint32_t thread : threads)
+                {
+                    hash = (hash ^ thread) * 1099511628211u;
+                }
+                return static_cast<phi::size_t>(hash);
+            }
+        };
+
+        void Reset()
+        {
+            m_States.clear();
+            m_StateIndices.clear();
+            m_Transitions.clear();
+
+            std::vector<phi::uint32_t> threads;
+            AddClosure(0u, threads);
+            FinishThreads(threads);
+            m_StartState = Intern(phi::move(threads));
+        }
+
+        // Adds the consuming instructions reachable from pc without consuming anything
+        void AddClosure(const phi::uint32_t pc, std::vector<phi::uint32_t>& threads)
+        {
+            m_Stack.push_back(pc);
+            while (!m_Stack.empty())
+            {
+                const phi::uint32_t current = m_Stack.back();
+                m_Stack.pop_back();
+
+                if (m_Marks[current] == m_Generation)
+                {
+                    continue;
+                }
+                m_Marks[current] = m_Generation;
+
+                const Instruction& instruction = m_Instructions[current];
+                switch (instruction.op)
+                {
+                    case OpCode::Split:
+                        m_Stack.push_back(instruction.alternative);
+                        m_Stack.push_back(instruction.argument);
+                        break;
+                    case OpCode::CheckProgress:
+                        m_Stack.push_back(instruction.alternative);
+                        m_Stack.push_back(current + 1u);
+                        break;
+                    case OpCode::Jump:
+                        m_Stack.push_back(instruction.argument);
+                        break;
+                    case OpCode::Save:
+                    case OpCode::Assertion:
+                        m_Stack.push_back(current + 1u);
+                        break;
+                    default:
+                        threads.push_back(current);
+                        break;
+                }
+            }
+        }
+
+        void FinishThreads(std::vector<phi::uint32_t>& threads)
+        {
+            std::sort(threads.begin(), threads.end());
+            if (++m_Generation == 0u)
+            {
+                std::fill(m_Marks.begin(), m_Marks.end(), 0u);
+                m_Generation = 1u;
+            }
+        }
+
+        phi::uint32_t Intern(std::vector<phi::uint32_t> threads)
+        {
+            const auto existing = m_StateIndices.find(threads);
+            if (existing != m_StateIndices.end())
+            {
+                return existing->second;
+            }
+
+            State state;
+            state.accepting = std::any_of(threads.begin(), threads.end(), [&](const auto thread) {
+                return m_Instructions[thread].op == OpCode::Match;
+            });
+            state.ascii_transitions.fill(-1);
+            state.threads = phi::move(threads);
+
+            const auto index = static_cast<phi::uint32_t>(m_States.size());
+            m_StateIndices.emplace(state.threads, index);
+            m_States.push_back(phi::move(state));
+            return index;
+        }
+
+        phi::uint32_t Transition(const phi::uint32_t state, const char32_t code_point)
+        {
+            const phi::uint64_t key = (static_cast<phi::uint64_t>(state) << 32u) | code_point;
+            if (code_point < 128u)
+            {
+                const phi::int32_t cached = m_States[state].ascii_transitions[code_point];
+                if (cached >= 0)
+                {
+                    return static_cast<phi::uint32_t>(cached);
+                }
+            }
+            else if (const auto cached = m_Transitions.find(key); cached != m_Transitions.end())
+            {
+                return cached->second;
+            }
+
+            std::vector<phi::uint32_t> threads;
+            for (const phi::uint32_t thread : m_States[state].threads)
+            {
+                if (Accepts(m_Instructions[thread], m_Sets, code_point))
+                {
+                    AddClosure(thread + 1u, threads);
+                }
+            }
+            if (!m_Anchored)
+            {
+                // A match may start at any position
+                AddClosure(0u, threads);
+            }
+            FinishThreads(threads);
+
+            if (m_States.size() >= MaximumDFAStates)
+            {
+                Reset();
+                return Intern(phi::move(threads));
+            }
+
+            const phi::uint32_t next = Intern(phi::move(threads));
+            if (code_point < 128u)
+            {
+                m_States[state].ascii_transitions[code_point] = static_cast<phi::int32_t>(next);
+            }
+            else
+            {
+                m_Transitions.emplace(key, next);
+            }
+
+            return next;
+        }
+
+        const std::vector<Instruction>&  m_Instructions;
+        const std::vector<CharacterSet>& m_Sets;
+        phi::boolean                     m_Anchored;
+
+        std::vector<State>                                                     m_States;
+        std::unordered_map<std::vector<phi::uint32_t>, phi::uint32_t, ThreadsHash> m_StateIndices;
+        std::unordered_map<phi::uint64_t, phi::uint32_t> m_Transitions;
+        phi::uint32_t                                    m_StartState{0u};
+
+        // Scratch space for computing closures
+        std::vector<phi::uint32_t> m_Stack;
+        std::vector<phi::uint32_t> m_Marks;
+        phi::uint32_t              m_Generation{1u};
+    };
+} // namespace
+
+struct Regex::Program
+{
+    std::vector<Instruction>  instructions;
+    std::vector<CharacterSet> sets;
+    phi::size_t               group_count{0u};
+    phi::size_t               register_count{0u};
+    phi::boolean              anchored{false};     // Can only match at the start of the subject
+    phi::boolean              backtracking{false}; // Needs backreferences, lookarounds or atomics
+    phi::boolean              has_assertions{false};
+
+    // Only set for patterns without backtracking
+    std::unique_ptr<LazyDFA> dfa;
+
+    // Generation of the search which last visited each state and position. The generations avoid
+    // clearing the memo between searches.
+    std::vector<phi::uint32_t> memo;
+    phi::uint32_t              memo_generation{0u};
+};
+
+namespace
+{
+    class Backtracker
+    {
+    public:
+        Backtracker(const std::vector<Instruction>&  instructions,
+                    const std::vector<CharacterSet>& sets, std::vector<phi::uint32_t>* memo,
+                    const phi::uint32_t memo_generation, const std::string_view subject,
+                    const phi::size_t offset)
+            : m_Instructions{instructions}
+            , m_Sets{sets}
+            , m_Memo{memo}
+            , m_MemoGeneration{memo_generation}
+            , m_Subject{subject}
+            , m_Offset{offset}
+        {}
+
+        // Runs the program starting at pc and returns the position where it reached the Match
+        // instruction or NoMatch. The registers are left as they were at the match.
+        [[nodiscard]] phi::size_t Run(const phi::uint32_t pc, const phi::size_t position,
+                                      std::vector<phi::size_t>& registers)
+        {
+            std::vector<Job> stack;
+            stack.push_back({JobKind::Branch, pc, position});
+
+            while (!stack.empty())
+            {
+                const Job job = stack.back();
+                stack.pop_back();
+
+                if (job.kind == JobKind::Restore)
+                {
+                    registers[job.index] = job.position;
+                    continue;
+                }
+
+                const phi::size_t result = Execute(job.index, job.position, registers, stack);
+                if (result != Regex::NoMatch)
+                {
+                    return result;
+                }
+            }
+
+            return Regex::NoMatch;
+        }
+
+    private:
+        enum class JobKind : phi::uint8_t
+        {
+            Branch,  // Continue at index and position
+            Restore, // Restore the register index to position
+        };
+
+        struct Job
+        {
+            JobKind       kind;
+            phi::uint32_t index;
+            phi::size_t   position;
+        };
+
+        // Returns false if the state was already visited before
+        phi::boolean Visit(const phi::uint32_t pc, const phi::size_t position)
+        {
+            if (m_Memo == nullptr)
+            {
+                return true;
+            }
+
+            phi::uint32_t& entry =
+                    (*m_Memo)[pc * (m_Subject.size() - m_Offset + 1u) + position - m_Offset];
+            if (entry == m_MemoGeneration)
+            {
+                return false;
+            }
+
+            entry = m_MemoGeneration;
+            return true;
+        }
+
+        phi::boolean MatchBackreference(const Instruction&              instruction,
+                                        const std::vector<phi::size_t>& registers,
+                                        phi::size_t&                    position) const
+        {
+            const phi::size_t start = registers[instruction.argument * 2u];
+            const phi::size_t end   = registers[instruction.argument * 2u + 1u];
+            if (start == Regex::NoMatch || end == Regex::NoMatch)
+            {
+                return false;
+            }
+
+            const std::string_view captured = m_Subject.substr(start, end - start);
+            if (!instruction.flag)
+            {
+                if (m_Subject.substr(position, captured.size()) != captured)
+                {
+                    return false;
+                }
+
+                position += captured.size();
+                return true;
+            }
+
+            phi::size_t index{0u};
+            while (index < captured.size())
+            {
+                if (position >= m_Subject.size() ||
+                    FoldCodePoint(NextCodePoint(captured, index)) !=
+                            FoldCodePoint(NextCodePoint(m_Subject, position)))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        // Moves the position back by the given number of code points
+        phi::boolean StepBack(phi::size_t& position, const phi::uint32_t code_points) const
+        {
+            for (phi::uint32_t count{0u}; count < code_points; ++count)
+            {
+                if (position == 0u)
+                {
+                    return false;
+                }
+
+                --position;
+                while (position > 0u && IsUTF8ContinuationByte(m_Subject[position]))
+                {
+                    --position;
+                }
+            }
+
+            return true;
+        }
+
+        // Keeps the groups captured by a lookaround or atomic group while still allowing them to
+        // be undone when backtracking past it
+        static void ApplyRegisters(std::vector<Job>& stack, std::vector<phi::size_t>& registers,
+                                   const std::vector<phi::size_t>& changed)
+        {
+            for (phi::size_t index{0u}; index < registers.size(); ++index)
+            {
+                if (registers[index] != changed[index])
+                {
+                    stack.push_back({JobKind::Restore, static_cast<phi::uint32_t>(index),
+                                     registers[index]});
+                    registers[index] = changed[index];
+                }
+            }
+        }
+
+        // Follows a single path until it fails or matches. Alternatives are pushed onto the stack.
+        phi::size_t Execute(phi::uint32_t pc, phi::size_t position,
+                            std::vector<phi::size_t>& registers, std::vector<Job>& stack)
+        {
+            for (;;)
+            {
+                if (!Visit(pc, position))
+                {
+                    return Regex::NoMatch;
+                }
+
+                const Instruction& instruction = m_Instructions[pc];
+                switch (instruction.op)
+                {
+                    case OpCode::Character:
+                    case OpCode::CharacterIgnoreCase:
+                    case OpCode::Any:
+                    case OpCode::AnyExceptNewLine:
+                    case OpCode::Set:
+                        if (position >= m_Subject.size() ||
+                            !Accepts(instruction, m_Sets, NextCodePoint(m_Subject, position)))
+                        {
+                            return Regex::NoMatch;
+                        }
+                        ++pc;
+                        break;
+                    case OpCode::Split:
+                        stack.push_back({JobKind::Branch, instruction.alternative, position});
+                        pc = instruction.argument;
+                        break;
+                    case OpCode::Jump:
+                        pc = instruction.argument;
+                        break;
+                    case OpCode::Save:
+                        stack.push_back(
+                                {JobKind::Restore, instruction.argument,
+                                 registers[instruction.argument]});
+                        registers[instruction.argument] = position;
+                        ++pc;
+                        break;
+                    case OpCode::CheckProgress:
+                        pc = registers[instruction.argument] == position ? instruction.alternative :
+                                                                           pc + 1u;
+                        break;
+                    case OpCode::Assertion:
+                        if (!CheckAssertion(static_cast<AssertionKind>(instruction.argument),
+                                            m_Subject, position))
+                        {
+                            return Regex::NoMatch;
+                        }
+                        ++pc;
+                        break;
+                    case OpCode::Backreference:
+                        if (!MatchBackreference(instruction, registers, position))
+                        {
+                            return Regex::NoMatch;
+                        }
+                        ++pc;
+                        break;
+                    case OpCode::LookAround: {
+                        phi::size_t              start = position;
+                        std::vector<phi::size_t> changed{registers};
+
+                        const phi::boolean matched =
+                                (!instruction.behind || StepBack(start, instruction.code_point)) &&
+                                Run(pc + 1u, start, changed) != Regex::NoMatch;
+                        if (matched == instruction.flag)
+                        {
+                            return Regex::NoMatch;
+                        }
+
+                        // Negative lookarounds never capture anything
+                        if (matched)
+                        {
+                            ApplyRegisters(stack, registers, changed);
+                        }
+                        pc = instruction.alternative;
+                        break;
+                    }
+                    case OpCode::Atomic: {
+                        std::vector<phi::size_t> changed{registers};
+
+                        const phi::size_t end = Run(pc + 1u, position, changed);
+                        if (end == Regex::NoMatch)
+                        {
+                            return Regex::NoMatch;
+                        }
+
+                        ApplyRegisters(stack, registers, changed);
+                        position = end;
+                        pc       = instruction.alternative;
+                        break;
+                    }
+                    case OpCode::Match:
+                        return position;
+                }
+            }
+        }
+
+        const std::vector<Instruction>&  m_Instructions;
+        const std::vector<CharacterSet>& m_Sets;
+        std::vector<phi::uint32_t>*      m_Memo;
+        phi::uint32_t                    m_MemoGeneration;
+        std::string_view                 m_Subject;
+        phi::size_t                      m_Offset;
+    };
+} // namespace
+
+Regex::Regex(std::unique_ptr<Program> program)
+    : m_Program{phi::move(program)}
+{}
+
+Regex::Regex(Regex&& other) noexcept = default;
+
+Regex& Regex::operator=(Regex&& other) noexcept = default;
+
+Regex::~Regex() = default;
+
+phi::optional<Regex> Regex::Compile(const std::string_view pattern)
+{
+    auto program = std::make_unique<Program>();
+
+    Parser                    parser{pattern, program->sets};
+    const phi::optional<Node> root = parser.Parse();
+    if (!root)
+    {
+        return {};
+    }
+
+    program->group_count = parser.GetGroupCount();
+
+    Compiler compiler{program->instructions, (program->group_count + 1u) * 2u};
+    if (!compiler.Compile(*root))
+    {
+        return {};
+    }
+    program->register_count = compiler.GetRegisterCount();
+
+    for (const Instruction& instruction : program->instructions)
+    {
+        program->backtracking = program->backtracking || instruction.op == OpCode::Backreference ||
+                                instruction.op == OpCode::LookAround ||
+                                instruction.op == OpCode::Atomic;
+        program->has_assertions = program->has_assertions || instruction.op == OpCode::Assertion;
+    }
+
+    // The first instruction saves the start of the match
+    const Instruction& first = program->instructions[1u];
+    program->anchored        = first.op == OpCode::Assertion &&
+                        static_cast<AssertionKind>(first.argument) == AssertionKind::BeginText;
+
+    if (!program->backtracking)
+    {
+        program->dfa = std::make_unique<LazyDFA>(program->instructions, program->sets,
+                                                 program->anchored);
+    }
+
+    return Regex{phi::move(program)};
+}
+
+phi::size_t Regex::GetGroupCount() const
+{
+    return m_Program->group_count;
+}
+
+phi::boolean Regex::IsMatch(const std::string_view subject, const phi::size_t offset) const
+{
+    if (offset > subject.size())
+    {
+        return false;
+    }
+
+    // Without assertions the DFA gives the exact answer
+    if (m_Program->dfa && !m_Program->has_assertions)
+    {
+        return m_Program->dfa->HasMatch(subject, offset);
+    }
+
+    Captures captures;
+    return Search(subject, offset, captures);
+}
+
+phi::boolean Regex::Search(const std::string_view subject, const phi::size_t offset,
+                           Captures& captures) const
+{
+    Program& program = *m_Program;
+    if (offset > subject.size() || (program.dfa && !program.dfa->HasMatch(subject, offset)))
+    {
+        return false;
+    }
+
+    // Remembering the failed states keeps the search linear but doesn't work with backtracking
+    std::vector<phi::uint32_t>* memo{nullptr};
+    const phi::size_t           memo_size =
+            program.instructions.size() * (subject.size() - offset + 1u);
+    if (!program.backtracking && memo_size <= MaximumMemoSize)
+    {
+        if (program.memo.size() < memo_size)
+        {
+            program.memo.resize(memo_size, 0u);
+        }
+        if (++program.memo_generation == 0u)
+        {
+            std::fill(program.memo.begin(), program.memo.end(), 0u);
+            program.memo_generation = 1u;
+        }
+
+        memo = &program.memo;
+    }
+
+    Backtracker backtracker{program.instructions, program.sets, memo, program.memo_generation,
+                            subject,              offset};
+    std::vector<phi::size_t> registers(program.register_count, NoMatch);
+
+    for (phi::size_t start{offset};;)
+    {
+        if (backtracker.Run(0u, start, registers) != NoMatch)
+        {
+            captures.assign(registers.begin(),
+                            registers.begin() +
+                                    static_cast<std::ptrdiff_t>((program.group_count + 1u) * 2u));
+            return true;
+        }
+
+        if (program.anchored || start >= subject.size())
+        {
+            return false;
+        }
+
+        // Only start matches at the beginning of a character
+        ++start;
+        while (start < subject.size() && IsUTF8ContinuationByte(subject[start]))
+        {
+            ++start;
+        }
+    }
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,157 @@
+#include "OpenAutoIt/StringClassification.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string_view>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace OpenAutoIt
+{
+namespace
+{
+    [[nodiscard]] constexpr phi::boolean IsInRange(const char character, const char first,
+                                                   const char last)
+    {
+        return character >= first && character <= last;
+    }
+
+    [[nodiscard]] constexpr phi::boolean IsASCIIInClass(const char           character,
+                                                        const CharacterClass character_class)
+    {
+        switch (character_class)
+        {
+            case CharacterClass::Alpha:
+                return IsInRange(FoldASCII(character), 'a', 'z');
+            case CharacterClass::AlphaNumeric:
+                return IsInRange(FoldASCII(character), 'a', 'z') || IsInRange(character, '0', '9');
+            case CharacterClass::ASCII:
+                return static_cast<unsigned char>(character) < 0x80u;
+            case CharacterClass::Digit:
+                return IsInRange(character, '0', '9');
+            case CharacterClass::HexDigit:
+                return IsInRange(FoldASCII(character), 'a', 'f') || IsInRange(character, '0', '9');
+            case CharacterClass::Lower:
+                return IsInRange(character, 'a', 'z');
+            case CharacterClass::Space:
+                return IsWhitespace(character);
+            case CharacterClass::Upper:
+                return IsInRange(character, 'A', 'Z');
+        }
+
+        PHI_ASSERT_NOT_REACHED();
+        return false;
+    }
+
+    [[nodiscard]] phi::boolean IsCodePointInClass(const char32_t       code_point,
+                                                  const CharacterClass character_class)
+    {
+        switch (character_class)
+        {
+            case CharacterClass::Alpha:
+            case CharacterClass::AlphaNumeric:
+                return IsLetter(code_point);
+            // NOTE: Sharp s is lower case even though it has no simple upper case mapping
+            case CharacterClass::Lower:
+                return ToUpperCase(code_point) != code_point || code_point == U'\u00DF';
+            case CharacterClass::Upper:
+                return ToLowerCase(code_point) != code_point;
+            case CharacterClass::ASCII:
+            case CharacterClass::Digit:
+            case CharacterClass::HexDigit:
+            case CharacterClass::Space:
+                return false;
+        }
+
+        PHI_ASSERT_NOT_REACHED();
+        return false;
+    }
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+    // One bit per byte which is set for ASCII bytes in the character class
+    [[nodiscard]] unsigned int MatchCharacterClass(const __m128i        bytes,
+                                                   const CharacterClass character_class)
+    {
+        switch (character_class)
+        {
+            case CharacterClass::Alpha:
+                return ToBits(MaskByteRange(FoldASCII(bytes), 'a', 'z'));
+            case CharacterClass::AlphaNumeric:
+                return ToBits(_mm_or_si128(MaskByteRange(FoldASCII(bytes), 'a', 'z'),
+                                           MaskByteRange(bytes, '0', '9')));
+            case CharacterClass::ASCII:
+                return ~MatchNonASCII(bytes) & 0xFFFFu;
+            case CharacterClass::Digit:
+                return ToBits(MaskByteRange(bytes, '0', '9'));
+            case CharacterClass::HexDigit:
+                return ToBits(_mm_or_si128(MaskByteRange(FoldASCII(bytes), 'a', 'f'),
+                                           MaskByteRange(bytes, '0', '9')));
+            case CharacterClass::Lower:
+                return ToBits(MaskByteRange(bytes, 'a', 'z'));
+            case CharacterClass::Space:
+                return MatchWhitespace(bytes);
+            case CharacterClass::Upper:
+                return ToBits(MaskByteRange(bytes, 'A', 'Z'));
+        }
+
+        PHI_ASSERT_NOT_REACHED();
+        return 0u;
+    }
+#endif
+} // namespace
+
+phi::boolean StringIsCharacterClass(const std::string_view string,
+                                    const CharacterClass   character_class)
+{
+    if (string.empty())
+    {
+        return false;
+    }
+
+    phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+    for (; index + 16u <= string.size(); index += 16u)
+    {
+        const __m128i bytes = LoadUnaligned(string.data() + index);
+        if (MatchCharacterClass(bytes, character_class) == 0xFFFFu)
+        {
+            continue;
+        }
+
+        // Non ASCII characters have to be decoded so continue with the slow path from here
+        if (MatchNonASCII(bytes) != 0u)
+        {
+            break;
+        }
+
+        return false;
+    }
+#endif
+
+    while (index < string.size())
+    {
+        const char character = string[index];
+        if (static_cast<unsigned char>(character) < 0x80u)
+        {
+            if (!IsASCIIInClass(character, character_class))
+            {
+                return false;
+            }
+            ++index;
+            continue;
+        }
+
+        if (!IsCodePointInClass(DecodeUTF8(string, index), character_class))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,131 @@
+#include "OpenAutoIt/StringComparison.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <bit>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    [[nodiscard]] constexpr phi::boolean IsASCII(const char character)
+    {
+        return static_cast<unsigned char>(character) < 0x80u;
+    }
+
+    // Returns the index of the first byte which differs after folding ASCII letters or size if
+    // there is none. Bytes outside of ASCII are compared as is.
+    [[nodiscard]] phi::size_t FindMismatchIgnoreCaseASCII(const char* lhs, const char* rhs,
+                                                          const phi::size_t size)
+    {
+        phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; index + 16u <= size; index += 16u)
+        {
+            const __m128i lhs_bytes = FoldASCII(LoadUnaligned(lhs + index));
+            const __m128i rhs_bytes = FoldASCII(LoadUnaligned(rhs + index));
+
+            const auto equal = static_cast<unsigned int>(
+                    _mm_movemask_epi8(_mm_cmpeq_epi8(lhs_bytes, rhs_bytes)));
+            if (equal != 0xFFFFu)
+            {
+                return index + static_cast<phi::size_t>(std::countr_one(equal));
+            }
+        }
+#endif
+
+        for (; index < size; ++index)
+        {
+            if (FoldASCII(lhs[index]) != FoldASCII(rhs[index]))
+            {
+                return index;
+            }
+        }
+
+        return size;
+    }
+
+    // Compares the case folded code points starting at index. Both strings must be equal before
+    // index ignoring the case of ASCII letters.
+    [[nodiscard]] int CompareFoldedCodePoints(const std::string_view lhs,
+                                              const std::string_view rhs, phi::size_t index)
+    {
+        const auto is_continuation = [](const std::string_view string, const phi::size_t at) {
+            return at < string.size() && IsUTF8ContinuationByte(string[at]);
+        };
+
+        // Start at the beginning of the code point containing the mismatch
+        while (index > 0u && (is_continuation(lhs, index) || is_continuation(rhs, index)))
+        {
+            --index;
+        }
+
+        phi::size_t lhs_index{index};
+        phi::size_t rhs_index{index};
+        while (lhs_index < lhs.size() && rhs_index < rhs.size())
+        {
+            const char32_t lhs_code_point = FoldCase(DecodeUTF8(lhs, lhs_index));
+            const char32_t rhs_code_point = FoldCase(DecodeUTF8(rhs, rhs_index));
+
+            if (lhs_code_point != rhs_code_point)
+            {
+                return lhs_code_point < rhs_code_point ? -1 : 1;
+            }
+        }
+
+        if (lhs_index < lhs.size())
+        {
+            return 1;
+        }
+
+        return rhs_index < rhs.size() ? -1 : 0;
+    }
+} // namespace
+
+phi::boolean StringEqualsIgnoreCase(const std::string_view lhs, const std::string_view rhs)
+{
+    const phi::size_t size     = std::min(lhs.size(), rhs.size());
+    const phi::size_t mismatch = FindMismatchIgnoreCaseASCII(lhs.data(), rhs.data(), size);
+
+    if (mismatch == size)
+    {
+        return lhs.size() == rhs.size();
+    }
+
+    // No case mapping can make two different ASCII characters equal
+    if (IsASCII(lhs[mismatch]) && IsASCII(rhs[mismatch]))
+    {
+        return false;
+    }
+
+    return CompareFoldedCodePoints(lhs, rhs, mismatch) == 0;
+}
+
+int StringCompareIgnoreCase(const std::string_view lhs, const std::string_view rhs)
+{
+    const phi::size_t size     = std::min(lhs.size(), rhs.size());
+    const phi::size_t mismatch = FindMismatchIgnoreCaseASCII(lhs.data(), rhs.data(), size);
+
+    if (mismatch == size)
+    {
+        if (lhs.size() == rhs.size())
+        {
+            return 0;
+        }
+
+        return lhs.size() < rhs.size() ? -1 : 1;
+    }
+
+    if (IsASCII(lhs[mismatch]) && IsASCII(rhs[mismatch]))
+    {
+        return FoldASCII(lhs[mismatch]) < FoldASCII(rhs[mismatch]) ? -1 : 1;
+    }
+
+    return CompareFoldedCodePoints(lhs, rhs, mismatch);
+}
+} // namespace OpenAutoIt
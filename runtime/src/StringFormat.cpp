@@ -0,0 +1,512 @@
+#include "OpenAutoIt/StringFormat.hpp"
+
+#include "OpenAutoIt/Unicode.hpp"
+#include "OpenAutoIt/Variant.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+
+PHI_GCC_SUPPRESS_WARNING_WITH_PUSH("-Wuninitialized")
+
+#include <fmt/core.h>
+#include <fmt/format.h>
+
+PHI_GCC_SUPPRESS_WARNING_POP()
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Keeps scripts from requesting absurdly large outputs with something like "%999999999d"
+    constexpr const phi::uint32_t MaximumWidthOrPrecision{65536u};
+
+    constexpr const phi::size_t DefaultFloatingPointPrecision{6u};
+
+    [[nodiscard]] constexpr phi::boolean IsDigit(const char character)
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    // Parses a decimal number at the index saturating at MaximumWidthOrPrecision
+    [[nodiscard]] phi::uint32_t ParseNumber(const std::string_view format, phi::size_t& index)
+    {
+        phi::uint32_t number{0u};
+        for (; index < format.size() && IsDigit(format[index]); ++index)
+        {
+            number = number * 10u + static_cast<phi::uint32_t>(format[index] - '0');
+            if (number > MaximumWidthOrPrecision)
+            {
+                number = MaximumWidthOrPrecision;
+            }
+        }
+
+        return number;
+    }
+
+    // Skips the C length modifiers h, l, L, ll, I, I32 and I64 which make no difference here
+    void SkipLengthModifiers(const std::string_view format, phi::size_t& index)
+    {
+        while (index < format.size())
+        {
+            const std::string_view rest = format.substr(index);
+            if (rest.starts_with("I64") || rest.starts_with("I32"))
+            {
+                index += 3u;
+            }
+            else if (rest[0] == 'h' || rest[0] == 'l' || rest[0] == 'L' || rest[0] == 'I')
+            {
+                ++index;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    // Pads the text appended since start up to the width. Zeros are inserted at the zero position
+    // which is behind the sign and prefix, everything else is padded with spaces.
+    void Pad(std::string& buffer, const phi::size_t start, const phi::size_t zero_position,
+             const phi::size_t length, const phi::size_t width, const phi::boolean left_align,
+             const phi::boolean zero_pad)
+    {
+        if (length >= width)
+        {
+            return;
+        }
+
+        const phi::size_t padding = width - length;
+        if (left_align)
+        {
+            buffer.append(padding, ' ');
+        }
+        else if (zero_pad)
+        {
+            buffer.insert(zero_position, padding, '0');
+        }
+        else
+        {
+            buffer.insert(start, padding, ' ');
+        }
+    }
+
+    // fmt writes at least two exponent digits while AutoIt writes at least three like "1.5e+003"
+    void WidenExponent(std::string& buffer, const phi::size_t start)
+    {
+        const phi::size_t exponent = buffer.find_first_of("eE", start);
+        if (exponent != std::string::npos && buffer.size() - exponent == 4u)
+        {
+            buffer.insert(exponent + 2u, 1u, '0');
+        }
+    }
+} // namespace
+
+phi::optional<FormatString> FormatString::Compile(const std::string_view format)
+{
+    FormatString result;
+    result.m_Literals.reserve(format.size());
+
+    phi::size_t literal_start{0u};
+    for (phi::size_t index{0u}; index < format.size();)
+    {
+        const phi::size_t percent = format.find('%', index);
+        if (percent == std::string_view::npos)
+        {
+            result.m_Literals.append(format.substr(index));
+            break;
+        }
+
+        result.m_Literals.append(format.substr(index, percent - index));
+        index = percent + 1u;
+
+        if (index < format.size() && format[index] == '%')
+        {
+            result.m_Literals += '%';
+            ++index;
+            continue;
+        }
+
+        Specification specification{};
+
+        for (; index < format.size(); ++index)
+        {
+            const char flag = format[index];
+            if (flag == '-')
+            {
+                specification.left_align = true;
+            }
+            else if (flag == '+')
+            {
+                specification.plus_sign = true;
+            }
+            else if (flag == ' ')
+            {
+                specification.space_sign = true;
+            }
+            else if (flag == '0')
+            {
+                specification.zero_pad = true;
+            }
+            else if (flag == '#')
+            {
+                specification.alternate_form = true;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        specification.width = ParseNumber(format, index);
+        if (index < format.size() && format[index] == '.')
+        {
+            ++index;
+            specification.precision = static_cast<phi::int32_t>(ParseNumber(format, index));
+        }
+
+        SkipLengthModifiers(format, index);
+
+        phi::boolean valid{index < format.size()};
+        if (valid)
+        {
+            switch (format[index])
+            {
+                case 'd':
+                case 'i':
+                    specification.conversion = Conversion::SignedDecimal;
+                    break;
+                case 'u':
+                    specification.conversion = Conversion::UnsignedDecimal;
+                    break;
+                case 'o':
+                    specification.conversion = Conversion::Octal;
+                    break;
+                case 'x':
+                    specification.conversion = Conversion::HexLowerCase;
+                    break;
+                case 'X':
+                    specification.conversion = Conversion::HexUpperCase;
+                    break;
+                case 'e':
+                    specification.conversion = Conversion::ExponentLowerCase;
+                    break;
+                case 'E':
+                    specification.conversion = Conversion::ExponentUpperCase;
+                    break;
+                case 'f':
+                    specification.conversion = Conversion::Fixed;
+                    break;
+                case 'g':
+                    specification.conversion = Conversion::GeneralLowerCase;
+                    break;
+                case 'G':
+                    specification.conversion = Conversion::GeneralUpperCase;
+                    break;
+                case 's':
+                    specification.conversion = Conversion::String;
+                    break;
+                default:
+                    valid = false;
+                    break;
+            }
+        }
+
+        if (!valid)
+        {
+            // Keep the percent sign as text and continue right after it
+            result.m_Literals += '%';
+            index = percent + 1u;
+            continue;
+        }
+        ++index;
+
+        specification.literal_offset = literal_start;
+        specification.literal_size   = result.m_Literals.size() - literal_start;
+        result.m_Specifications.push_back(specification);
+
+        literal_start = result.m_Literals.size();
+    }
+
+    result.m_TrailingLiteralOffset = literal_start;
+    return result;
+}
+
+phi::size_t FormatString::GetArgumentCount() const
+{
+    return m_Specifications.size();
+}
+
+void FormatString::Format(const Variant* arguments, const phi::size_t argument_count,
+                          std::string& buffer) const
+{
+    buffer.clear();
+
+    const std::string_view literals = m_Literals;
+    const Variant          missing_argument;
+
+    for (phi::size_t index{0u}; index < m_Specifications.size(); ++index)
+    {
+        const Specification& specification = m_Specifications[index];
+        const Variant&       argument =
+                index < argument_count ? arguments[index] : missing_argument;
+
+        buffer.append(literals.substr(specification.literal_offset, specification.literal_size));
+
+        switch (specification.conversion)
+        {
+            case Conversion::SignedDecimal:
+            case Conversion::UnsignedDecimal:
+            case Conversion::Octal:
+            case Conversion::HexLowerCase:
+            case Conversion::HexUpperCase:
+                AppendInteger(specification, argument, buffer);
+                break;
+
+            case Conversion::ExponentLowerCase:
+            case Conversion::ExponentUpperCase:
+            case Conversion::Fixed:
+            case Conversion::GeneralLowerCase:
+            case Conversion::GeneralUpperCase:
+                AppendFloatingPoint(specification, argument, buffer);
+                break;
+
+            case Conversion::String:
+                AppendString(specification, argument, buffer);
+                break;
+        }
+    }
+
+    buffer.append(literals.substr(m_TrailingLiteralOffset));
+}
+
+void FormatString::AppendInteger(const Specification& specification, const Variant& argument,
+                                 std::string& buffer)
+{
+    const phi::int64_t value = argument.CastToInt64().AsInt64().unsafe();
+    const phi::size_t  start = buffer.size();
+
+    phi::uint64_t magnitude{0u};
+    if (specification.conversion == Conversion::SignedDecimal)
+    {
+        magnitude = value < 0 ? 0u - static_cast<phi::uint64_t>(value) :
+                                static_cast<phi::uint64_t>(value);
+
+        if (value < 0)
+        {
+            buffer += '-';
+        }
+        else if (specification.plus_sign)
+        {
+            buffer += '+';
+        }
+        else if (specification.space_sign)
+        {
+            buffer += ' ';
+        }
+    }
+    else if (value >= std::numeric_limits<phi::int32_t>::min() &&
+             value <= std::numeric_limits<phi::int32_t>::max())
+    {
+        // Values which fit into 32 bits are converted like AutoIt's Int32 so -1 is "ffffffff"
+        magnitude = static_cast<phi::uint32_t>(static_cast<phi::int32_t>(value));
+    }
+    else
+    {
+        magnitude = static_cast<phi::uint64_t>(value);
+    }
+
+    if (specification.alternate_form && magnitude != 0u)
+    {
+        if (specification.conversion == Conversion::HexLowerCase)
+        {
+            buffer += "0x";
+        }
+        else if (specification.conversion == Conversion::HexUpperCase)
+        {
+            buffer += "0X";
+        }
+    }
+
+    const phi::size_t digits_start = buffer.size();
+
+    // An explicit precision of zero formats zero without any digits
+    if (magnitude != 0u || specification.precision != 0)
+    {
+        auto output = std::back_inserter(buffer);
+        switch (specification.conversion)
+        {
+            case Conversion::SignedDecimal:
+            case Conversion::UnsignedDecimal:
+                fmt::format_to(output, "{}", magnitude);
+                break;
+            case Conversion::Octal:
+                fmt::format_to(output, "{:o}", magnitude);
+                break;
+            case Conversion::HexLowerCase:
+                fmt::format_to(output, "{:x}", magnitude);
+                break;
+            case Conversion::HexUpperCase:
+                fmt::format_to(output, "{:X}", magnitude);
+                break;
+            default:
+                PHI_ASSERT_NOT_REACHED();
+        }
+    }
+
+    // The precision is the minimum number of digits
+    const phi::size_t digits = buffer.size() - digits_start;
+    if (specification.precision > 0 && digits < static_cast<phi::size_t>(specification.precision))
+    {
+        buffer.insert(digits_start, static_cast<phi::size_t>(specification.precision) - digits,
+                      '0');
+    }
+
+    if (specification.conversion == Conversion::Octal && specification.alternate_form &&
+        (buffer.size() == digits_start || buffer[digits_start] != '0'))
+    {
+        buffer.insert(digits_start, 1u, '0');
+    }
+
+    Pad(buffer, start, digits_start, buffer.size() - start, specification.width,
+        specification.left_align, specification.zero_pad && specification.precision < 0);
+}
+
+void FormatString::AppendFloatingPoint(const Specification& specification, const Variant& argument,
+                                       std::string& buffer)
+{
+    const double      value = argument.CastToDouble().AsDouble().unsafe();
+    const phi::size_t start = buffer.size();
+
+    if (std::signbit(value) && !std::isnan(value))
+    {
+        buffer += '-';
+    }
+    else if (specification.plus_sign)
+    {
+        buffer += '+';
+    }
+    else if (specification.space_sign)
+    {
+        buffer += ' ';
+    }
+
+    const phi::size_t digits_start = buffer.size();
+    const phi::boolean upper_case  = specification.conversion == Conversion::ExponentUpperCase ||
+                                    specification.conversion == Conversion::GeneralUpperCase;
+
+    if (!std::isfinite(value))
+    {
+        buffer += std::isnan(value) ? (upper_case ? "NAN" : "nan") : (upper_case ? "INF" : "inf");
+
+        // Never pad infinity and NaN with zeros
+        Pad(buffer, start, digits_start, buffer.size() - start, specification.width,
+            specification.left_align, false);
+        return;
+    }
+
+    const double      magnitude = std::fabs(value);
+    const phi::size_t precision = specification.precision < 0 ?
+                                          DefaultFloatingPointPrecision :
+                                          static_cast<phi::size_t>(specification.precision);
+    const phi::boolean alternate_form = specification.alternate_form;
+
+    auto output = std::back_inserter(buffer);
+    switch (specification.conversion)
+    {
+        case Conversion::ExponentLowerCase:
+            if (alternate_form)
+            {
+                fmt::format_to(output, "{:#.{}e}", magnitude, precision);
+            }
+            else
+            {
+                fmt::format_to(output, "{:.{}e}", magnitude, precision);
+            }
+            break;
+        case Conversion::ExponentUpperCase:
+            if (alternate_form)
+            {
+                fmt::format_to(output, "{:#.{}E}", magnitude, precision);
+            }
+            else
+            {
+                fmt::format_to(output, "{:.{}E}", magnitude, precision);
+            }
+            break;
+        case Conversion::Fixed:
+            if (alternate_form)
+            {
+                fmt::format_to(output, "{:#.{}f}", magnitude, precision);
+            }
+            else
+            {
+                fmt::format_to(output, "{:.{}f}", magnitude, precision);
+            }
+            break;
+        case Conversion::GeneralLowerCase:
+            if (alternate_form)
+            {
+                fmt::format_to(output, "{:#.{}g}", magnitude, precision);
+            }
+            else
+            {
+                fmt::format_to(output, "{:.{}g}", magnitude, precision);
+            }
+            break;
+        case Conversion::GeneralUpperCase:
+            if (alternate_form)
+            {
+                fmt::format_to(output, "{:#.{}G}", magnitude, precision);
+            }
+            else
+            {
+                fmt::format_to(output, "{:.{}G}", magnitude, precision);
+            }
+            break;
+        default:
+            PHI_ASSERT_NOT_REACHED();
+    }
+
+    if (specification.conversion != Conversion::Fixed)
+    {
+        WidenExponent(buffer, digits_start);
+    }
+
+    Pad(buffer, start, digits_start, buffer.size() - start, specification.width,
+        specification.left_align, specification.zero_pad);
+}
+
+void FormatString::AppendString(const Specification& specification, const Variant& argument,
+                                std::string& buffer)
+{
+    // Avoid copying arguments which already are strings
+    const Variant    converted = argument.IsString() ? Variant{} : argument.CastToString();
+    std::string_view string    = argument.IsString() ? argument.AsString() : converted.AsString();
+
+    // The precision is the maximum number of characters
+    if (specification.precision >= 0)
+    {
+        string = string.substr(
+                0u, FindUTF8Offset(string, static_cast<phi::size_t>(specification.precision)));
+    }
+
+    const phi::size_t start = buffer.size();
+    buffer.append(string);
+
+    if (specification.width != 0u)
+    {
+        Pad(buffer, start, start, CountUTF16CodeUnits(string), specification.width,
+            specification.left_align, false);
+    }
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,511 @@
+#include "OpenAutoIt/StringSearch.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <string_view>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace OpenAutoIt
+{
+namespace
+{
+    constexpr const phi::size_t NotFound = std::string_view::npos;
+
+    // Needles longer than this use the two-way algorithm for forward searches
+    constexpr const phi::size_t TwoWayThreshold{32u};
+
+    template <bool Fold>
+    [[nodiscard]] constexpr char Normalize(const char character)
+    {
+        if constexpr (Fold)
+        {
+            return FoldASCII(character);
+        }
+        else
+        {
+            return character;
+        }
+    }
+
+    template <bool Fold>
+    [[nodiscard]] phi::boolean EqualsAt(const char* haystack, const std::string_view needle)
+    {
+        if constexpr (!Fold)
+        {
+            return std::string_view{haystack, needle.size()} == needle;
+        }
+        else
+        {
+            for (phi::size_t index{0u}; index < needle.size(); ++index)
+            {
+                if (FoldASCII(haystack[index]) != needle[index])
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+    }
+
+    // Returns the first position at or after from where the needle starts
+    template <bool Fold>
+    [[nodiscard]] phi::size_t FindFiltered(const std::string_view haystack,
+                                           const std::string_view needle, phi::size_t from)
+    {
+        if (haystack.size() < needle.size())
+        {
+            return NotFound;
+        }
+
+        const char*       data  = haystack.data();
+        const phi::size_t last  = needle.size() - 1u;
+        const phi::size_t limit = haystack.size() - last; // Number of possible positions
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; from + 16u <= limit; from += 16u)
+        {
+            __m128i first_bytes = LoadUnaligned(data + from);
+            __m128i last_bytes  = LoadUnaligned(data + from + last);
+            if constexpr (Fold)
+            {
+                first_bytes = FoldASCII(first_bytes);
+                last_bytes  = FoldASCII(last_bytes);
+            }
+
+            unsigned int candidates =
+                    MatchByte(first_bytes, needle.front()) & MatchByte(last_bytes, needle.back());
+            while (candidates != 0u)
+            {
+                const phi::size_t position =
+                        from + static_cast<phi::size_t>(std::countr_zero(candidates));
+                if (EqualsAt<Fold>(data + position, needle))
+                {
+                    return position;
+                }
+
+                candidates &= candidates - 1u;
+            }
+        }
+#endif
+
+        for (; from < limit; ++from)
+        {
+            if (Normalize<Fold>(data[from]) == needle.front() &&
+                Normalize<Fold>(data[from + last]) == needle.back() &&
+                EqualsAt<Fold>(data + from, needle))
+            {
+                return from;
+            }
+        }
+
+        return NotFound;
+    }
+
+    // Returns the last position where the needle starts and ends at or before end
+    template <bool Fold>
+    [[nodiscard]] phi::size_t FindLastFiltered(const std::string_view haystack,
+                                               const std::string_view needle,
+                                               const phi::size_t      end)
+    {
+        if (end < needle.size())
+        {
+            return NotFound;
+        }
+
+        const char*       data  = haystack.data();
+        const phi::size_t last  = needle.size() - 1u;
+        phi::size_t       count = end - last; // Number of possible positions
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        while (count >= 16u)
+        {
+            const phi::size_t base = count - 16u;
+
+            __m128i first_bytes = LoadUnaligned(data + base);
+            __m128i last_bytes  = LoadUnaligned(data + base + last);
+            if constexpr (Fold)
+            {
+                first_bytes = FoldASCII(first_bytes);
+                last_bytes  = FoldASCII(last_bytes);
+            }
+
+            unsigned int candidates =
+                    MatchByte(first_bytes, needle.front()) & MatchByte(last_bytes, needle.back());
+            while (candidates != 0u)
+            {
+                const auto bit = static_cast<unsigned int>(std::bit_width(candidates)) - 1u;
+                const phi::size_t position = base + bit;
+                if (EqualsAt<Fold>(data + position, needle))
+                {
+                    return position;
+                }
+
+                candidates ^= 1u << bit;
+            }
+
+            count = base;
+        }
+#endif
+
+        while (count > 0u)
+        {
+            --count;
+            if (Normalize<Fold>(data[count]) == needle.front() &&
+                Normalize<Fold>(data[count + last]) == needle.back() &&
+                EqualsAt<Fold>(data + count, needle))
+            {
+                return count;
+            }
+        }
+
+        return NotFound;
+    }
+
+    struct Factorization
+    {
+        phi::size_t position;
+        phi::size_t period;
+    };
+
+    // Returns the start of the lexicographically maximal suffix of the needle and its period.
+    // Reversing the order instead finds the maximal suffix for the reversed alphabet.
+    [[nodiscard]] Factorization MaximalSuffix(const std::string_view needle,
+                                              const phi::boolean     reversed)
+    {
+        phi::size_t suffix{0u};
+        phi::size_t index{0u};
+        phi::size_t offset{1u};
+        phi::size_t period{1u};
+
+        while (index + offset < needle.size())
+        {
+            const auto current = static_cast<unsigned char>(needle[index + offset]);
+            const auto other   = static_cast<unsigned char>(needle[suffix + offset - 1u]);
+
+            if (reversed ? current > other : current < other)
+            {
+                index += offset;
+                offset = 1u;
+                period = index + 1u - suffix;
+            }
+            else if (current == other)
+            {
+                if (offset != period)
+                {
+                    ++offset;
+                }
+                else
+                {
+                    index += period;
+                    offset = 1u;
+                }
+            }
+            else
+            {
+                suffix = index + 1u;
+                index  = suffix;
+                offset = 1u;
+                period = 1u;
+            }
+        }
+
+        return {suffix, period};
+    }
+
+    // https://en.wikipedia.org/wiki/Two-way_string-matching_algorithm
+    template <bool Fold>
+    [[nodiscard]] phi::size_t FindTwoWay(const std::string_view haystack,
+                                         const std::string_view needle, phi::size_t position,
+                                         const phi::size_t critical_position,
+                                         const phi::size_t period, const phi::boolean periodic)
+    {
+        const char* data = haystack.data();
+
+        // Number of bytes at the start of the needle which are known to match
+        phi::size_t memory{0u};
+
+        while (position + needle.size() <= haystack.size())
+        {
+            // Match the right part of the needle
+            phi::size_t index = std::max(critical_position, memory);
+            while (index < needle.size() &&
+                   needle[index] == Normalize<Fold>(data[position + index]))
+            {
+                ++index;
+            }
+
+            if (index < needle.size())
+            {
+                position += index - critical_position + 1u;
+                memory = 0u;
+                continue;
+            }
+
+            // Match the left part of the needle backwards
+            index = critical_position;
+            while (index > memory &&
+                   needle[index - 1u] == Normalize<Fold>(data[position + index - 1u]))
+            {
+                --index;
+            }
+
+            if (index <= memory)
+            {
+                return position;
+            }
+
+            position += period;
+            if (periodic)
+            {
+                memory = needle.size() - period;
+            }
+        }
+
+        return NotFound;
+    }
+
+    // Whether the bytes at index encode U+0130, U+0131, U+017F or the Kelvin sign U+212A, which are
+    // the only non ASCII characters folding to an ASCII letter ('i', 's' and 'k' respectively)
+    [[nodiscard]] phi::boolean IsASCIIFoldableAt(const std::string_view haystack,
+                                                 const phi::size_t      index)
+    {
+        const std::string_view bytes = haystack.substr(index, 3u);
+
+        return bytes.starts_with("\xC4\xB0") || bytes.starts_with("\xC4\xB1") ||
+               bytes.starts_with("\xC5\xBF") || bytes.starts_with("\xE2\x84\xAA");
+    }
+
+    [[nodiscard]] phi::boolean ContainsASCIIFoldable(const std::string_view haystack)
+    {
+        const char* data = haystack.data();
+        phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; index + 16u <= haystack.size(); index += 16u)
+        {
+            const __m128i bytes      = LoadUnaligned(data + index);
+            unsigned int  candidates = MatchByte(bytes, '\xC4') | MatchByte(bytes, '\xC5') |
+                                      MatchByte(bytes, '\xE2');
+            while (candidates != 0u)
+            {
+                const phi::size_t position =
+                        index + static_cast<phi::size_t>(std::countr_zero(candidates));
+                if (IsASCIIFoldableAt(haystack, position))
+                {
+                    return true;
+                }
+
+                candidates &= candidates - 1u;
+            }
+        }
+#endif
+
+        for (; index < haystack.size(); ++index)
+        {
+            if ((data[index] == '\xC4' || data[index] == '\xC5' || data[index] == '\xE2') &&
+                IsASCIIFoldableAt(haystack, index))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    // Ignoring the case of ASCII letters is enough unless a non ASCII character of the haystack
+    // can fold to an ASCII letter of the needle. Only 'i', 'k' and 's' have such characters, so
+    // the haystack is only decoded when it actually contains one of them.
+    [[nodiscard]] phi::boolean CanFoldBytes(const std::string_view haystack,
+                                            const std::string_view needle)
+    {
+        if (!IsASCII(needle))
+        {
+            return false;
+        }
+
+        return needle.find_first_of("iIkKsS") == std::string_view::npos ||
+               !ContainsASCIIFoldable(haystack);
+    }
+} // namespace
+
+StringSearcher::StringSearcher(const std::string_view haystack, const std::string_view needle,
+                               const CaseSense case_sense)
+    : m_Haystack{haystack}
+    , m_Needle{needle}
+    , m_Strategy{Strategy::Bytes}
+{
+    if (needle.empty())
+    {
+        m_Strategy = Strategy::Empty;
+        return;
+    }
+
+    switch (case_sense)
+    {
+        case CaseSense::MatchCase:
+            m_Strategy = Strategy::Bytes;
+            break;
+
+        case CaseSense::IgnoreCaseASCII:
+            m_Strategy = Strategy::FoldedBytes;
+            break;
+
+        case CaseSense::IgnoreCase:
+            m_Strategy = CanFoldBytes(haystack, needle) ? Strategy::FoldedBytes :
+                                                          Strategy::FoldedCodePoints;
+            break;
+    }
+
+    if (m_Strategy == Strategy::FoldedCodePoints)
+    {
+        for (phi::size_t index{0u}; index < needle.size();)
+        {
+            m_FoldedCodePoints += FoldCase(DecodeUTF8(needle, index));
+        }
+        return;
+    }
+
+    if (m_Strategy == Strategy::FoldedBytes)
+    {
+        std::transform(m_Needle.begin(), m_Needle.end(), m_Needle.begin(),
+                       [](const char character) { return FoldASCII(character); });
+    }
+
+    if (m_Needle.size() > TwoWayThreshold)
+    {
+        const Factorization forward  = MaximalSuffix(m_Needle, false);
+        const Factorization backward = MaximalSuffix(m_Needle, true);
+        const Factorization critical = forward.position > backward.position ? forward : backward;
+
+        m_UseTwoWay        = true;
+        m_CriticalPosition = critical.position;
+        m_Periodic         = std::string_view{m_Needle}.substr(0u, m_CriticalPosition) ==
+                     std::string_view{m_Needle}.substr(critical.period, m_CriticalPosition);
+        m_Period           = m_Periodic ?
+                                     critical.period :
+                                     std::max(m_CriticalPosition,
+                                              m_Needle.size() - m_CriticalPosition) + 1u;
+    }
+}
+
+phi::optional<StringSearcher::Match> StringSearcher::FindNext(const phi::size_t from) const
+{
+    if (from > m_Haystack.size())
+    {
+        return {};
+    }
+
+    phi::size_t offset{NotFound};
+    switch (m_Strategy)
+    {
+        case Strategy::Empty:
+            return {};
+
+        case Strategy::Bytes:
+            offset = m_UseTwoWay ? FindTwoWay<false>(m_Haystack, m_Needle, from,
+                                                     m_CriticalPosition, m_Period, m_Periodic) :
+                                   FindFiltered<false>(m_Haystack, m_Needle, from);
+            break;
+
+        case Strategy::FoldedBytes:
+            offset = m_UseTwoWay ? FindTwoWay<true>(m_Haystack, m_Needle, from, m_CriticalPosition,
+                                                    m_Period, m_Periodic) :
+                                   FindFiltered<true>(m_Haystack, m_Needle, from);
+            break;
+
+        case Strategy::FoldedCodePoints:
+            for (phi::size_t index{from}; index < m_Haystack.size(); ++index)
+            {
+                if (IsUTF8ContinuationByte(m_Haystack[index]))
+                {
+                    continue;
+                }
+
+                const phi::size_t size = MatchCodePointsAt(index, m_Haystack.size());
+                if (size != 0u)
+                {
+                    return Match{index, size};
+                }
+            }
+            return {};
+    }
+
+    if (offset == NotFound)
+    {
+        return {};
+    }
+
+    return Match{offset, m_Needle.size()};
+}
+
+phi::optional<StringSearcher::Match> StringSearcher::FindPrevious(phi::size_t end) const
+{
+    end = std::min(end, m_Haystack.size());
+
+    // NOTE: Searching backwards is rare enough that even long needles only use the byte filter
+    phi::size_t offset{NotFound};
+    switch (m_Strategy)
+    {
+        case Strategy::Empty:
+            return {};
+
+        case Strategy::Bytes:
+            offset = FindLastFiltered<false>(m_Haystack, m_Needle, end);
+            break;
+
+        case Strategy::FoldedBytes:
+            offset = FindLastFiltered<true>(m_Haystack, m_Needle, end);
+            break;
+
+        case Strategy::FoldedCodePoints:
+            for (phi::size_t index{end}; index > 0u;)
+            {
+                --index;
+                if (IsUTF8ContinuationByte(m_Haystack[index]))
+                {
+                    continue;
+                }
+
+                const phi::size_t size = MatchCodePointsAt(index, end);
+                if (size != 0u)
+                {
+                    return Match{index, size};
+                }
+            }
+            return {};
+    }
+
+    if (offset == NotFound)
+    {
+        return {};
+    }
+
+    return Match{offset, m_Needle.size()};
+}
+
+// Returns the size of the match starting at offset or zero if there is none
+phi::size_t StringSearcher::MatchCodePointsAt(const phi::size_t offset, const phi::size_t end) const
+{
+    const std::string_view haystack = m_Haystack.substr(0u, end);
+
+    phi::size_t index{offset};
+    for (const char32_t code_point : m_FoldedCodePoints)
+    {
+        if (index >= haystack.size() || FoldCase(DecodeUTF8(haystack, index)) != code_point)
+        {
+            return 0u;
+        }
+    }
+
+    return index - offset;
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,266 @@
+#include "OpenAutoIt/StringSplit.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/StringSearch.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <string_view>
+
+PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Every first byte costs one comparison per 16 bytes so more of them are looked up one by one
+    constexpr const phi::size_t MaximumVectorizedFirstBytes{8u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+    [[nodiscard]] unsigned int MatchFirstBytes(const __m128i          bytes,
+                                               const std::string_view first_bytes)
+    {
+        unsigned int matches{0u};
+        for (const char first_byte : first_bytes)
+        {
+            matches |= MatchByte(bytes, first_byte);
+        }
+
+        return matches;
+    }
+#endif
+
+    // Number of characters which is the number of bytes not continuing a UTF-8 sequence
+    [[nodiscard]] phi::size_t CountCharacters(const std::string_view string)
+    {
+        phi::size_t count{0u};
+        phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; index + 16u <= string.size(); index += 16u)
+        {
+            const __m128i bytes = LoadUnaligned(string.data() + index);
+
+            // Continuation bytes are the only ones in [0x80, 0xBF]
+            const unsigned int continuation = ToBits(MaskByteRange(
+                    bytes, static_cast<char>(0x80), static_cast<char>(0xBF)));
+            count += 16u - static_cast<phi::size_t>(std::popcount(continuation));
+        }
+#endif
+
+        for (; index < string.size(); ++index)
+        {
+            count += IsUTF8ContinuationByte(string[index]) ? 0u : 1u;
+        }
+
+        return count;
+    }
+
+    // Advances the index past the character starting at it consistent with CountCharacters
+    void SkipCharacter(const std::string_view string, phi::size_t& index)
+    {
+        ++index;
+        while (index < string.size() && IsUTF8ContinuationByte(string[index]))
+        {
+            ++index;
+        }
+    }
+} // namespace
+
+StringSplitter::StringSplitter(const std::string_view string, const std::string_view delimiters,
+                               const phi::boolean entire_delimiter)
+    : m_String{string}
+    , m_Delimiters{delimiters}
+    , m_Strategy{delimiters.empty() ? Strategy::Characters :
+                 entire_delimiter   ? Strategy::EntireDelimiter :
+                                      Strategy::DelimiterCharacters}
+{
+    switch (m_Strategy)
+    {
+        case Strategy::Characters:
+            break;
+
+        case Strategy::DelimiterCharacters:
+            for (phi::size_t index{0u}; index < delimiters.size(); ++index)
+            {
+                const char byte = delimiters[index];
+                if (IsUTF8ContinuationByte(byte))
+                {
+                    continue;
+                }
+
+                m_ASCIIDelimiters = m_ASCIIDelimiters && static_cast<unsigned char>(byte) < 0x80u;
+                if (!m_IsFirstByte[static_cast<unsigned char>(byte)])
+                {
+                    m_IsFirstByte.set(static_cast<unsigned char>(byte));
+                    m_FirstBytes.push_back(byte);
+                }
+            }
+            break;
+
+        case Strategy::EntireDelimiter:
+            m_Searcher.emplace(string, delimiters, CaseSense::MatchCase);
+            break;
+    }
+}
+
+phi::size_t StringSplitter::CountFields() const
+{
+    if (m_String.empty())
+    {
+        return 1u;
+    }
+
+    switch (m_Strategy)
+    {
+        case Strategy::Characters:
+            return CountCharacters(m_String);
+
+        case Strategy::DelimiterCharacters:
+            if (m_ASCIIDelimiters)
+            {
+                // Every matching byte is a delimiter so they only need to be counted
+                phi::size_t count{1u};
+                phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+                if (m_FirstBytes.size() <= MaximumVectorizedFirstBytes)
+                {
+                    for (; index + 16u <= m_String.size(); index += 16u)
+                    {
+                        count += static_cast<phi::size_t>(std::popcount(MatchFirstBytes(
+                                LoadUnaligned(m_String.data() + index), m_FirstBytes)));
+                    }
+                }
+#endif
+
+                for (; index < m_String.size(); ++index)
+                {
+                    count += m_IsFirstByte[static_cast<unsigned char>(m_String[index])] ? 1u : 0u;
+                }
+
+                return count;
+            }
+            break;
+
+        case Strategy::EntireDelimiter:
+            break;
+    }
+
+    phi::size_t count{1u};
+    for (phi::optional<Delimiter> delimiter = FindDelimiter(0u); delimiter;
+         delimiter = FindDelimiter(delimiter->offset + delimiter->size))
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+phi::optional<std::string_view> StringSplitter::NextField()
+{
+    if (m_Finished)
+    {
+        return {};
+    }
+
+    if (m_Strategy == Strategy::Characters && !m_String.empty())
+    {
+        const phi::size_t start = m_Position;
+        SkipCharacter(m_String, m_Position);
+
+        m_Finished = m_Position >= m_String.size();
+        return m_String.substr(start, m_Position - start);
+    }
+
+    const phi::optional<Delimiter> delimiter =
+            m_Strategy == Strategy::Characters ? phi::optional<Delimiter>{} :
+                                                 FindDelimiter(m_Position);
+    if (!delimiter)
+    {
+        m_Finished = true;
+        return m_String.substr(m_Position);
+    }
+
+    const phi::size_t start = m_Position;
+    m_Position              = delimiter->offset + delimiter->size;
+    return m_String.substr(start, delimiter->offset - start);
+}
+
+phi::optional<StringSplitter::Delimiter> StringSplitter::FindDelimiter(phi::size_t from) const
+{
+    if (m_Strategy == Strategy::EntireDelimiter)
+    {
+        const phi::optional<StringSearcher::Match> match = m_Searcher->FindNext(from);
+        if (!match)
+        {
+            return {};
+        }
+
+        return Delimiter{match->offset, match->size};
+    }
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+    if (m_FirstBytes.size() <= MaximumVectorizedFirstBytes)
+    {
+        for (; from + 16u <= m_String.size(); from += 16u)
+        {
+            unsigned int candidates =
+                    MatchFirstBytes(LoadUnaligned(m_String.data() + from), m_FirstBytes);
+            while (candidates != 0u)
+            {
+                const phi::size_t offset =
+                        from + static_cast<phi::size_t>(std::countr_zero(candidates));
+                if (const phi::size_t size = MatchDelimiterCharacter(offset); size != 0u)
+                {
+                    return Delimiter{offset, size};
+                }
+
+                candidates &= candidates - 1u;
+            }
+        }
+    }
+#endif
+
+    for (; from < m_String.size(); ++from)
+    {
+        if (m_IsFirstByte[static_cast<unsigned char>(m_String[from])])
+        {
+            if (const phi::size_t size = MatchDelimiterCharacter(from); size != 0u)
+            {
+                return Delimiter{from, size};
+            }
+        }
+    }
+
+    return {};
+}
+
+phi::size_t StringSplitter::MatchDelimiterCharacter(const phi::size_t offset) const
+{
+    if (m_ASCIIDelimiters)
+    {
+        return 1u;
+    }
+
+    // Compare the whole UTF-8 sequence of each delimiter character
+    for (phi::size_t index{0u}; index < m_Delimiters.size();)
+    {
+        const phi::size_t start = index;
+        SkipCharacter(m_Delimiters, index);
+
+        const std::string_view character = m_Delimiters.substr(start, index - start);
+        if (m_String.substr(offset, character.size()) == character)
+        {
+            return character.size();
+        }
+    }
+
+    return 0u;
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,303 @@
+#include "OpenAutoIt/StringTransform.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <phi/core/types.hpp>
+#include <algorithm>
+#include <bit>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    template <bool Upper>
+    [[nodiscard]] std::string ConvertCase(const std::string_view string)
+    {
+        std::string result;
+        result.resize(string.size());
+
+        char*       output = result.data();
+        phi::size_t index{0u};
+        phi::size_t position{0u};
+
+        while (index < string.size())
+        {
+            phi::size_t chunk_end = string.size();
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+            // Convert runs of ASCII 16 bytes at a time
+            for (; index + 16u <= string.size(); index += 16u, position += 16u)
+            {
+                const __m128i bytes = LoadUnaligned(string.data() + index);
+                if (MatchNonASCII(bytes) != 0u)
+                {
+                    break;
+                }
+
+                const __m128i letters = Upper ? MaskByteRange(bytes, 'a', 'z') :
+                                                MaskByteRange(bytes, 'A', 'Z');
+                StoreUnaligned(output + position,
+                               _mm_xor_si128(bytes, _mm_and_si128(letters, _mm_set1_epi8(0x20))));
+            }
+
+            // Only go back to the vectorized loop after the chunk containing non ASCII bytes
+            chunk_end = std::min(index + 16u, string.size());
+#endif
+
+            while (index < chunk_end)
+            {
+                const char character = string[index];
+                if (static_cast<unsigned char>(character) < 0x80u)
+                {
+                    output[position++] = static_cast<char>(
+                            Upper ? ToUpperCase(static_cast<char32_t>(character)) :
+                                    ToLowerCase(static_cast<char32_t>(character)));
+                    ++index;
+                    continue;
+                }
+
+                const phi::size_t start      = index;
+                const char32_t    code_point = DecodeUTF8(string, index);
+                const char32_t    converted =
+                        Upper ? ToUpperCase(code_point) : ToLowerCase(code_point);
+
+                // Unchanged characters are copied as is which also keeps invalid sequences intact
+                if (converted == code_point)
+                {
+                    string.copy(output + position, index - start, start);
+                    position += index - start;
+                    continue;
+                }
+
+                // The result always has room for the rest of the input as is. Mappings which need
+                // more bytes than the original sequence grow it by the difference.
+                char              encoded[4];
+                const phi::size_t size = EncodeUTF8(converted, encoded);
+                if (size > index - start)
+                {
+                    result.resize(result.size() + size - (index - start));
+                    output = result.data();
+                }
+
+                std::copy_n(encoded, size, output + position);
+                position += size;
+                PHI_ASSERT(result.size() - position >= string.size() - index);
+            }
+        }
+
+        result.resize(position);
+        return result;
+    }
+
+    // Copies the string while leaving out every byte for which the matcher returns true. The
+    // chunk matcher gets 16 bytes at once and returns one bit per byte to leave out. It's only
+    // called with SSE2 support. Both may keep state as they see every byte once and in order.
+    template <typename ChunkMatcherT, typename MatcherT>
+    [[nodiscard]] std::string RemoveBytes(const std::string_view string,
+                                          [[maybe_unused]] ChunkMatcherT&& chunk_matcher,
+                                          MatcherT&&                       matcher)
+    {
+        std::string result;
+        result.resize(string.size());
+
+        char*       output = result.data();
+        phi::size_t index{0u};
+        phi::size_t position{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; index + 16u <= string.size(); index += 16u)
+        {
+            const __m128i      bytes   = LoadUnaligned(string.data() + index);
+            const unsigned int removed = chunk_matcher(bytes);
+            if (removed == 0u)
+            {
+                // NOTE: position never exceeds index so there is always room for 16 bytes
+                StoreUnaligned(output + position, bytes);
+                position += 16u;
+                continue;
+            }
+
+            for (unsigned int bit{0u}; bit < 16u; ++bit)
+            {
+                if ((removed & (1u << bit)) == 0u)
+                {
+                    output[position++] = string[index + bit];
+                }
+            }
+        }
+#endif
+
+        for (; index < string.size(); ++index)
+        {
+            if (!matcher(string[index]))
+            {
+                output[position++] = string[index];
+            }
+        }
+
+        result.resize(position);
+        return result;
+    }
+
+    [[nodiscard]] phi::size_t CountByte(const std::string_view string, const char character)
+    {
+        phi::size_t count{0u};
+        phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; index + 16u <= string.size(); index += 16u)
+        {
+            count += static_cast<phi::size_t>(
+                    std::popcount(MatchByte(LoadUnaligned(string.data() + index), character)));
+        }
+#endif
+
+        for (; index < string.size(); ++index)
+        {
+            count += static_cast<phi::size_t>(string[index] == character);
+        }
+
+        return count;
+    }
+
+    [[nodiscard]] phi::size_t FindFirstNonWhitespace(const std::string_view string)
+    {
+        phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; index + 16u <= string.size(); index += 16u)
+        {
+            const unsigned int whitespace =
+                    MatchWhitespace(LoadUnaligned(string.data() + index));
+            if (whitespace != 0xFFFFu)
+            {
+                return index + static_cast<phi::size_t>(std::countr_one(whitespace));
+            }
+        }
+#endif
+
+        while (index < string.size() && IsWhitespace(string[index]))
+        {
+            ++index;
+        }
+
+        return index;
+    }
+
+    // Returns the end of the string without its trailing whitespace
+    [[nodiscard]] phi::size_t FindLastNonWhitespace(const std::string_view string)
+    {
+        phi::size_t end = string.size();
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+        for (; end >= 16u; end -= 16u)
+        {
+            const auto whitespace = static_cast<phi::uint16_t>(
+                    MatchWhitespace(LoadUnaligned(string.data() + end - 16u)));
+            if (whitespace != 0xFFFFu)
+            {
+                return end - static_cast<phi::size_t>(std::countl_one(whitespace));
+            }
+        }
+#endif
+
+        while (end > 0u && IsWhitespace(string[end - 1u]))
+        {
+            --end;
+        }
+
+        return end;
+    }
+} // namespace
+
+std::string StringToUpperCase(const std::string_view string)
+{
+    return ConvertCase<true>(string);
+}
+
+std::string StringToLowerCase(const std::string_view string)
+{
+    return ConvertCase<false>(string);
+}
+
+std::string StringStripWhitespace(std::string_view string, const phi::int64_t flags)
+{
+    if ((flags & StripLeadingWhitespace) != 0)
+    {
+        string.remove_prefix(FindFirstNonWhitespace(string));
+    }
+    if ((flags & StripTrailingWhitespace) != 0)
+    {
+        string = string.substr(0u, FindLastNonWhitespace(string));
+    }
+
+    if ((flags & StripAllWhitespace) != 0)
+    {
+        return RemoveBytes(
+                string, [](const auto bytes) { return MatchWhitespace(bytes); },
+                [](const char character) { return IsWhitespace(character); });
+    }
+
+    if ((flags & StripDoubleWhitespace) != 0)
+    {
+        // Remove every whitespace character which directly follows another one
+        phi::boolean previous_whitespace{false};
+        return RemoveBytes(
+                string,
+                [&](const auto bytes) {
+                    const unsigned int whitespace = MatchWhitespace(bytes);
+                    const unsigned int removed =
+                            whitespace & ((whitespace << 1u) | (previous_whitespace ? 1u : 0u));
+
+                    previous_whitespace = (whitespace & 0x8000u) != 0u;
+                    return removed;
+                },
+                [&](const char character) {
+                    const phi::boolean whitespace = IsWhitespace(character);
+                    const phi::boolean removed    = whitespace && previous_whitespace;
+
+                    previous_whitespace = whitespace;
+                    return removed;
+                });
+    }
+
+    return std::string{string};
+}
+
+std::string StringAddCarriageReturns(const std::string_view string)
+{
+    std::string result;
+    result.resize(string.size() + CountByte(string, '\n'));
+
+    char*       output = result.data();
+    phi::size_t index{0u};
+    while (index < string.size())
+    {
+        const phi::size_t line_feed = std::min(string.find('\n', index), string.size());
+
+        output += string.copy(output, line_feed - index, index);
+        if (line_feed == string.size())
+        {
+            break;
+        }
+
+        *output++ = '\r';
+        *output++ = '\n';
+        index     = line_feed + 1u;
+    }
+
+    return result;
+}
+
+std::string StringStripCarriageReturns(const std::string_view string)
+{
+    return RemoveBytes(
+            string, [](const auto bytes) { return MatchByte(bytes, '\r'); },
+            [](const char character) { return character == '\r'; });
+}
+} // namespace OpenAutoIt
@@ -0,0 +1,274 @@
+#include "OpenAutoIt/ThreadPool.hpp"
+
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/assert.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/types.hpp>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Used to submit tasks from a worker to its own queue
+    thread_local const ThreadPool* current_thread_pool{nullptr};
+    thread_local phi::usize        current_worker_index{0u};
+} // namespace
+
+ThreadPool::ThreadPool(phi::usize number_of_threads)
+{
+    if (number_of_threads == 0u)
+    {
+        number_of_threads = 1u;
+    }
+
+    m_Queues.reserve(number_of_threads.unsafe());
+    for (phi::usize index{0u}; index < number_of_threads; ++index)
+    {
+        m_Queues.emplace_back(std::make_unique<WorkerQueue>());
+    }
+
+    m_Threads.reserve(number_of_threads.unsafe());
+    for (phi::usize index{0u}; index < number_of_threads; ++index)
+    {
+        m_Threads.emplace_back([this, index]() { WorkerLoop(index); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+        m_Stopping = true;
+    }
+    m_WorkAvailable.notify_all();
+
+    for (std::thread& thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::Submit(Task task)
+{
+    Enqueue(QueuedTask{phi::move(task), nullptr});
+}
+
+void ThreadPool::Submit(TaskGroup& group, Task task)
+{
+    Enqueue(QueuedTask{phi::move(task), &group});
+}
+
+void ThreadPool::Wait()
+{
+    std::unique_lock<std::mutex> lock{m_Mutex};
+    m_AllDone.wait(lock, [this]() { return m_UnfinishedTasks == 0u; });
+}
+
+void ThreadPool::Wait(TaskGroup& group)
+{
+    // Workers look at their own queue first which holds the tasks they just submitted
+    const phi::usize first_queue = current_thread_pool == this ? current_worker_index : 0u;
+
+    // NOTE: Only tasks of the group are run here. Other tasks might take arbitrarily long and the
+    //       group can always be finished by its own tasks since nested waits help as well.
+    QueuedTask task;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock{m_Mutex};
+            m_GroupProgress.wait(lock, [&group]() {
+                return group.m_UnfinishedTasks == 0u || group.m_QueuedTasks > 0u;
+            });
+
+            if (group.m_UnfinishedTasks == 0u)
+            {
+                return;
+            }
+        }
+
+        // Another thread might have taken the task in the meantime
+        if (TryPopGroupTask(first_queue, group, task))
+        {
+            RunTask(task);
+        }
+    }
+}
+
+ThreadPool& ThreadPool::GetShared()
+{
+    PHI_CLANG_SUPPRESS_WARNING_WITH_PUSH("-Wexit-time-destructors")
+
+    static ThreadPool shared_pool{std::thread::hardware_concurrency()};
+
+    PHI_CLANG_SUPPRESS_WARNING_POP()
+
+    return shared_pool;
+}
+
+phi::usize ThreadPool::GetNumberOfThreads() const
+{
+    return m_Threads.size();
+}
+
+void ThreadPool::Enqueue(QueuedTask task)
+{
+    phi::usize queue_index{0u};
+    if (current_thread_pool == this)
+    {
+        queue_index = current_worker_index;
+    }
+    else
+    {
+        std::lock_guard<std::mutex> lock{m_Mutex};
+        queue_index = m_NextQueue;
+        m_NextQueue = (m_NextQueue + 1u) % m_Queues.size();
+    }
+
+    const phi::boolean has_group = task.group != nullptr;
+
+    {
+        WorkerQueue&                queue = *m_Queues[queue_index.unsafe()];
+        std::lock_guard<std::mutex> queue_lock{queue.mutex};
+        std::lock_guard<std::mutex> lock{m_Mutex};
+
+        // Counted while the queue is still locked so the counts always match the queued tasks and
+        // a worker can never finish the task before it was counted
+        ++m_QueuedTasks;
+        ++m_UnfinishedTasks;
+        if (has_group)
+        {
+            ++task.group->m_QueuedTasks;
+            ++task.group->m_UnfinishedTasks;
+        }
+
+        queue.tasks.emplace_back(phi::move(task));
+    }
+
+    m_WorkAvailable.notify_one();
+    if (has_group)
+    {
+        m_GroupProgress.notify_all();
+    }
+}
+
+void ThreadPool::WorkerLoop(phi::usize worker_index)
+{
+    current_thread_pool  = this;
+    current_worker_index = worker_index;
+
+    QueuedTask task;
+    while (true)
+    {
+        if (TryPopTask(worker_index, task))
+        {
+            RunTask(task);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{m_Mutex};
+        m_WorkAvailable.wait(lock, [this]() { return m_Stopping || m_QueuedTasks > 0u; });
+
+        if (m_Stopping && m_QueuedTasks == 0u)
+        {
+            return;
+        }
+    }
+}
+
+phi::boolean ThreadPool::TryPopTask(phi::usize worker_index, QueuedTask& task)
+{
+    // First take the oldest task from our own queue
+    {
+        WorkerQueue&                queue = *m_Queues[worker_index.unsafe()];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        if (!queue.tasks.empty())
+        {
+            task = phi::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            Dequeued(task);
+            return true;
+        }
+    }
+
+    // Otherwise steal from another worker
+    const phi::usize number_of_queues = m_Queues.size();
+    for (phi::usize offset{1u}; offset < number_of_queues; ++offset)
+    {
+        WorkerQueue& queue = *m_Queues[((worker_index + offset) % number_of_queues).unsafe()];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        if (!queue.tasks.empty())
+        {
+            task = phi::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            Dequeued(task);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+phi::boolean ThreadPool::TryPopGroupTask(const phi::usize first_queue, const TaskGroup& group,
+                                         QueuedTask& task)
+{
+    const phi::usize number_of_queues = m_Queues.size();
+    for (phi::usize offset{0u}; offset < number_of_queues; ++offset)
+    {
+        WorkerQueue& queue = *m_Queues[((first_queue + offset) % number_of_queues).unsafe()];
+        std::lock_guard<std::mutex> lock{queue.mutex};
+
+        for (auto iterator = queue.tasks.rbegin(); iterator != queue.tasks.rend(); ++iterator)
+        {
+            if (iterator->group == &group)
+            {
+                task = phi::move(*iterator);
+                queue.tasks.erase(std::next(iterator).base());
+                Dequeued(task);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void ThreadPool::Dequeued(const QueuedTask& task)
+{
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    --m_QueuedTasks;
+    if (task.group != nullptr)
+    {
+        --task.group->m_QueuedTasks;
+    }
+}
+
+void ThreadPool::RunTask(QueuedTask& task)
+{
+    task.task();
+    task.task = nullptr;
+
+    std::lock_guard<std::mutex> lock{m_Mutex};
+    --m_UnfinishedTasks;
+    if (m_UnfinishedTasks == 0u)
+    {
+        m_AllDone.notify_all();
+    }
+
+    if (task.group != nullptr)
+    {
+        --task.group->m_UnfinishedTasks;
+        if (task.group->m_UnfinishedTasks == 0u)
+        {
+            m_GroupProgress.notify_all();
+        }
+        task.group = nullptr;
+    }
+}
+} // namespace OpenAutoIt
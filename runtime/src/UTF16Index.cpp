@@ -0,0 +1,116 @@
+#include "OpenAutoIt/UTF16Index.hpp"
+
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Lead bytes of four byte sequences encode characters which need a surrogate pair
+    [[nodiscard]] constexpr phi::size_t GetCodeUnits(const char lead_byte)
+    {
+        return static_cast<unsigned char>(lead_byte) >= 0xF0u ? 2u : 1u;
+    }
+} // namespace
+
+UTF16Index::UTF16Index(const std::string_view string)
+    : m_ASCIIPrefix{FindFirstNonASCII(string)}
+{
+    if (m_ASCIIPrefix == string.size())
+    {
+        m_Length = string.size();
+        return;
+    }
+
+    // Checkpoint n is the character containing the code unit m_ASCIIPrefix + n * CheckpointInterval
+    m_Checkpoints.reserve((string.size() - m_ASCIIPrefix) / CheckpointInterval + 1u);
+
+    phi::size_t code_units{m_ASCIIPrefix};
+    phi::size_t next_checkpoint{m_ASCIIPrefix};
+    for (phi::size_t offset{m_ASCIIPrefix}; offset < string.size(); ++offset)
+    {
+        const char byte = string[offset];
+        if (IsUTF8ContinuationByte(byte))
+        {
+            continue;
+        }
+
+        const phi::size_t width = GetCodeUnits(byte);
+        if (code_units + width > next_checkpoint)
+        {
+            m_Checkpoints.push_back({offset, code_units});
+            next_checkpoint += CheckpointInterval;
+        }
+
+        code_units += width;
+    }
+
+    m_Length = code_units;
+}
+
+phi::boolean UTF16Index::IsASCII() const
+{
+    return m_Checkpoints.empty();
+}
+
+phi::size_t UTF16Index::GetLength() const
+{
+    return m_Length;
+}
+
+phi::size_t UTF16Index::ToOffset(const std::string_view string, const phi::size_t index) const
+{
+    if (index <= m_ASCIIPrefix)
+    {
+        return std::min(index, string.size());
+    }
+
+    if (index >= m_Length)
+    {
+        return string.size();
+    }
+
+    const Checkpoint& checkpoint = m_Checkpoints[(index - m_ASCIIPrefix) / CheckpointInterval];
+
+    phi::size_t code_units{checkpoint.index};
+    for (phi::size_t offset{checkpoint.offset}; offset < string.size(); ++offset)
+    {
+        const char byte = string[offset];
+        if (IsUTF8ContinuationByte(byte))
+        {
+            continue;
+        }
+
+        if (code_units >= index)
+        {
+            return offset;
+        }
+
+        code_units += GetCodeUnits(byte);
+    }
+
+    return string.size();
+}
+
+phi::size_t UTF16Index::ToIndex(const std::string_view string, const phi::size_t offset) const
+{
+    if (offset <= m_ASCIIPrefix)
+    {
+        return std::min(offset, string.size());
+    }
+
+    // The last checkpoint at or before the offset
+    const auto checkpoint = std::prev(std::upper_bound(
+            m_Checkpoints.begin(), m_Checkpoints.end(), offset,
+            [](const phi::size_t value, const Checkpoint& entry) { return value < entry.offset; }));
+
+    return checkpoint->index +
+           CountUTF16CodeUnits(string.substr(checkpoint->offset, offset - checkpoint->offset));
+}
+} // namespace OpenAutoIt
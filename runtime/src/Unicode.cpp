@@ -0,0 +1,308 @@
+#include "OpenAutoIt/Unicode.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+namespace
+{
+    // Every stride-th code point in [first, last] maps to code point + delta
+    struct CaseMapping
+    {
+        char32_t     first;
+        char32_t     last;
+        phi::int32_t delta;
+        phi::uint8_t stride;
+    };
+
+    struct CodePointRange
+    {
+        char32_t first;
+        char32_t last;
+    };
+
+#include "UnicodeTables.inc"
+
+    [[nodiscard]] constexpr char32_t Offset(const char32_t code_point, const phi::int32_t delta)
+    {
+        return static_cast<char32_t>(static_cast<phi::int32_t>(code_point) + delta);
+    }
+
+    template <phi::size_t Size>
+    [[nodiscard]] char32_t MapCase(const CaseMapping (&mappings)[Size], const char32_t code_point)
+    {
+        // Find the last mapping starting at or before the code point
+        const CaseMapping* mapping = std::upper_bound(
+                mappings, mappings + Size, code_point,
+                [](const char32_t value, const CaseMapping& entry) { return value < entry.first; });
+        if (mapping == mappings)
+        {
+            return code_point;
+        }
+
+        --mapping;
+        if (code_point > mapping->last || (code_point - mapping->first) % mapping->stride != 0u)
+        {
+            return code_point;
+        }
+
+        return Offset(code_point, mapping->delta);
+    }
+} // namespace
+
+char32_t DecodeUTF8(const std::string_view string, phi::size_t& index)
+{
+    const auto lead = static_cast<unsigned char>(string[index]);
+    if (lead < 0x80u)
+    {
+        ++index;
+        return lead;
+    }
+
+    phi::size_t length{0u};
+    char32_t    code_point{0u};
+    char32_t    minimum{0u};
+    if ((lead & 0xE0u) == 0xC0u)
+    {
+        length     = 2u;
+        code_point = lead & 0x1Fu;
+        minimum    = 0x80u;
+    }
+    else if ((lead & 0xF0u) == 0xE0u)
+    {
+        length     = 3u;
+        code_point = lead & 0x0Fu;
+        minimum    = 0x800u;
+    }
+    else if ((lead & 0xF8u) == 0xF0u)
+    {
+        length     = 4u;
+        code_point = lead & 0x07u;
+        minimum    = 0x10000u;
+    }
+    else
+    {
+        ++index;
+        return ReplacementCharacter;
+    }
+
+    if (string.size() - index < length)
+    {
+        ++index;
+        return ReplacementCharacter;
+    }
+
+    for (phi::size_t offset{1u}; offset < length; ++offset)
+    {
+        const char byte = string[index + offset];
+        if (!IsUTF8ContinuationByte(byte))
+        {
+            ++index;
+            return ReplacementCharacter;
+        }
+
+        code_point = (code_point << 6u) | (static_cast<unsigned char>(byte) & 0x3Fu);
+    }
+
+    // Overlong encodings, surrogates and values past the last code point are invalid
+    if (code_point < minimum || code_point > 0x10FFFFu ||
+        (code_point >= 0xD800u && code_point <= 0xDFFFu))
+    {
+        ++index;
+        return ReplacementCharacter;
+    }
+
+    index += length;
+    return code_point;
+}
+
+phi::size_t EncodeUTF8(const char32_t code_point, char* output)
+{
+    if (code_point < 0x80u)
+    {
+        output[0u] = static_cast<char>(code_point);
+        return 1u;
+    }
+    if (code_point < 0x800u)
+    {
+        output[0u] = static_cast<char>(0xC0u | (code_point >> 6u));
+        output[1u] = static_cast<char>(0x80u | (code_point & 0x3Fu));
+        return 2u;
+    }
+    if (code_point < 0x10000u)
+    {
+        output[0u] = static_cast<char>(0xE0u | (code_point >> 12u));
+        output[1u] = static_cast<char>(0x80u | ((code_point >> 6u) & 0x3Fu));
+        output[2u] = static_cast<char>(0x80u | (code_point & 0x3Fu));
+        return 3u;
+    }
+
+    output[0u] = static_cast<char>(0xF0u | (code_point >> 18u));
+    output[1u] = static_cast<char>(0x80u | ((code_point >> 12u) & 0x3Fu));
+    output[2u] = static_cast<char>(0x80u | ((code_point >> 6u) & 0x3Fu));
+    output[3u] = static_cast<char>(0x80u | (code_point & 0x3Fu));
+    return 4u;
+}
+
+void AppendUTF8(std::string& string, const char32_t code_point)
+{
+    char              buffer[4u];
+    const phi::size_t size = EncodeUTF8(code_point, buffer);
+
+    string.append(buffer, size);
+}
+
+phi::boolean IsASCII(const std::string_view string)
+{
+    // NOTE: No early exit so the loop gets vectorized
+    unsigned char bits{0u};
+    for (const char character : string)
+    {
+        bits |= static_cast<unsigned char>(character);
+    }
+
+    return bits < 0x80u;
+}
+
+phi::size_t FindFirstNonASCII(const std::string_view string)
+{
+    phi::size_t index{0u};
+
+#if defined(OPENAUTOIT_HAS_SSE2)
+    for (; index + 16u <= string.size(); index += 16u)
+    {
+        if (const unsigned int non_ascii = MatchNonASCII(LoadUnaligned(string.data() + index));
+            non_ascii != 0u)
+        {
+            return index + static_cast<phi::size_t>(std::countr_zero(non_ascii));
+        }
+    }
+#endif
+
+    for (; index < string.size(); ++index)
+    {
+        if (static_cast<unsigned char>(string[index]) >= 0x80u)
+        {
+            return index;
+        }
+    }
+
+    return string.size();
+}
+
+phi::boolean IsValidUTF8(const std::string_view string)
+{
+    // Runs of ASCII are skipped 16 bytes at a time so only the other sequences get decoded. Invalid
+    // sequences are the only ones which decode to U+FFFD and advance by a single byte.
+    for (phi::size_t index = FindFirstNonASCII(string); index < string.size();
+         index += FindFirstNonASCII(string.substr(index)))
+    {
+        const phi::size_t start = index;
+        if (DecodeUTF8(string, index) == ReplacementCharacter && index - start == 1u)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string SanitizeUTF8(const std::string_view string)
+{
+    std::string result;
+    result.reserve(string.size());
+
+    phi::size_t valid_start{0u};
+    for (phi::size_t index = FindFirstNonASCII(string); index < string.size();
+         index += FindFirstNonASCII(string.substr(index)))
+    {
+        const phi::size_t start = index;
+        if (DecodeUTF8(string, index) == ReplacementCharacter && index - start == 1u)
+        {
+            result.append(string.substr(valid_start, start - valid_start));
+            AppendUTF8(result, ReplacementCharacter);
+            valid_start = index;
+        }
+    }
+
+    result.append(string.substr(valid_start));
+    return result;
+}
+
+phi::size_t CountUTF16CodeUnits(const std::string_view string)
+{
+    // Every lead byte starts a code unit and four byte sequences need a surrogate pair
+    phi::size_t code_units{0u};
+    for (const char character : string)
+    {
+        const auto byte = static_cast<unsigned char>(character);
+        code_units += static_cast<phi::size_t>((byte & 0xC0u) != 0x80u);
+        code_units += static_cast<phi::size_t>(byte >= 0xF0u);
+    }
+
+    return code_units;
+}
+
+phi::size_t FindUTF8Offset(const std::string_view string, const phi::size_t code_units)
+{
+    phi::size_t count{0u};
+    for (phi::size_t offset{0u}; offset < string.size(); ++offset)
+    {
+        const auto byte = static_cast<unsigned char>(string[offset]);
+        if ((byte & 0xC0u) == 0x80u)
+        {
+            continue;
+        }
+
+        if (count >= code_units)
+        {
+            return offset;
+        }
+
+        count += byte >= 0xF0u ? 2u : 1u;
+    }
+
+    return string.size();
+}
+
+char32_t ToLowerCase(const char32_t code_point)
+{
+    if (code_point < 0x80u)
+    {
+        return code_point >= 'A' && code_point <= 'Z' ? code_point + 32u : code_point;
+    }
+
+    return MapCase(lower_case_mappings, code_point);
+}
+
+char32_t ToUpperCase(const char32_t code_point)
+{
+    if (code_point < 0x80u)
+    {
+        return code_point >= 'a' && code_point <= 'z' ? code_point - 32u : code_point;
+    }
+
+    return MapCase(upper_case_mappings, code_point);
+}
+
+phi::boolean IsLetter(const char32_t code_point)
+{
+    const CodePointRange* range = std::upper_bound(
+            std::begin(letter_ranges), std::end(letter_ranges), code_point,
+            [](const char32_t value, const CodePointRange& entry) { return value < entry.first; });
+
+    return range != std::begin(letter_ranges) && code_point <= (range - 1)->last;
+}
+
+char32_t FoldCase(const char32_t code_point)
+{
+    return ToLowerCase(ToUpperCase(code_point));
+}
+} // namespace OpenAutoIt
@@ -1,5 +1,11 @@
 #include "OpenAutoIt/Variant.hpp"
 
+#include "OpenAutoIt/Arithmetic.hpp"
+#include "OpenAutoIt/Map.hpp"
+#include "OpenAutoIt/NumberFormatting.hpp"
+#include "OpenAutoIt/NumberParsing.hpp"
+#include "OpenAutoIt/StringComparison.hpp"
+#include "OpenAutoIt/UTF16Index.hpp"
 #include "OpenAutoIt/UnsafeOperations.hpp"
 #include <phi/algorithm/clamp.hpp>
 #include <phi/compiler_support/extended_attributes.hpp>
@@ -9,11 +15,17 @@
 #include <phi/core/boolean.hpp>
 #include <phi/core/move.hpp>
 #include <phi/core/narrow_cast.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
 #include <phi/core/types.hpp>
 #include <phi/core/unsafe_cast.hpp>
 #include <phi/math/abs.hpp>
+#include <algorithm>
+#include <cstring>
 #include <functional>
+#include <limits>
 #include <string>
+#include <string_view>
 
 PHI_MSVC_SUPPRESS_WARNING(4702) // unreachable code
 PHI_GCC_SUPPRESS_WARNING("-Wsuggest-attribute=const")
@@ -22,6 +34,254 @@ PHI_CLANG_SUPPRESS_WARNING("-Wswitch-default")
 namespace OpenAutoIt
 {
 
+namespace
+{
+    using ArithmeticFunction = Variant (*)(const Variant& lhs, const Variant& rhs);
+
+    // NOTE: Variant::Type::String is the last enum value
+    constexpr const phi::size_t NumberOfVariantTypes =
+            static_cast<phi::size_t>(Variant::Type::String) + 1u;
+
+    [[nodiscard]] Variant MakeVariant(const Number number)
+    {
+        if (number.is_double)
+        {
+            return Variant::MakeDouble(number.floating_point);
+        }
+
+        return Variant::MakeInt(number.int64);
+    }
+
+    // Entries of the dispatch table
+    template <ArithmeticOperation Operation>
+    [[nodiscard]] Variant ArithmeticInt64Int64(const Variant& lhs, const Variant& rhs)
+    {
+        return MakeVariant(
+                ArithmeticInt64<Operation>(lhs.AsInt64().unsafe(), rhs.AsInt64().unsafe()));
+    }
+
+    template <ArithmeticOperation Operation>
+    [[nodiscard]] Variant ArithmeticInt64Double(const Variant& lhs, const Variant& rhs)
+    {
+        return MakeVariant(ArithmeticDouble<Operation>(static_cast<double>(lhs.AsInt64().unsafe()),
+                                                       rhs.AsDouble().unsafe()));
+    }
+
+    template <ArithmeticOperation Operation>
+    [[nodiscard]] Variant ArithmeticDoubleInt64(const Variant& lhs, const Variant& rhs)
+    {
+        return MakeVariant(ArithmeticDouble<Operation>(
+                lhs.AsDouble().unsafe(), static_cast<double>(rhs.AsInt64().unsafe())));
+    }
+
+    template <ArithmeticOperation Operation>
+    [[nodiscard]] Variant ArithmeticDoubleDouble(const Variant& lhs, const Variant& rhs)
+    {
+        return MakeVariant(
+                ArithmeticDouble<Operation>(lhs.AsDouble().unsafe(), rhs.AsDouble().unsafe()));
+    }
+
+    template <ArithmeticOperation Operation>
+    [[nodiscard]] Variant DispatchArithmetic(const Variant& lhs, const Variant& rhs);
+
+    // Any non numeric operand is first converted to a number. Strings are parsed while all other
+    // types are cast to Int64
+    template <ArithmeticOperation Operation>
+    [[nodiscard]] Variant ArithmeticCoerce(const Variant& lhs, const Variant& rhs)
+    {
+        const Variant lhs_numeric = lhs.CastToNumeric();
+        const Variant rhs_numeric = rhs.CastToNumeric();
+
+        PHI_ASSERT(lhs_numeric.IsNumeric());
+        PHI_ASSERT(rhs_numeric.IsNumeric());
+
+        return DispatchArithmetic<Operation>(lhs_numeric, rhs_numeric);
+    }
+
+    template <ArithmeticOperation Operation>
+    class ArithmeticDispatchTable
+    {
+    public:
+        constexpr ArithmeticDispatchTable()
+        {
+            for (auto& row : m_Table)
+            {
+                for (ArithmeticFunction& function : row)
+                {
+                    function = &ArithmeticCoerce<Operation>;
+                }
+            }
+
+            m_Table[Index(Variant::Type::Int64)][Index(Variant::Type::Int64)] =
+                    &ArithmeticInt64Int64<Operation>;
+            m_Table[Index(Variant::Type::Int64)][Index(Variant::Type::Double)] =
+                    &ArithmeticInt64Double<Operation>;
+            m_Table[Index(Variant::Type::Double)][Index(Variant::Type::Int64)] =
+                    &ArithmeticDoubleInt64<Operation>;
+            m_Table[Index(Variant::Type::Double)][Index(Variant::Type::Double)] =
+                    &ArithmeticDoubleDouble<Operation>;
+        }
+
+        [[nodiscard]] constexpr ArithmeticFunction Lookup(const Variant::Type lhs,
+                                                          const Variant::Type rhs) const
+        {
+            return m_Table[Index(lhs)][Index(rhs)];
+        }
+
+    private:
+        [[nodiscard]] static constexpr phi::size_t Index(const Variant::Type type)
+        {
+            return static_cast<phi::size_t>(type);
+        }
+
+        ArithmeticFunction m_Table[NumberOfVariantTypes][NumberOfVariantTypes]{};
+    };
+
+    template <ArithmeticOperation Operation>
+    constexpr const ArithmeticDispatchTable<Operation> arithmetic_dispatch_table{};
+
+    template <ArithmeticOperation Operation>
+    Variant DispatchArithmetic(const Variant& lhs, const Variant& rhs)
+    {
+        return arithmetic_dispatch_table<Operation>.Lookup(lhs.GetType(), rhs.GetType())(lhs, rhs);
+    }
+
+    [[nodiscard]] Number ToNumber(const Variant& value)
+    {
+        switch (value.GetType())
+        {
+            case Variant::Type::Int64:
+                return Number::MakeInt(value.AsInt64().unsafe());
+
+            case Variant::Type::Double:
+                return Number::MakeDouble(value.AsDouble().unsafe());
+
+            case Variant::Type::String:
+                return ParseNumber(value.AsString());
+
+            default:
+                return ToNumber(value.CastToNumeric());
+        }
+    }
+
+    // https://www.autoitscript.com/autoit3/docs/intro/lang_operators.htm
+    // Two strings or two binaries are compared directly, everything else is compared as numbers
+    [[nodiscard]] Ordering CompareValues(const Variant& lhs, const Variant& rhs)
+    {
+        if (lhs.IsString() && rhs.IsString())
+        {
+            const int result = StringCompareIgnoreCase(lhs.AsString(), rhs.AsString());
+
+            return result < 0 ? Ordering::Less : result > 0 ? Ordering::Greater : Ordering::Equal;
+        }
+
+        if (lhs.IsBinary() && rhs.IsBinary())
+        {
+            const int result = lhs.AsBinary().GetBytes().compare(rhs.AsBinary().GetBytes());
+
+            return result < 0 ? Ordering::Less : result > 0 ? Ordering::Greater : Ordering::Equal;
+        }
+
+        return CompareNumbers(ToNumber(lhs), ToNumber(rhs));
+    }
+
+    // Writes the lowest size bytes of the value in little endian
+    [[nodiscard]] std::string EncodeLittleEndian(phi::uint64_t value, const phi::size_t size)
+    {
+        std::string bytes(size, '\0');
+        for (char& byte : bytes)
+        {
+            byte = static_cast<char>(value & 0xFFu);
+            value >>= 8u;
+        }
+
+        return bytes;
+    }
+
+    // Reads up to 8 bytes in little endian, missing bytes are treated as zero
+    [[nodiscard]] phi::int64_t DecodeLittleEndian(const std::string_view bytes)
+    {
+        phi::uint64_t value{0u};
+        for (phi::size_t index{std::min<phi::size_t>(bytes.size(), 8u)}; index > 0u; --index)
+        {
+            value = (value << 8u) | static_cast<unsigned char>(bytes[index - 1u]);
+        }
+
+        return static_cast<phi::int64_t>(value);
+    }
+
+    // Returned by the const accessors for payloads which were never allocated
+    const array_t  empty_array{};
+    const binary_t empty_binary{};
+    const map_t    empty_map{};
+    const string_t empty_string{};
+
+    const UTF16Index empty_utf16_index{};
+
+    // NOTE: The reference count isn't atomic. Variants can be created on other threads, like the
+    //       lines SplitLines produces on the thread pool, but a payload is never accessed by two
+    //       threads at the same time. Handing Variants to another thread has to go through a
+    //       synchronizing join like ThreadPool::Wait.
+    template <typename PayloadT>
+    [[nodiscard]] PayloadT* SharePayload(PayloadT* payload)
+    {
+        if (payload != nullptr)
+        {
+            ++payload->reference_count;
+        }
+
+        return payload;
+    }
+
+    template <typename PayloadT>
+    void ReleasePayload(PayloadT*& payload)
+    {
+        if (payload != nullptr && --payload->reference_count == 0u)
+        {
+            delete payload; // NOLINT(cppcoreguidelines-owning-memory)
+        }
+
+        payload = nullptr;
+    }
+
+    // Allocates the payload if its empty or copies it if its shared with other Variants, so it can
+    // safely be modified
+    template <typename PayloadT>
+    [[nodiscard]] auto& MutablePayload(PayloadT*& payload)
+    {
+        if (payload == nullptr)
+        {
+            payload = new PayloadT(); // NOLINT(cppcoreguidelines-owning-memory)
+        }
+        else if (payload->reference_count > 1u)
+        {
+            PayloadT* copy =
+                    new PayloadT{payload->value, 1u}; // NOLINT(cppcoreguidelines-owning-memory)
+            --payload->reference_count;
+            payload = copy;
+        }
+
+        return payload->value;
+    }
+} // namespace
+
+template <typename T>
+struct Variant::SharedPayload
+{
+    T           value;
+    phi::size_t reference_count{1u};
+};
+
+// Strings additionally cache their UTF-16 index which has to be dropped whenever the string is
+// handed out mutably. Copies of the payload start without an index.
+template <>
+struct Variant::SharedPayload<string_t>
+{
+    string_t                          value;
+    phi::size_t                       reference_count{1u};
+    mutable phi::optional<UTF16Index> utf16_index{};
+};
+
 PHI_MSVC_SUPPRESS_WARNING_PUSH()
 PHI_MSVC_SUPPRESS_WARNING(4582) // constructor is not implicitly called
 PHI_MSVC_SUPPRESS_WARNING(4583) // destructor is not implicitly called
@@ -29,7 +289,7 @@ PHI_MSVC_SUPPRESS_WARNING(4583) // destructor is not implicitly called
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
 Variant::Variant()
     : m_Type{Type::String}
-    , string{} // NOLINT(readability-redundant-member-init)
+    , string{nullptr}
 {}
 
 // NOLINTNEXTLINE(cppcoreguidelines-pro-type-member-init)
@@ -78,22 +338,20 @@ void Variant::Clear()
     switch (m_Type)
     {
         case Type::Array:
-            PHI_ASSERT(array.data());
-
-            array.~vector();
+            ReleasePayload(array);
             return;
 
         case Type::String:
         case Type::Function:
-            PHI_ASSERT(string.c_str());
-
-            string.~basic_string();
+            ReleasePayload(string);
             return;
 
         case Type::Binary:
-            PHI_ASSERT(binary.c_str());
+            ReleasePayload(binary);
+            return;
 
-            binary.~basic_string();
+        case Type::Map:
+            ReleasePayload(map);
             return;
 
         default:
@@ -131,6 +389,8 @@ PHI_ATTRIBUTE_PURE phi::string_view Variant::GetTypeName() const
             return "Int64";
         case Type::Keyword:
             return "Keyword";
+        case Type::Map:
+            return "Map";
         case Type::Pointer:
             return "Pointer";
         case Type::String:
@@ -201,6 +461,11 @@ PHI_ATTRIBUTE_CONST phi::boolean Variant::IsKeyword() const
     return m_Type == Type::Keyword;
 }
 
+PHI_ATTRIBUTE_CONST phi::boolean Variant::IsMap() const
+{
+    return m_Type == Type::Map;
+}
+
 PHI_ATTRIBUTE_CONST phi::boolean Variant::IsDefault() const
 {
     return m_Type == Type::Keyword && keyword == TokenKind::KW_Default;
@@ -257,32 +522,52 @@ PHI_ATTRIBUTE_PURE const phi::boolean& Variant::AsBoolean() const
     return boolean;
 }
 
-PHI_ATTRIBUTE_PURE string_t& Variant::AsString()
+string_t& Variant::AsString()
 {
     PHI_ASSERT(m_Type == Type::String);
 
-    return string;
+    string_t& value = MutablePayload(string);
+    string->utf16_index.reset();
+
+    return value;
 }
 
 PHI_ATTRIBUTE_PURE const string_t& Variant::AsString() const
 {
     PHI_ASSERT(m_Type == Type::String);
 
-    return string;
+    return string != nullptr ? string->value : empty_string;
+}
+
+const UTF16Index& Variant::GetUTF16Index() const
+{
+    PHI_ASSERT(m_Type == Type::String);
+
+    if (string == nullptr)
+    {
+        return empty_utf16_index;
+    }
+
+    if (!string->utf16_index)
+    {
+        string->utf16_index.emplace(std::string_view{string->value});
+    }
+
+    return *string->utf16_index;
 }
 
-PHI_ATTRIBUTE_PURE binary_t& Variant::AsBinary()
+binary_t& Variant::AsBinary()
 {
     PHI_ASSERT(m_Type == Type::Binary);
 
-    return binary;
+    return MutablePayload(binary);
 }
 
 PHI_ATTRIBUTE_PURE const binary_t& Variant::AsBinary() const
 {
     PHI_ASSERT(m_Type == Type::Binary);
 
-    return binary;
+    return binary != nullptr ? binary->value : empty_binary;
 }
 
 PHI_ATTRIBUTE_PURE ptr_t& Variant::AsPointer()
@@ -299,32 +584,46 @@ PHI_ATTRIBUTE_PURE const ptr_t& Variant::AsPointer() const
     return pointer;
 }
 
-PHI_ATTRIBUTE_PURE array_t& Variant::AsArray()
+array_t& Variant::AsArray()
 {
     PHI_ASSERT(m_Type == Type::Array);
 
-    return array;
+    return MutablePayload(array);
 }
 
 PHI_ATTRIBUTE_PURE const array_t& Variant::AsArray() const
 {
     PHI_ASSERT(m_Type == Type::Array);
 
-    return array;
+    return array != nullptr ? array->value : empty_array;
+}
+
+map_t& Variant::AsMap()
+{
+    PHI_ASSERT(m_Type == Type::Map);
+
+    return MutablePayload(map);
 }
 
-PHI_ATTRIBUTE_PURE string_t& Variant::AsFunction()
+PHI_ATTRIBUTE_PURE const map_t& Variant::AsMap() const
+{
+    PHI_ASSERT(m_Type == Type::Map);
+
+    return map != nullptr ? map->value : empty_map;
+}
+
+string_t& Variant::AsFunction()
 {
     PHI_ASSERT(m_Type == Type::Function);
 
-    return string;
+    return MutablePayload(string);
 }
 
 PHI_ATTRIBUTE_PURE const string_t& Variant::AsFunction() const
 {
     PHI_ASSERT(m_Type == Type::Function);
 
-    return string;
+    return string != nullptr ? string->value : empty_string;
 }
 
 PHI_ATTRIBUTE_PURE OpenAutoIt::TokenKind& Variant::AsKeyword()
@@ -341,11 +640,55 @@ PHI_ATTRIBUTE_PURE const OpenAutoIt::TokenKind& Variant::AsKeyword() const
     return keyword;
 }
 
-PHI_ATTRIBUTE_CONST Variant Variant::CastToBinary() const
+Variant Variant::CastToBinary() const
 {
-    // TODO: Implement me
+    // https://www.autoitscript.com/autoit3/docs/functions/Binary.htm
+    switch (m_Type)
+    {
+        // Nothing todo here since we're already a binary
+        case Type::Binary:
+            return *this;
 
-    return {};
+        // Numbers are stored in little endian, integers which fit into 32-bit only use 4 bytes
+        case Type::Boolean:
+            return MakeBinary(Binary{EncodeLittleEndian(AsBoolean() ? 1u : 0u, 4u)});
+
+        case Type::Double: {
+            phi::uint64_t bits{0u};
+            const double  value = AsDouble().unsafe();
+            std::memcpy(&bits, &value, sizeof(bits));
+
+            return MakeBinary(Binary{EncodeLittleEndian(bits, 8u)});
+        }
+
+        case Type::Int64: {
+            const phi::int64_t value = AsInt64().unsafe();
+            const phi::boolean fits_int32 =
+                    value >= std::numeric_limits<phi::int32_t>::min() &&
+                    value <= std::numeric_limits<phi::int32_t>::max();
+
+            return MakeBinary(Binary{
+                    EncodeLittleEndian(static_cast<phi::uint64_t>(value), fits_int32 ? 4u : 8u)});
+        }
+
+        case Type::Pointer:
+            return MakeBinary(Binary{EncodeLittleEndian(AsPointer(), sizeof(ptr_t))});
+
+        // Strings like "0x4142" are parsed as hex, all others use their bytes as is
+        case Type::String: {
+            const string_t&             string = AsString();
+            const phi::optional<Binary> parsed = Binary::FromHexString(string);
+            if (parsed)
+            {
+                return MakeBinary(binary_t{parsed.value()});
+            }
+
+            return MakeBinary(Binary{std::string_view{string}});
+        }
+
+        default:
+            return MakeBinary(Binary{});
+    }
 }
 
 Variant Variant::CastToBoolean() const
@@ -360,13 +703,13 @@ Variant Variant::CastToBoolean() const
         case Type::Array:
         case Type::Function:
         case Type::Keyword:
+        case Type::Map:
             // These types are always false regardless of their value
             return Variant::MakeBoolean(false);
 
-        case Type::Binary: {
-            // TODO:
-            return {};
-        }
+        // Empty binaries are false
+        case Type::Binary:
+            return MakeBoolean(!AsBinary().IsEmpty());
 
         case Type::Boolean:
             // Nothing todo as we already have a boolean
@@ -398,7 +741,7 @@ Variant Variant::CastToBoolean() const
         }
 
         case Type::String: {
-            const string_t value = AsString();
+            const string_t& value = AsString();
 
             // Every apart from the empty string "" is considered true
             return MakeBoolean(!value.empty());
@@ -409,16 +752,39 @@ Variant Variant::CastToBoolean() const
     return {};
 }
 
-PHI_ATTRIBUTE_CONST Variant Variant::CastToDouble() const
+Variant Variant::CastToDouble() const
 {
-    // TODO
-    return {};
+    switch (m_Type)
+    {
+        case Type::Binary:
+            return MakeDouble(static_cast<double>(DecodeLittleEndian(AsBinary().GetBytes())));
+
+        case Type::Boolean:
+            return MakeDouble(AsBoolean() ? 1.0 : 0.0);
+
+        // Nothing todo here since we're already a double
+        case Type::Double:
+            return *this;
+
+        case Type::Int64:
+            return MakeDouble(static_cast<double>(AsInt64().unsafe()));
+
+        case Type::String:
+            return MakeDouble(ParseNumber(AsString()).AsDouble());
+
+        default:
+            return MakeDouble(0.0);
+    }
 }
 
 PHI_ATTRIBUTE_CONST Variant Variant::CastToInt64() const
 {
     switch (m_Type)
     {
+        // The bytes are interpreted as a little endian integer
+        case Type::Binary:
+            return MakeInt(DecodeLittleEndian(AsBinary().GetBytes()));
+
         case Type::Boolean: {
             return MakeInt(AsBoolean() ? 1 : 0);
         }
@@ -440,11 +806,15 @@ PHI_ATTRIBUTE_CONST Variant Variant::CastToInt64() const
         }
 
         case Type::String: {
-            const string_t value = AsString();
+            const Number number = ParseNumber(AsString());
 
-            const phi::int64_t int64_value = std::strtol(value.c_str(), nullptr, 10);
+            // Fractions are truncated
+            if (number.is_double)
+            {
+                return MakeDouble(number.floating_point).CastToInt64();
+            }
 
-            return MakeInt(int64_value);
+            return MakeInt(number.int64);
         }
 
         default:
@@ -463,14 +833,17 @@ Variant Variant::CastToString() const
     // https://www.autoitscript.com/autoit3/docs/functions/String.htm
     switch (m_Type)
     {
-        case Type::Array: {
+        case Type::Array:
+        case Type::Map: {
             // TODO:
             return {};
         }
 
         case Type::Binary: {
-            // TODO:
-            return {};
+            Variant result;
+            AsBinary().AppendHexString(result.AsString());
+
+            return result;
         }
 
         case Type::Boolean: {
@@ -483,10 +856,10 @@ Variant Variant::CastToString() const
         }
 
         case Type::Double: {
-            const phi::f64 value = AsDouble();
+            NumberBuffer           buffer;
+            const std::string_view formatted = FormatDouble(AsDouble().unsafe(), buffer);
 
-            // TODO: std::to_string outputs our values with trailing zeros which is not what we want
-            return MakeString(std::to_string(value.unsafe()));
+            return MakeString(phi::string_view{formatted.data(), formatted.size()});
         }
 
         case Type::Function: {
@@ -496,9 +869,10 @@ Variant Variant::CastToString() const
         }
 
         case Type::Int64: {
-            const phi::i64 value = AsInt64();
+            NumberBuffer           buffer;
+            const std::string_view formatted = FormatInt64(AsInt64().unsafe(), buffer);
 
-            return MakeString(std::to_string(value.unsafe()));
+            return MakeString(phi::string_view{formatted.data(), formatted.size()});
         }
 
         case Type::Keyword: {
@@ -546,25 +920,8 @@ Variant Variant::CastToNumeric() const
         case Type::Double:
             return *this;
 
-        case Type::String: {
-            // TODO: Instead of converting the same string twice, we could write our own function to do this
-            string_t value = AsString();
-
-            // First attempt to convert to a double
-            char*        double_end_ptr = value.data() + value.length();
-            const double double_value   = strtod(value.c_str(), &double_end_ptr);
-
-            char*              int64_end_ptr = value.data() + value.length();
-            const phi::int64_t int64_value   = std::strtol(value.c_str(), &int64_end_ptr, 10);
-
-            // Use the double value if that parsed more otherwise use the int64
-            if (double_end_ptr > int64_end_ptr)
-            {
-                return MakeDouble(double_value);
-            }
-
-            return MakeInt(int64_value);
-        }
+        case Type::String:
+            return MakeVariant(ParseNumber(AsString()));
 
         // All other types are simply cast to int64
         default:
@@ -574,40 +931,128 @@ Variant Variant::CastToNumeric() const
 
 Variant Variant::Add(const Variant& other) const
 {
-    (void)other;
-    // TODO:
-    return {};
+    return DispatchArithmetic<ArithmeticOperation::Add>(*this, other);
 }
 
 Variant Variant::Subtract(const Variant& other) const
 {
-    (void)other;
-    // TODO:
-    return {};
+    return DispatchArithmetic<ArithmeticOperation::Subtract>(*this, other);
 }
 
 Variant Variant::Multiply(const Variant& other) const
 {
-    (void)other;
-    // TODO:
-    return {};
+    return DispatchArithmetic<ArithmeticOperation::Multiply>(*this, other);
 }
 
 Variant Variant::Divide(const Variant& other) const
 {
-    (void)other;
-    // TODO:
-    return {};
+    return DispatchArithmetic<ArithmeticOperation::Divide>(*this, other);
+}
+
+Variant Variant::Power(const Variant& other) const
+{
+    return DispatchArithmetic<ArithmeticOperation::Power>(*this, other);
 }
 
 Variant Variant::Concatenate(const Variant& other) const
 {
-    const Variant this_string  = CastToString();
-    const Variant other_string = other.CastToString();
+    // Concatenating two binaries results in a binary
+    Variant result = IsString() || (IsBinary() && other.IsBinary()) ? *this : CastToString();
+    result.Append(other);
 
-    const string_t string_value = this_string.AsString() + other_string.AsString();
+    return result;
+}
+
+void Variant::Append(const Variant& other)
+{
+    if (IsBinary() && other.IsBinary())
+    {
+        AsBinary().Append(other.AsBinary().GetBytes());
+        return;
+    }
+
+    if (!IsString())
+    {
+        *this = CastToString();
+    }
+
+    // NOTE: std::string grows geometrically so appending repeatedly is amortized linear
+    NumberBuffer buffer;
+    switch (other.GetType())
+    {
+        case Type::String:
+            AsString() += other.AsString();
+            return;
+
+        // Numbers are formatted directly into the string
+        case Type::Int64:
+            AsString() += FormatInt64(other.AsInt64().unsafe(), buffer);
+            return;
+
+        case Type::Double:
+            AsString() += FormatDouble(other.AsDouble().unsafe(), buffer);
+            return;
+
+        case Type::Binary:
+            other.AsBinary().AppendHexString(AsString());
+            return;
+
+        default:
+            AsString() += other.CastToString().AsString();
+            return;
+    }
+}
+
+Variant Variant::Equal(const Variant& other) const
+{
+    // Equality doesn't need the ordering which allows for a faster string comparison
+    if (IsString() && other.IsString())
+    {
+        return MakeBoolean(StringEqualsIgnoreCase(AsString(), other.AsString()));
+    }
 
-    return Variant::MakeString(phi::move(string_value));
+    return MakeBoolean(CompareValues(*this, other) == Ordering::Equal);
+}
+
+Variant Variant::EqualCaseSensitive(const Variant& other) const
+{
+    // NOTE: Only values which aren't strings yet are converted
+    const Variant lhs_string = IsString() ? Variant{} : CastToString();
+    const Variant rhs_string = other.IsString() ? Variant{} : other.CastToString();
+
+    const string_t& lhs = IsString() ? AsString() : lhs_string.AsString();
+    const string_t& rhs = other.IsString() ? other.AsString() : rhs_string.AsString();
+
+    return MakeBoolean(lhs == rhs);
+}
+
+Variant Variant::NotEqual(const Variant& other) const
+{
+    return MakeBoolean(!Equal(other).AsBoolean());
+}
+
+Variant Variant::LessThan(const Variant& other) const
+{
+    return MakeBoolean(CompareValues(*this, other) == Ordering::Less);
+}
+
+Variant Variant::LessThanEqual(const Variant& other) const
+{
+    const Ordering ordering = CompareValues(*this, other);
+
+    return MakeBoolean(ordering == Ordering::Less || ordering == Ordering::Equal);
+}
+
+Variant Variant::GreaterThan(const Variant& other) const
+{
+    return MakeBoolean(CompareValues(*this, other) == Ordering::Greater);
+}
+
+Variant Variant::GreaterThanEqual(const Variant& other) const
+{
+    const Ordering ordering = CompareValues(*this, other);
+
+    return MakeBoolean(ordering == Ordering::Greater || ordering == Ordering::Equal);
 }
 
 // https://www.autoitscript.com/autoit3/docs/functions/Abs.htm
@@ -668,6 +1113,34 @@ PHI_ATTRIBUTE_CONST Variant Variant::MakeUndefined()
     return Variant{};
 }
 
+Variant Variant::MakeArray(array_t&& value)
+{
+    Variant variant;
+
+    variant.m_Type = Type::Array;
+    variant.array  = nullptr;
+
+    variant.AsArray() = phi::move(value);
+
+    return variant;
+}
+
+Variant Variant::MakeBinary(binary_t&& value)
+{
+    Variant variant;
+
+    variant.m_Type = Type::Binary;
+    variant.binary = nullptr;
+
+    // Empty binaries don't need a payload
+    if (!value.IsEmpty())
+    {
+        variant.AsBinary() = phi::move(value);
+    }
+
+    return variant;
+}
+
 PHI_ATTRIBUTE_CONST Variant Variant::MakeBoolean(phi::boolean value)
 {
     Variant variant;
@@ -714,6 +1187,16 @@ PHI_ATTRIBUTE_PURE Variant Variant::MakeKeyword(OpenAutoIt::TokenKind value)
 
 PHI_GCC_SUPPRESS_WARNING_POP()
 
+Variant Variant::MakeMap()
+{
+    Variant variant;
+
+    variant.m_Type = Type::Map;
+    variant.map    = nullptr;
+
+    return variant;
+}
+
 PHI_ATTRIBUTE_CONST Variant Variant::MakePointer(ptr_t value)
 {
     Variant variant;
@@ -728,8 +1211,7 @@ Variant Variant::MakeString(const char* value)
 {
     Variant variant;
 
-    variant.m_Type = Type::String;
-    variant.string = value;
+    variant.AsString() = value;
 
     return variant;
 }
@@ -738,11 +1220,7 @@ Variant Variant::MakeString(phi::string_view value)
 {
     Variant variant;
 
-    // Reserve enough space for the string plus the null terminator
-    variant.string.reserve(value.length().unsafe());
-
-    variant.m_Type = Type::String;
-    variant.string = string_t{value.data(), value.length().unsafe()};
+    variant.AsString().assign(value.data(), value.length().unsafe());
 
     return variant;
 }
@@ -751,8 +1229,7 @@ Variant Variant::MakeString(const string_t& value)
 {
     Variant variant;
 
-    variant.m_Type = Type::String;
-    variant.string = value;
+    variant.AsString() = value;
 
     return variant;
 }
@@ -761,8 +1238,7 @@ Variant Variant::MakeString(string_t&& value)
 {
     Variant variant;
 
-    variant.m_Type = Type::String;
-    variant.string = phi::move(value);
+    variant.AsString() = phi::move(value);
 
     return variant;
 }
@@ -774,11 +1250,11 @@ void Variant::copy_from(const Variant& other)
     switch (m_Type)
     {
         case Type::Array:
-            new (&array) array_t(other.array);
+            array = SharePayload(other.array);
             return;
 
         case Type::Binary:
-            new (&binary) binary_t(other.binary);
+            binary = SharePayload(other.binary);
             return;
 
         case Type::Boolean:
@@ -790,7 +1266,7 @@ void Variant::copy_from(const Variant& other)
             return;
 
         case Type::Function:
-            new (&string) string_t(other.string);
+            string = SharePayload(other.string);
             return;
 
         case Type::Int64:
@@ -801,12 +1277,16 @@ void Variant::copy_from(const Variant& other)
             keyword = other.keyword;
             return;
 
+        case Type::Map:
+            map = SharePayload(other.map);
+            return;
+
         case Type::Pointer:
             pointer = other.pointer;
             return;
 
         case Type::String:
-            new (&string) string_t(other.string);
+            string = SharePayload(other.string);
             return;
     }
 
@@ -820,43 +1300,50 @@ void Variant::move_from(Variant&& other)
     switch (m_Type)
     {
         case Type::Array:
-            new (&array) array_t(phi::move(other.array));
-            return;
+            array       = other.array;
+            other.array = nullptr;
+            break;
 
         case Type::Binary:
-            new (&binary) binary_t(phi::move(other.binary));
-            return;
+            binary       = other.binary;
+            other.binary = nullptr;
+            break;
 
         case Type::Boolean:
             boolean = other.boolean;
-            return;
+            break;
 
         case Type::Double:
             floating_point = other.floating_point;
-            return;
+            break;
 
         case Type::Function:
-            new (&string) string_t(phi::move(other.string));
-            return;
+        case Type::String:
+            string       = other.string;
+            other.string = nullptr;
+            break;
 
         case Type::Int64:
             int64 = other.int64;
-            return;
+            break;
 
         case Type::Keyword:
             keyword = other.keyword;
-            return;
+            break;
+
+        case Type::Map:
+            map       = other.map;
+            other.map = nullptr;
+            break;
 
         case Type::Pointer:
             pointer = other.pointer;
-            return;
-
-        case Type::String:
-            new (&string) string_t(phi::move(other.string));
-            return;
+            break;
     }
 
-    PHI_ASSERT_NOT_REACHED();
+    // The moved from Variant is left as an empty string
+    other.m_Type = Type::String;
+    other.string = nullptr;
 }
 
 // TODO: Documentation talks about "correcting" floating point errors when converting to int64
@@ -1,36 +1,56 @@
 #include "OpenAutoIt/VirtualMachine.hpp"
 
+#include "OpenAutoIt/Directory.hpp"
+#include "OpenAutoIt/File.hpp"
+#include "OpenAutoIt/OutputStream.hpp"
+#include "OpenAutoIt/Regex.hpp"
 #include "OpenAutoIt/Scope.hpp"
 #include "OpenAutoIt/StackTraceEntry.hpp"
+#include "OpenAutoIt/ThreadPool.hpp"
 #include "OpenAutoIt/VariableScope.hpp"
 #include "OpenAutoIt/Variant.hpp"
 #include <phi/compiler_support/extended_attributes.hpp>
 #include <phi/compiler_support/warning.hpp>
 #include <phi/core/assert.hpp>
 #include <phi/core/boolean.hpp>
+#include <phi/core/move.hpp>
 #include <phi/core/observer_ptr.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
 
 PHI_GCC_SUPPRESS_WARNING("-Wsuggest-attribute=pure")
 
 namespace OpenAutoIt
 {
-void VirtualMachine::PushFunctionScope(std::string_view function_name, Statements& statements)
+void VirtualMachine::PushFunctionScope(std::string_view  function_name,
+                                       const Statements& statements)
 {
     m_Scopes.emplace_front(ScopeKind::Function, function_name, statements);
+    ++m_VariableLayoutVersion;
 }
 
-void VirtualMachine::PushBlockScope(Statements& statements)
+void VirtualMachine::PushBlockScope(const Statements& statements)
 {
     m_Scopes.emplace_front(ScopeKind::Block, "<block_scope>", statements);
 }
 
-void VirtualMachine::PushGlobalScope(Statements& statements)
+void VirtualMachine::PushGlobalScope(const Statements& statements)
 {
     m_Scopes.emplace_back(ScopeKind::Function, "<global>", statements);
+    ++m_VariableLayoutVersion;
 }
 
 void VirtualMachine::PopScope()
 {
+    PHI_ASSERT(!m_Scopes.empty());
+
+    const Scope& scope = m_Scopes.front();
+    if (scope.kind == ScopeKind::Function || !scope.variables.empty())
+    {
+        ++m_VariableLayoutVersion;
+    }
+
     m_Scopes.pop_front();
 }
 
@@ -101,6 +121,7 @@ phi::boolean VirtualMachine::PushVariable(std::string_view name, Variant value)
     }
 
     current_scope.variables[name] = phi::move(value);
+    ++m_VariableLayoutVersion;
     return true;
 }
 
@@ -114,6 +135,7 @@ phi::boolean VirtualMachine::PushVariableGlobal(std::string_view name, Variant v
     }
 
     global_scope.variables[name] = phi::move(value);
+    ++m_VariableLayoutVersion;
     return true;
 }
 
@@ -142,6 +164,7 @@ void VirtualMachine::PushOrAssignVariable(std::string_view name, Variant value)
 
     Scope& current_scope          = GetCurrentScope();
     current_scope.variables[name] = phi::move(value);
+    ++m_VariableLayoutVersion;
 }
 
 phi::optional<Variant> VirtualMachine::LookupVariableByName(std::string_view variable_name) const
@@ -167,9 +190,10 @@ phi::optional<Variant&> VirtualMachine::LookupVariableRefByName(std::string_view
             {
                 // We hit the function boundary so only check the global scope and don't continue
                 Scope& global_scope = GetGlobalScope();
-                if (global_scope.variables.contains(variable_name))
+                const auto global_it = global_scope.variables.find(variable_name);
+                if (global_it != global_scope.variables.end())
                 {
-                    return global_scope.variables.at(variable_name);
+                    return global_it->second;
                 }
 
                 return {};
@@ -178,9 +202,10 @@ phi::optional<Variant&> VirtualMachine::LookupVariableRefByName(std::string_view
             found_function_boundary = true;
         }
 
-        if (scope.variables.contains(variable_name))
+        const auto it = scope.variables.find(variable_name);
+        if (it != scope.variables.end())
         {
-            return scope.variables.at(variable_name);
+            return it->second;
         }
     }
 
@@ -199,16 +224,29 @@ phi::optional<const Variant&> VirtualMachine::LookupVariableRefByName(
     return {};
 }
 
+PHI_ATTRIBUTE_PURE phi::uint64_t VirtualMachine::GetVariableLayoutVersion() const
+{
+    return m_VariableLayoutVersion;
+}
+
 PHI_ATTRIBUTE_PURE phi::boolean VirtualMachine::CanRun() const
 {
     return !m_Scopes.empty() && !m_Aborting;
 }
 
+PHI_ATTRIBUTE_PURE phi::boolean VirtualMachine::IsAborting() const
+{
+    return m_Aborting;
+}
+
 void VirtualMachine::Exit(phi::u32 exit_code)
 {
     m_Scopes.clear();
+    ++m_VariableLayoutVersion;
     m_ExitCode = exit_code;
 
+    FlushOutput();
+
     // TODO: Push scopes of registered on exit functions
 }
 
@@ -219,24 +257,137 @@ phi::u32 VirtualMachine::GetExitCode() const
 
 void VirtualMachine::SetupOutputHandler(OutputHandler standard, OutputHandler error)
 {
-    m_StandardOutputHandler = standard;
-    m_ErrorOutputHandler    = error;
+    m_StandardOutput.SetHandler(phi::move(standard));
+    m_ErrorOutput.SetHandler(phi::move(error));
+}
+
+void VirtualMachine::SetupOutputFileDescriptors(int standard, int error)
+{
+    m_StandardOutput.SetFileDescriptor(standard, FlushPolicy::ForFileDescriptor(standard));
+    m_ErrorOutput.SetFileDescriptor(error, FlushPolicy::Unbuffered());
 }
 
-void VirtualMachine::Print(const std::string& message) const
+void VirtualMachine::Print(std::string_view message)
 {
-    if (m_StandardOutputHandler != nullptr)
+    m_StandardOutput.Write(message);
+}
+
+void VirtualMachine::PrintError(std::string_view message)
+{
+    // Keep the order of both streams when they end up in the same place
+    m_StandardOutput.Flush();
+
+    m_ErrorOutput.Write(message);
+}
+
+void VirtualMachine::FlushOutput()
+{
+    m_StandardOutput.Flush();
+    m_ErrorOutput.Flush();
+}
+
+phi::int64_t VirtualMachine::AddFile(File file)
+{
+    const auto free = AcquireFileHandle();
+    free->file      = phi::move(file);
+
+    return static_cast<phi::int64_t>(free - m_FileHandles.begin()) + 1;
+}
+
+phi::int64_t VirtualMachine::AddFileSearch(FileSearch search)
+{
+    const auto free = AcquireFileHandle();
+    free->search    = phi::move(search);
+
+    return static_cast<phi::int64_t>(free - m_FileHandles.begin()) + 1;
+}
+
+phi::optional<File&> VirtualMachine::LookupFile(const phi::int64_t handle)
+{
+    const phi::observer_ptr<FileHandle> entry = GetFileHandle(handle);
+    if (!entry || !entry->file)
     {
-        m_StandardOutputHandler(message);
+        return {};
     }
+
+    return *entry->file;
 }
 
-void VirtualMachine::PrintError(const std::string& message) const
+phi::optional<FileSearch&> VirtualMachine::LookupFileSearch(const phi::int64_t handle)
 {
-    if (m_ErrorOutputHandler != nullptr)
+    const phi::observer_ptr<FileHandle> entry = GetFileHandle(handle);
+    if (!entry || !entry->search)
     {
-        m_ErrorOutputHandler(message);
+        return {};
     }
+
+    return *entry->search;
 }
 
+phi::boolean VirtualMachine::CloseFile(const phi::int64_t handle)
+{
+    const phi::observer_ptr<FileHandle> entry = GetFileHandle(handle);
+    if (!entry || (!entry->file && !entry->search))
+    {
+        return false;
+    }
+
+    entry->file.reset();
+    entry->search.reset();
+
+    return true;
+}
+
+void VirtualMachine::SetThreadPool(ThreadPool& pool)
+{
+    m_ThreadPool = &pool;
+}
+
+ThreadPool& VirtualMachine::GetThreadPool()
+{
+    if (!m_ThreadPool)
+    {
+        return ThreadPool::GetShared();
+    }
+
+    return *m_ThreadPool;
+}
+
+RegexCache& VirtualMachine::GetRegexCache()
+{
+    return m_RegexCache;
+}
+
+FormatStringCache& VirtualMachine::GetFormatStringCache()
+{
+    return m_FormatStringCache;
+}
+
+std::string& VirtualMachine::GetFormatBuffer()
+{
+    return m_FormatBuffer;
+}
+
+std::vector<VirtualMachine::FileHandle>::iterator VirtualMachine::AcquireFileHandle()
+{
+    auto free = std::find_if(m_FileHandles.begin(), m_FileHandles.end(),
+                             [](const FileHandle& entry) { return !entry.file && !entry.search; });
+    if (free == m_FileHandles.end())
+    {
+        free = m_FileHandles.emplace(m_FileHandles.end());
+    }
+
+    return free;
+}
+
+phi::observer_ptr<VirtualMachine::FileHandle> VirtualMachine::GetFileHandle(
+        const phi::int64_t handle)
+{
+    if (handle < 1 || static_cast<phi::size_t>(handle) > m_FileHandles.size())
+    {
+        return nullptr;
+    }
+
+    return &m_FileHandles[static_cast<phi::size_t>(handle - 1)];
+}
 } // namespace OpenAutoIt
@@ -0,0 +1,129 @@
+#include "OpenAutoIt/Wildcard.hpp"
+
+#include "OpenAutoIt/SIMD.hpp"
+#include "OpenAutoIt/Unicode.hpp"
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <string>
+#include <string_view>
+
+namespace OpenAutoIt
+{
+Wildcard::Wildcard(const std::string_view pattern)
+{
+    // Only stars and Windows' *.* accept every name
+    if (pattern == "*.*" || (!pattern.empty() && pattern.find_first_not_of('*') == pattern.npos))
+    {
+        m_MatchesAll = true;
+        return;
+    }
+
+    m_LeadingStar  = pattern.starts_with('*');
+    m_TrailingStar = pattern.ends_with('*');
+
+    std::string segment;
+    for (const char character : pattern)
+    {
+        if (character != '*')
+        {
+            segment += FoldASCII(character);
+            continue;
+        }
+
+        if (!segment.empty())
+        {
+            m_Segments.push_back(segment);
+            segment.clear();
+        }
+    }
+
+    if (!segment.empty() || m_Segments.empty())
+    {
+        m_Segments.push_back(segment);
+    }
+}
+
+phi::boolean Wildcard::Matches(const std::string_view name) const
+{
+    if (m_MatchesAll)
+    {
+        return true;
+    }
+
+    phi::size_t offset{0u};
+    for (phi::size_t index{0u}; index < m_Segments.size(); ++index)
+    {
+        const std::string_view segment = m_Segments[index];
+        const phi::boolean     first   = index == 0u && !m_LeadingStar;
+        const phi::boolean     last    = index + 1u == m_Segments.size() && !m_TrailingStar;
+
+        // The first segment has to match right at the start
+        if (first)
+        {
+            offset = MatchSegment(name, offset, segment);
+            if (offset == name.npos || (last && offset != name.size()))
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        // Every other segment is matched as early as possible which leaves the most room for the
+        // following ones. The last one has to end with the name.
+        phi::size_t end{name.npos};
+        for (phi::size_t start{offset}; start <= name.size(); ++start)
+        {
+            end = MatchSegment(name, start, segment);
+            if (end != name.npos && (!last || end == name.size()))
+            {
+                break;
+            }
+
+            end = name.npos;
+        }
+
+        if (end == name.npos)
+        {
+            return false;
+        }
+
+        offset = end;
+    }
+
+    return true;
+}
+
+phi::size_t Wildcard::MatchSegment(const std::string_view name, phi::size_t offset,
+                                   const std::string_view segment)
+{
+    for (const char character : segment)
+    {
+        if (offset >= name.size())
+        {
+            return name.npos;
+        }
+
+        if (character == '?')
+        {
+            // Skip a whole UTF-8 sequence
+            ++offset;
+            while (offset < name.size() && IsUTF8ContinuationByte(name[offset]))
+            {
+                ++offset;
+            }
+
+            continue;
+        }
+
+        if (FoldASCII(name[offset]) != character)
+        {
+            return name.npos;
+        }
+
+        ++offset;
+    }
+
+    return offset;
+}
+} // namespace OpenAutoIt
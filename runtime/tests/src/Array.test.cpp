@@ -0,0 +1,220 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Array.hpp>
+#include <OpenAutoIt/Variant.hpp>
+#include <phi/compiler_support/warning.hpp>
+#include <phi/core/move.hpp>
+#include <phi/core/optional.hpp>
+#include <initializer_list>
+#include <vector>
+
+PHI_CLANG_AND_GCC_SUPPRESS_WARNING("-Wfloat-equal")
+
+namespace
+{
+OpenAutoIt::ArraySubscripts MakeSubscripts(std::initializer_list<phi::size_t> values)
+{
+    OpenAutoIt::ArraySubscripts subscripts;
+    for (const phi::size_t value : values)
+    {
+        subscripts.values[subscripts.count++] = value;
+    }
+
+    return subscripts;
+}
+} // namespace
+
+TEST_CASE("Array - ReDim")
+{
+    OpenAutoIt::Array array;
+    CHECK(array.GetDimensionCount() == 0u);
+    CHECK(array.GetElementCount() == 0u);
+
+    CHECK(array.ReDim(MakeSubscripts({3u})));
+    CHECK(array.GetDimensionCount() == 1u);
+    CHECK(array.GetDimension(0u) == 3u);
+    CHECK(array.GetElementCount() == 3u);
+
+    CHECK(array.SetElement(MakeSubscripts({2u}), OpenAutoIt::Variant::MakeString("21")));
+
+    // Growing the first dimension keeps all elements
+    CHECK(array.ReDim(MakeSubscripts({10u})));
+    CHECK(array.GetElement(MakeSubscripts({2u}))->AsString() == "21");
+
+    // Shrinking drops elements out of range
+    CHECK(array.ReDim(MakeSubscripts({2u})));
+    CHECK(array.GetElementCount() == 2u);
+    CHECK_FALSE(array.GetElement(MakeSubscripts({2u})));
+
+    // Changing the number of dimensions clears the array
+    CHECK(array.ReDim(MakeSubscripts({2u, 2u})));
+    CHECK(array.GetDimensionCount() == 2u);
+    CHECK(array.GetElement(MakeSubscripts({1u, 1u}))->IsString());
+}
+
+TEST_CASE("Array - ReDim inner dimension")
+{
+    OpenAutoIt::Array array;
+    CHECK(array.ReDim(MakeSubscripts({2u, 2u})));
+
+    CHECK(array.SetElement(MakeSubscripts({0u, 1u}), OpenAutoIt::Variant::MakeInt(1)));
+    CHECK(array.SetElement(MakeSubscripts({1u, 0u}), OpenAutoIt::Variant::MakeInt(2)));
+    CHECK(array.SetElement(MakeSubscripts({1u, 1u}), OpenAutoIt::Variant::MakeInt(3)));
+
+    CHECK(array.ReDim(MakeSubscripts({3u, 3u})));
+    CHECK(array.GetElement(MakeSubscripts({0u, 1u}))->AsInt64() == 1);
+    CHECK(array.GetElement(MakeSubscripts({1u, 0u}))->AsInt64() == 2);
+    CHECK(array.GetElement(MakeSubscripts({1u, 1u}))->AsInt64() == 3);
+    CHECK(array.GetElement(MakeSubscripts({0u, 2u}))->IsString());
+
+    CHECK(array.ReDim(MakeSubscripts({2u, 1u})));
+    CHECK(array.GetElement(MakeSubscripts({1u, 0u}))->AsInt64() == 2);
+    CHECK_FALSE(array.GetElement(MakeSubscripts({0u, 1u})));
+}
+
+TEST_CASE("Array - Limits")
+{
+    OpenAutoIt::Array array;
+
+    CHECK_FALSE(array.ReDim(MakeSubscripts({OpenAutoIt::MaxArrayElements + 1u})));
+    CHECK_FALSE(array.ReDim(MakeSubscripts({65'536u, 65'536u})));
+    CHECK(array.GetDimensionCount() == 0u);
+
+    CHECK(array.ReDim(MakeSubscripts({0u})));
+    CHECK(array.GetDimension(0u) == 0u);
+    CHECK_FALSE(array.GetElement(MakeSubscripts({0u})));
+
+    // Wrong number of subscripts
+    CHECK(array.ReDim(MakeSubscripts({2u, 2u})));
+    CHECK_FALSE(array.GetElement(MakeSubscripts({1u})));
+    CHECK_FALSE(array.GetElement(MakeSubscripts({1u, 1u, 1u})));
+    CHECK_FALSE(array.SetElement(MakeSubscripts({2u, 0u}), OpenAutoIt::Variant::MakeInt(1)));
+}
+
+TEST_CASE("Array - Unboxed storage")
+{
+    OpenAutoIt::Array array;
+    CHECK(array.ReDim(MakeSubscripts({3u})));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Boxed);
+
+    // Once every element is an Int64 the array is unboxed
+    CHECK(array.SetElement(MakeSubscripts({0u}), OpenAutoIt::Variant::MakeInt(1)));
+    CHECK(array.SetElement(MakeSubscripts({1u}), OpenAutoIt::Variant::MakeInt(2)));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Boxed);
+    CHECK(array.SetElement(MakeSubscripts({2u}), OpenAutoIt::Variant::MakeInt(3)));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+
+    CHECK(array.SetElement(MakeSubscripts({1u}), OpenAutoIt::Variant::MakeInt(20)));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+    CHECK(array.GetElement(MakeSubscripts({1u}))->AsInt64() == 20);
+
+    // Copies keep the storage
+    const OpenAutoIt::Array copy = array;
+    CHECK(copy.GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+    CHECK(copy.GetElement(MakeSubscripts({2u}))->AsInt64() == 3);
+
+    // Shrinking stays unboxed
+    CHECK(array.ReDim(MakeSubscripts({2u})));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+
+    // Taking an element leaves its value in place for unboxed arrays
+    CHECK(array.TakeElement(MakeSubscripts({0u}))->AsInt64() == 1);
+    CHECK(array.GetElement(MakeSubscripts({0u}))->AsInt64() == 1);
+
+    // A different type falls back to Variants for good
+    CHECK(array.SetElement(MakeSubscripts({0u}), OpenAutoIt::Variant::MakeDouble(1.5)));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Boxed);
+    CHECK(array.GetElement(MakeSubscripts({0u}))->AsDouble().unsafe() == 1.5);
+    CHECK(array.GetElement(MakeSubscripts({1u}))->AsInt64() == 20);
+
+    CHECK(array.SetElement(MakeSubscripts({0u}), OpenAutoIt::Variant::MakeInt(1)));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Boxed);
+}
+
+TEST_CASE("Array - Unboxed double storage")
+{
+    OpenAutoIt::Array array;
+    CHECK(array.ReDim(MakeSubscripts({2u})));
+
+    CHECK(array.SetElement(MakeSubscripts({0u}), OpenAutoIt::Variant::MakeDouble(0.5)));
+    CHECK(array.SetElement(MakeSubscripts({1u}), OpenAutoIt::Variant::MakeDouble(1.5)));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Double);
+    CHECK(array.GetElement(MakeSubscripts({1u}))->AsDouble().unsafe() == 1.5);
+
+    // Growing adds empty strings so the array has to be boxed
+    CHECK(array.ReDim(MakeSubscripts({3u})));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Boxed);
+    CHECK(array.GetElement(MakeSubscripts({0u}))->AsDouble().unsafe() == 0.5);
+    CHECK(array.GetElement(MakeSubscripts({2u}))->IsString());
+
+    // Filling the new element unboxes the array again
+    CHECK(array.SetElement(MakeSubscripts({2u}), OpenAutoIt::Variant::MakeDouble(2.5)));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Double);
+    CHECK(array.GetElement(MakeSubscripts({2u}))->AsDouble().unsafe() == 2.5);
+}
+
+TEST_CASE("Array - Growing with ReDim unboxes again")
+{
+    OpenAutoIt::Array array;
+
+    // Mirrors 'ReDim $a[UBound($a) + 1]' followed by '$a[UBound($a) - 1] = $i' in a loop
+    for (phi::size_t size{1u}; size <= 10u; ++size)
+    {
+        CHECK(array.ReDim(MakeSubscripts({size})));
+        CHECK(array.SetElement(MakeSubscripts({size - 1u}),
+                               OpenAutoIt::Variant::MakeInt(static_cast<phi::int64_t>(size))));
+        CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+    }
+
+    CHECK(array.GetElement(MakeSubscripts({0u}))->AsInt64() == 1);
+    CHECK(array.GetElement(MakeSubscripts({9u}))->AsInt64() == 10);
+
+    // Growing across the inner dimension boxes the array as well but keeps it specializable
+    CHECK(array.ReDim(MakeSubscripts({2u, 2u})));
+    CHECK(array.ReDim(MakeSubscripts({3u, 2u})));
+    for (phi::size_t row{0u}; row < 3u; ++row)
+    {
+        for (phi::size_t column{0u}; column < 2u; ++column)
+        {
+            CHECK(array.SetElement(MakeSubscripts({row, column}),
+                                   OpenAutoIt::Variant::MakeInt(1)));
+        }
+    }
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+
+    CHECK(array.ReDim(MakeSubscripts({3u, 3u})));
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Boxed);
+    for (phi::size_t row{0u}; row < 3u; ++row)
+    {
+        CHECK(array.SetElement(MakeSubscripts({row, 2u}), OpenAutoIt::Variant::MakeInt(2)));
+    }
+    CHECK(array.GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+    CHECK(array.GetElement(MakeSubscripts({1u, 2u}))->AsInt64() == 2);
+}
+
+TEST_CASE("Array - FromElements")
+{
+    std::vector<OpenAutoIt::Variant> elements;
+    elements.emplace_back(OpenAutoIt::Variant::MakeString("a"));
+    elements.emplace_back(OpenAutoIt::Variant::MakeInt(2));
+
+    phi::optional<OpenAutoIt::Array> array = OpenAutoIt::Array::FromElements(phi::move(elements));
+    CHECK(array);
+    CHECK(array->GetDimensionCount() == 1u);
+    CHECK(array->GetDimension(0u) == 2u);
+    CHECK(array->GetElement(MakeSubscripts({0u}))->AsString() == "a");
+    CHECK(array->GetElement(MakeSubscripts({1u}))->AsInt64() == 2);
+
+    // Elements of a single numeric type are unboxed right away
+    std::vector<OpenAutoIt::Variant> numbers;
+    numbers.emplace_back(OpenAutoIt::Variant::MakeInt(1));
+    numbers.emplace_back(OpenAutoIt::Variant::MakeInt(2));
+
+    phi::optional<OpenAutoIt::Array> unboxed = OpenAutoIt::Array::FromElements(phi::move(numbers));
+    CHECK(unboxed);
+    CHECK(unboxed->GetStorage() == OpenAutoIt::ArrayStorage::Int64);
+
+    phi::optional<OpenAutoIt::Array> empty = OpenAutoIt::Array::FromElements({});
+    CHECK(empty);
+    CHECK(empty->GetDimension(0u) == 0u);
+}
@@ -0,0 +1,93 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Binary.hpp>
+#include <phi/core/optional.hpp>
+#include <string>
+#include <string_view>
+
+TEST_CASE("Binary - Construction")
+{
+    OpenAutoIt::Binary empty;
+    CHECK(empty.IsEmpty());
+    CHECK(empty.GetSize() == 0u);
+    CHECK(empty.GetBytes().empty());
+
+    OpenAutoIt::Binary binary{std::string_view{"Hello"}};
+    CHECK_FALSE(binary.IsEmpty());
+    CHECK(binary.GetSize() == 5u);
+    CHECK(binary.GetBytes() == "Hello");
+
+    // Copies share the bytes
+    OpenAutoIt::Binary copy{binary};
+    CHECK(copy.GetBytes().data() == binary.GetBytes().data());
+}
+
+TEST_CASE("Binary - FromHexString")
+{
+    phi::optional<OpenAutoIt::Binary> binary = OpenAutoIt::Binary::FromHexString("0x00fF7a");
+    CHECK(binary.has_value());
+    CHECK(binary->GetBytes() == std::string_view("\x00\xFF\x7A", 3u));
+
+    binary = OpenAutoIt::Binary::FromHexString("0X");
+    CHECK(binary.has_value());
+    CHECK(binary->IsEmpty());
+
+    CHECK_FALSE(OpenAutoIt::Binary::FromHexString("").has_value());
+    CHECK_FALSE(OpenAutoIt::Binary::FromHexString("0x1").has_value());
+    CHECK_FALSE(OpenAutoIt::Binary::FromHexString("0xZZ").has_value());
+    CHECK_FALSE(OpenAutoIt::Binary::FromHexString("1234").has_value());
+}
+
+TEST_CASE("Binary - Slice")
+{
+    const OpenAutoIt::Binary binary{std::string_view{"OpenAutoIt"}};
+
+    const OpenAutoIt::Binary slice = binary.Slice(4u, 4u);
+    CHECK(slice.GetBytes() == "Auto");
+
+    // The slice points into the original buffer
+    CHECK(slice.GetBytes().data() == binary.GetBytes().data() + 4u);
+
+    // Slices of slices
+    CHECK(slice.Slice(1u, 2u).GetBytes() == "ut");
+
+    // Out of range parts are clamped
+    CHECK(binary.Slice(8u, 100u).GetBytes() == "It");
+    CHECK(binary.Slice(100u, 1u).IsEmpty());
+}
+
+TEST_CASE("Binary - Append")
+{
+    const OpenAutoIt::Binary binary{std::string_view{"OpenAutoIt"}};
+
+    // Appending to a shared slice copies it and leaves the original untouched
+    OpenAutoIt::Binary slice = binary.Slice(0u, 4u);
+    slice.Append("Source");
+    CHECK(slice.GetBytes() == "OpenSource");
+    CHECK(binary.GetBytes() == "OpenAutoIt");
+
+    // Appending to a binary which isn't shared doesn't copy it
+    OpenAutoIt::Binary unique{std::string_view{"abc"}};
+    unique.Append("def");
+    CHECK(unique.GetBytes() == "abcdef");
+
+    // Appending to itself
+    unique.Append(unique.GetBytes());
+    CHECK(unique.GetBytes() == "abcdefabcdef");
+
+    OpenAutoIt::Binary empty;
+    empty.Append("x");
+    CHECK(empty.GetBytes() == "x");
+}
+
+TEST_CASE("Binary - AppendHexString")
+{
+    std::string string{"Data: "};
+    OpenAutoIt::Binary::FromHexString("0x00ABCDEF")->AppendHexString(string);
+    CHECK(string == "Data: 0x00ABCDEF");
+
+    // Empty binaries don't append anything
+    string.clear();
+    OpenAutoIt::Binary{}.AppendHexString(string);
+    CHECK(string.empty());
+}
@@ -0,0 +1,173 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Directory.hpp>
+#include <OpenAutoIt/ThreadPool.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Creates a directory tree in the temporary directory and removes it again
+    class TemporaryDirectory
+    {
+    public:
+        explicit TemporaryDirectory(const std::string& name)
+            : m_Path{(std::filesystem::temp_directory_path() / name).string()}
+        {
+            std::filesystem::remove_all(m_Path);
+            std::filesystem::create_directory(m_Path);
+        }
+
+        TemporaryDirectory(const TemporaryDirectory&) = delete;
+        TemporaryDirectory(TemporaryDirectory&&)      = delete;
+
+        ~TemporaryDirectory()
+        {
+            std::filesystem::remove_all(m_Path);
+        }
+
+        TemporaryDirectory& operator=(const TemporaryDirectory&) = delete;
+        TemporaryDirectory& operator=(TemporaryDirectory&&)      = delete;
+
+        void AddDirectory(const std::string& name) const
+        {
+            std::filesystem::create_directories(std::filesystem::path{m_Path} / name);
+        }
+
+        void AddFile(const std::string& name, const phi::size_t size) const
+        {
+            std::ofstream stream{std::filesystem::path{m_Path} / name, std::ios::binary};
+            stream << std::string(size, 'x');
+        }
+
+        [[nodiscard]] const std::string& GetPath() const
+        {
+            return m_Path;
+        }
+
+    private:
+        std::string m_Path;
+    };
+
+    [[nodiscard]] std::vector<std::string> FindAll(const std::string& pattern)
+    {
+        std::vector<std::string> names;
+
+        phi::optional<OpenAutoIt::FileSearch> search = OpenAutoIt::FileSearch::Open(pattern);
+        if (!search)
+        {
+            return names;
+        }
+
+        while (const phi::optional<OpenAutoIt::FileSearch::Result> result = search->Next())
+        {
+            names.emplace_back(result->name);
+        }
+        std::sort(names.begin(), names.end());
+
+        return names;
+    }
+} // namespace
+
+TEST_CASE("DirectoryReader - Entries")
+{
+    const TemporaryDirectory directory{"OpenAutoIt_DirectoryReader"};
+    directory.AddFile("file.txt", 5u);
+    directory.AddDirectory("sub");
+
+    phi::optional<OpenAutoIt::DirectoryReader> reader =
+            OpenAutoIt::DirectoryReader::Open(directory.GetPath());
+    CHECK(reader);
+
+    phi::size_t count{0u};
+    while (const phi::optional<OpenAutoIt::DirectoryEntry> entry = reader->Next())
+    {
+        const phi::optional<OpenAutoIt::EntryStatus> status = reader->GetStatus(*entry);
+        CHECK(status);
+
+        if (entry->name == "file.txt")
+        {
+            CHECK(status->type == OpenAutoIt::EntryType::File);
+            CHECK(status->size == 5u);
+        }
+        else
+        {
+            CHECK(entry->name == "sub");
+            CHECK(status->type == OpenAutoIt::EntryType::Directory);
+        }
+        ++count;
+    }
+    CHECK(count == 2u);
+
+    CHECK_FALSE(OpenAutoIt::DirectoryReader::Open(directory.GetPath() + "/missing"));
+}
+
+TEST_CASE("FileSearch - Pattern")
+{
+    const TemporaryDirectory directory{"OpenAutoIt_FileSearch"};
+    directory.AddFile("a.au3", 1u);
+    directory.AddFile("b.AU3", 1u);
+    directory.AddFile("c.txt", 1u);
+    directory.AddDirectory("dir.au3");
+
+    const std::string path = directory.GetPath();
+
+    CHECK(FindAll(path + "/*.au3") == std::vector<std::string>{"a.au3", "b.AU3", "dir.au3"});
+    CHECK(FindAll(path + "/c.txt") == std::vector<std::string>{"c.txt"});
+    CHECK(FindAll(path + "/*").size() == 4u);
+
+    CHECK_FALSE(OpenAutoIt::FileSearch::Open(path + "/*.exe"));
+    CHECK_FALSE(OpenAutoIt::FileSearch::Open(path + "/missing/*"));
+}
+
+TEST_CASE("GetDirectorySize")
+{
+    const TemporaryDirectory directory{"OpenAutoIt_GetDirectorySize"};
+    directory.AddFile("root.bin", 10u);
+    directory.AddDirectory("a/b/c");
+    directory.AddFile("a/one.bin", 100u);
+    directory.AddFile("a/b/two.bin", 1000u);
+    directory.AddFile("a/b/c/three.bin", 10000u);
+    directory.AddDirectory("empty");
+
+    OpenAutoIt::ThreadPool pool{4u};
+
+    const phi::optional<OpenAutoIt::DirectorySize> parallel =
+            OpenAutoIt::GetDirectorySize(directory.GetPath(), true, &pool);
+    CHECK(parallel);
+    CHECK(parallel->size == 11110u);
+    CHECK(parallel->files == 4u);
+    CHECK(parallel->directories == 4u);
+
+    const phi::optional<OpenAutoIt::DirectorySize> sequential =
+            OpenAutoIt::GetDirectorySize(directory.GetPath(), true, nullptr);
+    CHECK(sequential);
+    CHECK(sequential->size == 11110u);
+    CHECK(sequential->files == 4u);
+    CHECK(sequential->directories == 4u);
+
+    const phi::optional<OpenAutoIt::DirectorySize> flat =
+            OpenAutoIt::GetDirectorySize(directory.GetPath(), false, nullptr);
+    CHECK(flat);
+    CHECK(flat->size == 10u);
+    CHECK(flat->files == 1u);
+    CHECK(flat->directories == 2u);
+
+    CHECK_FALSE(OpenAutoIt::GetDirectorySize(directory.GetPath() + "/missing", true, &pool));
+
+    // Called from the only worker of a pool like an Engine instance would
+    OpenAutoIt::ThreadPool                   single_pool{1u};
+    phi::optional<OpenAutoIt::DirectorySize> nested;
+    single_pool.Submit([&]() {
+        nested = OpenAutoIt::GetDirectorySize(directory.GetPath(), true, &single_pool);
+    });
+    single_pool.Wait();
+    CHECK(nested);
+    CHECK(nested->files == 4u);
+    CHECK(nested->directories == 4u);
+}
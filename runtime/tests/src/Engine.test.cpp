@@ -0,0 +1,103 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/AST/ASTDocument.hpp>
+#include <OpenAutoIt/DiagnosticEngine.hpp>
+#include <OpenAutoIt/Engine.hpp>
+#include <OpenAutoIt/Interpreter.hpp>
+#include <OpenAutoIt/Lexer.hpp>
+#include <OpenAutoIt/Parser.hpp>
+#include <OpenAutoIt/SourceManager.hpp>
+#include <phi/core/scope_ptr.hpp>
+#include <phi/core/types.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+TEST_CASE("Engine - Shared document")
+{
+    OpenAutoIt::EmptySourceManager source_manager;
+    OpenAutoIt::DiagnosticEngine   diagnostic_engine;
+    OpenAutoIt::Lexer              lexer{&diagnostic_engine};
+    auto document = phi::make_not_null_scope<OpenAutoIt::ASTDocument>();
+
+    OpenAutoIt::Parser parser{&source_manager, &diagnostic_engine, &lexer};
+    parser.ParseString(document, "Engine.au3",
+                       "For $i = 1 To 10000\n"
+                       "Next\n"
+                       "ConsoleWrite($i)\n"
+                       "ConsoleWriteError(\"done\")\n");
+
+    static constexpr const phi::usize number_of_instances{32u};
+
+    std::vector<std::string> std_out(number_of_instances.unsafe());
+    std::vector<std::string> std_err(number_of_instances.unsafe());
+
+    OpenAutoIt::Engine engine{document.not_null_observer(), 4u};
+    for (phi::usize index{0u}; index < number_of_instances; ++index)
+    {
+        std::string& out = std_out[index.unsafe()];
+        std::string& err = std_err[index.unsafe()];
+
+        engine.Spawn([&out](std::string_view message) { out += message; },
+                     [&err](std::string_view message) { err += message; });
+    }
+
+    engine.Wait();
+
+    for (phi::usize index{0u}; index < number_of_instances; ++index)
+    {
+        CHECK(std_out[index.unsafe()] == "10001");
+        CHECK(std_err[index.unsafe()] == "done");
+    }
+}
+
+TEST_CASE("Engine - Parallel builtins share the pool")
+{
+    // Large enough for FileReadToArray to split the file on the thread pool
+    const std::string path =
+            (std::filesystem::temp_directory_path() / "OpenAutoIt_Engine_Lines.txt").string();
+    {
+        std::ofstream stream{path, std::ios::binary};
+        for (int line{0}; line < 200'000; ++line)
+        {
+            stream << "line " << line << "\r\n";
+        }
+    }
+
+    // NOTE: The tokens refer to the source so it has to outlive the document
+    const std::string source =
+            "Local $lines = FileReadToArray(\"" + path + "\")\nConsoleWrite(UBound($lines))\n";
+
+    OpenAutoIt::EmptySourceManager source_manager;
+    OpenAutoIt::DiagnosticEngine   diagnostic_engine;
+    OpenAutoIt::Lexer              lexer{&diagnostic_engine};
+    auto document = phi::make_not_null_scope<OpenAutoIt::ASTDocument>();
+
+    OpenAutoIt::Parser parser{&source_manager, &diagnostic_engine, &lexer};
+    parser.ParseString(document, "Engine.au3", source);
+
+    static constexpr const phi::usize number_of_instances{8u};
+
+    std::vector<std::string> std_out(number_of_instances.unsafe());
+
+    // The only worker runs the instances and has to help with the work they split up
+    OpenAutoIt::Engine engine{document.not_null_observer(), 1u};
+    for (phi::usize index{0u}; index < number_of_instances; ++index)
+    {
+        std::string& out = std_out[index.unsafe()];
+
+        engine.Spawn([&out](std::string_view message) { out += message; },
+                     [](std::string_view /*message*/) {});
+    }
+
+    engine.Wait();
+
+    for (phi::usize index{0u}; index < number_of_instances; ++index)
+    {
+        CHECK(std_out[index.unsafe()] == "200000");
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,209 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/File.hpp>
+#include <phi/compiler_support/platform.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if !PHI_PLATFORM_IS(WINDOWS)
+#    include <unistd.h>
+#endif
+
+namespace
+{
+    // Writes the content to a file in the temporary directory and removes it again
+    class TemporaryFile
+    {
+    public:
+        TemporaryFile(const std::string& name, const std::string_view content)
+            : m_Path{(std::filesystem::temp_directory_path() / name).string()}
+        {
+            std::ofstream stream{m_Path, std::ios::binary};
+            stream.write(content.data(), static_cast<std::streamsize>(content.size()));
+        }
+
+        TemporaryFile(const TemporaryFile&) = delete;
+        TemporaryFile(TemporaryFile&&)      = delete;
+
+        ~TemporaryFile()
+        {
+            std::filesystem::remove(m_Path);
+        }
+
+        TemporaryFile& operator=(const TemporaryFile&) = delete;
+        TemporaryFile& operator=(TemporaryFile&&)      = delete;
+
+        [[nodiscard]] const std::string& GetPath() const
+        {
+            return m_Path;
+        }
+
+    private:
+        std::string m_Path;
+    };
+
+    [[nodiscard]] std::string ToString(const phi::optional<std::string_view>& view)
+    {
+        return view ? std::string{*view} : std::string{"<none>"};
+    }
+} // namespace
+
+TEST_CASE("File - Open")
+{
+    CHECK_FALSE(OpenAutoIt::File::Open("this/file/does/not/exist.txt", false));
+    CHECK_FALSE(
+            OpenAutoIt::File::Open(std::filesystem::temp_directory_path().string(), false));
+
+    const TemporaryFile             empty{"OpenAutoIt_File_Open.txt", ""};
+    phi::optional<OpenAutoIt::File> file = OpenAutoIt::File::Open(empty.GetPath(), false);
+    CHECK(file);
+    CHECK_FALSE(file->Read({}));
+    CHECK_FALSE(file->ReadLine());
+    CHECK_FALSE(file->ReadLine(1u));
+    CHECK_FALSE(file->ReadLastLine());
+}
+
+TEST_CASE("File - ReadLine")
+{
+    const TemporaryFile temporary{"OpenAutoIt_File_ReadLine.txt",
+                                  "\xEF\xBB\xBF" "first\r\nsecond\nthird\r\rfifth"};
+
+    phi::optional<OpenAutoIt::File> file = OpenAutoIt::File::Open(temporary.GetPath(), false);
+    CHECK(file);
+
+    // CRLF, LF and CR all end lines and the byte order mark is skipped
+    CHECK(ToString(file->ReadLine()) == "first");
+    CHECK(ToString(file->ReadLine()) == "second");
+    CHECK(ToString(file->ReadLine()) == "third");
+    CHECK(ToString(file->ReadLine()).empty());
+    CHECK(ToString(file->ReadLine()) == "fifth");
+    CHECK_FALSE(file->ReadLine());
+
+    // Reading a line by number continues behind it
+    CHECK(ToString(file->ReadLine(2u)) == "second");
+    CHECK(ToString(file->ReadLine()) == "third");
+    CHECK(ToString(file->ReadLine(1u)) == "first");
+    CHECK(ToString(file->ReadLastLine()) == "fifth");
+    CHECK_FALSE(file->ReadLine(6u));
+    CHECK_FALSE(file->ReadLine(0u));
+}
+
+TEST_CASE("File - ReadLine index")
+{
+    // Enough lines for several checkpoints of the line index
+    std::string content;
+    for (phi::size_t line{1u}; line <= 1000u; ++line)
+    {
+        content += "Line " + std::to_string(line) + (line % 3u == 0u ? "\r\n" : "\n");
+    }
+
+    const TemporaryFile             temporary{"OpenAutoIt_File_ReadLineIndex.txt", content};
+    phi::optional<OpenAutoIt::File> file = OpenAutoIt::File::Open(temporary.GetPath(), false);
+    CHECK(file);
+
+    CHECK(ToString(file->ReadLine(500u)) == "Line 500");
+    CHECK(ToString(file->ReadLine(64u)) == "Line 64");
+    CHECK(ToString(file->ReadLine(65u)) == "Line 65");
+    CHECK(ToString(file->ReadLine()) == "Line 66");
+    CHECK(ToString(file->ReadLine(1000u)) == "Line 1000");
+    CHECK_FALSE(file->ReadLine());
+    CHECK_FALSE(file->ReadLine(1001u));
+    CHECK(ToString(file->ReadLastLine()) == "Line 1000");
+    CHECK(ToString(file->ReadLine(129u)) == "Line 129");
+}
+
+TEST_CASE("File - Read")
+{
+    const TemporaryFile temporary{"OpenAutoIt_File_Read.txt", "a\xC3\xA4\xE2\x82\xAC" "bc"};
+
+    phi::optional<OpenAutoIt::File> file = OpenAutoIt::File::Open(temporary.GetPath(), false);
+    CHECK(file);
+
+    // Text files count characters
+    CHECK(ToString(file->Read(2u)) == "a\xC3\xA4");
+    CHECK(file->GetPosition() == 3u);
+    CHECK(ToString(file->Read({})) == "\xE2\x82\xAC" "bc");
+    CHECK_FALSE(file->Read({}));
+
+    // Binary files count bytes
+    phi::optional<OpenAutoIt::File> binary = OpenAutoIt::File::Open(temporary.GetPath(), true);
+    CHECK(binary);
+    CHECK(binary->IsBinary());
+    CHECK(ToString(binary->Read(2u)) == "a\xC3");
+    CHECK(ToString(binary->Read(100u)) == "\xA4\xE2\x82\xAC" "bc");
+}
+
+TEST_CASE("File - SetPosition")
+{
+    const TemporaryFile temporary{"OpenAutoIt_File_SetPosition.txt", "0123456789"};
+
+    phi::optional<OpenAutoIt::File> file = OpenAutoIt::File::Open(temporary.GetPath(), false);
+    CHECK(file);
+
+    CHECK(file->SetPosition(4, OpenAutoIt::FileOrigin::Begin));
+    CHECK(ToString(file->Read(2u)) == "45");
+    CHECK(file->SetPosition(-1, OpenAutoIt::FileOrigin::Current));
+    CHECK(ToString(file->Read(1u)) == "5");
+    CHECK(file->SetPosition(-2, OpenAutoIt::FileOrigin::End));
+    CHECK(file->GetPosition() == 8u);
+    CHECK(ToString(file->ReadLine()) == "89");
+    CHECK_FALSE(file->SetPosition(-1, OpenAutoIt::FileOrigin::Begin));
+}
+
+#if !PHI_PLATFORM_IS(WINDOWS)
+TEST_CASE("File - Pipe")
+{
+    int pipe_ends[2];
+    CHECK(::pipe(pipe_ends) == 0);
+
+    // Lines ending with CR and CRLF cross the boundaries of the read buffer
+    std::string content;
+    for (phi::size_t line{1u}; line <= 50000u; ++line)
+    {
+        content += "Line " + std::to_string(line) + (line % 2u == 0u ? "\r\n" : "\r");
+    }
+
+    std::thread writer{[&content, &pipe_ends]() {
+        std::string_view rest = content;
+        while (!rest.empty())
+        {
+            const auto written = ::write(pipe_ends[1], rest.data(), rest.size());
+            if (written <= 0)
+            {
+                break;
+            }
+
+            rest.remove_prefix(static_cast<phi::size_t>(written));
+        }
+
+        ::close(pipe_ends[1]);
+    }};
+
+    phi::optional<OpenAutoIt::File> file =
+            OpenAutoIt::File::Open("/dev/fd/" + std::to_string(pipe_ends[0]), false);
+    CHECK(file);
+
+    phi::size_t  lines{0u};
+    phi::boolean matching{true};
+    while (const phi::optional<std::string_view> line = file->ReadLine())
+    {
+        ++lines;
+        matching = matching && *line == "Line " + std::to_string(lines);
+    }
+
+    writer.join();
+    ::close(pipe_ends[0]);
+
+    CHECK(lines == 50000u);
+    CHECK(matching);
+
+    // Pipes can't seek
+    CHECK_FALSE(file->SetPosition(0, OpenAutoIt::FileOrigin::Begin));
+    CHECK_FALSE(file->ReadLine(1u));
+}
+#endif
@@ -0,0 +1,233 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/AST/ASTDocument.hpp>
+#include <OpenAutoIt/AST/ASTExpression.hpp>
+#include <OpenAutoIt/AST/ASTForStatement.hpp>
+#include <OpenAutoIt/AST/ASTFunctionDefinition.hpp>
+#include <OpenAutoIt/AST/ASTIfStatement.hpp>
+#include <OpenAutoIt/AST/ASTVariableAssignment.hpp>
+#include <OpenAutoIt/DiagnosticEngine.hpp>
+#include <OpenAutoIt/Interpreter.hpp>
+#include <OpenAutoIt/Lexer.hpp>
+#include <OpenAutoIt/Parser.hpp>
+#include <OpenAutoIt/SourceManager.hpp>
+#include <OpenAutoIt/Variant.hpp>
+#include <phi/core/scope_ptr.hpp>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    using ExpressionTier = OpenAutoIt::Interpreter::ExpressionTier;
+
+    // The body of the For statement following the two declarations of the scripts below
+    [[nodiscard]] const OpenAutoIt::Statements& GetLoopBody(const OpenAutoIt::ASTDocument& document)
+    {
+        return document.m_Statements[2u]->as<OpenAutoIt::ASTForStatement>()->m_Statements;
+    }
+
+    [[nodiscard]] const OpenAutoIt::ASTExpression& GetAssignedExpression(
+            const OpenAutoIt::ASTStatement& statement)
+    {
+        return *statement.as<OpenAutoIt::ASTVariableAssignment>()->m_InitialValueExpression;
+    }
+} // namespace
+
+TEST_CASE("Interpreter - Tiered expression deoptimizes and tiers up again")
+{
+    // NOTE: The tokens refer to the source so it has to outlive the document
+    const std::string source = "Local $x = 0\n"
+                               "Local $y = 1\n"
+                               "For $i = 1 To 200\n"
+                               "    If $i = 100 Then\n"
+                               "        $y = \"1\"\n"
+                               "    EndIf\n"
+                               "    If $i = 105 Then\n"
+                               "        $y = 1\n"
+                               "    EndIf\n"
+                               "    $x = $x + $y\n"
+                               "Next\n"
+                               "ConsoleWrite($x)\n";
+
+    OpenAutoIt::EmptySourceManager source_manager;
+    OpenAutoIt::DiagnosticEngine   diagnostic_engine;
+    OpenAutoIt::Lexer              lexer{&diagnostic_engine};
+    auto document = phi::make_not_null_scope<OpenAutoIt::ASTDocument>();
+
+    OpenAutoIt::Parser parser{&source_manager, &diagnostic_engine, &lexer};
+    parser.ParseString(document, "Tiers.au3", source);
+
+    std::string             out;
+    OpenAutoIt::Interpreter interpreter;
+    interpreter.SetDocument(document.not_null_observer());
+    interpreter.vm().SetupOutputHandler([&out](std::string_view message) { out += message; },
+                                        [](std::string_view /*message*/) {});
+    interpreter.Run();
+
+    // The string in $y fails the type guard for a few iterations which are interpreted instead
+    CHECK(out == "200");
+
+    const OpenAutoIt::Statements& body = GetLoopBody(*document);
+    CHECK(interpreter.GetExpressionTier(GetAssignedExpression(*body[2u])) ==
+          ExpressionTier::Compiled);
+
+    // Comparisons are compiled as well
+    const auto& condition = *body[0u]->as<OpenAutoIt::ASTIfStatement>()->m_IfCase.condition;
+    CHECK(interpreter.GetExpressionTier(condition) == ExpressionTier::Compiled);
+}
+
+TEST_CASE("Interpreter - Tiered expression gives up on unstable types")
+{
+    const std::string source = "Local $x = 0\n"
+                               "Local $y = 1\n"
+                               "For $i = 1 To 200\n"
+                               "    $y = 1\n"
+                               "    If $i > 100 And $i <= 200 Then\n"
+                               "        $y = \"1\"\n"
+                               "    EndIf\n"
+                               "    $x = $x + $y\n"
+                               "Next\n"
+                               "ConsoleWrite($x)\n";
+
+    OpenAutoIt::EmptySourceManager source_manager;
+    OpenAutoIt::DiagnosticEngine   diagnostic_engine;
+    OpenAutoIt::Lexer              lexer{&diagnostic_engine};
+    auto document = phi::make_not_null_scope<OpenAutoIt::ASTDocument>();
+
+    OpenAutoIt::Parser parser{&source_manager, &diagnostic_engine, &lexer};
+    parser.ParseString(document, "Tiers.au3", source);
+
+    std::string             out;
+    OpenAutoIt::Interpreter interpreter;
+    interpreter.SetDocument(document.not_null_observer());
+    interpreter.vm().SetupOutputHandler([&out](std::string_view message) { out += message; },
+                                        [](std::string_view /*message*/) {});
+    interpreter.Run();
+
+    CHECK(out == "200");
+
+    const OpenAutoIt::Statements& body = GetLoopBody(*document);
+    CHECK(interpreter.GetExpressionTier(GetAssignedExpression(*body[2u])) ==
+          ExpressionTier::NotCompilable);
+
+    const auto& condition = *body[1u]->as<OpenAutoIt::ASTIfStatement>()->m_IfCase.condition;
+    CHECK(interpreter.GetExpressionTier(condition) == ExpressionTier::Compiled);
+}
+
+TEST_CASE("Interpreter - Compiled expressions look up variables of new scopes")
+{
+    const std::string source = "Func Sum($n)\n"
+                               "    Local $total = 0\n"
+                               "    For $i = 1 To $n\n"
+                               "        $total = $total + $i\n"
+                               "    Next\n"
+                               "    ConsoleWrite($total & \" \")\n"
+                               "EndFunc\n"
+                               "Sum(100)\n"
+                               "Sum(200)\n";
+
+    OpenAutoIt::EmptySourceManager source_manager;
+    OpenAutoIt::DiagnosticEngine   diagnostic_engine;
+    OpenAutoIt::Lexer              lexer{&diagnostic_engine};
+    auto document = phi::make_not_null_scope<OpenAutoIt::ASTDocument>();
+
+    OpenAutoIt::Parser parser{&source_manager, &diagnostic_engine, &lexer};
+    parser.ParseString(document, "Tiers.au3", source);
+
+    std::string             out;
+    OpenAutoIt::Interpreter interpreter;
+    interpreter.SetDocument(document.not_null_observer());
+    interpreter.vm().SetupOutputHandler([&out](std::string_view message) { out += message; },
+                                        [](std::string_view /*message*/) {});
+    interpreter.Run();
+
+    CHECK(out == "5050 20100 ");
+}
+
+TEST_CASE("Interpreter - Functions and loops tier up as a whole")
+{
+    const std::string source = "Func Hot($n)\n"
+                               "    Local $a = $n + 1\n"
+                               "EndFunc\n"
+                               "Func Cold($n)\n"
+                               "    Local $b = $n + 2\n"
+                               "EndFunc\n"
+                               "For $i = 1 To 20\n"
+                               "    Hot($i)\n"
+                               "    Local $c = $i * 2\n"
+                               "Next\n"
+                               "Cold(1)\n";
+
+    OpenAutoIt::EmptySourceManager source_manager;
+    OpenAutoIt::DiagnosticEngine   diagnostic_engine;
+    OpenAutoIt::Lexer              lexer{&diagnostic_engine};
+    auto document = phi::make_not_null_scope<OpenAutoIt::ASTDocument>();
+
+    OpenAutoIt::Parser parser{&source_manager, &diagnostic_engine, &lexer};
+    parser.ParseString(document, "Tiers.au3", source);
+
+    // The loop and both functions each form a region
+    CHECK(document->m_RegionParents.size() == 3u);
+
+    OpenAutoIt::Interpreter interpreter;
+    interpreter.SetDocument(document.not_null_observer());
+    interpreter.Run();
+
+    // Called often enough although every call evaluates the expression only once
+    const auto& hot_function = *document->m_Functions[0u];
+    CHECK(interpreter.GetExpressionTier(GetAssignedExpression(*hot_function.m_FunctionBody[0u])) ==
+          ExpressionTier::Compiled);
+
+    const auto& cold_function = *document->m_Functions[1u];
+    CHECK(interpreter.GetExpressionTier(GetAssignedExpression(*cold_function.m_FunctionBody[0u])) ==
+          ExpressionTier::Interpreted);
+
+    // The loop itself didn't iterate often enough
+    const OpenAutoIt::Statements& body =
+            document->m_Statements[0u]->as<OpenAutoIt::ASTForStatement>()->m_Statements;
+    CHECK(interpreter.GetExpressionTier(GetAssignedExpression(*body[1u])) ==
+          ExpressionTier::Interpreted);
+}
+
+TEST_CASE("Interpreter - For...In shares the payload of the collection")
+{
+    const std::string source = "Local $a = [1, 2, 3]\n"
+                               "Local $m[]\n"
+                               "$m[\"x\"] = 4\n"
+                               "Local $sum = 0\n"
+                               "For $v In $a\n"
+                               "    $sum += $v\n"
+                               "Next\n"
+                               "For $v In $m\n"
+                               "    $sum += $v\n"
+                               "Next\n"
+                               "ConsoleWrite($sum)\n";
+
+    OpenAutoIt::EmptySourceManager source_manager;
+    OpenAutoIt::DiagnosticEngine   diagnostic_engine;
+    OpenAutoIt::Lexer              lexer{&diagnostic_engine};
+    auto document = phi::make_not_null_scope<OpenAutoIt::ASTDocument>();
+
+    OpenAutoIt::Parser parser{&source_manager, &diagnostic_engine, &lexer};
+    parser.ParseString(document, "ForIn.au3", source);
+
+    std::string             out;
+    OpenAutoIt::Interpreter interpreter;
+    interpreter.SetDocument(document.not_null_observer());
+    interpreter.vm().SetupOutputHandler([&out](std::string_view message) { out += message; },
+                                        [](std::string_view /*message*/) {});
+
+    const OpenAutoIt::VirtualMachine& vm = interpreter.vm();
+
+    // Stop inside of the body of the first loop, then inside of the body of the second one
+    CHECK(interpreter.RunFor(5u) == OpenAutoIt::Interpreter::RunResult::Yielded);
+    const OpenAutoIt::Variant& array_collection = vm.GetGlobalScope().for_loop.collection;
+    CHECK(&array_collection.AsArray() == &vm.LookupVariableRefByName("a")->AsArray());
+
+    CHECK(interpreter.RunFor(10u) == OpenAutoIt::Interpreter::RunResult::Yielded);
+    const OpenAutoIt::Variant& map_collection = vm.GetGlobalScope().for_loop.collection;
+    CHECK(&map_collection.AsMap() == &vm.LookupVariableRefByName("m")->AsMap());
+
+    interpreter.Run();
+    CHECK(out == "10");
+}
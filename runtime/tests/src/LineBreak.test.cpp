@@ -0,0 +1,131 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/LineBreak.hpp>
+#include <OpenAutoIt/ThreadPool.hpp>
+#include <OpenAutoIt/Variant.hpp>
+#include <phi/core/sized_types.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    // Straight forward version of the line splitting AutoIt does
+    [[nodiscard]] std::vector<std::string> ReferenceSplitLines(const std::string_view string)
+    {
+        std::vector<std::string> lines;
+        std::string              line;
+        for (phi::size_t index{0u}; index < string.size(); ++index)
+        {
+            const char character = string[index];
+            if (character != '\r' && character != '\n')
+            {
+                line += character;
+                continue;
+            }
+
+            if (character == '\r' && index + 1u < string.size() && string[index + 1u] == '\n')
+            {
+                ++index;
+            }
+
+            lines.push_back(line);
+            line.clear();
+        }
+
+        if (!line.empty())
+        {
+            lines.push_back(line);
+        }
+
+        return lines;
+    }
+
+    [[nodiscard]] bool MatchesReference(const std::vector<OpenAutoIt::Variant>& lines,
+                                        const std::string_view                  string)
+    {
+        const std::vector<std::string> expected = ReferenceSplitLines(string);
+        if (lines.size() != expected.size())
+        {
+            return false;
+        }
+
+        for (phi::size_t index{0u}; index < lines.size(); ++index)
+        {
+            if (lines[index].AsString() != expected[index])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+} // namespace
+
+TEST_CASE("LineBreak - FindLineBreak")
+{
+    CHECK(OpenAutoIt::FindLineBreak("") == 0u);
+    CHECK(OpenAutoIt::FindLineBreak("abc") == 3u);
+    CHECK(OpenAutoIt::FindLineBreak("abc\ndef") == 3u);
+    CHECK(OpenAutoIt::FindLineBreak("0123456789abcdefghij\rklm") == 20u);
+
+    CHECK(OpenAutoIt::GetLineBreakSize("a\r\nb", 1u) == 2u);
+    CHECK(OpenAutoIt::GetLineBreakSize("a\rb", 1u) == 1u);
+    CHECK(OpenAutoIt::GetLineBreakSize("a\n\rb", 1u) == 1u);
+    CHECK(OpenAutoIt::GetLineBreakSize("a\r", 1u) == 1u);
+}
+
+TEST_CASE("LineBreak - CountLines")
+{
+    CHECK(OpenAutoIt::CountLines("") == 0u);
+    CHECK(OpenAutoIt::CountLines("a") == 1u);
+    CHECK(OpenAutoIt::CountLines("a\r\n") == 1u);
+    CHECK(OpenAutoIt::CountLines("a\r\nb") == 2u);
+    CHECK(OpenAutoIt::CountLines("a\n\rb") == 3u);
+    CHECK(OpenAutoIt::CountLines("\r\r\n\n") == 3u);
+}
+
+TEST_CASE("LineBreak - SplitLines")
+{
+    const std::vector<OpenAutoIt::Variant> lines = OpenAutoIt::SplitLines("a\r\nb\n\nc\rd", {});
+    CHECK(lines.size() == 5u);
+    CHECK(lines[0u].AsString() == "a");
+    CHECK(lines[1u].AsString() == "b");
+    CHECK(lines[2u].AsString().empty());
+    CHECK(lines[3u].AsString() == "c");
+    CHECK(lines[4u].AsString() == "d");
+
+    CHECK(OpenAutoIt::SplitLines("", {}).empty());
+}
+
+TEST_CASE("LineBreak - SplitLines parallel")
+{
+    OpenAutoIt::ThreadPool pool{4u};
+
+    // Line breaks are likely so CRLFs end up crossing chunk boundaries
+    std::mt19937                       generator{42u};
+    std::uniform_int_distribution<int> distribution{0, 5};
+    constexpr const char               characters[]{'a', 'b', ' ', '\r', '\n', '\n'};
+
+    for (phi::size_t size : {0u, 1u, 15u, 16u, 17u, 63u, 64u, 65u, 1000u, 100000u})
+    {
+        for (int iteration{0}; iteration < 10; ++iteration)
+        {
+            std::string string(size, '\0');
+            for (char& character : string)
+            {
+                character = characters[distribution(generator)];
+            }
+
+            CHECK(MatchesReference(OpenAutoIt::SplitLines(string, {}), string));
+            CHECK(MatchesReference(OpenAutoIt::SplitLines(string, &pool), string));
+            CHECK(OpenAutoIt::CountLines(string) == ReferenceSplitLines(string).size());
+        }
+    }
+
+    // A single line spanning every chunk
+    const std::string long_line(100000u, 'x');
+    CHECK(MatchesReference(OpenAutoIt::SplitLines(long_line, &pool), long_line));
+    CHECK(MatchesReference(OpenAutoIt::SplitLines(long_line + "\r\n", &pool), long_line));
+}
@@ -0,0 +1,104 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Map.hpp>
+#include <OpenAutoIt/Variant.hpp>
+#include <string>
+
+TEST_CASE("Map - Insert and find")
+{
+    OpenAutoIt::Map map;
+    CHECK(map.GetSize() == 0u);
+    CHECK_FALSE(map.Find(OpenAutoIt::Variant::MakeString("key")));
+
+    map.FindOrInsert(OpenAutoIt::Variant::MakeString("key")) = OpenAutoIt::Variant::MakeInt(1);
+    map.FindOrInsert(OpenAutoIt::Variant::MakeInt(1))        = OpenAutoIt::Variant::MakeInt(2);
+    CHECK(map.GetSize() == 2u);
+
+    CHECK(map.Find(OpenAutoIt::Variant::MakeString("key"))->AsInt64() == 1);
+    CHECK(map.Find(OpenAutoIt::Variant::MakeInt(1))->AsInt64() == 2);
+
+    // Strings and integers are different keys and strings are case sensitive
+    CHECK_FALSE(map.Contains(OpenAutoIt::Variant::MakeString("1")));
+    CHECK_FALSE(map.Contains(OpenAutoIt::Variant::MakeString("KEY")));
+
+    // Inserting an existing key returns the existing value
+    map.FindOrInsert(OpenAutoIt::Variant::MakeString("key")) = OpenAutoIt::Variant::MakeInt(3);
+    CHECK(map.GetSize() == 2u);
+    CHECK(map.Find(OpenAutoIt::Variant::MakeString("key"))->AsInt64() == 3);
+
+    // Only strings and integers can be keys
+    CHECK_FALSE(OpenAutoIt::Map::IsValidKey(OpenAutoIt::Variant::MakeDouble(1.0)));
+    CHECK_FALSE(OpenAutoIt::Map::IsValidKey(OpenAutoIt::Variant::MakeBoolean(true)));
+    CHECK_FALSE(map.Contains(OpenAutoIt::Variant::MakeDouble(1.0)));
+}
+
+TEST_CASE("Map - Growing")
+{
+    OpenAutoIt::Map map;
+    for (phi::int64_t index{0}; index < 10'000; ++index)
+    {
+        map.FindOrInsert(OpenAutoIt::Variant::MakeString(std::to_string(index))) =
+                OpenAutoIt::Variant::MakeInt(index);
+    }
+
+    CHECK(map.GetSize() == 10'000u);
+    for (phi::int64_t index{0}; index < 10'000; ++index)
+    {
+        const auto value = map.Find(OpenAutoIt::Variant::MakeString(std::to_string(index)));
+        CHECK(value);
+        CHECK(value->AsInt64() == index);
+    }
+
+    // Entries keep their insertion order
+    CHECK(map.GetEntries()[1234u].key.AsString() == "1234");
+}
+
+TEST_CASE("Map - Remove")
+{
+    OpenAutoIt::Map map;
+    for (phi::int64_t index{0}; index < 100; ++index)
+    {
+        map.FindOrInsert(OpenAutoIt::Variant::MakeInt(index)) = OpenAutoIt::Variant::MakeInt(index);
+    }
+
+    CHECK(map.Remove(OpenAutoIt::Variant::MakeInt(50)));
+    CHECK_FALSE(map.Remove(OpenAutoIt::Variant::MakeInt(50)));
+    CHECK_FALSE(map.Contains(OpenAutoIt::Variant::MakeInt(50)));
+    CHECK(map.GetSize() == 99u);
+
+    // Removing most entries compacts them while keeping the order
+    for (phi::int64_t index{0}; index < 90; ++index)
+    {
+        map.Remove(OpenAutoIt::Variant::MakeInt(index));
+    }
+
+    CHECK(map.GetSize() == 10u);
+    CHECK(map.GetEntries().size() < 100u);
+    CHECK(map.Find(OpenAutoIt::Variant::MakeInt(95))->AsInt64() == 95);
+
+    phi::int64_t expected{90};
+    for (const OpenAutoIt::Map::Entry& entry : map.GetEntries())
+    {
+        if (!entry.removed)
+        {
+            CHECK(entry.key.AsInt64() == expected);
+            ++expected;
+        }
+    }
+    CHECK(expected == 100);
+
+    // Removed keys can be inserted again
+    map.FindOrInsert(OpenAutoIt::Variant::MakeInt(0)) = OpenAutoIt::Variant::MakeInt(-1);
+    CHECK(map.Find(OpenAutoIt::Variant::MakeInt(0))->AsInt64() == -1);
+}
+
+TEST_CASE("Map - Append")
+{
+    OpenAutoIt::Map map;
+    CHECK(map.Append(OpenAutoIt::Variant::MakeString("a")) == 0);
+    CHECK(map.Append(OpenAutoIt::Variant::MakeString("b")) == 1);
+
+    map.FindOrInsert(OpenAutoIt::Variant::MakeInt(10)) = OpenAutoIt::Variant::MakeString("c");
+    CHECK(map.Append(OpenAutoIt::Variant::MakeString("d")) == 11);
+    CHECK(map.Find(OpenAutoIt::Variant::MakeInt(11))->AsString() == "d");
+}
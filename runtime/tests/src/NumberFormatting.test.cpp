@@ -0,0 +1,48 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/NumberFormatting.hpp>
+#include <limits>
+#include <string_view>
+
+TEST_CASE("NumberFormatting - FormatInt64")
+{
+    OpenAutoIt::NumberBuffer buffer;
+
+    CHECK(OpenAutoIt::FormatInt64(0, buffer) == std::string_view{"0"});
+    CHECK(OpenAutoIt::FormatInt64(-42, buffer) == std::string_view{"-42"});
+    CHECK(OpenAutoIt::FormatInt64(std::numeric_limits<phi::int64_t>::max(), buffer) ==
+          std::string_view{"9223372036854775807"});
+    CHECK(OpenAutoIt::FormatInt64(std::numeric_limits<phi::int64_t>::min(), buffer) ==
+          std::string_view{"-9223372036854775808"});
+}
+
+TEST_CASE("NumberFormatting - FormatDouble")
+{
+    OpenAutoIt::NumberBuffer buffer;
+
+    CHECK(OpenAutoIt::FormatDouble(0.0, buffer) == std::string_view{"0"});
+    CHECK(OpenAutoIt::FormatDouble(1.0, buffer) == std::string_view{"1"});
+    CHECK(OpenAutoIt::FormatDouble(-1.5, buffer) == std::string_view{"-1.5"});
+    CHECK(OpenAutoIt::FormatDouble(1500.0, buffer) == std::string_view{"1500"});
+    CHECK(OpenAutoIt::FormatDouble(0.1 + 0.2, buffer) == std::string_view{"0.3"});
+    CHECK(OpenAutoIt::FormatDouble(1.0 / 3.0, buffer) == std::string_view{"0.333333333333333"});
+    CHECK(OpenAutoIt::FormatDouble(0.0001, buffer) == std::string_view{"0.0001"});
+    CHECK(OpenAutoIt::FormatDouble(0.00015, buffer) == std::string_view{"0.00015"});
+    CHECK(OpenAutoIt::FormatDouble(0.00001, buffer) == std::string_view{"1e-005"});
+    CHECK(OpenAutoIt::FormatDouble(123456789012345.0, buffer) ==
+          std::string_view{"123456789012345"});
+    CHECK(OpenAutoIt::FormatDouble(1e15, buffer) == std::string_view{"1e+015"});
+    CHECK(OpenAutoIt::FormatDouble(999999999999999.9, buffer) == std::string_view{"1e+015"});
+    CHECK(OpenAutoIt::FormatDouble(18446744073709551616.0, buffer) ==
+          std::string_view{"1.84467440737096e+019"});
+    CHECK(OpenAutoIt::FormatDouble(-1.7976931348623157e308, buffer) ==
+          std::string_view{"-1.79769313486232e+308"});
+    CHECK(OpenAutoIt::FormatDouble(5e-324, buffer) == std::string_view{"4.94065645841247e-324"});
+
+    CHECK(OpenAutoIt::FormatDouble(std::numeric_limits<double>::infinity(), buffer) ==
+          std::string_view{"1.#INF"});
+    CHECK(OpenAutoIt::FormatDouble(-std::numeric_limits<double>::infinity(), buffer) ==
+          std::string_view{"-1.#INF"});
+    CHECK(OpenAutoIt::FormatDouble(std::numeric_limits<double>::quiet_NaN(), buffer) ==
+          std::string_view{"-1.#IND"});
+}
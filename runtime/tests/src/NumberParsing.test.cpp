@@ -0,0 +1,133 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Arithmetic.hpp>
+#include <OpenAutoIt/NumberParsing.hpp>
+#include <phi/compiler_support/warning.hpp>
+#include <cmath>
+#include <limits>
+
+PHI_CLANG_AND_GCC_SUPPRESS_WARNING("-Wfloat-equal")
+
+TEST_CASE("NumberParsing - Integers")
+{
+    OpenAutoIt::Number number = OpenAutoIt::ParseNumber("42");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == 42);
+
+    number = OpenAutoIt::ParseNumber(" \t\n-17");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == -17);
+
+    number = OpenAutoIt::ParseNumber("+007");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == 7);
+
+    number = OpenAutoIt::ParseNumber("9223372036854775807");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == std::numeric_limits<phi::int64_t>::max());
+
+    number = OpenAutoIt::ParseNumber("-9223372036854775808");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == std::numeric_limits<phi::int64_t>::min());
+
+    // Too large for an Int64
+    number = OpenAutoIt::ParseNumber("9223372036854775808");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 9223372036854775808.0);
+
+    number = OpenAutoIt::ParseNumber("123456789012345678901234567890");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 123456789012345678901234567890.0);
+}
+
+TEST_CASE("NumberParsing - Hexadecimal")
+{
+    OpenAutoIt::Number number = OpenAutoIt::ParseNumber("0x10");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == 16);
+
+    number = OpenAutoIt::ParseNumber("-0XfF");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == -255);
+
+    number = OpenAutoIt::ParseNumber("0xFFFFFFFFFFFFFFFF");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == -1);
+
+    // Not a hexadecimal number so only the 0 is used
+    number = OpenAutoIt::ParseNumber("0xZ");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == 0);
+}
+
+TEST_CASE("NumberParsing - Doubles")
+{
+    OpenAutoIt::Number number = OpenAutoIt::ParseNumber("3.14");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 3.14);
+
+    number = OpenAutoIt::ParseNumber("-.5");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == -0.5);
+
+    number = OpenAutoIt::ParseNumber("1.");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 1.0);
+
+    number = OpenAutoIt::ParseNumber("1.5e3");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 1500.0);
+
+    number = OpenAutoIt::ParseNumber("2E-2");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 0.02);
+
+    number = OpenAutoIt::ParseNumber("0.1");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 0.1);
+
+    // Needs the slow path
+    number = OpenAutoIt::ParseNumber("2.2250738585072014e-308");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 2.2250738585072014e-308);
+
+    number = OpenAutoIt::ParseNumber("0.30000000000000000000001");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 0.3);
+
+    number = OpenAutoIt::ParseNumber("1e400");
+    CHECK(number.is_double);
+    CHECK(std::isinf(number.floating_point));
+
+    number = OpenAutoIt::ParseNumber("-1e-400");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 0.0);
+}
+
+TEST_CASE("NumberParsing - Partial")
+{
+    OpenAutoIt::Number number = OpenAutoIt::ParseNumber("1Love");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == 1);
+
+    number = OpenAutoIt::ParseNumber("3.14Hey");
+    CHECK(number.is_double);
+    CHECK(number.floating_point == 3.14);
+
+    // An exponent without digits is ignored
+    number = OpenAutoIt::ParseNumber("5e");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == 5);
+
+    number = OpenAutoIt::ParseNumber("5e+x");
+    CHECK_FALSE(number.is_double);
+    CHECK(number.int64 == 5);
+
+    // Nothing to parse
+    for (const char* string : {"", "String", "-", ".", "+.e5", "  "})
+    {
+        number = OpenAutoIt::ParseNumber(string);
+        CHECK_FALSE(number.is_double);
+        CHECK(number.int64 == 0);
+    }
+}
@@ -0,0 +1,115 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/OutputStream.hpp>
+#include <phi/compiler_support/platform.hpp>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if !PHI_PLATFORM_IS(WINDOWS)
+#    include <unistd.h>
+
+namespace
+{
+    // Reads everything written to the file so far
+    [[nodiscard]] std::string ReadFile(std::FILE* file)
+    {
+        std::string content(1024u * 1024u, '\0');
+        const auto  size = ::pread(fileno(file), content.data(), content.size(), 0);
+        content.resize(size < 0 ? 0u : static_cast<std::size_t>(size));
+
+        return content;
+    }
+} // namespace
+#endif
+
+TEST_CASE("OutputStream - Handler")
+{
+    std::vector<std::string> messages;
+
+    OpenAutoIt::OutputStream stream;
+    stream.SetHandler([&messages](std::string_view message) { messages.emplace_back(message); });
+
+    stream.Write("Hello");
+    stream.Write("");
+    stream.Write("World\n");
+
+    // Handlers see every message separately and unbuffered
+    CHECK(messages.size() == 3u);
+    CHECK(messages[0u] == "Hello");
+    CHECK(messages[1u].empty());
+    CHECK(messages[2u] == "World\n");
+}
+
+TEST_CASE("OutputStream - Discarded")
+{
+    OpenAutoIt::OutputStream stream;
+    stream.Write("Nowhere");
+    stream.Flush();
+}
+
+#if !PHI_PLATFORM_IS(WINDOWS)
+TEST_CASE("OutputStream - File descriptor")
+{
+    std::FILE* file = std::tmpfile();
+    CHECK(file != nullptr);
+
+    {
+        OpenAutoIt::FlushPolicy policy;
+        policy.threshold = 8u;
+
+        OpenAutoIt::OutputStream stream;
+        stream.SetFileDescriptor(fileno(file), policy);
+
+        // Buffered until the threshold would be exceeded
+        stream.Write("abc");
+        stream.Write("def");
+        CHECK(ReadFile(file).empty());
+
+        // The buffer and the message are written together
+        stream.Write("ghi");
+        CHECK(ReadFile(file) == "abcdefghi");
+
+        // Messages larger than the threshold are written directly
+        stream.Write("j");
+        stream.Write("0123456789");
+        CHECK(ReadFile(file) == "abcdefghij0123456789");
+
+        stream.Write("k");
+        stream.Flush();
+        CHECK(ReadFile(file) == "abcdefghij0123456789k");
+
+        // Destroying the stream writes the rest
+        stream.Write("l");
+    }
+    CHECK(ReadFile(file) == "abcdefghij0123456789kl");
+
+    std::fclose(file);
+}
+
+TEST_CASE("OutputStream - Line buffered")
+{
+    std::FILE* file = std::tmpfile();
+    CHECK(file != nullptr);
+
+    OpenAutoIt::FlushPolicy policy;
+    policy.line_buffered = true;
+
+    OpenAutoIt::OutputStream stream;
+    stream.SetFileDescriptor(fileno(file), policy);
+
+    stream.Write("Hello ");
+    CHECK(ReadFile(file).empty());
+
+    stream.Write("World\n");
+    CHECK(ReadFile(file) == "Hello World\n");
+
+    // Switching to a handler writes the buffered output first
+    stream.Write("rest");
+    stream.SetHandler([](std::string_view /*message*/) {});
+    CHECK(ReadFile(file) == "Hello World\nrest");
+
+    std::fclose(file);
+}
+#endif
@@ -0,0 +1,268 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Regex.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    // Returns the whole match followed by the groups or "<no match>"
+    [[nodiscard]] std::string Search(const std::string_view pattern,
+                                     const std::string_view subject, const phi::size_t offset = 0u)
+    {
+        const phi::optional<OpenAutoIt::Regex> regex = OpenAutoIt::Regex::Compile(pattern);
+        if (!regex)
+        {
+            return "<invalid>";
+        }
+
+        OpenAutoIt::Regex::Captures captures;
+        if (!regex->Search(subject, offset, captures))
+        {
+            return "<no match>";
+        }
+
+        std::string result;
+        for (phi::size_t index{0u}; index < captures.size(); index += 2u)
+        {
+            if (index > 0u)
+            {
+                result += '|';
+            }
+
+            result += captures[index] == OpenAutoIt::Regex::NoMatch ?
+                              std::string{"<unset>"} :
+                              std::string{subject.substr(captures[index],
+                                                         captures[index + 1u] - captures[index])};
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] bool IsMatch(const std::string_view pattern, const std::string_view subject)
+    {
+        const phi::optional<OpenAutoIt::Regex> regex = OpenAutoIt::Regex::Compile(pattern);
+        return regex && regex->IsMatch(subject);
+    }
+
+    [[nodiscard]] bool IsValid(const std::string_view pattern)
+    {
+        return OpenAutoIt::Regex::Compile(pattern).has_value();
+    }
+} // namespace
+
+TEST_CASE("Regex - Literals and classes")
+{
+    CHECK(Search("World", "Hello World") == "World");
+    CHECK(Search("world", "Hello World") == "<no match>");
+    CHECK(Search("(?i)world", "Hello World") == "World");
+    CHECK(Search("\\d+", "abc 123 def") == "123");
+    CHECK(Search("\\w+", "  foo_bar1 ") == "foo_bar1");
+    CHECK(Search("\\s\\S", "a b") == " b");
+    CHECK(Search("[a-c]+", "xxbcaxx") == "bca");
+    CHECK(Search("[^a-c]+", "abxyc") == "xy");
+    CHECK(Search("[[:digit:]x]+", "ab1x2c") == "1x2");
+    CHECK(Search("[\\d-]+", "tel 12-34") == "12-34");
+    CHECK(Search("[]a]+", "x]a]") == "]a]");
+    CHECK(Search("a.c", "a\nc abc") == "abc");
+    CHECK(Search("(?s)a.c", "a\nc abc") == "a\nc");
+    CHECK(Search("\\x41\\x{42}", "xABx") == "AB");
+    CHECK(Search("\\Q.*\\E", "a.*b") == ".*");
+    CHECK(Search("(?x) a b  # comment", "ab") == "ab");
+}
+
+TEST_CASE("Regex - Quantifiers")
+{
+    CHECK(Search("a*", "aaa") == "aaa");
+    CHECK(Search("a*?", "aaa").empty());
+    CHECK(Search("a+?", "aaa") == "a");
+    CHECK(Search("a{2}", "aaa") == "aa");
+    CHECK(Search("a{2,}", "aaaa") == "aaaa");
+    CHECK(Search("a{1,3}", "aaaa") == "aaa");
+    CHECK(Search("a{1,3}?", "aaaa") == "a");
+    CHECK(Search("a{,2}", "a{,2}") == "a{,2}");
+    CHECK(Search("<.+>", "<a><b>") == "<a><b>");
+    CHECK(Search("<.+?>", "<a><b>") == "<a>");
+
+    // Possessive quantifiers and atomic groups never give anything back
+    CHECK(Search("a*+a", "aaa") == "<no match>");
+    CHECK(Search("(?>a*)a", "aaa") == "<no match>");
+    CHECK(Search("(?>a|ab)c", "abc") == "<no match>");
+
+    // Loops whose body can match nothing still terminate. Unlike PCRE the group keeps the last
+    // iteration which matched something.
+    CHECK(Search("(a*)*b", "aab") == "aab|aa");
+    CHECK(Search("(a|)*c", "aac") == "aac|a");
+    CHECK(Search("(?:)*x", "x") == "x");
+}
+
+TEST_CASE("Regex - Groups")
+{
+    CHECK(Search("(\\d+)-(\\d+)", "10-20") == "10-20|10|20");
+    CHECK(Search("(?:a|b)+(c)", "abac") == "abac|c");
+    CHECK(Search("(a)|(b)", "b") == "b|<unset>|b");
+    CHECK(Search("(?<year>\\d{4})-(?P<month>\\d\\d)", "2024-05") == "2024-05|2024|05");
+    CHECK(Search("(a)(?:x(b))?", "a") == "a|a|<unset>");
+
+    // The last iteration of a group is captured
+    CHECK(Search("(\\w)+", "abc") == "abc|c");
+}
+
+TEST_CASE("Regex - Backreferences")
+{
+    CHECK(Search("(\\w)\\1", "abccd") == "cc|c");
+    CHECK(Search("<(\\w+)>.*?</\\1>", "<b>x</i><b>y</b>") == "<b>x</i><b>y</b>|b");
+    CHECK(Search("(?i)(a)\\1", "aA") == "aA|a");
+    CHECK(Search("(a)\\1", "aA") == "<no match>");
+    CHECK(Search("(?<c>x)\\k<c>", "axxb") == "xx|x");
+    CHECK_FALSE(IsValid("(a)\\2"));
+}
+
+TEST_CASE("Regex - Anchors and assertions")
+{
+    CHECK(Search("^b", "ab") == "<no match>");
+    CHECK(Search("(?m)^b", "a\nb") == "b");
+    CHECK(Search("a$", "a\n") == "a");
+    CHECK(Search("a\\z", "a\n") == "<no match>");
+    CHECK(Search("(?m)a$", "a\nb") == "a");
+    CHECK(Search("a$", "a\nb") == "<no match>");
+    CHECK(Search("\\bis\\b", "this is") == "is");
+    CHECK(Search("\\Bis", "this is") == "is");
+    CHECK(Search("foo(?=bar)", "foobaz foobar") == "foo");
+    CHECK(Search("foo(?!bar)\\w", "foobar foobaz") == "foob");
+    CHECK(Search("(?<=\\$)\\d+", "EUR 10 $20") == "20");
+    CHECK(Search("(?<!\\$)\\b\\d+", "$10 20") == "20");
+    CHECK(Search("(?=(\\w+))a", "ab") == "a|ab");
+    CHECK_FALSE(IsValid("(?<=a+)b"));
+
+    // Offsets don't move the beginning of the subject
+    CHECK(Search("^a", "aa", 1u) == "<no match>");
+    CHECK(Search("\\ba", "aa a", 1u) == "a");
+}
+
+TEST_CASE("Regex - Unicode")
+{
+    CHECK(Search("K.ln", "Köln") == "Köln");
+    CHECK(Search("(?i)ÄÖ", "xäöx") == "äö");
+    CHECK(Search("[ä-ü]+", "aöüb") == "öü");
+    CHECK(Search("(?i)k", "\xE2\x84\xAA") == "\xE2\x84\xAA");
+    CHECK(Search("^.$", "€") == "€");
+    CHECK(Search("(?<=ö)x", "öx") == "x");
+}
+
+TEST_CASE("Regex - Invalid patterns")
+{
+    CHECK_FALSE(IsValid("("));
+    CHECK_FALSE(IsValid(")"));
+    CHECK_FALSE(IsValid("[a"));
+    CHECK_FALSE(IsValid("*a"));
+    CHECK_FALSE(IsValid("a{3,2}"));
+    CHECK_FALSE(IsValid("[z-a]"));
+    CHECK_FALSE(IsValid("\\"));
+    CHECK_FALSE(IsValid("(?y)"));
+    CHECK_FALSE(IsValid("(a{1000}){1000}"));
+    CHECK(IsValid(""));
+    CHECK(IsValid("a{"));
+}
+
+TEST_CASE("Regex - IsMatch")
+{
+    CHECK(IsMatch("b+", "aaabbb"));
+    CHECK_FALSE(IsMatch("c", "aaabbb"));
+    CHECK(IsMatch("", ""));
+    CHECK(IsMatch("^$", ""));
+    CHECK_FALSE(IsMatch("^a", "ba"));
+    CHECK(IsMatch("(a|b)*abb", "babaabb"));
+
+    // Catastrophic backtracking patterns stay fast
+    const std::string subject(5000u, 'a');
+    CHECK_FALSE(IsMatch("(a*)*b", subject));
+    CHECK_FALSE(IsMatch("(a|aa)+$x", subject));
+    CHECK(Search("(a|aa)+c", subject + "c").size() == subject.size() + 3u);
+}
+
+TEST_CASE("Regex - Matches std::regex")
+{
+    // Random patterns without empty loops, which both engines handle the same way
+    std::mt19937 generator{42u};
+
+    const auto random = [&](const int count) {
+        return std::uniform_int_distribution<int>{0, count - 1}(generator);
+    };
+
+    const auto random_pattern = [&](const auto& self, const int depth) -> std::string {
+        std::string pattern;
+        const int   items = 1 + random(3);
+        for (int item{0}; item < items; ++item)
+        {
+            switch (depth > 0 ? random(7) : random(4))
+            {
+                case 0:
+                    pattern += static_cast<char>('a' + random(3));
+                    break;
+                case 1:
+                    pattern += '.';
+                    break;
+                case 2:
+                    pattern += "[ab]";
+                    break;
+                case 3:
+                    pattern += "[^b]";
+                    break;
+                case 4:
+                    pattern += "(" + self(self, depth - 1) + "|" + self(self, depth - 1) + ")";
+                    break;
+                case 5:
+                    pattern += "(?:" + self(self, depth - 1) + ")";
+                    break;
+                default:
+                    pattern += "(" + self(self, depth - 1) + ")";
+                    break;
+            }
+
+            // Only quantify single characters so no loop body can be empty
+            if (pattern.back() != ')')
+            {
+                constexpr const char* quantifiers[] = {"", "", "*", "+", "?", "*?", "{1,2}"};
+                pattern += quantifiers[random(7)];
+            }
+        }
+
+        return pattern;
+    };
+
+    for (int iteration{0}; iteration < 2000; ++iteration)
+    {
+        const std::string pattern = random_pattern(random_pattern, 2);
+
+        std::string subject;
+        const int   length = random(12);
+        for (int index{0}; index < length; ++index)
+        {
+            subject += static_cast<char>('a' + random(3));
+        }
+
+        const std::regex expected_regex{pattern};
+        std::smatch      expected_match;
+        const bool       expected = std::regex_search(subject, expected_match, expected_regex);
+
+        const phi::optional<OpenAutoIt::Regex> regex = OpenAutoIt::Regex::Compile(pattern);
+        CHECK(regex.has_value());
+
+        OpenAutoIt::Regex::Captures captures;
+        CHECK(regex->Search(subject, 0u, captures) == expected);
+        CHECK(regex->IsMatch(subject) == expected);
+        if (expected)
+        {
+            CHECK(captures[0] == static_cast<phi::size_t>(expected_match.position(0)));
+            CHECK(captures[1] - captures[0] == static_cast<phi::size_t>(expected_match.length(0)));
+        }
+
+        // A lookahead which always succeeds forces the plain backtracker without the DFA
+        CHECK(Search("(?=)" + pattern, subject) == Search(pattern, subject));
+    }
+}
@@ -0,0 +1,39 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/StringComparison.hpp>
+
+TEST_CASE("StringComparison - StringEqualsIgnoreCase")
+{
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("", ""));
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("AutoIt", "aUTOiT"));
+    CHECK_FALSE(OpenAutoIt::StringEqualsIgnoreCase("AutoIt", "AutoIt3"));
+
+    // Only letters differ by case
+    CHECK_FALSE(OpenAutoIt::StringEqualsIgnoreCase("@[\\]^", "`{|}~"));
+
+    // Long enough for the vectorized path with a difference in the scalar tail
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("The quick brown fox jumps over the lazy dog",
+                                             "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOG"));
+    CHECK_FALSE(OpenAutoIt::StringEqualsIgnoreCase("The quick brown fox jumps over the lazy dog",
+                                                   "THE QUICK BROWN FOX JUMPS OVER THE LAZY DOC"));
+
+    // Non ASCII code points
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("Straße ÄÖÜ", "STRAẞE äöü"));
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("Привет", "пРИВЕТ"));
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("\xE2\x84\xAA", "k")); // Kelvin sign
+    CHECK_FALSE(OpenAutoIt::StringEqualsIgnoreCase("Ä", "Ö"));
+
+    // Latin Extended-B
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("Ș", "ș"));
+    CHECK(OpenAutoIt::StringEqualsIgnoreCase("Ơ Ư", "ơ ư"));
+}
+
+TEST_CASE("StringComparison - StringCompareIgnoreCase")
+{
+    CHECK(OpenAutoIt::StringCompareIgnoreCase("abc", "ABC") == 0);
+    CHECK(OpenAutoIt::StringCompareIgnoreCase("abc", "ABD") < 0);
+    CHECK(OpenAutoIt::StringCompareIgnoreCase("b", "A") > 0);
+    CHECK(OpenAutoIt::StringCompareIgnoreCase("abc", "ab") > 0);
+    CHECK(OpenAutoIt::StringCompareIgnoreCase("", "a") < 0);
+    CHECK(OpenAutoIt::StringCompareIgnoreCase("ä", "Ö") < 0);
+}
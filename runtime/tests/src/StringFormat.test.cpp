@@ -0,0 +1,97 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/StringFormat.hpp>
+#include <OpenAutoIt/Variant.hpp>
+#include <phi/core/optional.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    [[nodiscard]] std::string Format(const std::string_view                format,
+                                     const std::vector<OpenAutoIt::Variant>& arguments = {})
+    {
+        const phi::optional<OpenAutoIt::FormatString> compiled =
+                OpenAutoIt::FormatString::Compile(format);
+
+        std::string buffer{"previous contents"};
+        compiled->Format(arguments.data(), arguments.size(), buffer);
+        return buffer;
+    }
+
+    [[nodiscard]] OpenAutoIt::Variant Int(const phi::int64_t value)
+    {
+        return OpenAutoIt::Variant::MakeInt(value);
+    }
+
+    [[nodiscard]] OpenAutoIt::Variant Double(const double value)
+    {
+        return OpenAutoIt::Variant::MakeDouble(value);
+    }
+
+    [[nodiscard]] OpenAutoIt::Variant String(const char* value)
+    {
+        return OpenAutoIt::Variant::MakeString(value);
+    }
+} // namespace
+
+TEST_CASE("FormatString - Literals")
+{
+    CHECK(Format("").empty());
+    CHECK(Format("plain text") == "plain text");
+    CHECK(Format("100%%") == "100%");
+    CHECK(Format("%y and %") == "%y and %");
+    CHECK(Format("a%sb%sc", {String("1"), String("2")}) == "a1b2c");
+    CHECK(OpenAutoIt::FormatString::Compile("%d %% %s %q")->GetArgumentCount() == 2u);
+}
+
+TEST_CASE("FormatString - Integers")
+{
+    CHECK(Format("%d", {Int(42)}) == "42");
+    CHECK(Format("%i", {Int(-42)}) == "-42");
+    CHECK(Format("%5d|%-5d|%05d", {Int(42), Int(42), Int(-42)}) == "   42|42   |-0042");
+    CHECK(Format("%+d % d", {Int(7), Int(7)}) == "+7  7");
+    CHECK(Format("%.3d|%6.3d|%06.3d", {Int(7), Int(-7), Int(7)}) == "007|  -007|   007");
+    CHECK(Format("[%.0d]", {Int(0)}) == "[]");
+    CHECK(Format("%x %X %o", {Int(255), Int(255), Int(8)}) == "ff FF 10");
+    CHECK(Format("%#x %#X %#o %#x", {Int(255), Int(255), Int(8), Int(0)}) == "0xff 0XFF 010 0");
+    CHECK(Format("%#08x", {Int(255)}) == "0x0000ff");
+    CHECK(Format("%x %u", {Int(-1), Int(-1)}) == "ffffffff 4294967295");
+    CHECK(Format("%x", {Int(0x100000000)}) == "100000000");
+    CHECK(Format("%I64d %ld %lld", {Int(1), Int(2), Int(3)}) == "1 2 3");
+    CHECK(Format("%d", {Double(3.9)}) == "3");
+    CHECK(Format("%d", {String("12abc")}) == "12");
+}
+
+TEST_CASE("FormatString - Floating point")
+{
+    CHECK(Format("%f", {Double(3.14159)}) == "3.141590");
+    CHECK(Format("%.2f|%8.3f|%-8.1f|", {Double(3.14159), Double(-2.5), Double(2.0)}) ==
+          "3.14|  -2.500|2.0     |");
+    CHECK(Format("%08.2f|%+.1f|% .1f", {Double(-3.14159), Double(1.0), Double(1.0)}) ==
+          "-0003.14|+1.0| 1.0");
+    CHECK(Format("%.0f|%#.0f", {Double(2.5), Double(3.0)}) == "2|3.");
+    CHECK(Format("%e", {Double(1234.5)}) == "1.234500e+003");
+    CHECK(Format("%.2E", {Double(0.000123)}) == "1.23E-004");
+    CHECK(Format("%e", {Double(1e100)}) == "1.000000e+100");
+    CHECK(Format("%g|%g|%g", {Double(0.0001), Double(100000.0), Double(1000000.0)}) ==
+          "0.0001|100000|1e+006");
+    CHECK(Format("%#g|%G", {Double(1.5), Double(1e-10)}) == "1.50000|1E-010");
+    CHECK(Format("%f", {Int(2)}) == "2.000000");
+    CHECK(Format("%05f", {Double(1.0 / 0.0)}) == "  inf");
+}
+
+TEST_CASE("FormatString - Strings")
+{
+    CHECK(Format("%s", {String("abc")}) == "abc");
+    CHECK(Format("[%5s][%-5s]", {String("ab"), String("ab")}) == "[   ab][ab   ]");
+    CHECK(Format("%.2s|%.5s", {String("abcdef"), String("ab")}) == "ab|ab");
+    CHECK(Format("[%4s][%.1s]", {String("äö"), String("äö")}) == "[  äö][ä]");
+    CHECK(Format("%s %s", {Int(42), Double(1.5)}) == "42 1.5");
+}
+
+TEST_CASE("FormatString - Missing arguments")
+{
+    CHECK(Format("[%s][%d]", {String("a")}) == "[a][0]");
+}
@@ -0,0 +1,115 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/StringSearch.hpp>
+#include <phi/core/optional.hpp>
+#include <phi/core/sized_types.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    [[nodiscard]] phi::size_t FindNext(const std::string_view      haystack,
+                                       const std::string_view      needle,
+                                       const OpenAutoIt::CaseSense case_sense,
+                                       const phi::size_t           from = 0u)
+    {
+        const OpenAutoIt::StringSearcher searcher{haystack, needle, case_sense};
+        const auto                       match = searcher.FindNext(from);
+
+        return match ? match->offset : std::string_view::npos;
+    }
+
+    [[nodiscard]] phi::size_t FindPrevious(const std::string_view      haystack,
+                                           const std::string_view      needle,
+                                           const OpenAutoIt::CaseSense case_sense)
+    {
+        const OpenAutoIt::StringSearcher searcher{haystack, needle, case_sense};
+        const auto                       match = searcher.FindPrevious(haystack.size());
+
+        return match ? match->offset : std::string_view::npos;
+    }
+} // namespace
+
+TEST_CASE("StringSearcher - MatchCase")
+{
+    constexpr auto match_case = OpenAutoIt::CaseSense::MatchCase;
+
+    CHECK(FindNext("Hello World", "World", match_case) == 6u);
+    CHECK(FindNext("Hello World", "world", match_case) == std::string_view::npos);
+    CHECK(FindNext("Hello World", "o", match_case, 5u) == 7u);
+    CHECK(FindNext("Hello", "Hello World", match_case) == std::string_view::npos);
+    CHECK(FindNext("Hello", "", match_case) == std::string_view::npos);
+    CHECK(FindPrevious("Hello World", "o", match_case) == 7u);
+    CHECK(FindPrevious("Hello World", "x", match_case) == std::string_view::npos);
+}
+
+TEST_CASE("StringSearcher - IgnoreCase")
+{
+    constexpr auto ignore_case = OpenAutoIt::CaseSense::IgnoreCase;
+
+    CHECK(FindNext("Hello World", "WORLD", ignore_case) == 6u);
+    CHECK(FindPrevious("abcABC", "abc", ignore_case) == 3u);
+    CHECK(FindNext("ÄÖÜ", "öü", ignore_case) == 2u);
+    CHECK(FindNext("ÄÖÜ", "öü", OpenAutoIt::CaseSense::IgnoreCaseASCII) ==
+          std::string_view::npos);
+
+    // Matches can have a different size than the searched string
+    const OpenAutoIt::StringSearcher searcher{"1 \xE2\x84\xAA 2", "k", ignore_case};
+    const auto                       match = searcher.FindNext(0u);
+    CHECK(match.has_value());
+    CHECK(match->offset == 2u);
+    CHECK(match->size == 3u);
+}
+
+TEST_CASE("StringSearcher - IgnoreCase with non ASCII haystack")
+{
+    constexpr auto ignore_case = OpenAutoIt::CaseSense::IgnoreCase;
+
+    // Non ASCII characters which do not fold to ASCII keep the byte search
+    CHECK(FindNext("Grüße aus dem KIOSK", "kiosk", ignore_case) == 16u);
+    CHECK(FindPrevious("kiosk, Kiosk, Köln", "KIOSK", ignore_case) == 7u);
+
+    // Characters folding to ASCII letters are found anywhere in the haystack
+    CHECK(FindNext("äöü äöü äöü äöü äöü mi\xC4\xB0", "mii", ignore_case) == 35u);
+    CHECK(FindNext("äöü äöü äöü äöü äöü \xC5\xBFo", "SO", ignore_case) == 35u);
+    CHECK(FindNext("ä \xE2\x84\xAA", "k", ignore_case) == 3u);
+    CHECK(FindPrevious("ä k \xE2\x84\xAA", "k", ignore_case) == 5u);
+}
+
+TEST_CASE("StringSearcher - Matches std::string_view::find")
+{
+    std::mt19937                       engine{42u};
+    std::uniform_int_distribution<int> letter{0, 2};
+    std::uniform_int_distribution<int> length{1, 80};
+
+    const auto random_string = [&](const int size) {
+        std::string string;
+        for (int index{0}; index < size; ++index)
+        {
+            string += static_cast<char>('a' + letter(engine));
+        }
+        return string;
+    };
+
+    // A small alphabet produces lots of partial matches for short and long needles alike
+    for (int iteration{0}; iteration < 2000; ++iteration)
+    {
+        const std::string haystack = random_string(length(engine) * 4);
+        const std::string needle   = iteration % 2 == 0 ?
+                                             random_string(length(engine) % 6 + 1) :
+                                             haystack.substr(haystack.size() / 3u, 40u);
+
+        const OpenAutoIt::StringSearcher searcher{haystack, needle,
+                                                  OpenAutoIt::CaseSense::MatchCase};
+
+        for (phi::size_t from{0u}; from <= haystack.size(); from += 7u)
+        {
+            const auto match = searcher.FindNext(from);
+            CHECK((match ? match->offset : std::string_view::npos) == haystack.find(needle, from));
+        }
+
+        const auto last = searcher.FindPrevious(haystack.size());
+        CHECK((last ? last->offset : std::string_view::npos) == haystack.rfind(needle));
+    }
+}
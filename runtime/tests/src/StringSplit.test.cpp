@@ -0,0 +1,92 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/StringSplit.hpp>
+#include <phi/core/boolean.hpp>
+#include <phi/core/sized_types.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+    [[nodiscard]] std::vector<std::string_view> Split(const std::string_view string,
+                                                      const std::string_view delimiters,
+                                                      const phi::boolean     entire_delimiter)
+    {
+        OpenAutoIt::StringSplitter splitter{string, delimiters, entire_delimiter};
+
+        std::vector<std::string_view> fields;
+        fields.reserve(splitter.CountFields());
+        while (const auto field = splitter.NextField())
+        {
+            fields.push_back(*field);
+        }
+
+        // The count has to match what is returned
+        CHECK(fields.size() == splitter.CountFields());
+        return fields;
+    }
+
+    using Fields = std::vector<std::string_view>;
+} // namespace
+
+TEST_CASE("StringSplitter - DelimiterCharacters")
+{
+    CHECK(Split("a,b,c", ",", false) == Fields{"a", "b", "c"});
+    CHECK(Split("a,b;c", ",;", false) == Fields{"a", "b", "c"});
+    CHECK(Split(",a,,", ",", false) == Fields{"", "a", "", ""});
+    CHECK(Split("abc", ",", false) == Fields{"abc"});
+    CHECK(Split("", ",", false) == Fields{""});
+    CHECK(Split("1€2·3", "€·", false) == Fields{"1", "2", "3"});
+    CHECK(Split("1€2a3", "€a", false) == Fields{"1", "2", "3"});
+
+    // A non ASCII delimiter only matches the whole character
+    CHECK(Split("\xE2\x82\xAC\xE2\x82\xAD", "\xE2\x82\xAD", false) == Fields{"\xE2\x82\xAC", ""});
+}
+
+TEST_CASE("StringSplitter - EntireDelimiter")
+{
+    CHECK(Split("a<>b<c", "<>", true) == Fields{"a", "b<c"});
+    CHECK(Split("<><>", "<>", true) == Fields{"", "", ""});
+    CHECK(Split("aaa", "aa", true) == Fields{"", "a"});
+}
+
+TEST_CASE("StringSplitter - Characters")
+{
+    CHECK(Split("abc", "", false) == Fields{"a", "b", "c"});
+    CHECK(Split("äöü", "", true) == Fields{"ä", "ö", "ü"});
+    CHECK(Split("", "", false) == Fields{""});
+}
+
+TEST_CASE("StringSplitter - Matches naive split")
+{
+    std::mt19937 generator{42u};
+
+    for (int iteration{0}; iteration < 1000; ++iteration)
+    {
+        std::string string;
+        const auto  length = std::uniform_int_distribution<phi::size_t>{0u, 80u}(generator);
+        for (phi::size_t index{0u}; index < length; ++index)
+        {
+            string += "ab,;\xC3\xA4"[std::uniform_int_distribution<int>{0, 4}(generator)];
+        }
+
+        // Compare against splitting one byte at a time
+        const std::string_view delimiters = iteration % 2 == 0 ? "," : ",;";
+
+        Fields      expected;
+        phi::size_t start{0u};
+        for (phi::size_t index{0u}; index < string.size(); ++index)
+        {
+            if (delimiters.find(string[index]) != std::string_view::npos)
+            {
+                expected.emplace_back(string.data() + start, index - start);
+                start = index + 1u;
+            }
+        }
+        expected.emplace_back(string.data() + start, string.size() - start);
+
+        CHECK(Split(string, delimiters, false) == expected);
+    }
+}
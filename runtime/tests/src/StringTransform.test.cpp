@@ -0,0 +1,67 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/StringClassification.hpp>
+#include <OpenAutoIt/StringTransform.hpp>
+#include <string>
+
+TEST_CASE("StringTransform - Case conversion")
+{
+    CHECK(OpenAutoIt::StringToUpperCase("") == "");
+    CHECK(OpenAutoIt::StringToUpperCase("abcdefghijklmnopqrstuvwxyz @[`{") ==
+          "ABCDEFGHIJKLMNOPQRSTUVWXYZ @[`{");
+    CHECK(OpenAutoIt::StringToLowerCase("ABCDEFGHIJKLMNOPQRSTUVWXYZ @[`{") ==
+          "abcdefghijklmnopqrstuvwxyz @[`{");
+
+    // Non ASCII characters in between runs of ASCII
+    CHECK(OpenAutoIt::StringToUpperCase("0123456789abcdefä0123456789abcdef") ==
+          "0123456789ABCDEFÄ0123456789ABCDEF");
+
+    // Mappings to shorter sequences shrink the result
+    CHECK(OpenAutoIt::StringToLowerCase("\xE2\x84\xAA") == "k"); // Kelvin sign
+    CHECK(OpenAutoIt::StringToUpperCase("\xC4\xB1") == "I");     // Dotless i
+
+    // Mappings to longer sequences grow the result
+    CHECK(OpenAutoIt::StringToLowerCase("\xC8\xBA\xC8\xBA") == "\xE2\xB1\xA5\xE2\xB1\xA5");
+    CHECK(OpenAutoIt::StringToUpperCase("0123456789abcdef\xC9\x90" "0123456789abcdef") ==
+          "0123456789ABCDEF\xE2\xB1\xAF" "0123456789ABCDEF");
+
+    CHECK(OpenAutoIt::StringToUpperCase("\xC8\x99\xC8\x9B") == "\xC8\x98\xC8\x9A"); // ș ț
+
+    // Invalid UTF-8 is kept as is
+    CHECK(OpenAutoIt::StringToUpperCase("a\xFF") == "A\xFF");
+}
+
+TEST_CASE("StringTransform - StringStripWhitespace")
+{
+    const std::string text = " \t a  \r\n b                  c \n";
+
+    CHECK(OpenAutoIt::StringStripWhitespace(text, OpenAutoIt::StripLeadingWhitespace) ==
+          "a  \r\n b                  c \n");
+    CHECK(OpenAutoIt::StringStripWhitespace(text, OpenAutoIt::StripTrailingWhitespace) ==
+          " \t a  \r\n b                  c");
+    CHECK(OpenAutoIt::StringStripWhitespace(text, OpenAutoIt::StripDoubleWhitespace) ==
+          " a b c ");
+    CHECK(OpenAutoIt::StringStripWhitespace(text, OpenAutoIt::StripAllWhitespace) == "abc");
+}
+
+TEST_CASE("StringTransform - Carriage returns")
+{
+    CHECK(OpenAutoIt::StringAddCarriageReturns("\na\n\nb") == "\r\na\r\n\r\nb");
+    CHECK(OpenAutoIt::StringStripCarriageReturns("\r\na\r\n\r\nb\r") == "\na\n\nb");
+}
+
+TEST_CASE("StringClassification - StringIsCharacterClass")
+{
+    using OpenAutoIt::CharacterClass;
+
+    CHECK_FALSE(OpenAutoIt::StringIsCharacterClass("", CharacterClass::ASCII));
+    CHECK(OpenAutoIt::StringIsCharacterClass("0123456789012345678901234567890",
+                                             CharacterClass::Digit));
+    CHECK_FALSE(OpenAutoIt::StringIsCharacterClass("012345678901234567890123456789x",
+                                                   CharacterClass::Digit));
+    CHECK(OpenAutoIt::StringIsCharacterClass("abcdefghijklmnopqrstuvwxyzäöüß",
+                                             CharacterClass::Lower));
+    CHECK(OpenAutoIt::StringIsCharacterClass("日本語", CharacterClass::Alpha));
+    CHECK_FALSE(OpenAutoIt::StringIsCharacterClass("日本語", CharacterClass::Lower));
+    CHECK(OpenAutoIt::StringIsCharacterClass(" \t\n\v\f\r", CharacterClass::Space));
+}
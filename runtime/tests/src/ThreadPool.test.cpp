@@ -0,0 +1,79 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/ThreadPool.hpp>
+#include <OpenAutoIt/VirtualMachine.hpp>
+#include <phi/core/sized_types.hpp>
+#include <atomic>
+#include <future>
+#include <vector>
+
+TEST_CASE("ThreadPool - Wait for group")
+{
+    OpenAutoIt::ThreadPool   pool{2u};
+    OpenAutoIt::TaskGroup    group;
+    std::vector<phi::size_t> results(100u);
+
+    for (phi::size_t index{0u}; index < results.size(); ++index)
+    {
+        pool.Submit(group, [&results, index]() { results[index] = index * 2u; });
+    }
+    pool.Wait(group);
+
+    for (phi::size_t index{0u}; index < results.size(); ++index)
+    {
+        CHECK(results[index] == index * 2u);
+    }
+}
+
+TEST_CASE("ThreadPool - Group ignores other tasks")
+{
+    OpenAutoIt::ThreadPool pool{2u};
+
+    // Occupies a worker until the group is done
+    std::promise<void> release;
+    pool.Submit([future = release.get_future().share()]() { future.wait(); });
+
+    OpenAutoIt::TaskGroup group;
+    std::atomic<int>      count{0};
+    for (int index{0}; index < 10; ++index)
+    {
+        pool.Submit(group, [&count]() { ++count; });
+    }
+    pool.Wait(group);
+    CHECK(count == 10);
+
+    release.set_value();
+    pool.Wait();
+}
+
+TEST_CASE("ThreadPool - Wait for group inside a task")
+{
+    // The only worker waits for its own subtasks which it has to run itself
+    OpenAutoIt::ThreadPool pool{1u};
+    std::atomic<int>       count{0};
+
+    for (int outer{0}; outer < 4; ++outer)
+    {
+        pool.Submit([&pool, &count]() {
+            OpenAutoIt::TaskGroup group;
+            for (int inner{0}; inner < 8; ++inner)
+            {
+                pool.Submit(group, [&count]() { ++count; });
+            }
+            pool.Wait(group);
+        });
+    }
+    pool.Wait();
+
+    CHECK(count == 32);
+}
+
+TEST_CASE("ThreadPool - Shared pool")
+{
+    OpenAutoIt::VirtualMachine vm;
+    CHECK(&vm.GetThreadPool() == &OpenAutoIt::ThreadPool::GetShared());
+
+    OpenAutoIt::ThreadPool pool{1u};
+    vm.SetThreadPool(pool);
+    CHECK(&vm.GetThreadPool() == &pool);
+}
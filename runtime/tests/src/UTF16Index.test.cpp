@@ -0,0 +1,80 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/UTF16Index.hpp>
+#include <OpenAutoIt/Unicode.hpp>
+#include <phi/core/sized_types.hpp>
+#include <random>
+#include <string>
+#include <string_view>
+
+TEST_CASE("UTF16Index - ASCII")
+{
+    const std::string_view       string = "Hello World";
+    const OpenAutoIt::UTF16Index index{string};
+
+    CHECK(index.IsASCII());
+    CHECK(index.GetLength() == 11u);
+    CHECK(index.ToOffset(string, 6u) == 6u);
+    CHECK(index.ToOffset(string, 20u) == 11u);
+    CHECK(index.ToIndex(string, 6u) == 6u);
+
+    const OpenAutoIt::UTF16Index empty;
+    CHECK(empty.IsASCII());
+    CHECK(empty.GetLength() == 0u);
+    CHECK(empty.ToOffset("", 3u) == 0u);
+}
+
+TEST_CASE("UTF16Index - Non ASCII")
+{
+    // ä takes two bytes, € three and 😀 four bytes as well as two code units
+    const std::string_view       string = "a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80z";
+    const OpenAutoIt::UTF16Index index{string};
+
+    CHECK_FALSE(index.IsASCII());
+    CHECK(index.GetLength() == 6u);
+    CHECK(index.ToOffset(string, 0u) == 0u);
+    CHECK(index.ToOffset(string, 1u) == 1u);
+    CHECK(index.ToOffset(string, 2u) == 3u);
+    CHECK(index.ToOffset(string, 3u) == 6u);
+    CHECK(index.ToOffset(string, 4u) == 10u); // Second half of the surrogate pair
+    CHECK(index.ToOffset(string, 5u) == 10u);
+    CHECK(index.ToOffset(string, 6u) == 11u);
+    CHECK(index.ToIndex(string, 3u) == 2u);
+    CHECK(index.ToIndex(string, 10u) == 5u);
+    CHECK(index.ToIndex(string, 11u) == 6u);
+}
+
+TEST_CASE("UTF16Index - Matches a linear scan")
+{
+    constexpr const char* characters[] = {"a", "b", "\xC3\xA4", "\xE2\x82\xAC",
+                                          "\xF0\x9F\x98\x80"};
+
+    std::mt19937 generator{7u};
+    for (int iteration{0}; iteration < 200; ++iteration)
+    {
+        std::string string(std::uniform_int_distribution<phi::size_t>{0u, 40u}(generator), 'x');
+        const int   count = std::uniform_int_distribution<int>{0, 300}(generator);
+        for (int character{0}; character < count; ++character)
+        {
+            string += characters[std::uniform_int_distribution<int>{0, 4}(generator)];
+        }
+
+        const OpenAutoIt::UTF16Index index{string};
+        CHECK(index.GetLength() == OpenAutoIt::CountUTF16CodeUnits(string));
+
+        for (phi::size_t position{0u}; position <= index.GetLength() + 1u; ++position)
+        {
+            CHECK(index.ToOffset(string, position) ==
+                  OpenAutoIt::FindUTF8Offset(string, position));
+        }
+
+        for (phi::size_t offset{0u}; offset <= string.size(); ++offset)
+        {
+            if (offset == string.size() || !OpenAutoIt::IsUTF8ContinuationByte(string[offset]))
+            {
+                CHECK(index.ToIndex(string, offset) ==
+                      OpenAutoIt::CountUTF16CodeUnits(std::string_view{string}.substr(0u, offset)));
+            }
+        }
+    }
+}
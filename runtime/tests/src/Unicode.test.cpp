@@ -0,0 +1,87 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Unicode.hpp>
+#include <phi/core/sized_types.hpp>
+
+TEST_CASE("Unicode - Case mapping")
+{
+    CHECK(OpenAutoIt::ToUpperCase(U'a') == U'A');
+    CHECK(OpenAutoIt::ToLowerCase(U'Ä') == U'ä');
+    CHECK(OpenAutoIt::ToUpperCase(U'ω') == U'Ω');
+    CHECK(OpenAutoIt::ToLowerCase(U'Ж') == U'ж');
+    CHECK(OpenAutoIt::ToUpperCase(U'1') == U'1');
+    CHECK(OpenAutoIt::FoldCase(U'K') == U'k');
+}
+
+TEST_CASE("Unicode - Case mapping Latin Extended-B")
+{
+    CHECK(OpenAutoIt::ToLowerCase(U'Ș') == U'ș'); // S with comma below
+    CHECK(OpenAutoIt::ToUpperCase(U'ț') == U'Ț'); // t with comma below
+    CHECK(OpenAutoIt::ToLowerCase(U'Ơ') == U'ơ'); // O with horn
+    CHECK(OpenAutoIt::ToUpperCase(U'ư') == U'Ư'); // u with horn
+
+    // The title case DZ digraph has a mapping in both directions
+    CHECK(OpenAutoIt::ToUpperCase(U'ǆ') == U'Ǆ');
+    CHECK(OpenAutoIt::ToUpperCase(U'ǅ') == U'Ǆ');
+    CHECK(OpenAutoIt::ToLowerCase(U'ǅ') == U'ǆ');
+    CHECK(OpenAutoIt::FoldCase(U'ǅ') == U'ǆ');
+
+    // Mappings into Latin Extended-C
+    CHECK(OpenAutoIt::ToLowerCase(U'Ⱥ') == U'ⱥ');
+    CHECK(OpenAutoIt::ToUpperCase(U'ɐ') == U'Ɐ');
+
+    CHECK(OpenAutoIt::IsLetter(U'Ș'));
+    CHECK(OpenAutoIt::IsLetter(U'ⱥ'));
+    CHECK_FALSE(OpenAutoIt::IsLetter(U'\u0300')); // Combining grave accent
+}
+
+TEST_CASE("Unicode - Case mapping of other scripts")
+{
+    CHECK(OpenAutoIt::ToUpperCase(U'ͱ') == U'Ͱ'); // Greek heta
+    CHECK(OpenAutoIt::ToLowerCase(U'ϴ') == U'θ'); // Greek theta symbol
+    CHECK(OpenAutoIt::ToUpperCase(U'ა') == U'Ა'); // Georgian
+    CHECK(OpenAutoIt::ToLowerCase(U'Ⰰ') == U'ⰰ'); // Glagolitic
+    CHECK(OpenAutoIt::ToUpperCase(U'ꭰ') == U'Ꭰ'); // Cherokee
+
+    // Outside of the basic multilingual plane
+    CHECK(OpenAutoIt::ToLowerCase(U'\U00010400') == U'\U00010428'); // Deseret
+
+    CHECK(OpenAutoIt::ToUpperCase(U'一') == U'一');
+    CHECK(OpenAutoIt::IsLetter(U'一'));
+    CHECK_FALSE(OpenAutoIt::IsLetter(U'1'));
+}
+
+TEST_CASE("Unicode - DecodeUTF8")
+{
+    phi::size_t index{0u};
+    CHECK(OpenAutoIt::DecodeUTF8("a\xC3\xA4", index) == U'a');
+    CHECK(index == 1u);
+    CHECK(OpenAutoIt::DecodeUTF8("a\xC3\xA4", index) == U'\u00E4');
+    CHECK(index == 3u);
+
+    // Invalid sequences only skip a single byte
+    index = 0u;
+    CHECK(OpenAutoIt::DecodeUTF8("\xC3", index) == OpenAutoIt::ReplacementCharacter);
+    CHECK(index == 1u);
+    index = 0u;
+    CHECK(OpenAutoIt::DecodeUTF8("\xC0\x80", index) == OpenAutoIt::ReplacementCharacter);
+    CHECK(index == 1u);
+}
+
+TEST_CASE("Unicode - UTF-8 validation")
+{
+    CHECK(OpenAutoIt::FindFirstNonASCII("") == 0u);
+    CHECK(OpenAutoIt::FindFirstNonASCII("plain ASCII text longer than 16 bytes") == 37u);
+    CHECK(OpenAutoIt::FindFirstNonASCII("0123456789abcdefghij\xC3\xA4") == 20u);
+
+    CHECK(OpenAutoIt::IsValidUTF8(""));
+    CHECK(OpenAutoIt::IsValidUTF8("0123456789abcdef a\xC3\xA4\xE2\x82\xAC\xF0\x9F\x98\x80"));
+    CHECK(OpenAutoIt::IsValidUTF8("\xEF\xBF\xBD"));
+    CHECK_FALSE(OpenAutoIt::IsValidUTF8("0123456789abcdefghij\xC3"));
+    CHECK_FALSE(OpenAutoIt::IsValidUTF8("\xC0\x80"));
+    CHECK_FALSE(OpenAutoIt::IsValidUTF8("\xED\xA0\x80"));
+    CHECK_FALSE(OpenAutoIt::IsValidUTF8("a\x80z"));
+
+    CHECK(OpenAutoIt::SanitizeUTF8("a\xC3\xA4") == "a\xC3\xA4");
+    CHECK(OpenAutoIt::SanitizeUTF8("a\x80z\xC3") == "a\xEF\xBF\xBDz\xEF\xBF\xBD");
+}
@@ -0,0 +1,53 @@
+#include <phi/test/test_macros.hpp>
+
+#include <OpenAutoIt/Wildcard.hpp>
+
+TEST_CASE("Wildcard - Literal")
+{
+    const OpenAutoIt::Wildcard wildcard{"File.txt"};
+
+    CHECK(wildcard.Matches("File.txt"));
+    CHECK(wildcard.Matches("file.TXT"));
+    CHECK_FALSE(wildcard.Matches("File.txt2"));
+    CHECK_FALSE(wildcard.Matches("AFile.txt"));
+    CHECK_FALSE(wildcard.Matches(""));
+}
+
+TEST_CASE("Wildcard - Star")
+{
+    CHECK(OpenAutoIt::Wildcard{"*"}.Matches(""));
+    CHECK(OpenAutoIt::Wildcard{"*"}.Matches("anything"));
+    CHECK(OpenAutoIt::Wildcard{"*.*"}.Matches("no_extension"));
+
+    const OpenAutoIt::Wildcard extension{"*.au3"};
+    CHECK(extension.Matches("script.au3"));
+    CHECK(extension.Matches(".au3"));
+    CHECK(extension.Matches("a.au3.au3"));
+    CHECK_FALSE(extension.Matches("script.au3.bak"));
+
+    const OpenAutoIt::Wildcard prefix{"log*"};
+    CHECK(prefix.Matches("log"));
+    CHECK(prefix.Matches("LOG_2024.txt"));
+    CHECK_FALSE(prefix.Matches("blog"));
+
+    const OpenAutoIt::Wildcard middle{"a*b*c"};
+    CHECK(middle.Matches("abc"));
+    CHECK(middle.Matches("aXbYbZc"));
+    CHECK(middle.Matches("abcbc"));
+    CHECK_FALSE(middle.Matches("acb"));
+    CHECK_FALSE(middle.Matches("abcd"));
+}
+
+TEST_CASE("Wildcard - Question mark")
+{
+    const OpenAutoIt::Wildcard wildcard{"file?.txt"};
+
+    CHECK(wildcard.Matches("file1.txt"));
+    CHECK(wildcard.Matches("file\xC3\xA4.txt"));
+    CHECK_FALSE(wildcard.Matches("file.txt"));
+    CHECK_FALSE(wildcard.Matches("file12.txt"));
+
+    CHECK(OpenAutoIt::Wildcard{"*?"}.Matches("x"));
+    CHECK_FALSE(OpenAutoIt::Wildcard{"*?"}.Matches(""));
+    CHECK(OpenAutoIt::Wildcard{"?*?"}.Matches("xy"));
+}
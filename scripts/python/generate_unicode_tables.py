@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""Generates runtime/src/UnicodeTables.inc from UnicodeData.txt.
+
+Usage: generate_unicode_tables.py <UnicodeData.txt> <output>
+
+The simple case mappings (fields 12 and 13) are stored as ranges of code points which all map by
+the same delta. A stride of 2 covers the alternating upper and lower case pairs most scripts use.
+Letters are all code points of the general categories Lu, Ll, Lt, Lm and Lo.
+"""
+
+import sys
+
+LETTER_CATEGORIES = {"Lu", "Ll", "Lt", "Lm", "Lo"}
+
+
+def read_unicode_data(path):
+    upper = {}
+    lower = {}
+    letters = set()
+    range_start = None
+
+    with open(path, encoding="utf-8") as file:
+        for line in file:
+            fields = line.rstrip("\n").split(";")
+            if len(fields) < 15:
+                continue
+
+            code_point = int(fields[0], 16)
+            name = fields[1]
+            category = fields[2]
+
+            # Large blocks like the CJK ideographs are given by their first and last code point
+            if name.endswith(", First>"):
+                range_start = code_point
+                continue
+            if name.endswith(", Last>"):
+                code_points = range(range_start, code_point + 1)
+                range_start = None
+            else:
+                code_points = range(code_point, code_point + 1)
+
+            for current in code_points:
+                if category in LETTER_CATEGORIES:
+                    letters.add(current)
+                if fields[12]:
+                    upper[current] = int(fields[12], 16)
+                if fields[13]:
+                    lower[current] = int(fields[13], 16)
+
+    return upper, lower, letters
+
+
+def compress_mappings(mappings):
+    """Returns (first, last, delta, stride) tuples which don't overlap."""
+    entries = []
+    for code_point in sorted(mappings):
+        delta = mappings[code_point] - code_point
+        if entries:
+            first, last, last_delta, stride = entries[-1]
+            if last_delta == delta:
+                if code_point == last + 1 and stride in (0, 1):
+                    entries[-1] = (first, code_point, delta, 1)
+                    continue
+                if code_point == last + 2 and stride in (0, 2):
+                    entries[-1] = (first, code_point, delta, 2)
+                    continue
+        entries.append((code_point, code_point, delta, 0))
+
+    return [(first, last, delta, stride or 1) for first, last, delta, stride in entries]
+
+
+def compress_ranges(code_points):
+    ranges = []
+    for code_point in sorted(code_points):
+        if ranges and ranges[-1][1] + 1 == code_point:
+            ranges[-1][1] = code_point
+        else:
+            ranges.append([code_point, code_point])
+
+    return ranges
+
+
+def format_mappings(name, entries):
+    lines = [f"constexpr const CaseMapping {name}[]{{"]
+    for first, last, delta, stride in entries:
+        lines.append(f"        {{0x{first:04X}, 0x{last:04X}, {delta}, {stride}}},")
+    lines.append("};")
+
+    return lines
+
+
+def format_ranges(name, ranges):
+    lines = [f"constexpr const CodePointRange {name}[]{{"]
+    for first, last in ranges:
+        lines.append(f"        {{0x{first:04X}, 0x{last:04X}}},")
+    lines.append("};")
+
+    return lines
+
+
+def main():
+    if len(sys.argv) != 3:
+        print(__doc__)
+        return 1
+
+    upper, lower, letters = read_unicode_data(sys.argv[1])
+
+    lines = [
+        "// Generated by scripts/python/generate_unicode_tables.py from",
+        "// https://www.unicode.org/Public/UCD/latest/ucd/UnicodeData.txt",
+        "// Do not edit by hand.",
+        "",
+        "// Simple upper case mappings",
+        *format_mappings("upper_case_mappings", compress_mappings(upper)),
+        "",
+        "// Simple lower case mappings",
+        *format_mappings("lower_case_mappings", compress_mappings(lower)),
+        "",
+        "// General categories Lu, Ll, Lt, Lm and Lo",
+        *format_ranges("letter_ranges", compress_ranges(letters)),
+    ]
+
+    with open(sys.argv[2], "w", encoding="utf-8", newline="\n") as file:
+        file.write("\n".join(lines) + "\n")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
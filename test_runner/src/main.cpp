@@ -32,6 +32,7 @@ PHI_GCC_SUPPRESS_WARNING("-Walloc-zero")
 #include <iostream>
 #include <regex>
 #include <string>
+#include <string_view>
 
 using namespace OpenAutoIt;
 
@@ -78,14 +79,16 @@ static const std::regex expect_error_regex{R"regex(expect-error:\s*"(.*)")regex"
 
 PHI_CLANG_SUPPRESS_WARNING_POP()
 
-void standard_output_handler(const std::string& message)
+void standard_output_handler(std::string_view message)
 {
-    out_buffer.std_out += message + '\0';
+    out_buffer.std_out += message;
+    out_buffer.std_out += '\0';
 }
 
-void error_output_handler(const std::string& message)
+void error_output_handler(std::string_view message)
 {
-    out_buffer.std_err += message + '\0';
+    out_buffer.std_err += message;
+    out_buffer.std_err += '\0';
 }
 
 void basic_trim(std::string& str)